@@ -0,0 +1,170 @@
+/**
+ * @file BrewSnapshot.h
+ * @brief Snapshot do processo de brassagem no LittleFS para retomada após queda de energia.
+ * @details A loggerTask grava um registro compacto (48 bytes) com o estado ativo e as variáveis
+ * da statechart, a receita/etapa em andamento, o tempo já cumprido da etapa e o integrador do PID
+ * a partir dos pedidos que a controlTask publica (PersistenceMailbox, ControlLoop.h) no início de
+ * cada etapa, quando o setpoint é atingido e periodicamente durante a etapa.
+ * A gravação é atômica: o registro é escrito em um arquivo temporário e renomeado sobre o
+ * snapshot anterior, de modo que uma queda durante a escrita preserva o snapshot antigo.
+ * No boot, o setup() carrega e valida o snapshot (magic, versão, tamanho e CRC-32) e a
+ * stateMachineTask retoma a etapa com o tempo restante correto em vez de entrar no IDLE.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef BREWSNAPSHOT_H
+#define BREWSNAPSHOT_H
+
+// Includes do projeto
+#include <Arduino.h>
+#include <stddef.h>
+
+// LittleFS
+#include "FS.h"
+#include "LittleFS.h"
+
+// --- PARÂMETROS DO SNAPSHOT ---
+#define BREW_SNAPSHOT_FILE "/brew_state.bin"     // Snapshot válido
+#define BREW_SNAPSHOT_TMP_FILE "/brew_state.tmp" // Escrita em andamento (descartado no boot)
+#define BREW_SNAPSHOT_MAGIC 0x4E535242UL         // "BRSN" em little-endian
+#define BREW_SNAPSHOT_VERSION 1
+#define BREW_SNAPSHOT_PERIOD_MS 10000UL // Gravação periódica durante a etapa (perda máxima de 10 s de contagem)
+
+/**
+ * @brief Registro gravado no LittleFS (layout fixo, sem padding).
+ */
+struct BrewSnapshot
+{
+  uint32_t magic;               // BREW_SNAPSHOT_MAGIC
+  uint16_t version;             // BREW_SNAPSHOT_VERSION
+  uint16_t size;                // sizeof(BrewSnapshot)
+  uint32_t sequence;            // Incrementado a cada gravação
+  uint8_t activeState;          // Estado folha ativo (Statechart::StatechartStates)
+  int8_t recipeIdx;             // StatechartCallback::currentRecipeIdx
+  int8_t stepIdx;               // StatechartCallback::currentStepIdx
+  uint8_t setpointReached;      // Contagem da etapa já iniciada
+  int16_t targetTemperature;    // Temperatura alvo da etapa (ºC)
+  int16_t durationMinutes;      // Duração da etapa (min)
+  uint32_t elapsedMillis;       // Tempo da etapa já cumprido (após atingir o setpoint)
+  int32_t customNumSteps;       // Variável custom_num_steps da statechart
+  int32_t currentCustomStepIdx; // Variável current_custom_step_idx da statechart
+  int32_t receivedValue;        // Variável received_value da statechart
+  float pidOutput;              // Saída do PID no momento da gravação
+  float pidIntegral;            // Integrador do PID no momento da gravação
+  uint32_t crc;                 // CRC-32 de todos os campos anteriores
+};
+static_assert(sizeof(BrewSnapshot) == 48, "BrewSnapshot deve manter o layout de 48 bytes");
+
+/**
+ * @brief Gravação atômica e leitura validada do snapshot no LittleFS.
+ * @details Usado pela loggerTask (gravação/remoção) e pelo setup() (leitura no boot).
+ */
+class BrewSnapshotStore
+{
+public:
+  /**
+   * @brief Grava o snapshot (arquivo temporário + rename).
+   * @param snapshot Registro a gravar; magic, versão, tamanho, sequência e CRC são preenchidos aqui.
+   * @return true se o snapshot foi gravado e renomeado com sucesso.
+   */
+  bool save(BrewSnapshot &snapshot)
+  {
+    uint32_t startMicros = micros();
+    snapshot.magic = BREW_SNAPSHOT_MAGIC;
+    snapshot.version = BREW_SNAPSHOT_VERSION;
+    snapshot.size = sizeof(BrewSnapshot);
+    snapshot.sequence = ++sequence;
+    snapshot.crc = crc32((const uint8_t *)&snapshot, offsetof(BrewSnapshot, crc));
+
+    File file = LittleFS.open(BREW_SNAPSHOT_TMP_FILE, FILE_WRITE);
+    if (!file)
+    {
+      failures++;
+      return false;
+    }
+    size_t written = file.write((const uint8_t *)&snapshot, sizeof(BrewSnapshot));
+    file.close();
+    if (written != sizeof(BrewSnapshot) || !LittleFS.rename(BREW_SNAPSHOT_TMP_FILE, BREW_SNAPSHOT_FILE))
+    {
+      failures++;
+      return false;
+    }
+
+    uint32_t elapsed = micros() - startMicros;
+    writes++;
+    if (elapsed > maxWriteMicros)
+      maxWriteMicros = elapsed;
+    return true;
+  }
+
+  /**
+   * @brief Lê e valida o snapshot gravado.
+   * @param snapshot Recebe o registro lido.
+   * @return true se existe um snapshot íntegro (magic, versão, tamanho e CRC conferem).
+   */
+  bool load(BrewSnapshot &snapshot)
+  {
+    File file = LittleFS.open(BREW_SNAPSHOT_FILE, FILE_READ);
+    if (!file)
+    {
+      return false;
+    }
+    size_t read = file.read((uint8_t *)&snapshot, sizeof(BrewSnapshot));
+    file.close();
+    if (read != sizeof(BrewSnapshot) || snapshot.magic != BREW_SNAPSHOT_MAGIC ||
+        snapshot.version != BREW_SNAPSHOT_VERSION || snapshot.size != sizeof(BrewSnapshot) ||
+        snapshot.crc != crc32((const uint8_t *)&snapshot, offsetof(BrewSnapshot, crc)))
+    {
+      Serial.println("BrewSnapshot: Snapshot invalido descartado.");
+      return false;
+    }
+    sequence = snapshot.sequence;
+    return true;
+  }
+
+  /**
+   * @brief Remove o snapshot (processo concluído ou abortado).
+   */
+  void clear()
+  {
+    LittleFS.remove(BREW_SNAPSHOT_FILE);
+    LittleFS.remove(BREW_SNAPSHOT_TMP_FILE);
+  }
+
+  /**
+   * @brief Imprime as estatísticas de gravação na Serial.
+   */
+  void printStats(Print &out)
+  {
+    out.printf("Snapshot: %lu gravacoes, %lu falhas, pior gravacao=%lu us\n",
+               (unsigned long)writes, (unsigned long)failures, (unsigned long)maxWriteMicros);
+  }
+
+  /**
+   * @brief CRC-32 (polinômio refletido 0xEDB88320), bit a bit: os registros têm poucas dezenas de bytes.
+   * @details Também usado pelo PidGainsStore (PidGains.h).
+   */
+  static uint32_t crc32(const uint8_t *data, size_t length)
+  {
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (size_t i = 0; i < length; ++i)
+    {
+      crc ^= data[i];
+      for (uint8_t bit = 0; bit < 8; ++bit)
+      {
+        crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+      }
+    }
+    return ~crc;
+  }
+
+private:
+  uint32_t sequence = 0;       // Sequência da última gravação
+  uint32_t writes = 0;         // Gravações concluídas
+  uint32_t failures = 0;       // Falhas de escrita ou rename
+  uint32_t maxWriteMicros = 0; // Pior tempo de gravação
+};
+
+#endif // BREWSNAPSHOT_H
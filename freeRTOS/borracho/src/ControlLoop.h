@@ -0,0 +1,292 @@
+/**
+ * @file ControlLoop.h
+ * @brief Período fixo da controlTask com prazos absolutos e estatísticas de jitter.
+ * @details A controlTask fazia `vTaskDelay(100)` depois de um trabalho de duração variável (log no
+ * LittleFS, sprintf, montagem da tela de status, Serial.printf), então o período real passava de
+ * 100 ms e variava a cada volta. ControlLoopScheduler acorda a tarefa em instantes absolutos
+ * (vTaskDelayUntil): a duração do trabalho não desloca o próximo ciclo. Se o trabalho passar de um
+ * período inteiro, o prazo é contado como perdido e o ciclo seguinte volta para a grade de
+ * períodos, sem uma rajada de ciclos atrasados para "recuperar".
+ * Registra o período medido entre despertares (mínimo, máximo e histograma do desvio em relação
+ * ao nominal), o pior tempo de trabalho, a latência do despertar até o PWM ser aplicado, os prazos
+ * perdidos e os cálculos do PID descartados. Impressos junto com o log (tecla '*' no IDLE).
+ * A controlTask só lê o sensor, calcula o PID e aplica o PWM; o que ela precisa registrar (linha
+ * do log CSV, tela de status) vira um ControlRecord publicado em filas SPSC (SpscRing.h) e
+ * consumido por tarefas de menor prioridade, de modo que uma gravação lenta no flash não atrasa o
+ * aquecedor. As filas podem descartar registros quando cheias; o que muda o estado persistido
+ * (snapshot de retomada, remoção dele, ganhos do auto-tune) vai pela PersistenceMailbox, que
+ * guarda o pedido mais novo de cada tipo até a loggerTask gravá-lo.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef CONTROLLOOP_H
+#define CONTROLLOOP_H
+
+// Includes do projeto
+#include <Arduino.h>
+
+// FreeRTOS Headers
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define CONTROL_PERIOD_MS 100 // Período da controlTask (e do PID)
+#define CONTROL_RECORD_RING 16 // Registros pendentes por consumidor (16 s de folga a 1 registro/s)
+
+// --- O QUE O CONSUMIDOR FAZ COM UM ControlRecord (ControlRecord::flags) ---
+#define CONTROL_RECORD_LOG 0x01            // Linha no log CSV (uma por segundo)
+#define CONTROL_RECORD_STATUS 0x02         // Atualização da tela de status (uma por segundo)
+#define CONTROL_RECORD_SNAPSHOT 0x04       // Grava o snapshot de retomada (PersistenceMailbox)
+#define CONTROL_RECORD_CLEAR_SNAPSHOT 0x08 // Apaga o snapshot, processo abortado ou concluído (PersistenceMailbox)
+#define CONTROL_RECORD_NEW_LOG 0x10        // Recomeça o log CSV com o cabeçalho (nova receita)
+#define CONTROL_RECORD_SAVE_GAINS 0x20     // Grava os ganhos do auto-tune, campos gain* (PersistenceMailbox)
+
+/**
+ * @brief Registro compacto de um ciclo da controlTask, publicado para o logger e a tela de status.
+ */
+struct ControlRecord
+{
+  uint32_t timestampMillis;   // millis() do ciclo
+  uint32_t stepElapsedMillis; // Tempo da etapa já cumprido (0 antes de atingir o setpoint)
+  float temperature;          // Temperatura medida (°C)
+  float output;               // Saída do PID (duty cycle)
+  float pidIntegral;          // Integrador do PID (snapshot)
+  int16_t targetTemperature;  // Setpoint da etapa (°C)
+  int16_t durationMinutes;    // Duração da etapa
+  int16_t remainingSeconds;   // Tempo restante da etapa
+  int8_t recipeIdx;           // Receita em andamento
+  int8_t stepIdx;             // Etapa em andamento
+  bool setpointReached;       // Contagem da etapa iniciada
+  uint8_t flags;              // CONTROL_RECORD_*
+
+  // Variáveis da receita personalizada no início da etapa (vindas no CMD_START_RECIPE_STEP): o
+  // snapshot e a tela de status não leem a statechart, que é da stateMachineTask
+  int8_t customNumSteps;       // Número de etapas da receita personalizada
+  int8_t currentCustomStepIdx; // Etapa personalizada em edição/execução
+  int16_t receivedValue;       // Último valor digitado
+
+  // Ganhos identificados pelo auto-tune (só com CONTROL_RECORD_SAVE_GAINS): cópia feita pela
+  // controlTask, a loggerTask não lê o RelayAutoTune
+  float gainKp;
+  float gainKi;
+  float gainKd;
+  float gainUltimate;          // Ku
+  float gainUltimatePeriodSec; // Pu (s)
+};
+
+/**
+ * @brief Pedidos de gravação da controlTask que não podem se perder (snapshot, remoção, ganhos).
+ * @details A SpscRing descarta o registro quando está cheia, o que só é aceitável para uma linha
+ * do log. Uma remoção perdida deixaria o /brew_state.bin de um processo abortado ou concluído, e
+ * o próximo boot retomaria a receita com o aquecedor ligado. Aqui cada tipo de pedido é uma flag
+ * pendente com a cópia do registro mais novo: um pedido novo substitui o anterior ainda não
+ * gravado em vez de ser descartado. A remoção também descarta o snapshot pendente, que é de antes
+ * dela. A loggerTask drena tudo com take() a cada despertar.
+ */
+class PersistenceMailbox
+{
+public:
+  /**
+   * @brief Pedidos entregues por take(), na ordem em que devem ser gravados.
+   */
+  struct Pending
+  {
+    bool clearSnapshot;          // Apagar o snapshot
+    bool snapshot;               // Gravar snapshotRecord (posterior à remoção)
+    bool gains;                  // Gravar os ganhos de gainsRecord
+    ControlRecord snapshotRecord;
+    ControlRecord gainsRecord;
+  };
+
+  /** @brief Snapshot de retomada (chamado pela controlTask). */
+  void postSnapshot(const ControlRecord &record)
+  {
+    portENTER_CRITICAL(&mux);
+    if (pending.snapshot)
+      replaced++;
+    pending.snapshot = true;
+    pending.snapshotRecord = record;
+    portEXIT_CRITICAL(&mux);
+  }
+
+  /** @brief Remoção do snapshot (chamado pela controlTask). */
+  void postClearSnapshot()
+  {
+    portENTER_CRITICAL(&mux);
+    if (pending.snapshot)
+      replaced++;
+    pending.snapshot = false;
+    pending.clearSnapshot = true;
+    portEXIT_CRITICAL(&mux);
+  }
+
+  /** @brief Ganhos do auto-tune (campos gain* do registro; chamado pela controlTask). */
+  void postGains(const ControlRecord &record)
+  {
+    portENTER_CRITICAL(&mux);
+    if (pending.gains)
+      replaced++;
+    pending.gains = true;
+    pending.gainsRecord = record;
+    portEXIT_CRITICAL(&mux);
+  }
+
+  /**
+   * @brief Retira todos os pedidos pendentes (chamado pela loggerTask).
+   * @return true se havia algum pedido.
+   */
+  bool take(Pending &out)
+  {
+    portENTER_CRITICAL(&mux);
+    out = pending;
+    pending.clearSnapshot = pending.snapshot = pending.gains = false;
+    portEXIT_CRITICAL(&mux);
+    return out.clearSnapshot || out.snapshot || out.gains;
+  }
+
+  void printStats(Print &out)
+  {
+    out.printf("Persistencia: %lu pedidos substituidos por um mais novo antes da gravacao\n", (unsigned long)replaced);
+  }
+
+private:
+  portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+  Pending pending = {};
+  uint32_t replaced = 0; // Pedidos sobrescritos antes de a loggerTask gravá-los
+};
+
+/**
+ * @brief Escalonador periódico de uma tarefa (usado só pela própria tarefa).
+ */
+class ControlLoopScheduler
+{
+public:
+  static const uint8_t JITTER_BUCKETS = 6;
+
+  explicit ControlLoopScheduler(uint32_t periodMs)
+      : periodTicks(pdMS_TO_TICKS(periodMs)), periodMicros(periodMs * 1000UL) {}
+
+  /**
+   * @brief Define o instante de referência da grade de períodos (antes do primeiro ciclo).
+   */
+  void start()
+  {
+    lastWake = xTaskGetTickCount();
+    lastWakeMicros = micros();
+  }
+
+  /**
+   * @brief Bloqueia até o início do próximo período.
+   * @return Períodos perdidos porque o trabalho do ciclo passou do prazo (normalmente 0).
+   */
+  uint32_t waitNextPeriod()
+  {
+    uint32_t workMicros = micros() - lastWakeMicros;
+    if (workMicros > maxWorkMicros)
+      maxWorkMicros = workMicros;
+
+    uint32_t missed = 0;
+    TickType_t elapsed = xTaskGetTickCount() - lastWake;
+    if (elapsed > periodTicks)
+    {
+      // Pula os períodos já vencidos: o próximo despertar é o primeiro da grade ainda no futuro
+      missed = (elapsed - 1) / periodTicks;
+      lastWake += missed * periodTicks;
+      deadlineMisses++;
+      missedPeriods += missed;
+    }
+    vTaskDelayUntil(&lastWake, periodTicks);
+
+    uint32_t now = micros();
+    recordPeriod(now - lastWakeMicros, missed);
+    lastWakeMicros = now;
+    return missed;
+  }
+
+  /**
+   * @brief Registra a latência do despertar do ciclo até o PWM ser aplicado.
+   */
+  void recordActuation()
+  {
+    uint32_t latency = micros() - lastWakeMicros;
+    actuations++;
+    totalActuationMicros += latency;
+    if (latency > maxActuationMicros)
+      maxActuationMicros = latency;
+  }
+
+  /**
+   * @brief Conta um ciclo em que o PID deveria calcular e não calculou.
+   */
+  void recordSkippedCompute()
+  {
+    skippedComputes++;
+  }
+
+  /**
+   * @brief Imprime período, histograma de jitter, prazos perdidos e cálculos do PID descartados.
+   */
+  void printStats(Print &out)
+  {
+    out.printf("Controle: %lu ciclos de %lu ms, periodo min=%lu us max=%lu us, trabalho max=%lu us, prazos perdidos=%lu (%lu periodos), PID sem calculo=%lu\n",
+               (unsigned long)cycles, (unsigned long)(periodMicros / 1000), (unsigned long)(cycles ? minPeriodMicros : 0),
+               (unsigned long)maxPeriodMicros, (unsigned long)maxWorkMicros, (unsigned long)deadlineMisses,
+               (unsigned long)missedPeriods, (unsigned long)skippedComputes);
+    out.printf("Controle: despertar -> PWM medio=%lu us (max %lu us) em %lu ciclos ativos\n",
+               (unsigned long)(actuations ? totalActuationMicros / actuations : 0), (unsigned long)maxActuationMicros,
+               (unsigned long)actuations);
+    out.print("Controle: jitter |");
+    for (uint8_t b = 0; b < JITTER_BUCKETS; ++b)
+    {
+      if (b < JITTER_BUCKETS - 1)
+        out.printf(" <%luus=%lu", (unsigned long)bucketLimitMicros(b), (unsigned long)jitterHistogram[b]);
+      else
+        out.printf(" >=%luus=%lu", (unsigned long)bucketLimitMicros(b - 1), (unsigned long)jitterHistogram[b]);
+    }
+    out.println();
+  }
+
+private:
+  // Limites superiores (us) dos baldes do desvio; o último balde é ">= 20 ms"
+  static uint32_t bucketLimitMicros(uint8_t bucket)
+  {
+    static const uint32_t limits[JITTER_BUCKETS - 1] = {50, 200, 1000, 5000, 20000};
+    return limits[bucket];
+  }
+
+  // Período medido (desconta os períodos perdidos, já contados à parte)
+  void recordPeriod(uint32_t period, uint32_t missed)
+  {
+    period -= missed * periodMicros;
+    cycles++;
+    if (cycles == 1 || period < minPeriodMicros)
+      minPeriodMicros = period;
+    if (period > maxPeriodMicros)
+      maxPeriodMicros = period;
+    uint32_t jitter = period > periodMicros ? period - periodMicros : periodMicros - period;
+    uint8_t bucket = 0;
+    while (bucket < JITTER_BUCKETS - 1 && jitter >= bucketLimitMicros(bucket))
+      bucket++;
+    jitterHistogram[bucket]++;
+  }
+
+  const TickType_t periodTicks;
+  const uint32_t periodMicros;
+  TickType_t lastWake = 0;     // Início do período atual (ticks, referência do vTaskDelayUntil)
+  uint32_t lastWakeMicros = 0; // Despertar do ciclo atual
+
+  uint32_t cycles = 0;                             // Períodos medidos
+  uint32_t minPeriodMicros = 0;                    // Menor período entre despertares
+  uint32_t maxPeriodMicros = 0;                    // Maior período entre despertares
+  uint32_t maxWorkMicros = 0;                      // Pior tempo de trabalho de um ciclo
+  uint32_t deadlineMisses = 0;                     // Ciclos cujo trabalho passou do prazo
+  uint32_t missedPeriods = 0;                      // Períodos pulados por esses atrasos
+  uint32_t skippedComputes = 0;                    // Ciclos ativos sem cálculo do PID
+  uint32_t actuations = 0;                         // Ciclos ativos (PWM aplicado)
+  uint64_t totalActuationMicros = 0;               // Soma das latências despertar -> PWM
+  uint32_t maxActuationMicros = 0;                 // Pior latência despertar -> PWM
+  uint32_t jitterHistogram[JITTER_BUCKETS] = {};   // Ciclos por faixa de |período - nominal|
+};
+
+#endif // CONTROLLOOP_H
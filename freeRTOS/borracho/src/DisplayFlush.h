@@ -0,0 +1,282 @@
+/**
+ * @file DisplayFlush.h
+ * @brief Atualização parcial do display SSD1306: envia apenas as páginas e colunas alteradas.
+ * @details O `display.display()` da Adafruit transmite o framebuffer inteiro (1 KB) a cada comando,
+ * mesmo quando só a linha "Digitado:" ou o cabeçalho mudou. Esta classe mantém uma cópia do
+ * último quadro enviado (shadow buffer), compara página a página (8 linhas de pixels = 128 bytes)
+ * e, para cada página alterada, envia só o intervalo de colunas entre a primeira e a última
+ * diferença, usando os comandos PAGEADDR/COLUMNADDR do SSD1306 (endereçamento horizontal,
+ * configurado pelo begin() da Adafruit). Cada página é uma reserva do barramento I2C (I2CBus),
+ * de modo que uma leitura do sensor pendente passa na frente entre duas páginas.
+ * Registra bytes enviados, tempo e vazão de cada atualização.
+ * O envio roda em uma tarefa própria (displayFlushTask): a displayTask desenha o quadro no
+ * framebuffer da Adafruit, copia-o para a FrameMailbox e já pode desenhar o próximo enquanto o
+ * anterior está no barramento (buffer duplo). Se um quadro novo fica pronto antes de o anterior
+ * sair da caixa, o mais novo o substitui.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef DISPLAYFLUSH_H
+#define DISPLAYFLUSH_H
+
+// Includes do projeto
+#include <Arduino.h>
+
+#include "I2CBus.h"
+
+// DisplayOLED
+#include <Adafruit_SSD1306.h>
+
+// FreeRTOS Headers
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+// --- PARÂMETROS DA ATUALIZAÇÃO ---
+#define DISPLAY_FLUSH_CHUNK 31       // Bytes de dados por transação (buffer do Wire de 32 bytes - byte de controle)
+#define DISPLAY_FRAME_SIZE (SCREEN_WIDTH * SCREEN_HEIGHT / 8)
+#define DISPLAY_FRAME_MAX_INPUTS 8   // Teclas distintas registradas por quadro (latência tecla -> tela)
+
+/**
+ * @brief Atualização do SSD1306 por páginas sujas.
+ */
+class DirtyPageFlusher
+{
+public:
+  static const uint8_t PAGES = SCREEN_HEIGHT / 8;
+
+  /**
+   * @param bus Barramento I2C compartilhado.
+   * @param address Endereço I2C do display.
+   */
+  DirtyPageFlusher(I2CBus &bus, uint8_t address)
+      : bus(bus), address(address) {}
+
+  /**
+   * @brief Força o envio do quadro inteiro na próxima atualização (ex: display reinicializado).
+   */
+  void invalidate()
+  {
+    shadowValid = false;
+  }
+
+  /**
+   * @brief Envia ao display as partes do quadro que mudaram desde o último envio.
+   * @param buffer Quadro no formato do framebuffer do SSD1306 (DISPLAY_FRAME_SIZE bytes).
+   * @return Número de bytes transmitidos (dados + comandos), 0 se nada mudou.
+   */
+  uint32_t flush(const uint8_t *buffer)
+  {
+    uint32_t startMicros = micros();
+    uint32_t bytes = 0;
+
+    for (uint8_t page = 0; page < PAGES; ++page)
+    {
+      const uint8_t *row = buffer + page * SCREEN_WIDTH;
+      uint8_t *shadowRow = shadow + page * SCREEN_WIDTH;
+
+      // Intervalo de colunas alteradas na página
+      int16_t first = 0;
+      int16_t last = SCREEN_WIDTH - 1;
+      if (shadowValid)
+      {
+        while (first < SCREEN_WIDTH && row[first] == shadowRow[first])
+          first++;
+        if (first == SCREEN_WIDTH)
+          continue; // Página inalterada
+        while (row[last] == shadowRow[last])
+          last--;
+      }
+
+      // Janela de escrita: uma página, colunas [first, last] (byte de controle 0x00 + lista de comandos)
+      const uint8_t window[] = {0x00, SSD1306_PAGEADDR, page, page, SSD1306_COLUMNADDR, (uint8_t)first, (uint8_t)last};
+      bus.acquire(I2C_CLIENT_DISPLAY);
+      bool sent = bus.write(address, window, sizeof(window)) == 0 && sendData(row + first, last - first + 1);
+      bus.release();
+      bytes += sizeof(window);
+
+      if (!sent)
+      {
+        errors++;
+        shadowValid = false; // Conteúdo do display incerto: reenvia tudo na próxima
+        return bytes;
+      }
+      bytes += (last - first + 1) + ((last - first) / DISPLAY_FLUSH_CHUNK + 1); // Dados + bytes de controle
+      memcpy(shadowRow + first, row + first, last - first + 1);
+      pagesSent++;
+    }
+
+    shadowValid = true;
+
+    uint32_t elapsed = micros() - startMicros;
+    frames++;
+    if (bytes == 0)
+      skippedFrames++;
+    totalBytes += bytes;
+    totalMicros += elapsed;
+    if (elapsed > maxMicros)
+      maxMicros = elapsed;
+    lastBytes = bytes;
+    lastMicros = elapsed;
+    return bytes;
+  }
+
+  /**
+   * @brief Imprime as estatísticas de atualização na Serial.
+   */
+  void printStats(Print &out)
+  {
+    out.printf("Display: %lu quadros (%lu sem mudancas), %lu paginas, media %lu bytes/quadro (quadro cheio=%u), ultimo %lu bytes\n",
+               (unsigned long)frames, (unsigned long)skippedFrames, (unsigned long)pagesSent,
+               (unsigned long)(frames ? totalBytes / frames : 0), (unsigned)(SCREEN_WIDTH * PAGES),
+               (unsigned long)lastBytes);
+    out.printf("Display: tempo medio=%lu us (max %lu us, ultimo %lu us), vazao=%lu bytes/s, erros I2C=%lu\n",
+               (unsigned long)(frames ? totalMicros / frames : 0), (unsigned long)maxMicros,
+               (unsigned long)lastMicros, (unsigned long)(totalMicros ? totalBytes * 1000000ULL / totalMicros : 0),
+               (unsigned long)errors);
+  }
+
+private:
+  // Envia dados do GDDRAM em transações de até DISPLAY_FLUSH_CHUNK bytes (byte de controle 0x40)
+  bool sendData(const uint8_t *data, uint16_t length)
+  {
+    uint8_t transaction[1 + DISPLAY_FLUSH_CHUNK];
+    transaction[0] = 0x40;
+    while (length > 0)
+    {
+      uint16_t chunk = length < DISPLAY_FLUSH_CHUNK ? length : DISPLAY_FLUSH_CHUNK;
+      memcpy(transaction + 1, data, chunk);
+      if (bus.write(address, transaction, 1 + chunk) != 0)
+      {
+        return false;
+      }
+      data += chunk;
+      length -= chunk;
+    }
+    return true;
+  }
+
+  I2CBus &bus;
+  uint8_t address;
+
+  uint8_t shadow[DISPLAY_FRAME_SIZE]; // Último quadro enviado ao display
+  bool shadowValid = false;             // false: o próximo envio é o quadro inteiro
+
+  // Estatísticas
+  uint32_t frames = 0;        // Atualizações solicitadas
+  uint32_t skippedFrames = 0; // Atualizações sem nenhuma mudança
+  uint32_t pagesSent = 0;     // Páginas transmitidas
+  uint32_t errors = 0;        // Falhas de transmissão I2C
+  uint64_t totalBytes = 0;    // Bytes transmitidos
+  uint64_t totalMicros = 0;   // Tempo total de atualização
+  uint32_t maxMicros = 0;     // Pior tempo de atualização
+  uint32_t lastBytes = 0;     // Bytes do último quadro
+  uint32_t lastMicros = 0;    // Tempo do último quadro
+};
+
+/**
+ * @brief Dados de um quadro entregue à displayFlushTask (cadência, prazo e latência).
+ */
+struct FrameInfo
+{
+  uint32_t firstCommandMicros;                     // Recebimento do primeiro comando do quadro
+  uint32_t renderStartMicros;                      // Início do desenho
+  uint8_t lastCommandType;                         // Último comando desenhado (trace)
+  uint8_t inputCount;                              // Entradas válidas em inputMicros
+  uint32_t inputMicros[DISPLAY_FRAME_MAX_INPUTS];  // Teclas com resposta no quadro (em ordem)
+
+  /**
+   * @brief Acrescenta uma tecla ao quadro (ignora repetidas e o excedente).
+   */
+  void addInput(uint32_t stamp)
+  {
+    if (stamp == 0 || (inputCount > 0 && inputMicros[inputCount - 1] == stamp) || inputCount >= DISPLAY_FRAME_MAX_INPUTS)
+      return;
+    inputMicros[inputCount++] = stamp;
+  }
+};
+
+/**
+ * @brief Caixa de um quadro entre a displayTask (produtora) e a displayFlushTask (consumidora).
+ * @details Dois buffers: o pendente (último quadro desenhado) e o em envio. O mutex protege só a
+ * cópia para o pendente e a troca dos ponteiros; o envio I2C acontece fora dele.
+ */
+class FrameMailbox
+{
+public:
+  /**
+   * @brief Cria o mutex (chamar no setup, antes das tarefas).
+   */
+  bool begin()
+  {
+    mutex = xSemaphoreCreateMutex();
+    return mutex != NULL;
+  }
+
+  /**
+   * @brief Publica um quadro desenhado (copia o framebuffer; não espera o envio).
+   * @details Se o quadro anterior ainda não foi retirado, é substituído; ele chegou antes, então
+   * o novo herda o instante do seu primeiro comando e as suas teclas.
+   */
+  void post(const uint8_t *frame, const FrameInfo &info)
+  {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    memcpy(pending, frame, DISPLAY_FRAME_SIZE);
+    if (hasPending)
+    {
+      replaced++;
+      pendingInfo.renderStartMicros = info.renderStartMicros;
+      pendingInfo.lastCommandType = info.lastCommandType;
+      for (uint8_t i = 0; i < info.inputCount; ++i)
+        pendingInfo.addInput(info.inputMicros[i]);
+    }
+    else
+    {
+      pendingInfo = info;
+      hasPending = true;
+    }
+    xSemaphoreGive(mutex);
+  }
+
+  /**
+   * @brief Retira o quadro pendente para envio.
+   * @param info Recebe os dados do quadro.
+   * @return Quadro a enviar (válido até a próxima chamada), ou nullptr se não há quadro pendente.
+   */
+  const uint8_t *take(FrameInfo &info)
+  {
+    const uint8_t *frame = nullptr;
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    if (hasPending)
+    {
+      uint8_t *swap = inFlight;
+      inFlight = pending;
+      pending = swap;
+      info = pendingInfo;
+      hasPending = false;
+      frame = inFlight;
+    }
+    xSemaphoreGive(mutex);
+    return frame;
+  }
+
+  /**
+   * @brief Quadros substituídos antes de serem enviados.
+   */
+  uint32_t replacedFrames() const
+  {
+    return replaced;
+  }
+
+private:
+  uint8_t buffers[2][DISPLAY_FRAME_SIZE];
+  uint8_t *pending = buffers[0];  // Último quadro publicado pela displayTask
+  uint8_t *inFlight = buffers[1]; // Quadro em envio pela displayFlushTask
+  FrameInfo pendingInfo = {};
+  bool hasPending = false;
+  uint32_t replaced = 0;
+  SemaphoreHandle_t mutex = NULL;
+};
+
+#endif // DISPLAYFLUSH_H
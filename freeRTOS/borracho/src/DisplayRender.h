@@ -0,0 +1,186 @@
+/**
+ * @file DisplayRender.h
+ * @brief Desenho dos comandos de display em um framebuffer, independente do display físico.
+ * @details O desenho de cada DisplayCommand é feito por drawDisplayCommand() sobre qualquer display
+ * com a interface da Adafruit_GFX mais `clearDisplay()` e `getBuffer()`: o Adafruit_SSD1306 da
+ * displayTask ou o HeadlessDisplay (HeadlessDisplay.h), que desenha só em memória e permite gerar e
+ * comparar as telas no host, sem o OLED. O envio ao display físico fica fora daqui (DisplayFlush.h).
+ * DisplayRenderStats registra o custo de desenho por tipo de comando (impresso com o log, tecla
+ * '*' no IDLE).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef DISPLAYRENDER_H
+#define DISPLAYRENDER_H
+
+// Includes do projeto
+#include "StatechartCallback.h"
+#include <Arduino.h>
+
+#define DISPLAY_COMMAND_TYPES (CMD_PLOT_TEMPERATURE_SAMPLE + 1) // Número de DisplayCommandType
+
+/**
+ * @brief Desenha um comando de display no framebuffer com a Adafruit_GFX.
+ * @tparam Display Adafruit_SSD1306 ou HeadlessDisplay (com ou sem PageGlyphText).
+ * @param display Display de destino (só o framebuffer é alterado).
+ * @param cmd Comando de display.
+ * @details Todo comando reposiciona o cursor antes de desenhar, então o resultado depende apenas
+ * do conteúdo atual do framebuffer e do próprio comando.
+ */
+template <class Display>
+void drawDisplayCommand(Display &display, const DisplayCommand &cmd)
+{
+  if (cmd.clearScreen)
+  { // Limpa a tela apenas se o comando exigir
+    display.clearDisplay();
+  }
+  display.setCursor(0, 0); // Reinicia o cursor no topo esquerdo para a maioria dos desenhos
+
+  // Processa o tipo de comando recebido
+  switch (cmd.type)
+  {
+  case CMD_CLEAR_DISPLAY:
+    display.clearDisplay(); // Limpeza explícita
+    break;
+  case CMD_SHOW_STATE_INFO:
+    // Desenha o nome do estado no topo, sem limpar o resto da tela
+    display.fillRect(0, 0, SCREEN_WIDTH, 8, SSD1306_BLACK); // Limpa a linha superior
+    display.setCursor(0, 0);
+    display.print("Estado: ");
+    display.println(cmd.text);
+    break;
+  case CMD_SHOW_MAIN_MENU_SCREEN: // Tela IDLE: "Bem-vindo", "1-Iniciar", "2-Sair", "3-Auto-tune"
+    display.println("Bem-vindo!");
+    display.setCursor(0, 16);
+    display.println("1 - Iniciar");
+    display.println("2 - Sair");
+    display.println("3 - Auto-tune PID");
+    break;
+  case CMD_SHOW_STARTUP_MESSAGE: // Mensagem de inicialização (apenas texto)
+    display.println("Executando showStartup()");
+    break;
+  case CMD_SHOW_RECIPES_LIST: // Menu de seleção de receitas
+    display.println("Receitas:");
+    display.setCursor(0, 16);
+    display.println("1- American Pale Ale");
+    display.println("2- Witbier");
+    display.println("3- Belgian Dubbel");
+    display.println("4- Bohemian Pilsen");
+    display.println("5- Customizar");
+    break;
+  case CMD_SHOW_RECIPE_DETAILS_SCREEN:
+  { // Detalhes de uma receita específica
+    if (cmd.recipeId >= 0 && cmd.recipeId < NUM_RECIPES)
+    {
+      const Recipe &currentRecipe = recipes[cmd.recipeId];
+
+      display.println(currentRecipe.name);
+      display.print("Etapas: ");
+      display.println(currentRecipe.numSteps);
+      display.println();
+
+      int yPos = 32; // Posição Y inicial para as etapas
+      for (int i = 0; i < currentRecipe.numSteps; ++i)
+      {
+        if (yPos + 8 > SCREEN_HEIGHT - 16)
+        { // Verifica se há espaço antes de imprimir
+          // Se não houver espaço para mais etapas, podemos indicar que há mais
+          display.setCursor(0, yPos);
+          display.println("...mais etapas");
+          break; // Sai do loop para não estourar a tela
+        }
+        display.setCursor(0, yPos);
+        display.print("* ");
+        display.print(currentRecipe.steps[i].name);
+        display.print(" ");
+        display.print(currentRecipe.steps[i].temperature);
+        display.print(" C ");
+        display.print(currentRecipe.steps[i].duration);
+        display.println(" min");
+        yPos += 8; // Avança para a próxima linha
+      }
+      display.println(); // Pula uma linha
+      // Posiciona as opções de iniciar/voltar no final da tela
+      display.setCursor(0, SCREEN_HEIGHT - 16); // 2 linhas de 8 pixels cada
+      display.println("1 - Iniciar Receita");
+      display.println("2 - Voltar as Receitas");
+    }
+    else
+    {
+      display.println("ERRO: Receita invalida!");
+    }
+    break;
+  }
+  // CASE para exibir o status do processo
+  case CMD_SHOW_PROCESS_STATUS_SCREEN:
+    // Limpa só as linhas de texto; as páginas 6 e 7 são do gráfico (TemperatureGraph)
+    display.fillRect(0, 0, SCREEN_WIDTH, TEMP_GRAPH_TOP, SSD1306_BLACK);
+    display.setTextWrap(false); // Linhas longas são cortadas em vez de invadir o gráfico
+    display.println("Processo Ativo:");
+    display.setCursor(0, 16);  // Posiciona abaixo do título
+    display.println(cmd.text); // Imprime a string de status preparada
+    display.setTextWrap(true);
+    break;
+  // CASE para exibir mensagem de conclusão
+  case CMD_SHOW_FINISHED_MESSAGE_SCREEN:
+    display.println("Processo Concluido!");
+    display.setCursor(0, 16);
+    display.println("Receita finalizada.");
+    display.setCursor(0, 32);
+    display.println("Voltando ao menu principal...");
+    break;
+  case CMD_PRINT_KEYPAD_INPUT: // Imprime o texto digitado pelo teclado
+    // Localiza a posição para o texto digitado (geralmente no rodapé)
+    display.fillRect(0, SCREEN_HEIGHT - 8, SCREEN_WIDTH, 8, SSD1306_BLACK); // Limpa a última linha
+    display.setCursor(0, SCREEN_HEIGHT - 8);                                // Última linha do display
+    display.println(cmd.text);
+    break;
+  case CMD_PLOT_TEMPERATURE_SAMPLE: // Desenhado pela displayTask direto no framebuffer (TemperatureGraph)
+    break;
+  }
+}
+
+/**
+ * @brief Custo de desenho por tipo de comando de display.
+ */
+class DisplayRenderStats
+{
+public:
+  /**
+   * @brief Registra o desenho de um comando (cópia do cache ou desenho com a GFX).
+   */
+  void record(DisplayCommandType type, uint32_t elapsedMicros)
+  {
+    if ((unsigned)type >= DISPLAY_COMMAND_TYPES)
+      return;
+    count[type]++;
+    totalMicros[type] += elapsedMicros;
+    if (elapsedMicros > maxMicros[type])
+      maxMicros[type] = elapsedMicros;
+  }
+
+  /**
+   * @brief Imprime, por tipo de comando desenhado, o número de desenhos e o tempo médio e máximo.
+   */
+  void printStats(Print &out)
+  {
+    out.print("Desenho por comando (n/media/max us):");
+    for (uint8_t type = 0; type < DISPLAY_COMMAND_TYPES; ++type)
+    {
+      if (count[type] == 0)
+        continue;
+      out.printf(" %u=%lu/%lu/%lu", (unsigned)type, (unsigned long)count[type],
+                 (unsigned long)(totalMicros[type] / count[type]), (unsigned long)maxMicros[type]);
+    }
+    out.println();
+  }
+
+private:
+  uint32_t count[DISPLAY_COMMAND_TYPES] = {};       // Comandos desenhados
+  uint64_t totalMicros[DISPLAY_COMMAND_TYPES] = {}; // Tempo total de desenho
+  uint32_t maxMicros[DISPLAY_COMMAND_TYPES] = {};   // Pior tempo de desenho
+};
+
+#endif // DISPLAYRENDER_H
@@ -0,0 +1,234 @@
+/**
+ * @file FloatPid.h
+ * @brief Controlador PID em precisão simples, no lugar do PID_v1 (double).
+ * @details A FPU do ESP32 só opera em float: cada Compute() do PID_v1 em double era emulado em
+ * software. BasicPid segue o mesmo algoritmo do PID_v1 (mesmas saídas, a menos do arredondamento):
+ * - integrador acumulado como Ki * dt * erro e limitado à faixa da saída (anti-windup por saturação);
+ * - derivada sobre a medição (-Kd * dInput / dt), sem o "chute" da derivada quando o setpoint muda;
+ * - transferência sem solavanco MANUAL -> AUTOMATIC: o integrador parte da saída atual e a derivada
+ *   da entrada atual;
+ * - troca de ganhos sem solavanco em AUTOMATIC (ganhos por etapa, GainSchedule.h): o integrador
+ *   absorve a mudança do termo proporcional, o que o PID_v1 não faz.
+ * A diferença é o disparo: o PID_v1 só calcula se millis() avançou SampleTime, enquanto aqui cada
+ * compute() é um passo de dt fixo, chamado pela controlTask no período do ControlLoopScheduler.
+ * O integrador é exposto (integral()/setIntegral()) para o snapshot de retomada gravar o valor real.
+ * Cada compute() mede os ciclos de CPU gastos (impressos com o log, tecla '*' no IDLE); com
+ * `-D PID_BENCHMARK` (ver platformio.ini) o setup() compara float x double no boot.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef FLOATPID_H
+#define FLOATPID_H
+
+// Includes do projeto
+#include <Arduino.h>
+
+/**
+ * @brief Modo do controlador.
+ */
+enum PidMode
+{
+  PID_MANUAL,   // Saída definida por quem chama; compute() não altera a saída
+  PID_AUTOMATIC // compute() calcula a saída
+};
+
+/**
+ * @brief PID de ação direta com dt fixo, ligado às variáveis de entrada, saída e setpoint.
+ * @tparam T float (controlTask) ou double (só para a comparação do PID_BENCHMARK).
+ */
+template <typename T>
+class BasicPid
+{
+public:
+  BasicPid(T *input, T *output, T *setpoint, T kp, T ki, T kd, uint32_t sampleTimeMs)
+      : input(input), output(output), setpoint(setpoint), sampleTimeMs(sampleTimeMs)
+  {
+    setTunings(kp, ki, kd);
+  }
+
+  /**
+   * @brief Calcula um passo do PID e escreve a saída.
+   * @return false em MANUAL (a saída não é alterada).
+   */
+  bool compute()
+  {
+    if (mode != PID_AUTOMATIC)
+    {
+      return false;
+    }
+    uint32_t startCycles = ESP.getCycleCount();
+
+    T in = *input;
+    T error = *setpoint - in;
+    T dInput = in - lastInput;
+    outputSum = clamp(outputSum + ki * error);
+    *output = clamp(kp * error + outputSum - kd * dInput);
+    lastInput = in;
+
+    recordCycles(ESP.getCycleCount() - startCycles);
+    return true;
+  }
+
+  /**
+   * @brief Troca o modo; na passagem para AUTOMATIC o integrador parte da saída atual (sem solavanco).
+   */
+  void setMode(PidMode newMode)
+  {
+    if (newMode == PID_AUTOMATIC && mode != PID_AUTOMATIC)
+    {
+      outputSum = clamp(*output);
+      lastInput = *input;
+    }
+    mode = newMode;
+  }
+
+  PidMode getMode() const
+  {
+    return mode;
+  }
+
+  /**
+   * @brief Define os ganhos (Ki em 1/s e Kd em s, convertidos para o dt fixo).
+   * @details Em AUTOMATIC a saída do próximo passo continua a mesma para o mesmo erro.
+   */
+  void setTunings(T newKp, T newKi, T newKd)
+  {
+    if (newKp < 0 || newKi < 0 || newKd < 0)
+    {
+      return;
+    }
+    if (mode == PID_AUTOMATIC)
+    {
+      outputSum = clamp(outputSum + (kp - newKp) * (*setpoint - lastInput));
+    }
+    dispKp = newKp;
+    dispKi = newKi;
+    dispKd = newKd;
+    T sampleTimeSec = (T)sampleTimeMs / 1000;
+    kp = newKp;
+    ki = newKi * sampleTimeSec;
+    kd = newKd / sampleTimeSec;
+  }
+
+  /**
+   * @brief Define a faixa da saída; a saída e o integrador atuais são limitados a ela.
+   */
+  void setOutputLimits(T min, T max)
+  {
+    if (min >= max)
+    {
+      return;
+    }
+    outMin = min;
+    outMax = max;
+    if (mode == PID_AUTOMATIC)
+    {
+      *output = clamp(*output);
+      outputSum = clamp(outputSum);
+    }
+  }
+
+  T getKp() const { return dispKp; }
+  T getKi() const { return dispKi; }
+  T getKd() const { return dispKd; }
+
+  /**
+   * @brief Integrador atual (mesma unidade da saída).
+   */
+  T integral() const
+  {
+    return outputSum;
+  }
+
+  /**
+   * @brief Substitui o integrador (retomada do snapshot); vale a partir do próximo compute().
+   */
+  void setIntegral(T value)
+  {
+    outputSum = clamp(value);
+  }
+
+  /**
+   * @brief Ciclos de CPU médios por compute() (0 antes do primeiro).
+   */
+  uint32_t averageCycles() const
+  {
+    return computes ? (uint32_t)(totalCycles / computes) : 0;
+  }
+
+  /**
+   * @brief Imprime o número de cálculos e os ciclos de CPU por cálculo (médio e máximo).
+   */
+  void printStats(Print &out)
+  {
+    out.printf("PID: %lu calculos, %lu ciclos medios (max %lu) por calculo, integrador=%.1f\n",
+               (unsigned long)computes, (unsigned long)averageCycles(), (unsigned long)maxCycles, (double)outputSum);
+  }
+
+private:
+  T clamp(T value) const
+  {
+    return value > outMax ? outMax : (value < outMin ? outMin : value);
+  }
+
+  void recordCycles(uint32_t cycles)
+  {
+    computes++;
+    totalCycles += cycles;
+    if (cycles > maxCycles)
+      maxCycles = cycles;
+  }
+
+  T *input;
+  T *output;
+  T *setpoint;
+  const uint32_t sampleTimeMs; // dt do passo (período de quem chama compute())
+
+  T dispKp = 0, dispKi = 0, dispKd = 0; // Ganhos como informados (Ki em 1/s, Kd em s)
+  T kp = 0, ki = 0, kd = 0;             // Ganhos por passo (Ki * dt, Kd / dt)
+  T outMin = 0, outMax = 255;           // Mesma faixa padrão do PID_v1
+  T outputSum = 0;                      // Integrador
+  T lastInput = 0;                      // Entrada do passo anterior (derivada sobre a medição)
+  PidMode mode = PID_MANUAL;
+
+  uint32_t computes = 0;    // Cálculos feitos em AUTOMATIC
+  uint64_t totalCycles = 0; // Soma dos ciclos de CPU por cálculo
+  uint32_t maxCycles = 0;   // Pior cálculo
+};
+
+typedef BasicPid<float> FloatPid;
+
+// Ciclos médios por cálculo com uma planta de primeira ordem simulada (aquecimento proporcional à
+// saída, perda proporcional à diferença para o ambiente): as contas passam por valores realistas
+// e pela saturação
+template <typename T>
+uint32_t benchmarkPidCycles(uint32_t steps)
+{
+  T setpoint = 65, input = 25, output = 0;
+  BasicPid<T> pid(&input, &output, &setpoint, (T)30, (T)5.0, (T)0.5, 100);
+  pid.setOutputLimits(0, 1023);
+  pid.setMode(PID_AUTOMATIC);
+  for (uint32_t i = 0; i < steps; ++i)
+  {
+    pid.compute();
+    input += (output * (T)0.0004 - (input - 25) * (T)0.002);
+  }
+  return pid.averageCycles();
+}
+
+/**
+ * @brief Mede os ciclos de CPU por cálculo do PID em float e em double com a mesma planta simulada.
+ * @param out Destino do resultado.
+ * @param steps Cálculos por tipo.
+ */
+inline void benchmarkPid(Print &out, uint32_t steps)
+{
+  uint32_t floatCycles = benchmarkPidCycles<float>(steps);
+  uint32_t doubleCycles = benchmarkPidCycles<double>(steps);
+  out.printf("PID: %lu calculos por tipo, float=%lu ciclos, double=%lu ciclos por calculo\n",
+             (unsigned long)steps, (unsigned long)floatCycles, (unsigned long)doubleCycles);
+}
+
+#endif // FLOATPID_H
@@ -0,0 +1,160 @@
+/**
+ * @file FramePacer.h
+ * @brief Cadência de quadros da displayTask e latência tecla -> tela.
+ * @details Limita a taxa de quadros do display (DISPLAY_MAX_FPS): enquanto o intervalo mínimo desde
+ * o último quadro não passou, a displayTask continua acumulando comandos da fila, que são
+ * coalescidos e enviados em um único quadro em vez de vários envios seguidos. Cada quadro tem um
+ * prazo (DISPLAY_FRAME_DEADLINE_US) contado do recebimento do seu primeiro comando até o fim do
+ * envio ao display (na displayFlushTask); os quadros fora do prazo são contados.
+ * Os comandos gerados pelo tratamento de uma tecla levam o instante em que a tecla foi lida
+ * (DisplayCommand::inputMicros); quando o primeiro quadro com esses comandos termina de ser
+ * enviado, a latência tecla -> tela entra em um histograma comparado ao requisito de 500 ms
+ * (RNF10). Impressos junto com o log (tecla '*' no IDLE).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+// Includes do projeto
+#include <Arduino.h>
+
+// FreeRTOS Headers
+#include "freertos/FreeRTOS.h"
+
+// --- PARÂMETROS DA CADÊNCIA ---
+#ifndef DISPLAY_MAX_FPS
+#define DISPLAY_MAX_FPS 20 // Taxa máxima de quadros (intervalo mínimo de 50 ms)
+#endif
+#ifndef DISPLAY_FRAME_DEADLINE_US
+#define DISPLAY_FRAME_DEADLINE_US 100000UL // Prazo do quadro: primeiro comando recebido -> envio concluído
+#endif
+#define DISPLAY_LATENCY_LIMIT_US 500000UL // RNF10: resposta à tecla em até 500 ms
+
+/**
+ * @brief Controle da taxa de quadros e estatísticas de prazo e latência do display.
+ * @details A cadência (ticksUntilNextFrame/frameStarted) é usada só pela displayTask; as
+ * estatísticas (recordFrame/recordInput) só pela displayFlushTask, ao fim de cada envio.
+ */
+class FramePacer
+{
+public:
+  static const uint8_t LATENCY_BUCKETS = 7;
+
+  /**
+   * @brief Ticks a esperar até o próximo quadro poder começar (0 se já pode).
+   */
+  TickType_t ticksUntilNextFrame() const
+  {
+    const uint32_t interval = 1000000UL / DISPLAY_MAX_FPS;
+    uint32_t elapsed = micros() - lastFrameMicros;
+    if (!started || elapsed >= interval)
+    {
+      return 0;
+    }
+    uint32_t remainingMs = (interval - elapsed + 999) / 1000;
+    return (remainingMs + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+  }
+
+  /**
+   * @brief Marca o início do desenho de um quadro (referência do intervalo mínimo).
+   */
+  void frameStarted(uint32_t renderStartMicros)
+  {
+    lastFrameMicros = renderStartMicros;
+    started = true;
+  }
+
+  /**
+   * @brief Registra um quadro enviado.
+   * @param firstCommandMicros Instante em que o primeiro comando do quadro foi recebido.
+   * @param renderStartMicros Início do desenho (após a espera pelo intervalo mínimo).
+   * @param doneMicros Fim do envio ao display.
+   * @details O "trabalho" inclui o desenho, a espera na caixa de quadros e o envio I2C.
+   */
+  void recordFrame(uint32_t firstCommandMicros, uint32_t renderStartMicros, uint32_t doneMicros)
+  {
+    uint32_t frameMicros = doneMicros - firstCommandMicros;
+    uint32_t workMicros = doneMicros - renderStartMicros;
+    frames++;
+    totalWorkMicros += workMicros;
+    if (workMicros > maxWorkMicros)
+      maxWorkMicros = workMicros;
+    if (frameMicros > maxFrameMicros)
+      maxFrameMicros = frameMicros;
+    if (frameMicros > DISPLAY_FRAME_DEADLINE_US)
+      deadlineMisses++;
+  }
+
+  /**
+   * @brief Registra a latência de uma tecla cujo primeiro quadro de resposta acabou de ser enviado.
+   * @param inputMicros Instante em que a tecla foi lida (DisplayCommand::inputMicros, != 0).
+   * @param doneMicros Fim do envio do quadro.
+   * @details Uma tecla pode gerar vários comandos em quadros diferentes; só o primeiro conta.
+   */
+  void recordInput(uint32_t inputMicros, uint32_t doneMicros)
+  {
+    if (inputs > 0 && (int32_t)(inputMicros - lastInputMicros) <= 0)
+    {
+      return; // Tecla já registrada em um quadro anterior
+    }
+    lastInputMicros = inputMicros;
+    uint32_t latency = doneMicros - inputMicros;
+    inputs++;
+    uint8_t bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && latency >= bucketLimitMs(bucket) * 1000UL)
+      bucket++;
+    latencyHistogram[bucket]++;
+    if (latency > maxLatencyMicros)
+      maxLatencyMicros = latency;
+    if (latency > DISPLAY_LATENCY_LIMIT_US)
+      overLimit++;
+  }
+
+  /**
+   * @brief Imprime cadência, prazos e o histograma de latência tecla -> tela na Serial.
+   */
+  void printStats(Print &out)
+  {
+    out.printf("Quadros: %lu (max %u fps), trabalho medio=%lu us (max %lu us), pior quadro=%lu us, fora do prazo de %lu us=%lu\n",
+               (unsigned long)frames, (unsigned)DISPLAY_MAX_FPS,
+               (unsigned long)(frames ? totalWorkMicros / frames : 0), (unsigned long)maxWorkMicros,
+               (unsigned long)maxFrameMicros, (unsigned long)DISPLAY_FRAME_DEADLINE_US, (unsigned long)deadlineMisses);
+    out.printf("Tecla->tela: %lu teclas, max=%lu us, acima de 500 ms=%lu |", (unsigned long)inputs,
+               (unsigned long)maxLatencyMicros, (unsigned long)overLimit);
+    for (uint8_t b = 0; b < LATENCY_BUCKETS; ++b)
+    {
+      if (b < LATENCY_BUCKETS - 1)
+        out.printf(" <%ums=%lu", (unsigned)bucketLimitMs(b), (unsigned long)latencyHistogram[b]);
+      else
+        out.printf(" >=%ums=%lu", (unsigned)bucketLimitMs(b - 1), (unsigned long)latencyHistogram[b]);
+    }
+    out.println();
+  }
+
+private:
+  // Limites superiores (ms) dos baldes do histograma; o último balde é ">= 500 ms"
+  static uint16_t bucketLimitMs(uint8_t bucket)
+  {
+    static const uint16_t limits[LATENCY_BUCKETS - 1] = {10, 20, 50, 100, 200, 500};
+    return limits[bucket];
+  }
+
+  uint32_t lastFrameMicros = 0; // Início do último quadro (cadência, displayTask)
+  bool started = false;         // Algum quadro já começou (displayTask)
+  uint32_t frames = 0;          // Quadros enviados
+  uint64_t totalWorkMicros = 0; // Tempo de desenho + envio
+  uint32_t maxWorkMicros = 0;   // Pior tempo de desenho + envio
+  uint32_t maxFrameMicros = 0;  // Pior tempo do primeiro comando ao fim do envio
+  uint32_t deadlineMisses = 0;  // Quadros acima de DISPLAY_FRAME_DEADLINE_US
+
+  uint32_t lastInputMicros = 0;                     // Última tecla registrada
+  uint32_t inputs = 0;                              // Teclas com resposta na tela
+  uint32_t latencyHistogram[LATENCY_BUCKETS] = {};  // Teclas por faixa de latência
+  uint32_t maxLatencyMicros = 0;                    // Pior latência tecla -> tela
+  uint32_t overLimit = 0;                           // Teclas acima de 500 ms (RNF10)
+};
+
+#endif // FRAMEPACER_H
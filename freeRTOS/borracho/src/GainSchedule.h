@@ -0,0 +1,185 @@
+/**
+ * @file GainSchedule.h
+ * @brief Ganhos do PID por faixa de setpoint, com override opcional por etapa da receita.
+ * @details Um único conjunto de ganhos cobria do descanso proteico (45–52 °C) ao mash-out (76 °C),
+ * e o log mostra comportamentos bem diferentes entre as etapas (sobressinal de 9,5 °C a 67 °C,
+ * acomodação de 123 s a 76 °C). A tabela GAIN_SCHEDULE guarda, por setpoint, fatores sobre os
+ * ganhos base (os de fábrica ou os do último auto-tune, identificados em AUTOTUNE_SETPOINT, onde o
+ * fator é 1). Entre duas linhas os fatores são interpolados linearmente pelo setpoint; fora da
+ * tabela vale a linha mais próxima. Uma RecipeStep pode trazer ganhos absolutos (`gains`), que
+ * substituem a tabela naquela etapa.
+ * A controlTask consulta o GainSchedule no CMD_START_RECIPE_STEP, já com o novo setpoint, e não
+ * troca os ganhos de uma vez: o GainRamp leva os ganhos em uso aos da etapa em GAIN_RAMP_MS,
+ * com um setTunings() por período. Cada passo é pequeno e sem solavanco no termo proporcional
+ * (o FloatPid compensa no integrador); o da derivada e a inclinação do integral mudam aos poucos.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef GAINSCHEDULE_H
+#define GAINSCHEDULE_H
+
+// Includes do projeto
+#include <Arduino.h>
+
+/**
+ * @brief Ganhos do PID (Ki em 1/s, Kd em s, como no FloatPid::setTunings).
+ */
+struct PidTunings
+{
+  float kp;
+  float ki;
+  float kd;
+};
+
+/**
+ * @brief Linha da tabela: fatores sobre os ganhos base em um setpoint.
+ */
+struct GainBand
+{
+  int16_t setpoint; // °C (linhas em ordem crescente)
+  float kpScale;
+  float kiScale;
+  float kdScale;
+};
+
+#define GAIN_RAMP_MS 30000UL // Janela da troca de ganhos no início de uma etapa (cerca de Pu / 3)
+
+// Pontos de partida: menos integral no descanso proteico (pouca perda térmica, o integrador
+// acumula durante a rampa) e mais ganho no mash-out (perda maior, acomodação lenta)
+const GainBand GAIN_SCHEDULE[] = {
+    {45, 1.0f, 0.5f, 1.0f}, // Descanso proteico
+    {65, 1.0f, 1.0f, 1.0f}, // Mostura: referência (AUTOTUNE_SETPOINT)
+    {76, 1.2f, 1.5f, 1.0f}, // Mash-out
+};
+const uint8_t GAIN_SCHEDULE_BANDS = sizeof(GAIN_SCHEDULE) / sizeof(GAIN_SCHEDULE[0]);
+
+/**
+ * @brief Ganhos base e consulta da tabela (usado só pela controlTask, exceto setBase() no setup()).
+ */
+class GainSchedule
+{
+public:
+  /**
+   * @brief Define os ganhos base (fator 1 da tabela).
+   */
+  void setBase(const PidTunings &tunings)
+  {
+    baseTunings = tunings;
+  }
+
+  const PidTunings &base() const
+  {
+    return baseTunings;
+  }
+
+  /**
+   * @brief Ganhos de uma etapa.
+   * @param setpoint Setpoint da etapa (°C).
+   * @param stepGains Ganhos da RecipeStep (nullptr: usa a tabela).
+   */
+  PidTunings tuningsFor(float setpoint, const PidTunings *stepGains)
+  {
+    if (stepGains != nullptr)
+    {
+      overrides++;
+      return last = *stepGains;
+    }
+    scheduled++;
+    float kpScale, kiScale, kdScale;
+    interpolate(setpoint, kpScale, kiScale, kdScale);
+    last.kp = baseTunings.kp * kpScale;
+    last.ki = baseTunings.ki * kiScale;
+    last.kd = baseTunings.kd * kdScale;
+    return last;
+  }
+
+  /**
+   * @brief Imprime os ganhos base, os últimos aplicados e de onde vieram.
+   */
+  void printStats(Print &out)
+  {
+    out.printf("Ganhos: base Kp=%.2f Ki=%.3f Kd=%.2f, ultimos Kp=%.2f Ki=%.3f Kd=%.2f, %lu pela tabela, %lu da etapa\n",
+               (double)baseTunings.kp, (double)baseTunings.ki, (double)baseTunings.kd,
+               (double)last.kp, (double)last.ki, (double)last.kd,
+               (unsigned long)scheduled, (unsigned long)overrides);
+  }
+
+private:
+  static void interpolate(float setpoint, float &kpScale, float &kiScale, float &kdScale)
+  {
+    uint8_t upper = 0;
+    while (upper < GAIN_SCHEDULE_BANDS && GAIN_SCHEDULE[upper].setpoint < setpoint)
+      upper++;
+    if (upper == 0 || upper == GAIN_SCHEDULE_BANDS)
+    {
+      const GainBand &edge = GAIN_SCHEDULE[upper == 0 ? 0 : GAIN_SCHEDULE_BANDS - 1];
+      kpScale = edge.kpScale;
+      kiScale = edge.kiScale;
+      kdScale = edge.kdScale;
+      return;
+    }
+    const GainBand &lo = GAIN_SCHEDULE[upper - 1];
+    const GainBand &hi = GAIN_SCHEDULE[upper];
+    float t = (setpoint - lo.setpoint) / (float)(hi.setpoint - lo.setpoint);
+    kpScale = lo.kpScale + t * (hi.kpScale - lo.kpScale);
+    kiScale = lo.kiScale + t * (hi.kiScale - lo.kiScale);
+    kdScale = lo.kdScale + t * (hi.kdScale - lo.kdScale);
+  }
+
+  PidTunings baseTunings = {};
+  PidTunings last = {};   // Últimos ganhos entregues
+  uint32_t scheduled = 0; // Etapas com ganhos da tabela
+  uint32_t overrides = 0; // Etapas com ganhos próprios
+};
+
+/**
+ * @brief Transição linear entre dois conjuntos de ganhos em GAIN_RAMP_MS (usado só pela controlTask).
+ */
+class GainRamp
+{
+public:
+  /**
+   * @brief Começa a transição.
+   * @param from Ganhos em uso no FloatPid.
+   * @param to Ganhos da etapa, entregues no fim da janela.
+   */
+  void start(const PidTunings &from, const PidTunings &to, uint32_t nowMillis)
+  {
+    origin = from;
+    target = to;
+    startMillis = nowMillis;
+    ramping = true;
+  }
+
+  bool active() const
+  {
+    return ramping;
+  }
+
+  /**
+   * @brief Ganhos no instante; no fim da janela devolve os da etapa e encerra a transição.
+   */
+  PidTunings at(uint32_t nowMillis)
+  {
+    uint32_t elapsed = nowMillis - startMillis;
+    if (elapsed >= GAIN_RAMP_MS)
+    {
+      ramping = false;
+      return target;
+    }
+    float t = elapsed / (float)GAIN_RAMP_MS;
+    return {origin.kp + t * (target.kp - origin.kp),
+            origin.ki + t * (target.ki - origin.ki),
+            origin.kd + t * (target.kd - origin.kd)};
+  }
+
+private:
+  PidTunings origin = {};
+  PidTunings target = {};
+  uint32_t startMillis = 0;
+  bool ramping = false;
+};
+
+#endif // GAINSCHEDULE_H
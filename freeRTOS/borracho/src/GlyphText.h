@@ -0,0 +1,166 @@
+/**
+ * @file GlyphText.h
+ * @brief Texto rápido alinhado às páginas do SSD1306, no lugar do drawChar pixel a pixel da GFX.
+ * @details Cada `display.print` passa pelo `Adafruit_GFX::write`, que desenha cada caractere com o
+ * `drawChar` genérico: 35 chamadas a `drawPixel` por glifo 5x7. Na fonte clássica da GFX (glcdfont)
+ * cada coluna de um glifo é um byte com o bit 0 na linha de cima, o mesmo formato de uma página do
+ * SSD1306. Quando o cursor está em uma linha múltipla de 8 (todas as telas do projeto), PageGlyphText
+ * grava o glifo com 5 operações OR direto no framebuffer; o resultado é idêntico ao do drawChar com
+ * texto branco transparente. Tamanho de texto diferente de 1, outra cor, fonte customizada, rotação
+ * ou cursor fora do alinhamento usam o caminho da GFX.
+ * Com `-D GLYPH_BENCHMARK` (ver platformio.ini) o setup() mede a vazão dos dois caminhos no boot;
+ * a mesma medição (measureText(), em ciclos de CPU) roda no host com um HeadlessDisplay no
+ * test_glyph_text.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef GLYPHTEXT_H
+#define GLYPHTEXT_H
+
+// Includes do projeto
+#include <Arduino.h>
+
+// DisplayOLED
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <glcdfont.c> // Fonte 5x7 da Adafruit_GFX (a mesma usada pelo drawChar)
+
+#define GLYPH_WIDTH 6  // 5 colunas do glifo + 1 de espaçamento
+#define GLYPH_HEIGHT 8 // Uma página
+
+/**
+ * @brief Resultado de PageGlyphText::measureText().
+ */
+struct GlyphBenchmark
+{
+  uint32_t glyphs;        // Glifos desenhados por caminho
+  uint32_t alignedCycles; // Ciclos de CPU do caminho por bytes
+  uint32_t gfxCycles;     // Ciclos de CPU do drawChar da GFX
+};
+
+/**
+ * @brief Display com escrita de texto por bytes inteiros nas linhas alinhadas às páginas.
+ * @tparam Base Adafruit_SSD1306 ou HeadlessDisplay (framebuffer no formato do SSD1306 em getBuffer()).
+ */
+template <class Base>
+class PageGlyphText : public Base
+{
+public:
+  using Base::Base;
+
+  size_t write(uint8_t c) override
+  {
+    if (c == '\n' || c == '\r')
+    {
+      return Base::write(c); // Só move o cursor
+    }
+    if (!fastPathUsable())
+    {
+      fallbackGlyphs++;
+      return Base::write(c);
+    }
+    writeGlyph(c);
+    fastGlyphs++;
+    return 1;
+  }
+
+  /**
+   * @brief Imprime quantos caracteres foram escritos por bytes e quantos pela GFX.
+   */
+  void printTextStats(Print &out)
+  {
+    out.printf("Texto: %lu glifos alinhados, %lu pela GFX\n", (unsigned long)fastGlyphs, (unsigned long)fallbackGlyphs);
+  }
+
+  /**
+   * @brief Mede os dois caminhos desenhando telas cheias (8 linhas de 21 caracteres).
+   * @param rounds Telas desenhadas por caminho.
+   * @details Conta ciclos de CPU (ESP.getCycleCount()), que também andam no host, onde o micros()
+   * é um relógio virtual. Sobrescreve o framebuffer; o chamador o limpa depois.
+   */
+  GlyphBenchmark measureText(uint16_t rounds)
+  {
+    const uint8_t columns = this->_width / GLYPH_WIDTH;
+    const uint8_t rows = this->_height / GLYPH_HEIGHT;
+    uint32_t elapsed[2];
+    for (uint8_t pass = 0; pass < 2; ++pass)
+    {
+      uint32_t startCycles = ESP.getCycleCount();
+      for (uint16_t r = 0; r < rounds; ++r)
+      {
+        for (uint8_t row = 0; row < rows; ++row)
+        {
+          this->setCursor(0, row * GLYPH_HEIGHT);
+          for (uint8_t col = 0; col < columns; ++col)
+          {
+            uint8_t c = 'A' + (r + row + col) % 26;
+            if (pass == 0)
+              writeGlyph(c);
+            else
+              Base::write(c);
+          }
+        }
+      }
+      elapsed[pass] = ESP.getCycleCount() - startCycles;
+    }
+    return {(uint32_t)rounds * rows * columns, elapsed[0], elapsed[1]};
+  }
+
+  /**
+   * @brief Imprime a medição de measureText() em ciclos por glifo.
+   * @param out Destino do resultado.
+   * @param rounds Telas desenhadas por caminho.
+   */
+  void benchmarkText(Print &out, uint16_t rounds)
+  {
+    GlyphBenchmark result = measureText(rounds);
+    out.printf("Texto: %lu glifos por caminho, alinhado %lu ciclos/glifo, GFX %lu ciclos/glifo\n",
+               (unsigned long)result.glyphs,
+               (unsigned long)(result.alignedCycles / result.glyphs), (unsigned long)(result.gfxCycles / result.glyphs));
+  }
+
+private:
+  // Texto branco transparente, tamanho 1, fonte clássica, sem rotação, cursor no topo de uma página
+  bool fastPathUsable() const
+  {
+    return this->textsize_x == 1 && this->textsize_y == 1 && this->gfxFont == nullptr && this->rotation == 0 &&
+           this->textcolor == SSD1306_WHITE && this->textbgcolor == SSD1306_WHITE &&
+           this->cursor_y >= 0 && (this->cursor_y % GLYPH_HEIGHT) == 0;
+  }
+
+  // Mesmo avanço e quebra de linha do Adafruit_GFX::write, com o glifo gravado por colunas
+  void writeGlyph(uint8_t c)
+  {
+    if (this->wrap && this->cursor_x + GLYPH_WIDTH > this->_width)
+    {
+      this->cursor_x = 0;
+      this->cursor_y += GLYPH_HEIGHT;
+    }
+    int16_t x = this->cursor_x;
+    this->cursor_x += GLYPH_WIDTH;
+    if (x >= this->_width || x + GLYPH_WIDTH - 1 < 0 || this->cursor_y >= this->_height)
+    {
+      return; // Fora da tela (o drawChar também não desenha)
+    }
+    if (!this->_cp437 && c >= 176)
+    {
+      c++; // Mesmo desvio da tabela antiga feito pelo drawChar
+    }
+    uint8_t *page = this->getBuffer() + (this->cursor_y / GLYPH_HEIGHT) * this->_width;
+    for (int8_t i = 0; i < GLYPH_WIDTH - 1; ++i)
+    {
+      int16_t column = x + i;
+      if (column >= 0 && column < this->_width)
+      {
+        page[column] |= pgm_read_byte(&font[c * 5 + i]);
+      }
+    }
+  }
+
+  uint32_t fastGlyphs = 0;     // Caracteres gravados por bytes
+  uint32_t fallbackGlyphs = 0; // Caracteres desenhados pelo drawChar da GFX
+};
+
+#endif // GLYPHTEXT_H
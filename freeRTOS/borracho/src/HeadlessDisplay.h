@@ -0,0 +1,127 @@
+/**
+ * @file HeadlessDisplay.h
+ * @brief Display 128x64 só em memória, para desenhar as telas sem o OLED.
+ * @details Implementa a parte da interface do Adafruit_SSD1306 usada por drawDisplayCommand()
+ * (DisplayRender.h): desenha com a Adafruit_GFX em um framebuffer com o mesmo formato do SSD1306
+ * (uma página de 8 linhas por byte, bit 0 = linha de cima), sem I2C. Assim as telas de cada
+ * DisplayCommandType podem ser geradas no host, salvas como imagem PBM e comparadas byte a byte
+ * com o framebuffer da displayTask ou com uma imagem de referência.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HEADLESSDISPLAY_H
+#define HEADLESSDISPLAY_H
+
+// Includes do projeto
+#include <Arduino.h>
+
+// DisplayOLED
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+
+#define HEADLESS_WIDTH 128
+#define HEADLESS_HEIGHT 64
+#define HEADLESS_FRAME_SIZE (HEADLESS_WIDTH * HEADLESS_HEIGHT / 8)
+
+/**
+ * @brief Display monocromático em memória com o framebuffer no formato do SSD1306.
+ */
+class HeadlessDisplay : public Adafruit_GFX
+{
+public:
+  HeadlessDisplay() : Adafruit_GFX(HEADLESS_WIDTH, HEADLESS_HEIGHT)
+  {
+    clearDisplay();
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override
+  {
+    if (x < 0 || x >= HEADLESS_WIDTH || y < 0 || y >= HEADLESS_HEIGHT)
+      return;
+    uint8_t &cell = buffer[x + (y / 8) * HEADLESS_WIDTH];
+    uint8_t bit = 1 << (y & 7);
+    switch (color)
+    {
+    case SSD1306_WHITE:
+      cell |= bit;
+      break;
+    case SSD1306_BLACK:
+      cell &= ~bit;
+      break;
+    case SSD1306_INVERSE:
+      cell ^= bit;
+      break;
+    }
+  }
+
+  /**
+   * @brief Apaga o framebuffer (mesmo efeito de Adafruit_SSD1306::clearDisplay).
+   */
+  void clearDisplay()
+  {
+    memset(buffer, 0, sizeof(buffer));
+  }
+
+  uint8_t *getBuffer()
+  {
+    return buffer;
+  }
+
+  /**
+   * @brief Número de pixels diferentes entre o framebuffer e outro quadro no mesmo formato.
+   */
+  uint32_t diffPixels(const uint8_t *other) const
+  {
+    uint32_t pixels = 0;
+    for (uint16_t i = 0; i < HEADLESS_FRAME_SIZE; ++i)
+    {
+      for (uint8_t diff = buffer[i] ^ other[i]; diff != 0; diff &= diff - 1)
+        pixels++;
+    }
+    return pixels;
+  }
+
+  /**
+   * @brief Grava o framebuffer como imagem PBM binária (P4).
+   */
+  size_t writePbm(Print &out) const
+  {
+    return writePbm(out, buffer);
+  }
+
+  /**
+   * @brief Grava um quadro no formato do SSD1306 como imagem PBM binária (P4).
+   * @param out Destino (arquivo no host, ou a Serial).
+   * @param frame Framebuffer de HEADLESS_FRAME_SIZE bytes.
+   * @return Bytes gravados.
+   * @details Pixel aceso = 1 (preto na imagem), linha a linha, 8 pixels por byte (mais
+   * significativo à esquerda).
+   */
+  static size_t writePbm(Print &out, const uint8_t *frame)
+  {
+    size_t written = out.print("P4\n" "128 64\n");
+    for (uint8_t y = 0; y < HEADLESS_HEIGHT; ++y)
+    {
+      const uint8_t *page = frame + (y / 8) * HEADLESS_WIDTH;
+      uint8_t bit = 1 << (y & 7);
+      for (uint8_t x = 0; x < HEADLESS_WIDTH; x += 8)
+      {
+        uint8_t packed = 0;
+        for (uint8_t i = 0; i < 8; ++i)
+        {
+          if (page[x + i] & bit)
+            packed |= 0x80 >> i;
+        }
+        written += out.write(packed);
+      }
+    }
+    return written;
+  }
+
+private:
+  uint8_t buffer[HEADLESS_FRAME_SIZE];
+};
+
+#endif // HEADLESSDISPLAY_H
@@ -0,0 +1,216 @@
+/**
+ * @file HeapCounter.h
+ * @brief Contador de alocações de heap por tarefa e por trecho de código.
+ * @details Opcional: só é compilado com `-D HEAP_ALLOC_COUNTER` junto com as opções de linker
+ * `-Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc` (ver platformio.ini). O linker desvia
+ * todas as chamadas a malloc/calloc/realloc (inclusive as da `String` do core Arduino) para as
+ * funções `__wrap_*` abaixo, que contam a chamada e repassam para a implementação original.
+ * As tarefas acompanhadas se registram com `HEAP_ALLOC_TRACK_TASK()`; trechos de código marcados
+ * com `HEAP_ALLOC_SCOPE(escopo)` acumulam quantas alocações a tarefa fez dentro deles (ex: montagem
+ * dos comandos de display). A controlTask imprime as alocações de uma receita completa ao final
+ * do processo. Sem a flag, as macros viram `((void)0)`.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HEAPCOUNTER_H
+#define HEAPCOUNTER_H
+
+#ifdef HEAP_ALLOC_COUNTER
+
+// Includes do projeto
+#include <Arduino.h>
+
+// FreeRTOS Headers
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/**
+ * @brief Trechos de código medidos com HEAP_ALLOC_SCOPE.
+ */
+enum HeapAllocScopeId : uint8_t
+{
+  HEAP_SCOPE_DISPLAY_COMMAND, ///< Montagem e envio de um DisplayCommand (callbacks)
+  HEAP_SCOPE_DISPLAY_RENDER,  ///< Desenho de um lote de comandos na displayTask
+  HEAP_SCOPE_COUNT
+};
+
+/**
+ * @brief Contadores de alocação (total, por tarefa acompanhada e por escopo).
+ */
+class HeapAllocCounter
+{
+public:
+  static const uint8_t MAX_TASKS = 4; // Tarefas acompanhadas individualmente
+
+  /**
+   * @brief Passa a contar as alocações da tarefa que chama (no início da tarefa).
+   */
+  void trackCurrentTask()
+  {
+    TaskHandle_t handle = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < MAX_TASKS; ++i)
+    {
+      TaskHandle_t empty = NULL;
+      // Tarefas iniciam em paralelo nos dois núcleos: reserva a entrada de forma atômica
+      if (__atomic_compare_exchange_n(&tasks[i], &empty, handle, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      {
+        taskNames[i] = pcTaskGetName(handle);
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Registra uma alocação (chamada pelos __wrap_*, de qualquer tarefa).
+   */
+  void count()
+  {
+    __atomic_fetch_add(&total, 1, __ATOMIC_RELAXED);
+    int8_t slot = currentSlot();
+    if (slot >= 0)
+    {
+      perTask[slot]++; // Só a própria tarefa escreve no seu contador
+    }
+  }
+
+  /**
+   * @brief Alocações feitas até agora pela tarefa que chama (0 se ela não é acompanhada).
+   */
+  uint32_t currentTaskCount()
+  {
+    int8_t slot = currentSlot();
+    return slot >= 0 ? perTask[slot] : 0;
+  }
+
+  /**
+   * @brief Acumula as alocações de uma execução de um escopo.
+   */
+  void recordScope(HeapAllocScopeId scope, uint32_t allocations)
+  {
+    scopeRuns[scope]++;
+    scopeAllocations[scope] += allocations;
+  }
+
+  /**
+   * @brief Inicia a janela de medição de uma receita (início da primeira etapa).
+   */
+  void beginWindow()
+  {
+    windowTotal = total;
+    for (uint8_t s = 0; s < HEAP_SCOPE_COUNT; ++s)
+    {
+      windowScopeRuns[s] = scopeRuns[s];
+      windowScopeAllocations[s] = scopeAllocations[s];
+    }
+  }
+
+  /**
+   * @brief Imprime as alocações desde beginWindow() (fim da receita).
+   */
+  void printWindow(Print &out)
+  {
+    out.printf("Heap: receita com %lu alocacoes no sistema; comandos de display: %lu alocacoes em %lu comandos; desenho: %lu alocacoes em %lu quadros\n",
+               (unsigned long)(total - windowTotal),
+               (unsigned long)(scopeAllocations[HEAP_SCOPE_DISPLAY_COMMAND] - windowScopeAllocations[HEAP_SCOPE_DISPLAY_COMMAND]),
+               (unsigned long)(scopeRuns[HEAP_SCOPE_DISPLAY_COMMAND] - windowScopeRuns[HEAP_SCOPE_DISPLAY_COMMAND]),
+               (unsigned long)(scopeAllocations[HEAP_SCOPE_DISPLAY_RENDER] - windowScopeAllocations[HEAP_SCOPE_DISPLAY_RENDER]),
+               (unsigned long)(scopeRuns[HEAP_SCOPE_DISPLAY_RENDER] - windowScopeRuns[HEAP_SCOPE_DISPLAY_RENDER]));
+  }
+
+  /**
+   * @brief Imprime os contadores acumulados desde o boot.
+   */
+  void printStats(Print &out)
+  {
+    out.printf("Heap: %lu alocacoes desde o boot", (unsigned long)total);
+    for (uint8_t i = 0; i < MAX_TASKS && tasks[i] != NULL; ++i)
+    {
+      out.printf(", %s=%lu", taskNames[i] ? taskNames[i] : "?", (unsigned long)perTask[i]);
+    }
+    out.printf("\nHeap: comandos de display %lu alocacoes/%lu, desenho %lu alocacoes/%lu quadros\n",
+               (unsigned long)scopeAllocations[HEAP_SCOPE_DISPLAY_COMMAND], (unsigned long)scopeRuns[HEAP_SCOPE_DISPLAY_COMMAND],
+               (unsigned long)scopeAllocations[HEAP_SCOPE_DISPLAY_RENDER], (unsigned long)scopeRuns[HEAP_SCOPE_DISPLAY_RENDER]);
+  }
+
+private:
+  int8_t currentSlot()
+  {
+    TaskHandle_t handle = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < MAX_TASKS; ++i)
+    {
+      if (handle != NULL && __atomic_load_n(&tasks[i], __ATOMIC_ACQUIRE) == handle)
+        return i;
+    }
+    return -1;
+  }
+
+  TaskHandle_t tasks[MAX_TASKS] = {};
+  const char *taskNames[MAX_TASKS] = {};
+  uint32_t perTask[MAX_TASKS] = {};
+  uint32_t total = 0;
+  uint32_t scopeRuns[HEAP_SCOPE_COUNT] = {};
+  uint32_t scopeAllocations[HEAP_SCOPE_COUNT] = {};
+
+  // Valores no início da janela da receita
+  uint32_t windowTotal = 0;
+  uint32_t windowScopeRuns[HEAP_SCOPE_COUNT] = {};
+  uint32_t windowScopeAllocations[HEAP_SCOPE_COUNT] = {};
+};
+
+// --- CONTADOR GLOBAL ---
+extern HeapAllocCounter heapAllocCounter; // Definido em main.cpp
+
+/**
+ * @brief Conta as alocações da tarefa atual entre a construção e a destruição do objeto.
+ */
+class HeapAllocScope
+{
+public:
+  explicit HeapAllocScope(HeapAllocScopeId scope)
+      : scope(scope), start(heapAllocCounter.currentTaskCount()) {}
+  ~HeapAllocScope()
+  {
+    heapAllocCounter.recordScope(scope, heapAllocCounter.currentTaskCount() - start);
+  }
+
+private:
+  HeapAllocScopeId scope;
+  uint32_t start;
+};
+
+// Desvios do linker (-Wl,--wrap=...): contam e chamam a implementação original
+extern "C" void *__real_malloc(size_t size);
+extern "C" void *__real_calloc(size_t count, size_t size);
+extern "C" void *__real_realloc(void *ptr, size_t size);
+
+extern "C" void *__wrap_malloc(size_t size)
+{
+  heapAllocCounter.count();
+  return __real_malloc(size);
+}
+
+extern "C" void *__wrap_calloc(size_t count, size_t size)
+{
+  heapAllocCounter.count();
+  return __real_calloc(count, size);
+}
+
+extern "C" void *__wrap_realloc(void *ptr, size_t size)
+{
+  heapAllocCounter.count();
+  return __real_realloc(ptr, size);
+}
+
+#define HEAP_ALLOC_TRACK_TASK() heapAllocCounter.trackCurrentTask()
+#define HEAP_ALLOC_SCOPE(scope) HeapAllocScope heapAllocScope_((scope))
+
+#else
+
+#define HEAP_ALLOC_TRACK_TASK() ((void)0)
+#define HEAP_ALLOC_SCOPE(scope) ((void)0)
+
+#endif // HEAP_ALLOC_COUNTER
+
+#endif // HEAPCOUNTER_H
@@ -0,0 +1,272 @@
+/**
+ * @file I2CBus.h
+ * @brief Árbitro do barramento I2C compartilhado pelo display e pelo sensor de temperatura.
+ * @details O SSD1306 (0x3C, displayFlushTask) e o ESP32 simulador do sensor (0x08, temperatureSensorTask)
+ * usam o mesmo `Wire` a partir de tarefas diferentes. Cada transação passa a ser feita com o
+ * barramento reservado por `acquire()`/`release()`, protegido por um mutex do FreeRTOS.
+ * O sensor tem prioridade: a displayFlushTask reserva o barramento uma página por vez e, se há uma
+ * leitura do sensor esperando, cede o barramento antes da próxima página. O clock de cada cliente
+ * (100 kHz para o sensor, 400 kHz para o display) é aplicado na troca de dono.
+ * O acesso ao hardware passa pela interface I2CTransport (implementada sobre o `Wire` por
+ * WireTransport), o que permite exercitar o árbitro com um barramento simulado no host.
+ * Registra, por cliente, o tempo de espera e de ocupação de cada transação, erros e, para o
+ * sensor, o intervalo entre leituras (jitter). Impressos junto com o log (tecla '*' no IDLE).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef I2CBUS_H
+#define I2CBUS_H
+
+// Includes do projeto
+#include <Arduino.h>
+#include <Wire.h>
+
+// FreeRTOS Headers
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+// --- PARÂMETROS DO BARRAMENTO ---
+#define I2C_CLOCK_SENSOR 100000UL  // Clock das leituras do sensor simulado
+#define I2C_CLOCK_DISPLAY 400000UL // Clock das transferências para o SSD1306
+
+/**
+ * @brief Clientes do barramento, em ordem de prioridade (o primeiro tem precedência).
+ */
+enum I2CClient : uint8_t
+{
+  I2C_CLIENT_SENSOR,  ///< temperatureSensorTask (alta prioridade)
+  I2C_CLIENT_DISPLAY, ///< displayFlushTask, pelo DirtyPageFlusher (cede o barramento entre páginas)
+  I2C_CLIENT_COUNT
+};
+
+/**
+ * @brief Acesso ao hardware I2C usado pelo I2CBus.
+ */
+class I2CTransport
+{
+public:
+  virtual ~I2CTransport() {}
+
+  /**
+   * @brief Define o clock do barramento (Hz).
+   */
+  virtual void setClock(uint32_t hz) = 0;
+
+  /**
+   * @brief Escreve uma transação completa (início, endereço, dados, parada).
+   * @return 0 em caso de sucesso (mesmo código de TwoWire::endTransmission).
+   */
+  virtual uint8_t write(uint8_t address, const uint8_t *data, size_t length) = 0;
+
+  /**
+   * @brief Lê até `length` bytes do escravo.
+   * @return Número de bytes recebidos.
+   */
+  virtual size_t read(uint8_t address, uint8_t *data, size_t length) = 0;
+};
+
+/**
+ * @brief I2CTransport sobre o TwoWire do core Arduino.
+ */
+class WireTransport : public I2CTransport
+{
+public:
+  explicit WireTransport(TwoWire &wire) : wire(wire) {}
+
+  void setClock(uint32_t hz) override
+  {
+    wire.setClock(hz);
+  }
+
+  uint8_t write(uint8_t address, const uint8_t *data, size_t length) override
+  {
+    wire.beginTransmission(address);
+    wire.write(data, length);
+    return wire.endTransmission();
+  }
+
+  size_t read(uint8_t address, uint8_t *data, size_t length) override
+  {
+    size_t received = 0;
+    wire.requestFrom(address, (uint8_t)length);
+    while (received < length && wire.available())
+    {
+      data[received++] = (uint8_t)wire.read();
+    }
+    return received;
+  }
+
+private:
+  TwoWire &wire;
+};
+
+/**
+ * @brief Árbitro do barramento com prioridade para o sensor.
+ */
+class I2CBus
+{
+public:
+  explicit I2CBus(I2CTransport &transport) : transport(transport) {}
+
+  /**
+   * @brief Cria o mutex do barramento (chamar no setup, depois de Wire.begin e antes das tarefas).
+   * @return true se o mutex foi criado.
+   */
+  bool begin()
+  {
+    mutex = xSemaphoreCreateMutex();
+    currentClock = 0; // display.begin() mexe no clock: o primeiro dono sempre o redefine
+    return mutex != NULL;
+  }
+
+  /**
+   * @brief Reserva o barramento para um cliente (bloqueia até conseguir).
+   * @details O sensor espera apenas a transação em andamento. O display não começa uma
+   * transação enquanto houver uma leitura do sensor esperando.
+   */
+  void acquire(I2CClient client)
+  {
+    uint32_t startMicros = micros();
+    if (client == I2C_CLIENT_SENSOR)
+    {
+      __atomic_add_fetch(&sensorWaiting, 1, __ATOMIC_ACQ_REL);
+      xSemaphoreTake(mutex, portMAX_DELAY);
+      __atomic_sub_fetch(&sensorWaiting, 1, __ATOMIC_ACQ_REL);
+    }
+    else
+    {
+      for (;;)
+      {
+        while (__atomic_load_n(&sensorWaiting, __ATOMIC_ACQUIRE) > 0)
+        {
+          yields++;
+          vTaskDelay(1); // Cede a vez: a displayFlushTask (prioridade 2) está acima da temperatureSensorTask (1)
+        }
+        xSemaphoreTake(mutex, portMAX_DELAY);
+        if (__atomic_load_n(&sensorWaiting, __ATOMIC_ACQUIRE) == 0)
+          break;
+        xSemaphoreGive(mutex); // O sensor chegou enquanto esperávamos: ele vai primeiro
+      }
+    }
+
+    owner = client;
+    acquiredMicros = micros();
+    ClientStats &s = stats[client];
+    uint32_t waited = acquiredMicros - startMicros;
+    s.totalWaitMicros += waited;
+    if (waited > s.maxWaitMicros)
+      s.maxWaitMicros = waited;
+    if (client == I2C_CLIENT_SENSOR)
+      recordSensorInterval(acquiredMicros);
+
+    uint32_t clock = (client == I2C_CLIENT_SENSOR) ? I2C_CLOCK_SENSOR : I2C_CLOCK_DISPLAY;
+    if (clock != currentClock)
+    {
+      transport.setClock(clock);
+      currentClock = clock;
+    }
+  }
+
+  /**
+   * @brief Libera o barramento reservado por acquire().
+   */
+  void release()
+  {
+    ClientStats &s = stats[owner];
+    uint32_t held = micros() - acquiredMicros;
+    s.transactions++;
+    s.totalHoldMicros += held;
+    if (held > s.maxHoldMicros)
+      s.maxHoldMicros = held;
+    xSemaphoreGive(mutex);
+  }
+
+  /**
+   * @brief Escreve uma transação (barramento reservado pelo chamador).
+   * @return 0 em caso de sucesso.
+   */
+  uint8_t write(uint8_t address, const uint8_t *data, size_t length)
+  {
+    uint8_t result = transport.write(address, data, length);
+    if (result != 0)
+      stats[owner].errors++;
+    return result;
+  }
+
+  /**
+   * @brief Lê do escravo (barramento reservado pelo chamador).
+   * @return Número de bytes recebidos.
+   */
+  size_t read(uint8_t address, uint8_t *data, size_t length)
+  {
+    size_t received = transport.read(address, data, length);
+    if (received != length)
+      stats[owner].errors++;
+    return received;
+  }
+
+  /**
+   * @brief Imprime as estatísticas por cliente e o jitter das leituras do sensor.
+   */
+  void printStats(Print &out)
+  {
+    static const char *names[I2C_CLIENT_COUNT] = {"sensor", "display"};
+    for (uint8_t c = 0; c < I2C_CLIENT_COUNT; ++c)
+    {
+      const ClientStats &s = stats[c];
+      out.printf("I2C %s: %lu transacoes, espera media=%lu us (max %lu us), ocupacao media=%lu us (max %lu us), erros=%lu\n",
+                 names[c], (unsigned long)s.transactions,
+                 (unsigned long)(s.transactions ? s.totalWaitMicros / s.transactions : 0), (unsigned long)s.maxWaitMicros,
+                 (unsigned long)(s.transactions ? s.totalHoldMicros / s.transactions : 0), (unsigned long)s.maxHoldMicros,
+                 (unsigned long)s.errors);
+    }
+    out.printf("I2C sensor: intervalo entre leituras min=%lu us max=%lu us (jitter %lu us), display cedeu a vez %lu vezes\n",
+               (unsigned long)(sensorIntervals ? minIntervalMicros : 0), (unsigned long)maxIntervalMicros,
+               (unsigned long)(sensorIntervals ? maxIntervalMicros - minIntervalMicros : 0), (unsigned long)yields);
+  }
+
+private:
+  struct ClientStats
+  {
+    uint32_t transactions = 0;    // Reservas concluídas
+    uint32_t errors = 0;          // Falhas de escrita ou leituras incompletas
+    uint64_t totalWaitMicros = 0; // Espera pelo barramento
+    uint32_t maxWaitMicros = 0;
+    uint64_t totalHoldMicros = 0; // Tempo com o barramento reservado
+    uint32_t maxHoldMicros = 0;
+  };
+
+  // Intervalo entre leituras consecutivas do sensor (inclui a espera pelo barramento)
+  void recordSensorInterval(uint32_t readMicros)
+  {
+    if (lastSensorReadMicros != 0)
+    {
+      uint32_t interval = readMicros - lastSensorReadMicros;
+      if (sensorIntervals == 0 || interval < minIntervalMicros)
+        minIntervalMicros = interval;
+      if (interval > maxIntervalMicros)
+        maxIntervalMicros = interval;
+      sensorIntervals++;
+    }
+    lastSensorReadMicros = readMicros;
+  }
+
+  I2CTransport &transport;
+  SemaphoreHandle_t mutex = NULL;
+  uint32_t sensorWaiting = 0; // Leituras do sensor esperando o barramento
+  I2CClient owner = I2C_CLIENT_SENSOR;
+  uint32_t acquiredMicros = 0;
+  uint32_t currentClock = 0;
+  ClientStats stats[I2C_CLIENT_COUNT];
+
+  uint32_t yields = 0;                  // Vezes em que o display esperou por uma leitura do sensor
+  uint32_t lastSensorReadMicros = 0;    // Última leitura do sensor
+  uint32_t sensorIntervals = 0;         // Intervalos medidos
+  uint32_t minIntervalMicros = 0;
+  uint32_t maxIntervalMicros = 0;
+};
+
+#endif // I2CBUS_H
@@ -0,0 +1,187 @@
+/**
+ * @file KeypadDispatch.h
+ * @brief Tabela de despacho de teclas por estado da máquina de estados.
+ * @details Substitui a cadeia de `isStateActive()` da stateMachineTask por uma tabela
+ * constante (armazenada em flash) indexada diretamente pelo estado folha ativo
+ * (`Statechart::getActiveLeafState()`). Cada estado possui uma lista compacta de
+ * associações tecla -> ação e um comportamento padrão para as demais teclas.
+ * A execução das ações fica na stateMachineTask (main.cpp).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef KEYPADDISPATCH_H
+#define KEYPADDISPATCH_H
+
+// Includes do projeto
+#include "src-gen/Statechart.h"
+
+/**
+ * @brief Ações que uma tecla associada pode disparar.
+ */
+enum KeyActionType : uint8_t
+{
+  KEY_ACTION_RAISE,        ///< Dispara o evento `event` na statechart
+  KEY_ACTION_START_RECIPE, ///< Seleciona a receita `arg` (índice 0-baseado) e dispara `event` + start_first_step
+  KEY_ACTION_PRINT_LOG,    ///< Imprime o log e as estatísticas na Serial
+  KEY_ACTION_DUMP_TRACE,   ///< Despeja o trace das transições em binário na Serial (SC_TRACE_ENABLED)
+  KEY_ACTION_ABORT,        ///< Aborta o processo na controlTask e volta ao menu de receitas
+  KEY_ACTION_AUTOTUNE      ///< Inicia (`arg` = 1) ou cancela (`arg` = 0) o auto-tune do PID na controlTask
+};
+
+/**
+ * @brief Comportamento para teclas sem associação no estado.
+ */
+enum KeyFallbackType : uint8_t
+{
+  KEY_FALLBACK_REDRAW, ///< Redesenha a tela do estado e imprime o "Digitado: "
+  KEY_FALLBACK_IGNORE, ///< Limpa o buffer sem redesenhar (não interrompe telas de processo)
+  KEY_FALLBACK_SILENT  ///< Limpa o buffer; usado quando qualquer tecla deve ser ignorada
+};
+
+/**
+ * @brief Telas que podem ser redesenhadas por uma tecla inválida ou pelo timeout do buffer.
+ */
+enum KeyScreen : uint8_t
+{
+  KEY_SCREEN_NONE,          ///< Nenhuma tela a redesenhar
+  KEY_SCREEN_IDLE,          ///< Tela "Bem-vindo" (showIdleScreen)
+  KEY_SCREEN_RECIPES,       ///< Lista de receitas (showRecipes)
+  KEY_SCREEN_RECIPE_DETAILS ///< Detalhes da receita `screenArg` (showRecipe)
+};
+
+/**
+ * @brief Associação de uma tecla a uma ação.
+ */
+struct KeyBinding
+{
+  char key;            // Tecla
+  KeyActionType action; // Ação disparada
+  uint8_t event;       // Evento da statechart (statechart_events::StatechartEventName)
+  int8_t arg;          // Argumento da ação (ex: índice da receita)
+};
+
+/**
+ * @brief Mapa de teclas de um estado.
+ */
+struct StateKeyMap
+{
+  const KeyBinding *bindings; // Associações do estado
+  uint8_t count;              // Número de associações
+  KeyFallbackType fallback;   // Comportamento para as demais teclas
+  KeyScreen screen;           // Tela do estado (redesenho por tecla inválida e por timeout)
+  int8_t screenArg;           // Argumento da tela (ex: ID 1-baseado da receita)
+};
+
+// --- TABELAS (const => flash) ---
+namespace keypad_dispatch
+{
+using namespace statechart_events;
+
+const KeyBinding IDLE_KEYS[] = {
+    {'1', KEY_ACTION_RAISE, start_button, 0},
+    {'2', KEY_ACTION_RAISE, exit_process, 0},
+    {'*', KEY_ACTION_PRINT_LOG, invalid_event, 0},
+    {'#', KEY_ACTION_DUMP_TRACE, invalid_event, 0},
+    {'3', KEY_ACTION_AUTOTUNE, invalid_event, 1},
+    {'A', KEY_ACTION_AUTOTUNE, invalid_event, 0}};
+
+const KeyBinding MENU_KEYS[] = {
+    {'1', KEY_ACTION_RAISE, recipe_1, 0},
+    {'2', KEY_ACTION_RAISE, recipe_2, 0},
+    {'3', KEY_ACTION_RAISE, recipe_3, 0},
+    {'4', KEY_ACTION_RAISE, recipe_4, 0},
+    {'5', KEY_ACTION_RAISE, recipe_5, 0}};
+
+const KeyBinding RECIPE_1_KEYS[] = {
+    {'1', KEY_ACTION_START_RECIPE, recipe_1_process, 0}, // American Pale Ale é índice 0
+    {'2', KEY_ACTION_RAISE, recipe_back_menu, 0}};
+
+const KeyBinding RECIPE_2_KEYS[] = {
+    {'1', KEY_ACTION_START_RECIPE, recipe_2_process, 1}, // Witbier é índice 1
+    {'2', KEY_ACTION_RAISE, recipe_back_menu, 0}};
+
+const KeyBinding RECIPE_3_KEYS[] = {
+    {'1', KEY_ACTION_START_RECIPE, recipe_3_process, 2}, // Belgian Dubbel é índice 2
+    {'2', KEY_ACTION_RAISE, recipe_back_menu, 0}};
+
+const KeyBinding RECIPE_4_KEYS[] = {
+    {'1', KEY_ACTION_START_RECIPE, recipe_4_process, 3}, // Bohemian Pilsen é índice 3
+    {'2', KEY_ACTION_RAISE, recipe_back_menu, 0}};
+
+// RECIPE_5 (Customizar): só volta ao menu; '1' (recipe_5_process -> CUSTOM_SETUP) fica sem
+// associação enquanto as operações do CUSTOM_SETUP forem stubs no StatechartCallback
+const KeyBinding RECIPE_5_KEYS[] = {
+    {'2', KEY_ACTION_RAISE, recipe_back_menu, 0}};
+
+// Processo em andamento: 'A' aborta na controlTask e volta ao menu (transição menu do STANDARD_PROCESS)
+const KeyBinding ABORT_KEYS[] = {
+    {'A', KEY_ACTION_ABORT, menu, 0}};
+
+// CUSTOM_SETUP: 'B' cancela e volta ao menu (transição keypad_input_cancel do modelo)
+const KeyBinding CUSTOM_SETUP_KEYS[] = {
+    {'B', KEY_ACTION_RAISE, keypad_input_cancel, 0}};
+
+#define KEYMAP(keys) keys, (uint8_t)(sizeof(keys) / sizeof(keys[0]))
+
+/**
+ * @brief Mapa de teclas indexado por Statechart::StatechartStates (mesma ordem da enumeração).
+ */
+const StateKeyMap STATE_KEY_MAPS[Statechart::numStates + 1] = {
+    {nullptr, 0, KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},                     // Statechart_last_state
+    {KEYMAP(IDLE_KEYS), KEY_FALLBACK_REDRAW, KEY_SCREEN_IDLE, 0},             // main_region_IDLE
+    {KEYMAP(MENU_KEYS), KEY_FALLBACK_REDRAW, KEY_SCREEN_RECIPES, 0},          // main_region_MENU
+    {nullptr, 0, KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},                     // main_region_EXIT (final: sistema desligado)
+    {KEYMAP(ABORT_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},            // main_region_STANDARD_PROCESS
+    {KEYMAP(ABORT_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},            // ..._START_PROCESS
+    {KEYMAP(ABORT_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},            // ..._FINISH_PROCESS
+    {KEYMAP(ABORT_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},            // ..._CONTROL_PROCESS_LOOP
+    {KEYMAP(CUSTOM_SETUP_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},     // main_region_CUSTOM_SETUP
+    {KEYMAP(CUSTOM_SETUP_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},     // ..._CUSTOM_SETUP_COMPLETE
+    {KEYMAP(CUSTOM_SETUP_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},     // ..._NUM_STEPS
+    {KEYMAP(CUSTOM_SETUP_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},     // ..._LOOP_TEMP_TIME_STEPS
+    {KEYMAP(CUSTOM_SETUP_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},     // ..._loop_steps_TEMP
+    {KEYMAP(CUSTOM_SETUP_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},     // ..._loop_steps_TIME
+    {nullptr, 0, KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},                     // main_region_INIT_SYSTEM (o timer leva ao MENU)
+    {KEYMAP(RECIPE_1_KEYS), KEY_FALLBACK_REDRAW, KEY_SCREEN_RECIPE_DETAILS, 1}, // main_region_RECIPE_1
+    {KEYMAP(RECIPE_2_KEYS), KEY_FALLBACK_REDRAW, KEY_SCREEN_RECIPE_DETAILS, 2}, // main_region_RECIPE_2
+    {KEYMAP(RECIPE_3_KEYS), KEY_FALLBACK_REDRAW, KEY_SCREEN_RECIPE_DETAILS, 3}, // main_region_RECIPE_3
+    {KEYMAP(RECIPE_4_KEYS), KEY_FALLBACK_REDRAW, KEY_SCREEN_RECIPE_DETAILS, 4}, // main_region_RECIPE_4
+    {KEYMAP(RECIPE_5_KEYS), KEY_FALLBACK_IGNORE, KEY_SCREEN_NONE, 0},         // main_region_RECIPE_5 (sem tela de detalhes: showRecipe(5) não desenha)
+    {nullptr, 0, KEY_FALLBACK_SILENT, KEY_SCREEN_NONE, 0}                     // main_region_FINISHED_MESSAGE (apenas o timeout volta ao IDLE)
+};
+
+#undef KEYMAP
+} // namespace keypad_dispatch
+
+/**
+ * @brief Retorna o mapa de teclas do estado folha ativo em O(1).
+ * @param state Estado folha ativo (Statechart::getActiveLeafState()).
+ */
+inline const StateKeyMap &keyMapForState(Statechart::StatechartStates state)
+{
+  if ((int)state < 0 || (int)state > Statechart::numStates)
+  {
+    return keypad_dispatch::STATE_KEY_MAPS[Statechart::Statechart_last_state];
+  }
+  return keypad_dispatch::STATE_KEY_MAPS[state];
+}
+
+/**
+ * @brief Procura a associação de uma tecla no mapa do estado.
+ * @return Ponteiro para a associação, ou nullptr se a tecla não estiver associada.
+ */
+inline const KeyBinding *findKeyBinding(const StateKeyMap &map, char key)
+{
+  for (uint8_t i = 0; i < map.count; ++i)
+  {
+    if (map.bindings[i].key == key)
+    {
+      return &map.bindings[i];
+    }
+  }
+  return nullptr;
+}
+
+#endif // KEYPADDISPATCH_H
@@ -0,0 +1,122 @@
+/**
+ * @file PidGains.h
+ * @brief Ganhos do PID identificados pelo auto-tune, gravados no LittleFS.
+ * @details O registro guarda Kp, Ki e Kd calculados pelo RelayAutoTune (RelayAutoTune.h) e o ganho
+ * e o período críticos de onde vieram. A gravação usa o mesmo esquema do BrewSnapshot: arquivo
+ * temporário renomeado sobre o anterior e validação por magic, versão, tamanho e CRC-32 na leitura.
+ * No boot o setup() carrega os ganhos gravados; sem registro válido ficam os ganhos de fábrica.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef PIDGAINS_H
+#define PIDGAINS_H
+
+// Includes do projeto
+#include "BrewSnapshot.h"
+#include <Arduino.h>
+#include <stddef.h>
+
+// LittleFS
+#include "FS.h"
+#include "LittleFS.h"
+
+// --- PARÂMETROS DO REGISTRO ---
+#define PID_GAINS_FILE "/pid_gains.bin"     // Ganhos válidos
+#define PID_GAINS_TMP_FILE "/pid_gains.tmp" // Escrita em andamento
+#define PID_GAINS_MAGIC 0x47444950UL        // "PIDG" em little-endian
+#define PID_GAINS_VERSION 1
+
+/**
+ * @brief Registro gravado no LittleFS (layout fixo, sem padding).
+ */
+struct PidGains
+{
+  uint32_t magic;          // PID_GAINS_MAGIC
+  uint16_t version;        // PID_GAINS_VERSION
+  uint16_t size;           // sizeof(PidGains)
+  float kp;                // Ganho proporcional (duty/°C)
+  float ki;                // Ganho integral (duty/(°C.s))
+  float kd;                // Ganho derivativo (duty.s/°C)
+  float ultimateGain;      // Ku identificado pelo relé (duty/°C)
+  float ultimatePeriodSec; // Pu identificado pelo relé (s)
+  uint32_t crc;            // CRC-32 de todos os campos anteriores
+};
+static_assert(sizeof(PidGains) == 32, "PidGains deve manter o layout de 32 bytes");
+
+/**
+ * @brief Gravação atômica e leitura validada dos ganhos no LittleFS.
+ * @details Usado pela loggerTask (gravação) e pelo setup() (leitura no boot).
+ */
+class PidGainsStore
+{
+public:
+  /**
+   * @brief Grava os ganhos (arquivo temporário + rename).
+   * @param gains Registro a gravar; magic, versão, tamanho e CRC são preenchidos aqui.
+   * @return true se o registro foi gravado e renomeado com sucesso.
+   */
+  bool save(PidGains &gains)
+  {
+    gains.magic = PID_GAINS_MAGIC;
+    gains.version = PID_GAINS_VERSION;
+    gains.size = sizeof(PidGains);
+    gains.crc = BrewSnapshotStore::crc32((const uint8_t *)&gains, offsetof(PidGains, crc));
+
+    File file = LittleFS.open(PID_GAINS_TMP_FILE, FILE_WRITE);
+    if (!file)
+    {
+      failures++;
+      return false;
+    }
+    size_t written = file.write((const uint8_t *)&gains, sizeof(PidGains));
+    file.close();
+    if (written != sizeof(PidGains) || !LittleFS.rename(PID_GAINS_TMP_FILE, PID_GAINS_FILE))
+    {
+      failures++;
+      return false;
+    }
+    writes++;
+    return true;
+  }
+
+  /**
+   * @brief Lê e valida os ganhos gravados.
+   * @param gains Recebe o registro lido.
+   * @return true se existe um registro íntegro com ganhos não negativos.
+   */
+  bool load(PidGains &gains)
+  {
+    File file = LittleFS.open(PID_GAINS_FILE, FILE_READ);
+    if (!file)
+    {
+      return false;
+    }
+    size_t read = file.read((uint8_t *)&gains, sizeof(PidGains));
+    file.close();
+    if (read != sizeof(PidGains) || gains.magic != PID_GAINS_MAGIC ||
+        gains.version != PID_GAINS_VERSION || gains.size != sizeof(PidGains) ||
+        gains.crc != BrewSnapshotStore::crc32((const uint8_t *)&gains, offsetof(PidGains, crc)) ||
+        !(gains.kp >= 0 && gains.ki >= 0 && gains.kd >= 0))
+    {
+      Serial.println("PidGains: Ganhos invalidos descartados.");
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Imprime as estatísticas de gravação na Serial.
+   */
+  void printStats(Print &out)
+  {
+    out.printf("Ganhos PID: %lu gravacoes, %lu falhas\n", (unsigned long)writes, (unsigned long)failures);
+  }
+
+private:
+  uint32_t writes = 0;   // Gravações concluídas
+  uint32_t failures = 0; // Falhas de escrita ou rename
+};
+
+#endif // PIDGAINS_H
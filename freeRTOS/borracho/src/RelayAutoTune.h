@@ -0,0 +1,240 @@
+/**
+ * @file RelayAutoTune.h
+ * @brief Auto-tune do PID pelo método do relé de Åström–Hägglund.
+ * @details Os ganhos de fábrica (Kp = 30, Ki = 5, Kd = 0,5) foram ajustados à mão e passam 9,5 °C
+ * do setpoint na etapa de 67 °C. No auto-tune a controlTask troca o PID por um relé com histerese:
+ * aquecedor no duty máximo abaixo de setpoint - ε e desligado acima de setpoint + ε. A
+ * temperatura oscila em torno do setpoint no período crítico Pu da planta, com amplitude a. Com
+ * o relé de amplitude d = duty máximo / 2, o ganho crítico é
+ * Ku = 4d / (π·sqrt(a² - ε²)). O primeiro ciclo (transitório do aquecimento) é descartado; o
+ * auto-tune termina quando dois ciclos seguidos concordam em amplitude e período (AUTOTUNE_TOLERANCE)
+ * e calcula os ganhos pela regra de Ziegler–Nichols "sem sobressinal" (Kp = 0,2·Ku, Ti = Pu/2,
+ * Td = Pu/3), escolhida por causa do sobressinal dos ganhos de fábrica.
+ * Falha (aquecedor desligado, ganhos mantidos) se a temperatura passar de setpoint +
+ * AUTOTUNE_MAX_OVERSHOOT, se o sensor falhar, se a oscilação não se estabilizar em
+ * AUTOTUNE_MAX_CYCLES ciclos ou se o tempo passar de AUTOTUNE_TIMEOUT_MS.
+ * Usado só pela controlTask; os ganhos calculados seguem para a loggerTask copiados no ControlRecord.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef RELAYAUTOTUNE_H
+#define RELAYAUTOTUNE_H
+
+// Includes do projeto
+#include "PidGains.h"
+#include <Arduino.h>
+#include <math.h>
+
+// --- PARÂMETROS DO AUTO-TUNE ---
+#define AUTOTUNE_SETPOINT 65                  // Temperatura de oscilação (°C), no meio da faixa de mostura
+#define AUTOTUNE_HYSTERESIS 0.5f              // ε (°C): evita chaveamento pelo ruído do sensor
+#define AUTOTUNE_TOLERANCE 0.10f              // Diferença relativa aceita entre dois ciclos seguidos
+#define AUTOTUNE_MAX_CYCLES 10                // Ciclos medidos antes de desistir
+#define AUTOTUNE_MAX_OVERSHOOT 10.0f          // Acima de setpoint + 10 °C o auto-tune é abortado
+#define AUTOTUNE_TIMEOUT_MS (120UL * 60000UL) // Duração máxima (2 h)
+
+/**
+ * @brief Situação do auto-tune.
+ */
+enum AutoTuneState : uint8_t
+{
+  AUTOTUNE_IDLE,    // Nunca iniciado ou cancelado
+  AUTOTUNE_RUNNING, // Relé oscilando
+  AUTOTUNE_DONE,    // Ganhos calculados (result())
+  AUTOTUNE_FAILED   // Abortado por segurança, sensor, tempo ou oscilação instável
+};
+
+/**
+ * @brief Relé com histerese, medição dos ciclos e cálculo dos ganhos.
+ */
+class RelayAutoTune
+{
+public:
+  /**
+   * @brief Inicia a oscilação em torno de um setpoint (relé ligado).
+   * @param newSetpoint Temperatura de oscilação (°C).
+   * @param outputHigh Duty cycle com o relé ligado (o máximo do PWM).
+   */
+  void start(float newSetpoint, float outputHigh, uint32_t nowMillis)
+  {
+    setpoint = newSetpoint;
+    relayHigh = outputHigh;
+    state = AUTOTUNE_RUNNING;
+    relayOn = true;
+    startMillis = nowMillis;
+    lastCycleMillis = 0;
+    cycleStarted = false;
+    cycles = 0;
+    lastAmplitude = 0;
+    lastPeriodSec = 0;
+    failure = "";
+  }
+
+  /**
+   * @brief Interrompe a oscilação sem alterar os ganhos.
+   */
+  void cancel()
+  {
+    if (state == AUTOTUNE_RUNNING)
+    {
+      state = AUTOTUNE_IDLE;
+    }
+  }
+
+  bool running() const
+  {
+    return state == AUTOTUNE_RUNNING;
+  }
+
+  AutoTuneState getState() const
+  {
+    return state;
+  }
+
+  /**
+   * @brief Um passo do relé (a cada período da controlTask).
+   * @param input Temperatura medida (°C).
+   * @return Duty cycle a aplicar (0 fora de RUNNING).
+   */
+  float update(float input, uint32_t nowMillis)
+  {
+    if (state != AUTOTUNE_RUNNING)
+    {
+      return 0;
+    }
+    if (input < -100)
+    {
+      return fail("sensor");
+    }
+    if (input > setpoint + AUTOTUNE_MAX_OVERSHOOT)
+    {
+      return fail("temperatura");
+    }
+    if (nowMillis - startMillis > AUTOTUNE_TIMEOUT_MS)
+    {
+      return fail("tempo");
+    }
+
+    if (input > cycleMax)
+      cycleMax = input;
+    if (input < cycleMin)
+      cycleMin = input;
+
+    if (relayOn && input > setpoint + AUTOTUNE_HYSTERESIS)
+    {
+      // Cada desligamento do relé fecha um ciclo (o primeiro só abre a medição)
+      relayOn = false;
+      if (cycleStarted && closeCycle(nowMillis))
+      {
+        return 0;
+      }
+      cycleStarted = true;
+      lastCycleMillis = nowMillis;
+      cycleMax = input;
+      cycleMin = input;
+    }
+    else if (!relayOn && input < setpoint - AUTOTUNE_HYSTERESIS)
+    {
+      relayOn = true;
+    }
+    return relayOn ? relayHigh : 0;
+  }
+
+  /**
+   * @brief Ganhos calculados (válidos em AUTOTUNE_DONE).
+   */
+  const PidGains &result() const
+  {
+    return gains;
+  }
+
+  /**
+   * @brief Imprime a situação, os ciclos medidos e o último resultado.
+   */
+  void printStats(Print &out)
+  {
+    static const char *const names[] = {"parado", "oscilando", "concluido", "falhou"};
+    out.printf("Auto-tune: %s%s%s, %u ciclos, a=%.2f C, Pu=%.1f s",
+               names[state], failure[0] ? " por " : "", failure, (unsigned)cycles,
+               (double)lastAmplitude, (double)lastPeriodSec);
+    if (state == AUTOTUNE_DONE)
+    {
+      out.printf(", Ku=%.1f -> Kp=%.2f Ki=%.3f Kd=%.2f", (double)gains.ultimateGain,
+                 (double)gains.kp, (double)gains.ki, (double)gains.kd);
+    }
+    out.println();
+  }
+
+private:
+  // Registra o ciclo que terminou; com dois ciclos concordantes calcula os ganhos
+  bool closeCycle(uint32_t nowMillis)
+  {
+    float amplitude = (cycleMax - cycleMin) / 2;
+    float periodSec = (nowMillis - lastCycleMillis) / 1000.0f;
+    cycles++;
+    bool settled = cycles >= 2 && similar(amplitude, lastAmplitude) && similar(periodSec, lastPeriodSec);
+    lastAmplitude = amplitude;
+    lastPeriodSec = periodSec;
+    if (settled)
+    {
+      if (amplitude <= AUTOTUNE_HYSTERESIS)
+      {
+        fail("amplitude");
+        return true;
+      }
+      computeGains(amplitude, periodSec);
+      state = AUTOTUNE_DONE;
+      return true;
+    }
+    if (cycles >= AUTOTUNE_MAX_CYCLES)
+    {
+      fail("instavel");
+      return true;
+    }
+    return false;
+  }
+
+  static bool similar(float a, float b)
+  {
+    return fabsf(a - b) <= AUTOTUNE_TOLERANCE * fmaxf(a, b);
+  }
+
+  void computeGains(float amplitude, float periodSec)
+  {
+    const float relayAmplitude = relayHigh / 2;
+    float ku = 4 * relayAmplitude /
+               ((float)M_PI * sqrtf(amplitude * amplitude - AUTOTUNE_HYSTERESIS * AUTOTUNE_HYSTERESIS));
+    gains = {};
+    gains.ultimateGain = ku;
+    gains.ultimatePeriodSec = periodSec;
+    gains.kp = 0.2f * ku;                 // Ziegler–Nichols "sem sobressinal"
+    gains.ki = gains.kp / (periodSec / 2); // Ti = Pu / 2
+    gains.kd = gains.kp * (periodSec / 3); // Td = Pu / 3
+  }
+
+  float fail(const char *reason)
+  {
+    state = AUTOTUNE_FAILED;
+    failure = reason;
+    return 0;
+  }
+
+  AutoTuneState state = AUTOTUNE_IDLE;
+  float setpoint = 0;
+  float relayHigh = 0; // Duty cycle com o relé ligado
+  bool relayOn = false;
+  uint32_t startMillis = 0;
+  uint32_t lastCycleMillis = 0; // Desligamento do relé que abriu o ciclo atual
+  bool cycleStarted = false;    // Transitório do aquecimento já passou
+  float cycleMax = 0;           // Extremos do ciclo atual (°C)
+  float cycleMin = 0;
+  uint8_t cycles = 0;           // Ciclos completos medidos
+  float lastAmplitude = 0;      // Amplitude do último ciclo (°C)
+  float lastPeriodSec = 0;      // Período do último ciclo (s)
+  const char *failure = "";     // Motivo da falha
+  PidGains gains = {};          // Resultado (AUTOTUNE_DONE)
+};
+
+#endif // RELAYAUTOTUNE_H
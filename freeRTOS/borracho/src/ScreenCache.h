@@ -0,0 +1,168 @@
+/**
+ * @file ScreenCache.h
+ * @brief Framebuffers pré-desenhados das telas estáticas do display.
+ * @details As telas de IDLE, lista de receitas, receita concluída e detalhes de cada receita não
+ * mudam durante a execução, mas eram refeitas com chamadas de texto da Adafruit_GFX a cada
+ * exibição (ex: após cada tecla inválida). O setup() desenha cada uma delas uma única vez e guarda
+ * o framebuffer (1 KB por tela); a displayTask passa a exibi-las com um memcpy, e os campos
+ * dinâmicos ("Estado:", texto digitado) continuam sendo desenhados por cima pelos seus próprios
+ * comandos. Registra o tempo de desenho com a GFX (no boot) e o tempo da cópia (a cada exibição).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef SCREENCACHE_H
+#define SCREENCACHE_H
+
+// Includes do projeto
+#include "StatechartCallback.h"
+#include <Arduino.h>
+
+/**
+ * @brief Telas estáticas guardadas no cache (uma entrada por receita para os detalhes).
+ */
+enum StaticScreen : int8_t
+{
+  SCREEN_NONE = -1,            ///< Comando sem tela estática (desenhado normalmente)
+  SCREEN_MAIN_MENU,            ///< CMD_SHOW_MAIN_MENU_SCREEN
+  SCREEN_RECIPES_LIST,         ///< CMD_SHOW_RECIPES_LIST
+  SCREEN_FINISHED_MESSAGE,     ///< CMD_SHOW_FINISHED_MESSAGE_SCREEN
+  SCREEN_RECIPE_DETAILS_FIRST, ///< CMD_SHOW_RECIPE_DETAILS_SCREEN da receita 0 (as demais em sequência)
+};
+
+#define SCREEN_CACHE_SLOTS (SCREEN_RECIPE_DETAILS_FIRST + NUM_RECIPES)
+#define SCREEN_CACHE_FRAME_SIZE (SCREEN_WIDTH * SCREEN_HEIGHT / 8)
+
+/**
+ * @brief Cache de framebuffers das telas estáticas.
+ * @details Preenchido pelo setup() antes de as tarefas serem criadas e depois só lido pela
+ * displayTask, por isso não precisa de sincronização.
+ */
+class ScreenCache
+{
+public:
+  /**
+   * @brief Tela estática correspondente a um comando.
+   * @return Índice da tela no cache, ou SCREEN_NONE se o comando não é uma tela estática completa.
+   */
+  static int8_t screenFor(const DisplayCommand &cmd)
+  {
+    if (!cmd.clearScreen)
+    {
+      return SCREEN_NONE; // Desenha por cima do conteúdo atual: depende do que já está na tela
+    }
+    switch (cmd.type)
+    {
+    case CMD_SHOW_MAIN_MENU_SCREEN:
+      return SCREEN_MAIN_MENU;
+    case CMD_SHOW_RECIPES_LIST:
+      return SCREEN_RECIPES_LIST;
+    case CMD_SHOW_FINISHED_MESSAGE_SCREEN:
+      return SCREEN_FINISHED_MESSAGE;
+    case CMD_SHOW_RECIPE_DETAILS_SCREEN:
+      if (cmd.recipeId >= 0 && cmd.recipeId < NUM_RECIPES)
+      {
+        return SCREEN_RECIPE_DETAILS_FIRST + cmd.recipeId;
+      }
+      return SCREEN_NONE;
+    default:
+      return SCREEN_NONE;
+    }
+  }
+
+  /**
+   * @brief Comando que desenha uma tela estática (usado para pré-desenhá-la no boot).
+   */
+  static DisplayCommand commandFor(int8_t screen)
+  {
+    DisplayCommand cmd = {CMD_SHOW_MAIN_MENU_SCREEN};
+    cmd.clearScreen = true;
+    switch (screen)
+    {
+    case SCREEN_MAIN_MENU:
+      break;
+    case SCREEN_RECIPES_LIST:
+      cmd.type = CMD_SHOW_RECIPES_LIST;
+      break;
+    case SCREEN_FINISHED_MESSAGE:
+      cmd.type = CMD_SHOW_FINISHED_MESSAGE_SCREEN;
+      break;
+    default:
+      cmd.type = CMD_SHOW_RECIPE_DETAILS_SCREEN;
+      cmd.recipeId = screen - SCREEN_RECIPE_DETAILS_FIRST;
+      break;
+    }
+    return cmd;
+  }
+
+  /**
+   * @brief Guarda o framebuffer de uma tela recém-desenhada.
+   * @param screen Índice da tela.
+   * @param framebuffer Framebuffer do display (SCREEN_CACHE_FRAME_SIZE bytes).
+   * @param drawMicros Tempo gasto desenhando a tela com a Adafruit_GFX.
+   */
+  void store(int8_t screen, const uint8_t *framebuffer, uint32_t drawMicros)
+  {
+    memcpy(frames[screen], framebuffer, SCREEN_CACHE_FRAME_SIZE);
+    gfxMicros[screen] = drawMicros;
+    stored[screen] = true;
+  }
+
+  /**
+   * @brief Copia uma tela guardada para o framebuffer do display.
+   * @return false se a tela não está no cache (o chamador desenha normalmente).
+   */
+  bool load(int8_t screen, uint8_t *framebuffer)
+  {
+    if (screen == SCREEN_NONE || !stored[screen])
+    {
+      return false;
+    }
+    uint32_t startMicros = micros();
+    memcpy(framebuffer, frames[screen], SCREEN_CACHE_FRAME_SIZE);
+    uint32_t elapsed = micros() - startMicros;
+    hits[screen]++;
+    blitMicros[screen] += elapsed;
+    return true;
+  }
+
+  /**
+   * @brief Imprime, por tela, o tempo de desenho com a GFX e o tempo médio da cópia do cache.
+   */
+  void printStats(Print &out)
+  {
+    for (int8_t screen = 0; screen < SCREEN_CACHE_SLOTS; ++screen)
+    {
+      if (!stored[screen])
+        continue;
+      out.printf("Tela '%s': GFX %lu us -> cache %lu us (%lu exibicoes)\n", screenName(screen),
+                 (unsigned long)gfxMicros[screen],
+                 (unsigned long)(hits[screen] ? blitMicros[screen] / hits[screen] : 0), (unsigned long)hits[screen]);
+    }
+  }
+
+private:
+  static const char *screenName(int8_t screen)
+  {
+    switch (screen)
+    {
+    case SCREEN_MAIN_MENU:
+      return "IDLE";
+    case SCREEN_RECIPES_LIST:
+      return "Receitas";
+    case SCREEN_FINISHED_MESSAGE:
+      return "Concluido";
+    default:
+      return recipes[screen - SCREEN_RECIPE_DETAILS_FIRST].name;
+    }
+  }
+
+  uint8_t frames[SCREEN_CACHE_SLOTS][SCREEN_CACHE_FRAME_SIZE]; // Framebuffers das telas
+  bool stored[SCREEN_CACHE_SLOTS] = {};                        // Tela já pré-desenhada
+  uint32_t gfxMicros[SCREEN_CACHE_SLOTS] = {};                 // Tempo de desenho com a GFX (boot)
+  uint32_t hits[SCREEN_CACHE_SLOTS] = {};                      // Exibições servidas pelo cache
+  uint64_t blitMicros[SCREEN_CACHE_SLOTS] = {};                // Tempo total das cópias
+};
+
+#endif // SCREENCACHE_H
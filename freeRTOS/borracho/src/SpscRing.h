@@ -0,0 +1,92 @@
+/**
+ * @file SpscRing.h
+ * @brief Fila circular sem trava para um produtor e um consumidor (SPSC).
+ * @details O produtor só escreve `head` e o consumidor só escreve `tail`; cada lado publica o seu
+ * índice com release e lê o do outro com acquire, então um elemento só é visto pelo consumidor
+ * depois de copiado. Nenhum lado bloqueia nem desabilita interrupções: push() em uma fila cheia
+ * falha na hora (o produtor conta a perda e segue), o que permite à controlTask publicar sem
+ * depender do ritmo de quem consome. O aviso de dados novos ao consumidor fica com o chamador
+ * (ex: notificação de tarefa).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+// Includes do projeto
+#include <Arduino.h>
+#include <type_traits>
+
+/**
+ * @brief Fila SPSC de capacidade fixa.
+ * @tparam T Tipo do elemento (copiado byte a byte).
+ * @tparam N Número de posições (potência de 2).
+ */
+template <typename T, uint32_t N>
+class SpscRing
+{
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "N deve ser potência de 2");
+  static_assert(std::is_trivially_copyable<T>::value, "T é copiado byte a byte");
+
+public:
+  /**
+   * @brief Publica um elemento (só o produtor).
+   * @return false se a fila está cheia (o elemento é descartado e contado).
+   */
+  bool push(const T &item)
+  {
+    uint32_t h = __atomic_load_n(&head, __ATOMIC_RELAXED);
+    uint32_t t = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+    if (h - t >= N)
+    {
+      dropped++;
+      return false;
+    }
+    slots[h & (N - 1)] = item;
+    __atomic_store_n(&head, h + 1, __ATOMIC_RELEASE);
+    pushed++;
+    if (h + 1 - t > highWater)
+      highWater = h + 1 - t;
+    return true;
+  }
+
+  /**
+   * @brief Retira o elemento mais antigo (só o consumidor).
+   * @return false se a fila está vazia.
+   */
+  bool pop(T &item)
+  {
+    uint32_t t = __atomic_load_n(&tail, __ATOMIC_RELAXED);
+    uint32_t h = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+    if (t == h)
+    {
+      return false;
+    }
+    item = slots[t & (N - 1)];
+    __atomic_store_n(&tail, t + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  /**
+   * @brief Imprime elementos publicados, perdidos por fila cheia e a maior ocupação.
+   */
+  void printStats(Print &out, const char *name)
+  {
+    out.printf("Fila %s: %lu publicados, %lu perdidos (cheia), ocupacao max=%lu/%lu\n", name,
+               (unsigned long)pushed, (unsigned long)dropped, (unsigned long)highWater, (unsigned long)N);
+  }
+
+private:
+  T slots[N];
+  uint32_t head = 0; // Próxima posição a escrever (produtor)
+  uint32_t tail = 0; // Próxima posição a ler (consumidor)
+
+  // Estatísticas (escritas só pelo produtor)
+  uint32_t pushed = 0;
+  uint32_t dropped = 0;
+  uint32_t highWater = 0;
+};
+
+#endif // SPSCRING_H
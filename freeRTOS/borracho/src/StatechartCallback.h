@@ -15,7 +15,12 @@
 
 // Includes do projeto
 #include "src-gen/Statechart.h"
+#include "StatechartIngress.h"
+#include "HeapCounter.h"
+#include "TemperatureGraph.h"
+#include "GainSchedule.h"
 #include <Arduino.h>
+#include <type_traits>
 
 // DisplayOLED
 #include <Wire.h>
@@ -27,6 +32,7 @@
 
 // FreeRTOS Headers
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "freertos/queue.h"
 
 // --- DEFINES DO HARDWARE ---
@@ -34,6 +40,7 @@
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 #define OLED_RESET -1
+#define OLED_ADDRESS 0x3C // Endereço I2C do SSD1306
 
 // --- DEFINES ESPECÍFICAS DO PWM LEDC (ESP32) ---
 #define LEDC_CHANNEL_PWM_HEATER 0
@@ -57,25 +64,41 @@ enum DisplayCommandType
 {
   CMD_CLEAR_DISPLAY,               ///< Limpa a tela do display
   CMD_SHOW_STATE_INFO,             ///< Exibe o nome do estado atual (geralmente no topo)
-  CMD_SHOW_MAIN_MENU_SCREEN,       ///< Exibe a tela do menu principal (IDLE: "1- Iniciar", "2- Sair")
+  CMD_SHOW_MAIN_MENU_SCREEN,       ///< Exibe a tela do menu principal (IDLE: "1- Iniciar", "2- Sair", "3- Auto-tune PID")
   CMD_SHOW_STARTUP_MESSAGE,        ///< Exibe a mensagem de inicialização ("DisplayTask OK!", "Executando showStartup()")
   CMD_SHOW_RECIPES_LIST,           ///< Exibe a lista de receitas disponíveis (MENU: "1- APA", "2- Witbier", etc.)
   CMD_SHOW_RECIPE_DETAILS_SCREEN,  ///< Exibe os detalhes de uma receita específica (etapas, temperaturas, tempos)
   CMD_PRINT_KEYPAD_INPUT,          ///< Imprime o texto digitado pelo teclado, geralmente na parte inferior da tela
   CMD_SHOW_PROCESS_STATUS_SCREEN,  ///< Exibe o status atual do processo de cozimento
-  CMD_SHOW_FINISHED_MESSAGE_SCREEN ///< Exibe a mensagem de receita concluída
+  CMD_SHOW_FINISHED_MESSAGE_SCREEN, ///< Exibe a mensagem de receita concluída
+  CMD_PLOT_TEMPERATURE_SAMPLE       ///< Acrescenta uma amostra ao gráfico da tela de processo (páginas 6 e 7)
 };
 
+#define DISPLAY_TEXT_SIZE 96 // Texto de um comando de display, com o '\0' (a tela de status usa ~80)
+
 /**
  * @brief Estrutura para os comandos de display, enviados via fila.
+ * @details POD de tamanho fixo: a fila copia o comando byte a byte, então o texto fica no próprio
+ * comando (truncado em DISPLAY_TEXT_SIZE - 1 caracteres) em vez de em uma `String` no heap.
  */
 struct DisplayCommand
 {
-  DisplayCommandType type; // Tipo do comando
-  String text;             // Texto associado ao comando (ex: nome do estado, texto digitado)
-  bool clearScreen;        // Flag para indicar se a tela deve ser limpa antes de exibir o conteúdo
-  int recipeId;            // ID da receita (para comandos de detalhes de receita)
+  DisplayCommandType type;       // Tipo do comando
+  char text[DISPLAY_TEXT_SIZE];  // Texto associado ao comando (ex: nome do estado, texto digitado)
+  bool clearScreen;              // Flag para indicar se a tela deve ser limpa antes de exibir o conteúdo
+  int recipeId;                  // ID da receita (para comandos de detalhes de receita)
+  uint32_t inputMicros;          // Instante da tecla que gerou o comando (0: não veio de uma tecla)
+  TemperatureSample sample;      // Amostra do gráfico (CMD_PLOT_TEMPERATURE_SAMPLE)
+
+  /**
+   * @brief Copia um texto para o comando (truncado no tamanho do buffer).
+   */
+  void setText(const char *value)
+  {
+    snprintf(text, sizeof(text), "%s", value);
+  }
 };
+static_assert(std::is_trivially_copyable<DisplayCommand>::value, "DisplayCommand é copiado byte a byte pela fila");
 
 /**
  * @brief Enumeração dos tipos de comandos para o controle do processo.
@@ -83,7 +106,11 @@ struct DisplayCommand
 enum ControlCommandType
 {
   CMD_START_RECIPE_STEP, // Inicia uma nova etapa da receita com temperatura e duração alvos
-  CMD_ABORT_PROCESS      // Aborta o processo de cozimento em andamento
+  CMD_ABORT_PROCESS,     // Aborta o processo de cozimento em andamento
+  CMD_FINISH_PROCESS,    // Processo concluído (descarta o snapshot de retomada)
+  CMD_START_AUTOTUNE,    // Inicia o auto-tune do PID em targetTemperature (só sem etapa ativa)
+  CMD_CANCEL_AUTOTUNE,   // Interrompe o auto-tune mantendo os ganhos atuais
+  CMD_SHUTDOWN           // Desliga o aquecedor: encerra a etapa e o auto-tune (estado EXIT)
 };
 
 /**
@@ -96,6 +123,18 @@ struct ControlCommand
   int durationMinutes;     // Duração da etapa em minutos
   int recipeIndex;         // Índice da receita atual
   int stepIndex;           // Índice da etapa atual
+
+  // Retomada após queda de energia (CMD_START_RECIPE_STEP vindo do snapshot, ver BrewSnapshot.h)
+  bool resume;                  // true: continua a etapa em vez de iniciá-la do zero
+  uint32_t resumeElapsedMillis; // Tempo da etapa já cumprido antes da queda
+  bool resumeSetpointReached;   // Contagem da etapa já iniciada antes da queda
+  float resumePidIntegral;      // Integrador do PID no momento do snapshot
+
+  // Variáveis da receita personalizada lidas pela stateMachineTask ao enviar a etapa; a
+  // controlTask as repassa nos ControlRecord (snapshot e tela de status)
+  int customNumSteps;       // Número de etapas da receita personalizada
+  int currentCustomStepIdx; // Etapa personalizada atual
+  int receivedValue;        // Último valor digitado
 };
 
 // --- ESTRUTURAS DE DADOS PARA AS RECEITAS ---
@@ -104,9 +143,10 @@ struct ControlCommand
  */
 struct RecipeStep
 {
-  String name;     // Nome da etapa (ex: "Mostura", "Descanso de Proteína")
-  int temperature; // Temperatura da etapa em ºC
-  int duration;    // Duração da etapa em minutos
+  const char *name; // Nome da etapa (ex: "Mostura", "Descanso de Proteína")
+  int temperature;  // Temperatura da etapa em ºC
+  int duration;     // Duração da etapa em minutos
+  const PidTunings *gains; // Ganhos próprios da etapa (nullptr: tabela por setpoint, ver GainSchedule.h)
 };
 
 /**
@@ -114,7 +154,7 @@ struct RecipeStep
  */
 struct Recipe
 {
-  String name;         // Nome da receita (ex: "American Pale Ale")
+  const char *name;    // Nome da receita (ex: "American Pale Ale")
   int numSteps;        // Número total de etapas nesta receita
   RecipeStep steps[5]; // Array das etapas da receita (limite de 5 etapas)
 };
@@ -164,6 +204,8 @@ public:
   bool matrixOK = false;              // Flag para indicar se o teclado matricial foi inicializado com sucesso
   String inputBuffer = "";            // Buffer para armazenar a entrada digitada pelo teclado
   unsigned long lastKeyPressTime = 0; // Timestamp da última tecla pressionada (para timeout de buffer)
+  TaskHandle_t inputTask = nullptr;   // Tarefa que trata as teclas (stateMachineTask)
+  uint32_t inputMicros = 0;           // Instante da tecla em tratamento (0 fora do tratamento de uma tecla)
 
   // Variáveis para controle da receita e etapa atual em processamento
   // (Inicializadas em -1 para indicar que nenhuma receita está ativa)
@@ -227,7 +269,7 @@ public:
   void showStartup() override
   {
     DisplayCommand cmd = {CMD_SHOW_STARTUP_MESSAGE};
-    xQueueSend(xDisplayQueue, &cmd, portMAX_DELAY);
+    postDisplayCommand(cmd);
   }
 
   /**
@@ -239,7 +281,7 @@ public:
     Serial.println("Callback: Executando showRecipes() - Menu de Receitas");
     DisplayCommand cmd = {CMD_SHOW_RECIPES_LIST};
     cmd.clearScreen = true; // Sempre limpa para o menu principal de receitas
-    xQueueSend(xDisplayQueue, &cmd, portMAX_DELAY);
+    postDisplayCommand(cmd);
     inputBuffer = ""; // Limpa o buffer do teclado para a nova tela
   }
 
@@ -258,7 +300,7 @@ public:
       DisplayCommand cmd = {CMD_SHOW_RECIPE_DETAILS_SCREEN}; // Comando para detalhes da receita
       cmd.recipeId = recipeId - 1;                           // Ajusta para índice base 0 do array `recipes`
       cmd.clearScreen = true;                                // Sempre limpa para os detalhes da receita
-      xQueueSend(xDisplayQueue, &cmd, portMAX_DELAY);
+      postDisplayCommand(cmd);
     }
     else
     {
@@ -305,18 +347,24 @@ public:
       {
         const RecipeStep &step = recipe.steps[this->currentStepIdx];
         Serial.printf("Callback: INICIANDO ETAPA %d/%d: %s (Temp: %dC, Tempo: %dmin)\n",
-                      this->currentStepIdx + 1, recipe.numSteps, step.name.c_str(), step.temperature, step.duration);
+                      this->currentStepIdx + 1, recipe.numSteps, step.name, step.temperature, step.duration);
 
         ControlCommand controlCmd = {CMD_START_RECIPE_STEP};
         controlCmd.recipeIndex = this->currentRecipeIdx;
         controlCmd.stepIndex = this->currentStepIdx;
         controlCmd.targetTemperature = step.temperature;       // Passa a temperatura alvo
         controlCmd.durationMinutes = step.duration;            // Passa a duração
+        if (myStatechart != nullptr)
+        {
+          controlCmd.customNumSteps = myStatechart->getCustom_num_steps();
+          controlCmd.currentCustomStepIdx = myStatechart->getCurrent_custom_step_idx();
+          controlCmd.receivedValue = myStatechart->getReceived_value();
+        }
         xQueueSend(xControlQueue, &controlCmd, portMAX_DELAY); // Envia o comando para a ControlTask
 
         // Exibe o status inicial da etapa no display
         // Os valores de temperatura atual e tempo restante serão atualizados por uma tarefa de controle
-        showProcessStatus(0, step.temperature, step.duration, 0, const_cast<sc_string>(step.name.c_str()), this->currentStepIdx + 1, recipe.numSteps, true);
+        showProcessStatus(0, step.temperature, step.duration, 0, const_cast<sc_string>(step.name), this->currentStepIdx + 1, recipe.numSteps, true);
       }
       else
       {
@@ -378,35 +426,40 @@ public:
    * @param isRamping Indica se a etapa está em fase de rampa (esperando atingir o setpoint). // <--- NOVO PARÂMETRO
    */
   void showProcessStatus(sc_integer currentTemp, sc_integer targetTemp, sc_integer remainingMinutes, sc_integer remainingSeconds, sc_string stepName, sc_integer stepNum, sc_integer totalSteps, sc_boolean isRamping) override
+  {
+    showProcessStatusFor(currentRecipeIdx, currentTemp, targetTemp, remainingMinutes, remainingSeconds, stepName, stepNum, totalSteps, isRamping);
+  }
+
+  /**
+   * @brief Monta e envia a tela de status para uma receita dada, sem ler o estado do callback.
+   * @details Usado pela statusTask com os campos do ControlRecord: currentRecipeIdx pertence à
+   * stateMachineTask. Os demais parâmetros são os de showProcessStatus().
+   * @param recipeIdx Receita em andamento (índice em recipes[]).
+   */
+  void showProcessStatusFor(int recipeIdx, int currentTemp, int targetTemp, int remainingMinutes, int remainingSeconds, const char *stepName, int stepNum, int totalSteps, bool isRamping)
   {
     // Debug
     Serial.printf("Callback: Status Processo: Etapa %d/%d '%s' - Atual: %dC, Alvo: %dC. Tempo: %d:%02d (Rampa: %s)\n",
                   stepNum, totalSteps, stepName, currentTemp, targetTemp, remainingMinutes, remainingSeconds, isRamping ? "SIM" : "NAO");
 
+    HEAP_ALLOC_SCOPE(HEAP_SCOPE_DISPLAY_COMMAND);
     DisplayCommand cmd = {CMD_SHOW_PROCESS_STATUS_SCREEN};
-    cmd.clearScreen = true; // Sempre limpa para esta tela de status
-
-    // --- LÓGICA DE MONTAGEM DA STRING AGORA DENTRO DESTE CALLBACK ---
-    String statusMessage_part1 = "Receita: " + recipes[currentRecipeIdx].name;
-    String statusMessage_part2 = "Etapa " + String(stepNum) + "/" + String(totalSteps) + ": " + String(stepName);
-    String statusMessage_part3; // Linha da temperatura
-    String statusMessage_part4; // Linha do tempo ou rampa
+    cmd.clearScreen = false; // O desenho limpa só as linhas de texto: o gráfico das páginas 6 e 7 fica
 
+    // --- MONTAGEM DO TEXTO DIRETAMENTE NO BUFFER DO COMANDO (sem alocação) ---
+    // Linhas: receita, etapa, temperatura (rampa ou patamar) e tempo restante
+    const char *recipeName = (recipeIdx >= 0 && recipeIdx < NUM_RECIPES) ? recipes[recipeIdx].name : "-";
     if (isRamping)
     { // Se está em fase de rampa
-      statusMessage_part3 = "Rampa: " + String(currentTemp) + "C / " + String(targetTemp) + "C";
-      statusMessage_part4 = "Aguardando Setpoint...";
+      snprintf(cmd.text, sizeof(cmd.text), "Receita: %s\nEtapa %d/%d: %s\nRampa: %dC / %dC\nAguardando Setpoint...",
+               recipeName, stepNum, totalSteps, stepName, currentTemp, targetTemp);
     }
     else
     { // Se atingiu o setpoint, mostra temp e tempo
-      statusMessage_part3 = "Temp: " + String(currentTemp) + "C / " + String(targetTemp) + "C";
-      char timeBuffer[10];
-      sprintf(timeBuffer, "%d m %02d s", remainingMinutes, remainingSeconds);
-      statusMessage_part4 = "Tempo: " + String(timeBuffer);
+      snprintf(cmd.text, sizeof(cmd.text), "Receita: %s\nEtapa %d/%d: %s\nTemp: %dC / %dC\nTempo: %d m %02d s",
+               recipeName, stepNum, totalSteps, stepName, currentTemp, targetTemp, remainingMinutes, remainingSeconds);
     }
-
-    cmd.text = statusMessage_part1 + "\n" + statusMessage_part2 + "\n" + statusMessage_part3 + "\n" + statusMessage_part4;
-    xQueueSend(xDisplayQueue, &cmd, portMAX_DELAY); // Envia para a displayTask
+    postDisplayCommand(cmd); // Envia para a displayTask
   }
 
   /**
@@ -418,15 +471,24 @@ public:
     Serial.println("Callback: Processo de cozimento finalizado. Desligando atuadores.");
     // Após desligar os atuadores, disparar o evento finished_process
     // para a máquina de estados transitar para FINISHED_MESSAGE
-    if (myStatechart != nullptr)
-    {
-      myStatechart->raiseFinished_process();
-    }
-    else
+    // (publicado na fila de entrada; processado pela stateMachineTask após o ciclo atual).
+    // Sem espera: este callback roda na stateMachineTask, a única que esvazia a fila, e esperar
+    // por espaço nunca terminaria. Com a fila cheia o descarte é contado pelo ingress e o evento
+    // vai para a fila interna da statechart, consumida ainda neste run cycle; sem isso o processo
+    // ficaria parado no FINISH_PROCESS.
+    if (!statechartIngress.postEvent(statechart_events::finished_process, INGRESS_FROM_CALLBACK, 0))
     {
-      Serial.println("Callback: Erro: myStatechart é nullptr em showFinished!");
+      Serial.println("Callback: ERRO! Fila de entrada cheia; finished_process entregue direto a statechart.");
+      if (myStatechart != nullptr)
+      {
+        myStatechart->raiseFinished_process();
+      }
     }
 
+    // Processo concluído: a controlTask descarta o snapshot de retomada
+    ControlCommand controlCmd = {CMD_FINISH_PROCESS};
+    xQueueSend(xControlQueue, &controlCmd, portMAX_DELAY);
+
     // Resetar índices de receita/etapa após o fim do processo
     currentRecipeIdx = -1;
     currentStepIdx = -1;
@@ -441,7 +503,7 @@ public:
     Serial.println("Callback: Exibindo mensagem 'Receita concluída'.");
     DisplayCommand cmd = {CMD_SHOW_FINISHED_MESSAGE_SCREEN};
     cmd.clearScreen = true; // Limpa a tela para exibir a mensagem final
-    xQueueSend(xDisplayQueue, &cmd, portMAX_DELAY);
+    postDisplayCommand(cmd);
   }
 
   /**
@@ -454,13 +516,15 @@ public:
     Serial.print("Callback: Estado atual: ");
     Serial.println(state);
     // Envia comando para a displayTask para mostrar o nome do estado
-    DisplayCommand cmd = {CMD_SHOW_STATE_INFO, String(state)};
+    HEAP_ALLOC_SCOPE(HEAP_SCOPE_DISPLAY_COMMAND);
+    DisplayCommand cmd = {CMD_SHOW_STATE_INFO};
+    cmd.setText(state);
     cmd.clearScreen = false; // Não limpa a tela inteira, apenas a linha superior é reescrita
-    xQueueSend(xDisplayQueue, &cmd, portMAX_DELAY);
+    postDisplayCommand(cmd);
   }
 
   /**
-   * @brief Exibe a tela inicial de IDLE ("Bem-vindo!", "1- Iniciar", "2- Sair").
+   * @brief Exibe a tela inicial de IDLE ("Bem-vindo!", "1- Iniciar", "2- Sair", "3- Auto-tune PID").
    * Chamado pelo estado IDLE do Itemis.
    */
   void showIdleScreen() override
@@ -468,7 +532,7 @@ public:
     Serial.println("Callback: Exibindo tela de IDLE");
     DisplayCommand cmd = {CMD_SHOW_MAIN_MENU_SCREEN};
     cmd.clearScreen = true; // Sempre limpa para esta tela
-    xQueueSend(xDisplayQueue, &cmd, portMAX_DELAY);
+    postDisplayCommand(cmd);
   }
 
   /**
@@ -494,6 +558,26 @@ public:
     }
   }
 
+  /**
+   * @brief Reinicializa os periféricos ao retomar um processo após queda de energia.
+   * @details A retomada não executa as ações de entrada de IDLE, INIT_SYSTEM e STANDARD_PROCESS,
+   * então este método refaz o que elas configuram (teclado, semáforo e LED); o PWM do aquecedor
+   * já é configurado no setup().
+   */
+  void resumeHardware()
+  {
+    Serial.println("Callback: Reinicializando perifericos para retomar o processo.");
+    beginDisplay();
+    beginMatrix();
+    beginSemaphore();
+    if (myStatechart != nullptr)
+    {
+      pinMode(myStatechart->getLed_pin(), myStatechart->getOutput());
+      digitalWrite(myStatechart->getLed_pin(), myStatechart->getLow());               // Como na entrada do MENU
+      digitalWrite(myStatechart->getSemaphore_yellow_pin(), myStatechart->getHigh()); // Como na entrada do STANDARD_PROCESS
+    }
+  }
+
   // --- FUNÇÕES AUXILIARES PARA GERENCIAMENTO DE ENTRADA DO TECLADO E DISPLAY ---
   /**
    * @brief Lê uma tecla do teclado matricial.
@@ -517,8 +601,10 @@ public:
   {
     if (inputBuffer.length() > 0)
     {
-      DisplayCommand printCmd = {CMD_PRINT_KEYPAD_INPUT, "Digitado: " + inputBuffer};
-      xQueueSend(xDisplayQueue, &printCmd, portMAX_DELAY);
+      HEAP_ALLOC_SCOPE(HEAP_SCOPE_DISPLAY_COMMAND);
+      DisplayCommand printCmd = {CMD_PRINT_KEYPAD_INPUT};
+      snprintf(printCmd.text, sizeof(printCmd.text), "Digitado: %s", inputBuffer.c_str());
+      postDisplayCommand(printCmd);
     }
   }
 
@@ -589,6 +675,20 @@ public:
     }
   }
 
+  /**
+   * @brief Envia uma amostra de temperatura para o gráfico da tela de processo.
+   * Chamado pela controlTask junto com showProcessStatus (uma vez por segundo).
+   * @param temperature Temperatura medida (°C).
+   * @param targetTemp Setpoint da etapa (°C).
+   */
+  void showTemperatureSample(float temperature, sc_integer targetTemp)
+  {
+    DisplayCommand cmd = {CMD_PLOT_TEMPERATURE_SAMPLE};
+    cmd.sample.temperature = (int16_t)lroundf(temperature * 10);
+    cmd.sample.setpoint = (int16_t)(targetTemp * 10);
+    postDisplayCommand(cmd);
+  }
+
   /**
    * @brief Controla o aquecedor através do sinal PWM.
    * Esta função é chamada pela operação 'heat' do Itemis e pela 'controlTask'.
@@ -649,8 +749,20 @@ public:
     // Nenhuma ação específica aqui para o sensor de temperatura simulado via I2C
   }
 
+  /**
+   * @brief Desliga o aquecedor ao entrar no estado EXIT.
+   * @details O PWM é zerado aqui mesmo; o CMD_SHUTDOWN faz a controlTask (dona do PID, da etapa e
+   * do auto-tune) parar de acioná-lo a partir do próximo período.
+   */
+  void shutdownSystem() override
+  {
+    controlHeaterPWM(0);
+    ControlCommand controlCmd = {CMD_SHUTDOWN};
+    xQueueSend(xControlQueue, &controlCmd, portMAX_DELAY);
+    Serial.println("Callback: shutdownSystem() - aquecedor desligado.");
+  }
+
   // --- MÉTODOS DE CALLBACK PARA FUNÇÕES AINDA NÃO IMPLEMENTADAS OU SIMPLES ---
-  void shutdownSystem() override {}
   void time(sc_integer) override {}
   void setTemperature(sc_integer) override {}
   void setTime(sc_integer) override {}
@@ -671,6 +783,18 @@ public:
   void showCustomSetup_Summary() override {}
 
 private:
+  /**
+   * @brief Envia um comando para a displayTask.
+   * @details Comandos gerados pela stateMachineTask durante o tratamento de uma tecla levam o
+   * instante da tecla, para a medição da latência tecla -> tela (FramePacer). Os da controlTask
+   * (status periódico) não vêm de uma tecla.
+   */
+  void postDisplayCommand(DisplayCommand &cmd)
+  {
+    cmd.inputMicros = (xTaskGetCurrentTaskHandle() == inputTask) ? inputMicros : 0;
+    xQueueSend(xDisplayQueue, &cmd, portMAX_DELAY);
+  }
+
   Statechart *myStatechart = nullptr; // Ponteiro para a instância da Statechart
 };
 
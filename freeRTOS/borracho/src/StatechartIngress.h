@@ -0,0 +1,245 @@
+/**
+ * @file StatechartIngress.h
+ * @brief Fila única de entrada (MPSC) para todos os eventos da máquina de estados.
+ * @details Todos os produtores (keypadTask, controlTask, callbacks e o serviço de timer)
+ * publicam suas mensagens nesta fila FreeRTOS. Apenas a stateMachineTask consome a fila
+ * e executa os ciclos da Statechart, de modo que a fila interna de eventos gerada pelo
+ * Itemis nunca é acessada por mais de uma tarefa ao mesmo tempo.
+ * Cada mensagem carrega o produtor, um número de sequência por produtor e o instante
+ * da publicação, permitindo medir a latência até o processamento e provar que nenhuma
+ * mensagem foi perdida ou reordenada (exato para produtores que publicam de uma única tarefa).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef STATECHARTINGRESS_H
+#define STATECHARTINGRESS_H
+
+// Includes do projeto
+#include "src-gen/Statechart.h"
+#include <Arduino.h>
+
+// FreeRTOS Headers
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+// Tamanho padrão da fila de entrada da máquina de estados
+#define INGRESS_QUEUE_LENGTH 16
+
+/**
+ * @brief Tipos de mensagem aceitos pela fila de entrada.
+ */
+enum IngressMessageType
+{
+  INGRESS_KEY,       ///< Tecla lida do teclado matricial
+  INGRESS_EVENT,     ///< Evento de entrada da Statechart (raise*)
+  INGRESS_TIME_EVENT ///< Há eventos de tempo pendentes no serviço de timer (StatechartTimer)
+};
+
+/**
+ * @brief Identificação do produtor de cada mensagem (usada nas estatísticas).
+ */
+enum IngressProducer
+{
+  INGRESS_FROM_KEYPAD,   ///< keypadTask
+  INGRESS_FROM_CONTROL,  ///< controlTask
+  INGRESS_FROM_CALLBACK, ///< Callbacks da Statechart (ex: showFinished)
+  INGRESS_FROM_TIMER,    ///< Serviço de timer (StatechartTimer)
+  INGRESS_PRODUCER_COUNT
+};
+
+/**
+ * @brief Mensagem trafegada pela fila de entrada (POD, copiada byte a byte pelo FreeRTOS).
+ */
+struct IngressMessage
+{
+  IngressMessageType type;                   // Tipo da mensagem
+  IngressProducer producer;                  // Quem publicou a mensagem
+  char key;                                  // Tecla (INGRESS_KEY)
+  statechart_events::StatechartEventName event; // Evento de entrada (INGRESS_EVENT)
+  uint32_t sequence;                         // Número de sequência por produtor
+  uint32_t postedAtMicros;                   // Instante da publicação (micros())
+};
+
+/**
+ * @brief Fila de entrada multi-produtor / consumidor único da máquina de estados.
+ */
+class StatechartIngress
+{
+public:
+  /**
+   * @brief Cria a fila FreeRTOS.
+   * @param length Número máximo de mensagens pendentes.
+   * @return true se a fila foi criada com sucesso.
+   */
+  bool begin(UBaseType_t length = INGRESS_QUEUE_LENGTH)
+  {
+    queue = xQueueCreate(length, sizeof(IngressMessage));
+    return queue != NULL;
+  }
+
+  /**
+   * @brief Publica uma tecla lida do teclado.
+   * @param key Caractere da tecla.
+   * @param ticksToWait Tempo máximo de espera caso a fila esteja cheia.
+   */
+  bool postKey(char key, TickType_t ticksToWait = portMAX_DELAY)
+  {
+    IngressMessage msg = makeMessage(INGRESS_KEY, INGRESS_FROM_KEYPAD);
+    msg.key = key;
+    return send(msg, ticksToWait);
+  }
+
+  /**
+   * @brief Publica um evento de entrada da Statechart.
+   * @param event Nome do evento (statechart_events::StatechartEventName).
+   * @param producer Produtor que está publicando.
+   * @param ticksToWait Tempo máximo de espera caso a fila esteja cheia.
+   */
+  bool postEvent(statechart_events::StatechartEventName event, IngressProducer producer, TickType_t ticksToWait = portMAX_DELAY)
+  {
+    IngressMessage msg = makeMessage(INGRESS_EVENT, producer);
+    msg.event = event;
+    return send(msg, ticksToWait);
+  }
+
+  /**
+   * @brief Acorda a stateMachineTask para os eventos de tempo pendentes. Não bloqueia (chamado a
+   * partir do contexto do timer).
+   * @details As expirações ficam no StatechartTimer e são entregues por dispatchExpired(), que a
+   * stateMachineTask chama depois de cada mensagem: com a fila cheia este aviso é descartado
+   * (e contado), mas nenhum evento de tempo se perde.
+   */
+  bool postTimeEvent()
+  {
+    return send(makeMessage(INGRESS_TIME_EVENT, INGRESS_FROM_TIMER), 0);
+  }
+
+  /**
+   * @brief Recebe a próxima mensagem. Deve ser chamada apenas pela stateMachineTask.
+   * @param msg Mensagem recebida.
+   * @param ticksToWait Tempo máximo de espera.
+   */
+  bool receive(IngressMessage &msg, TickType_t ticksToWait)
+  {
+    return xQueueReceive(queue, &msg, ticksToWait) == pdPASS;
+  }
+
+  /**
+   * @brief Registra o processamento de uma mensagem e atualiza as estatísticas.
+   * @details Calcula a latência entre a publicação e o processamento e verifica se a
+   * sequência do produtor é contínua. Uma regressão indica reordenação; uma lacuna indica
+   * mensagem que não chegou ao consumidor. Como a mensagem descartada por fila cheia também
+   * consome um número de sequência, o total de lacunas deve ser igual ao de descartes. Vale para
+   * produtores de uma única tarefa (keypadTask, controlTask, timer); INGRESS_FROM_CALLBACK vindo de
+   * duas tarefas pode acusar reordenação sem que a fila tenha reordenado nada (ver send()).
+   * @param msg Mensagem já processada pela máquina de estados.
+   */
+  void markProcessed(const IngressMessage &msg)
+  {
+    uint32_t latency = micros() - msg.postedAtMicros;
+    processed++;
+    latencySumMicros += latency;
+    if (latency > latencyMaxMicros)
+    {
+      latencyMaxMicros = latency;
+    }
+
+    uint32_t expected = lastProcessedSequence[msg.producer] + 1;
+    if (msg.sequence < expected)
+    {
+      reordered++;
+    }
+    else if (msg.sequence > expected)
+    {
+      gaps += msg.sequence - expected;
+    }
+    lastProcessedSequence[msg.producer] = msg.sequence;
+  }
+
+  /**
+   * @brief Imprime as estatísticas da fila de entrada.
+   * @param out Destino da impressão (ex: Serial).
+   */
+  void printStats(Print &out)
+  {
+    uint32_t published[INGRESS_PRODUCER_COUNT];
+    uint32_t discarded[INGRESS_PRODUCER_COUNT];
+    portENTER_CRITICAL_SAFE(&producerMux);
+    memcpy(published, sequence, sizeof(published));
+    memcpy(discarded, dropped, sizeof(discarded));
+    portEXIT_CRITICAL_SAFE(&producerMux);
+
+    out.printf("Ingress: processados=%lu lacunas=%lu reordenados=%lu\n",
+               (unsigned long)processed, (unsigned long)gaps, (unsigned long)reordered);
+    for (int p = 0; p < INGRESS_PRODUCER_COUNT; ++p)
+    {
+      out.printf("Ingress: produtor %d publicados=%lu descartados=%lu\n",
+                 p, (unsigned long)published[p], (unsigned long)discarded[p]);
+    }
+    out.printf("Ingress: latencia media=%lu us max=%lu us\n",
+               (unsigned long)(processed ? latencySumMicros / processed : 0), (unsigned long)latencyMaxMicros);
+  }
+
+private:
+  /**
+   * @brief Monta a mensagem com produtor, o próximo número de sequência desse produtor e timestamp.
+   * @details Só o incremento de sequence[] fica na seção crítica (um mesmo produtor lógico, como
+   * INGRESS_FROM_CALLBACK, pode publicar de tarefas diferentes e nenhum número se repete). A
+   * mensagem ainda não está na fila: a ordem de chegada é decidida em send().
+   * @param type Tipo da mensagem.
+   * @param producer Produtor que terá a sequência incrementada.
+   */
+  IngressMessage makeMessage(IngressMessageType type, IngressProducer producer)
+  {
+    IngressMessage msg = {};
+    msg.type = type;
+    msg.producer = producer;
+    portENTER_CRITICAL_SAFE(&producerMux);
+    msg.sequence = ++sequence[producer];
+    portEXIT_CRITICAL_SAFE(&producerMux);
+    msg.postedAtMicros = micros();
+    return msg;
+  }
+
+  /**
+   * @brief Envia a mensagem para a fila; se não couber em ticksToWait, conta o descarte em dropped[].
+   * @details xQueueSend() roda fora da seção crítica de makeMessage() (pode bloquear). Duas tarefas
+   * publicando pelo mesmo produtor podem ser preemptadas entre as duas chamadas e enfileirar as
+   * sequências trocadas; markProcessed() conta isso como reordenação e lacuna, mesmo sem mensagem
+   * perdida. O controle de ordem só é exato para produtores que publicam de uma única tarefa.
+   * @return true se a mensagem entrou na fila.
+   */
+  bool send(const IngressMessage &msg, TickType_t ticksToWait)
+  {
+    if (xQueueSend(queue, &msg, ticksToWait) != pdPASS)
+    {
+      portENTER_CRITICAL_SAFE(&producerMux);
+      dropped[msg.producer]++;
+      portEXIT_CRITICAL_SAFE(&producerMux);
+      return false;
+    }
+    return true;
+  }
+
+  QueueHandle_t queue = NULL;
+  portMUX_TYPE producerMux = portMUX_INITIALIZER_UNLOCKED; // Protege sequence[] e dropped[]
+
+  // Estatísticas dos produtores (escritas por várias tarefas, sempre sob producerMux)
+  uint32_t sequence[INGRESS_PRODUCER_COUNT] = {};
+  uint32_t dropped[INGRESS_PRODUCER_COUNT] = {};
+
+  // Estatísticas do consumidor (atualizadas apenas pela stateMachineTask)
+  uint32_t lastProcessedSequence[INGRESS_PRODUCER_COUNT] = {};
+  uint32_t processed = 0;
+  uint32_t gaps = 0;
+  uint32_t reordered = 0;
+  uint64_t latencySumMicros = 0;
+  uint32_t latencyMaxMicros = 0;
+};
+
+// --- FILA DE ENTRADA GLOBAL ---
+extern StatechartIngress statechartIngress; // Definida em main.cpp
+
+#endif // STATECHARTINGRESS_H
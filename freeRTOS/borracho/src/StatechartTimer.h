@@ -3,42 +3,88 @@
 #define STATECHARTTIMER_H
 
 #include "src-gen/Statechart.h"
-#include <Ticker.h> 
+#include "StatechartIngress.h"
+#include "TimerWheel.h"
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/timers.h"
+
+// Timer service backed by a timer wheel: every parallel time event gets its own
+// slot, and a single periodic FreeRTOS timer advances the wheel. Expirations stay
+// pending in the wheel (one bit per timer, never dropped); the tick only posts a
+// wake-up to the ingress queue and stateMachineTask raises them with
+// dispatchExpired(), so the state machine only runs in that task. If the queue is
+// full the wake-up is dropped, but the task is then busy with queued messages and
+// drains the pending expirations after each of them.
 class StatechartTimer : public sc::timer::TimerServiceInterface {
 public:
-  StatechartTimer() {
-    instance = this;
+  // create and start the periodic tick (call once from setup)
+  bool begin() {
+    tickTimer = xTimerCreate("ScTimerWheel", pdMS_TO_TICKS(TIMER_WHEEL_TICK_MS), pdTRUE, this, onTick);
+    return tickTimer != NULL && xTimerStart(tickTimer, 0) == pdPASS;
   }
   void setTimer(sc::timer::TimedInterface* sm, sc_eventid event, sc_time time_ms, sc_boolean isPeriodic) override {
-    // store context
-    this->sm = sm;
-    this->eventId = event;
-    // detach any previous
-    ticker.detach();
-    // use static callback
-    if (isPeriodic) {
-      ticker.attach_ms((uint32_t)time_ms, onTimeout);
-    } else {
-      ticker.once_ms((uint32_t)time_ms, onTimeout);
+    portENTER_CRITICAL(&wheelMux);
+    wheel.arm(sm, event, TimerWheel::msToTicks(time_ms), isPeriodic);
+    portEXIT_CRITICAL(&wheelMux);
+  }
+  void unsetTimer(sc::timer::TimedInterface* /*sm*/, sc_eventid event) override {
+    portENTER_CRITICAL(&wheelMux);
+    wheel.cancel(event);
+    portEXIT_CRITICAL(&wheelMux);
+  }
+  int getActiveCount() {
+    portENTER_CRITICAL(&wheelMux);
+    int count = wheel.getActiveCount();
+    portEXIT_CRITICAL(&wheelMux);
+    return count;
+  }
+  // runs in stateMachineTask: raises every pending expiration whose timer was not
+  // cancelled or re-armed since the tick (generation check in takeExpired)
+  int dispatchExpired() {
+    int count = 0;
+    TimerExpiration expired;
+    for (;;) {
+      portENTER_CRITICAL(&wheelMux);
+      bool valid = wheel.takeExpired(expired);
+      portEXIT_CRITICAL(&wheelMux);
+      if (!valid) {
+        return count;
+      }
+      // outside the critical section: the run cycle arms and cancels timers
+      expired.sm->raiseTimeEvent(expired.event);
+      count++;
     }
   }
-  void unsetTimer(sc::timer::TimedInterface* /*sm*/, sc_eventid /*event*/) override {
-    ticker.detach();
+  // armed timers, refused arms, stale/coalesced expirations and the wheel clock
+  // (printed with the log, key '*' in IDLE)
+  void printStats(Print& out) {
+    int active = getActiveCount();
+    portENTER_CRITICAL(&wheelMux);
+    uint32_t overflows = wheel.getOverflowCount();
+    uint32_t stale = wheel.getStaleCount();
+    uint32_t coalesced = wheel.getCoalescedCount();
+    uint32_t now = wheel.getNow();
+    portEXIT_CRITICAL(&wheelMux);
+    out.printf("Timers: %d armados, %lu recusados, %lu expiracoes obsoletas, %lu somadas, relogio=%lu ticks de %d ms\n",
+               active, (unsigned long)overflows, (unsigned long)stale, (unsigned long)coalesced,
+               (unsigned long)now, TIMER_WHEEL_TICK_MS);
   }
 private:
-  static void onTimeout() {
-    if (instance && instance->sm) {
-      instance->sm->raiseTimeEvent(instance->eventId);
+  // runs in the FreeRTOS timer daemon task
+  static void onTick(TimerHandle_t handle) {
+    StatechartTimer* self = static_cast<StatechartTimer*>(pvTimerGetTimerID(handle));
+    portENTER_CRITICAL(&self->wheelMux);
+    int count = self->wheel.tick();
+    portEXIT_CRITICAL(&self->wheelMux);
+    // wake stateMachineTask outside the critical section (the expirations stay pending)
+    if (count > 0) {
+      statechartIngress.postTimeEvent();
     }
   }
-  static StatechartTimer* instance;
-  sc::timer::TimedInterface* sm = nullptr;
-  sc_eventid eventId = 0;
-  Ticker ticker;
+  TimerWheel wheel;
+  portMUX_TYPE wheelMux = portMUX_INITIALIZER_UNLOCKED;
+  TimerHandle_t tickTimer = NULL;
 };
 
-// define static instance pointer
-StatechartTimer* StatechartTimer::instance = nullptr;
-
-#endif // STATECHARTTIMER_H
\ No newline at end of file
+#endif // STATECHARTTIMER_H
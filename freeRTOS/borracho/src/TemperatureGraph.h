@@ -0,0 +1,211 @@
+/**
+ * @file TemperatureGraph.h
+ * @brief Gráfico rolante de temperatura e setpoint nas duas últimas páginas do display.
+ * @details A controlTask envia uma amostra por segundo (CMD_PLOT_TEMPERATURE_SAMPLE), guardada em
+ * um buffer circular de SCREEN_WIDTH amostras (uma por coluna). O gráfico ocupa as páginas 6 e 7
+ * (16 linhas) da tela de processo, abaixo das quatro linhas de texto. Com o gráfico na tela, cada
+ * amostra nova desloca as colunas uma posição para a esquerda direto no framebuffer (memmove das
+ * duas páginas) e desenha só a coluna mais nova; o gráfico inteiro só é redesenhado quando volta
+ * à tela ou quando uma amostra sai da escala atual. Como o desenho muda só as páginas do gráfico,
+ * o DirtyPageFlusher envia apenas essas páginas (mais a linha de texto que mudou).
+ * O framebuffer tem o formato do SSD1306 (bit 0 = linha de cima da página), o mesmo do
+ * HeadlessDisplay.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef TEMPERATUREGRAPH_H
+#define TEMPERATUREGRAPH_H
+
+// Includes do projeto
+#include <Arduino.h>
+
+// --- PARÂMETROS DO GRÁFICO ---
+#define TEMP_GRAPH_WIDTH 128     // Colunas (= SCREEN_WIDTH), uma amostra por coluna
+#define TEMP_GRAPH_FIRST_PAGE 6  // Primeira página do gráfico (linha 48)
+#define TEMP_GRAPH_TOP (TEMP_GRAPH_FIRST_PAGE * 8)
+#define TEMP_GRAPH_HEIGHT 16     // Duas páginas
+#define TEMP_GRAPH_PAGES_MASK 0xC0
+#define TEMP_GRAPH_MIN_SPAN 20   // Faixa mínima da escala: 2,0 °C (em décimos)
+#define TEMP_GRAPH_MARGIN 10     // Folga acima e abaixo das amostras ao refazer a escala: 1,0 °C
+
+/**
+ * @brief Amostra do gráfico (décimos de °C).
+ */
+struct TemperatureSample
+{
+  int16_t temperature; // Temperatura medida
+  int16_t setpoint;    // Setpoint da etapa
+};
+
+/**
+ * @brief Buffer circular de amostras e desenho incremental do gráfico.
+ * @details Usado só pela displayTask.
+ */
+class TemperatureGraph
+{
+public:
+  /**
+   * @brief Guarda uma amostra sem desenhar (ex: comando coalescido por uma tela posterior).
+   */
+  void push(const TemperatureSample &sample)
+  {
+    samples[head] = sample;
+    head = (head + 1) % TEMP_GRAPH_WIDTH;
+    pushed++;
+    if (count < TEMP_GRAPH_WIDTH)
+      count++;
+  }
+
+  /**
+   * @brief Guarda uma amostra e a desenha.
+   * @param framebuffer Framebuffer do display.
+   * @details Com o gráfico na tela e a amostra dentro da escala, só desloca as colunas e desenha a
+   * nova; caso contrário redesenha tudo.
+   */
+  void plot(const TemperatureSample &sample, uint8_t *framebuffer)
+  {
+    push(sample);
+    if (!onScreen || !inScale(sample))
+    {
+      draw(framebuffer);
+      return;
+    }
+    for (uint8_t page = 0; page < TEMP_GRAPH_HEIGHT / 8; ++page)
+    {
+      uint8_t *row = framebuffer + (TEMP_GRAPH_FIRST_PAGE + page) * TEMP_GRAPH_WIDTH;
+      memmove(row, row + 1, TEMP_GRAPH_WIDTH - 1);
+    }
+    writeColumn(framebuffer, TEMP_GRAPH_WIDTH - 1, count - 1);
+    incrementalDraws++;
+  }
+
+  /**
+   * @brief Redesenha o gráfico inteiro se ele não está na tela (chamado pela tela de processo).
+   */
+  void show(uint8_t *framebuffer)
+  {
+    if (!onScreen)
+    {
+      draw(framebuffer);
+    }
+  }
+
+  /**
+   * @brief Marca que outro comando desenhou sobre as páginas do gráfico.
+   */
+  void invalidate()
+  {
+    onScreen = false;
+  }
+
+  /**
+   * @brief Imprime quantas amostras foram desenhadas de forma incremental e quantas vezes o gráfico foi refeito.
+   */
+  void printStats(Print &out)
+  {
+    out.printf("Grafico: %u amostras, %lu colunas incrementais, %lu redesenhos completos, escala %d..%d (decimos de C)\n",
+               (unsigned)count, (unsigned long)incrementalDraws, (unsigned long)fullDraws, lo, hi);
+  }
+
+private:
+  // Redesenha todas as colunas com uma escala nova (amostras alinhadas à direita)
+  void draw(uint8_t *framebuffer)
+  {
+    rescale();
+    for (uint8_t x = 0; x < TEMP_GRAPH_WIDTH; ++x)
+    {
+      int16_t age = TEMP_GRAPH_WIDTH - 1 - x; // 0 = amostra mais nova
+      if (age >= count)
+      {
+        framebuffer[TEMP_GRAPH_FIRST_PAGE * TEMP_GRAPH_WIDTH + x] = 0;
+        framebuffer[(TEMP_GRAPH_FIRST_PAGE + 1) * TEMP_GRAPH_WIDTH + x] = 0;
+        continue;
+      }
+      writeColumn(framebuffer, x, count - 1 - age);
+    }
+    onScreen = true;
+    fullDraws++;
+  }
+
+  // Escala que cobre todas as amostras guardadas, com folga, em graus inteiros
+  void rescale()
+  {
+    int16_t minValue = INT16_MAX;
+    int16_t maxValue = INT16_MIN;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+      const TemperatureSample &s = at(i);
+      minValue = min(minValue, min(s.temperature, s.setpoint));
+      maxValue = max(maxValue, max(s.temperature, s.setpoint));
+    }
+    if (count == 0)
+    {
+      minValue = maxValue = 0;
+    }
+    lo = floorDegree(minValue - TEMP_GRAPH_MARGIN);
+    hi = lo + TEMP_GRAPH_MIN_SPAN;
+    if (maxValue + TEMP_GRAPH_MARGIN > hi)
+      hi = -floorDegree(-(maxValue + TEMP_GRAPH_MARGIN));
+  }
+
+  static int16_t floorDegree(int16_t tenths)
+  {
+    return tenths >= 0 ? tenths / 10 * 10 : -((-tenths + 9) / 10 * 10);
+  }
+
+  bool inScale(const TemperatureSample &s) const
+  {
+    return s.temperature >= lo && s.temperature <= hi && s.setpoint >= lo && s.setpoint <= hi;
+  }
+
+  // Linha (0 = topo do gráfico) de um valor na escala atual
+  uint8_t rowFor(int16_t value) const
+  {
+    int32_t row = (int32_t)(hi - value) * (TEMP_GRAPH_HEIGHT - 1) / (hi - lo);
+    return row < 0 ? 0 : (row > TEMP_GRAPH_HEIGHT - 1 ? TEMP_GRAPH_HEIGHT - 1 : row);
+  }
+
+  // Desenha a coluna x com a amostra de índice i (0 = mais antiga): setpoint pontilhado e
+  // temperatura ligada à amostra anterior por um traço vertical
+  void writeColumn(uint8_t *framebuffer, uint8_t x, uint8_t i)
+  {
+    const TemperatureSample &s = at(i);
+    uint16_t column = 0;
+    if (((pushed - count + i) & 1) == 0) // Pontilhado preso à amostra, não à coluna: acompanha o deslocamento
+      column |= 1 << rowFor(s.setpoint);
+    uint8_t row = rowFor(s.temperature);
+    uint8_t from = row;
+    uint8_t to = row;
+    if (i > 0)
+    {
+      uint8_t previous = rowFor(at(i - 1).temperature);
+      from = min(row, previous);
+      to = max(row, previous);
+    }
+    for (uint8_t r = from; r <= to; ++r)
+      column |= 1 << r;
+    framebuffer[TEMP_GRAPH_FIRST_PAGE * TEMP_GRAPH_WIDTH + x] = column & 0xFF;
+    framebuffer[(TEMP_GRAPH_FIRST_PAGE + 1) * TEMP_GRAPH_WIDTH + x] = column >> 8;
+  }
+
+  // Amostra de índice i (0 = mais antiga guardada)
+  const TemperatureSample &at(uint8_t i) const
+  {
+    return samples[(head + TEMP_GRAPH_WIDTH - count + i) % TEMP_GRAPH_WIDTH];
+  }
+
+  TemperatureSample samples[TEMP_GRAPH_WIDTH]; // Buffer circular
+  uint8_t head = 0;                            // Próxima posição a escrever
+  uint8_t count = 0;                           // Amostras guardadas
+  uint32_t pushed = 0;                         // Amostras recebidas desde o boot
+  bool onScreen = false;                       // O framebuffer mostra o gráfico atual
+  int16_t lo = 0;                              // Escala atual (décimos de °C)
+  int16_t hi = TEMP_GRAPH_MIN_SPAN;
+
+  uint32_t incrementalDraws = 0; // Amostras desenhadas só com o deslocamento de colunas
+  uint32_t fullDraws = 0;        // Redesenhos completos
+};
+
+#endif // TEMPERATUREGRAPH_H
@@ -0,0 +1,328 @@
+/**
+ * @file TimerWheel.h
+ * @brief Roda de temporização (timer wheel) para os eventos de tempo da máquina de estados.
+ * @details Mantém vários timers simultâneos (um por evento de tempo ativo) com armar e
+ * cancelar em O(1). A roda não depende do Arduino nem do FreeRTOS: o relógio é virtual e
+ * avança apenas quando `tick()` é chamado. No firmware, um único timer periódico do FreeRTOS
+ * chama `tick()`; no host, basta chamar `tick()` em laço para simular a passagem do tempo.
+ * As expirações não saem de `tick()`: cada timer expirado ganha um bit no conjunto de pendentes,
+ * retirado depois por `takeExpired()` na tarefa que despacha os eventos. Um pendente nunca se perde
+ * (não há fila a encher); duas expirações de um timer periódico ainda não retiradas viram uma só.
+ * Cada timer tem uma geração, incrementada ao armar e ao cancelar: uma expiração só é entregue se
+ * o timer não foi cancelado nem rearmado desde o tick, então um timer cancelado na saída de um
+ * estado não dispara no estado reentrado. Um timer de disparo único continua ocupando sua posição
+ * até a expiração ser retirada, para que o cancelamento ainda o encontre.
+ * A classe não é thread-safe; quem a utiliza deve protegê-la (ver StatechartTimer).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include "src-gen/sc_types.h"
+#include "src-gen/sc_timer.h"
+
+// --- PARÂMETROS DA RODA ---
+#ifndef TIMER_WHEEL_SLOTS
+#define TIMER_WHEEL_SLOTS 64 // Número de posições da roda (potência de 2)
+#endif
+#ifndef TIMER_WHEEL_MAX_TIMERS
+#define TIMER_WHEEL_MAX_TIMERS 8 // Número máximo de timers armados ao mesmo tempo
+#endif
+#ifndef TIMER_WHEEL_TICK_MS
+#define TIMER_WHEEL_TICK_MS 10 // Resolução de um tick em milissegundos
+#endif
+
+static_assert(TIMER_WHEEL_MAX_TIMERS <= 32, "um bit por timer no conjunto de pendentes");
+
+/**
+ * @brief Expiração retirada por `TimerWheel::takeExpired()`, entregue fora da seção crítica.
+ */
+struct TimerExpiration
+{
+  sc::timer::TimedInterface *sm; // Máquina de estados dona do evento
+  sc_eventid event;              // Evento de tempo expirado
+};
+
+/**
+ * @brief Roda de temporização com armar/cancelar em O(1) e relógio virtual.
+ */
+class TimerWheel
+{
+public:
+  TimerWheel()
+  {
+    for (int i = 0; i < TIMER_WHEEL_SLOTS; ++i)
+    {
+      buckets[i] = NONE;
+    }
+    for (int i = 0; i < TIMER_WHEEL_MAX_TIMERS; ++i)
+    {
+      entries[i].used = false;
+      entries[i].fired = false;
+      entries[i].generation = 0;
+      pendingGeneration[i] = 0;
+    }
+  }
+
+  /**
+   * @brief Converte milissegundos em ticks (arredondando para cima, mínimo 1 tick).
+   */
+  static uint32_t msToTicks(sc_time time_ms)
+  {
+    if (time_ms <= 0)
+    {
+      return 1;
+    }
+    return ((uint32_t)time_ms + TIMER_WHEEL_TICK_MS - 1) / TIMER_WHEEL_TICK_MS;
+  }
+
+  /**
+   * @brief Arma (ou rearma) o timer de um evento.
+   * @param sm Máquina de estados que receberá o evento.
+   * @param event Identificador do evento de tempo.
+   * @param delayTicks Atraso em ticks até a expiração.
+   * @param periodic Se verdadeiro, o timer é rearmado com o mesmo atraso a cada expiração.
+   * @return false se não houver espaço para mais timers.
+   */
+  bool arm(sc::timer::TimedInterface *sm, sc_eventid event, uint32_t delayTicks, bool periodic)
+  {
+    int idx = find(event);
+    if (idx == NONE)
+    {
+      idx = allocate(event);
+      if (idx == NONE)
+      {
+        overflows++;
+        return false;
+      }
+      active++;
+    }
+    else if (entries[idx].fired)
+    {
+      active++; // Disparo único expirado e ainda não retirado: volta a contar como armado
+    }
+    else
+    {
+      unlink(idx);
+    }
+    Entry &e = entries[idx];
+    e.generation++; // Uma expiração pendente de antes desta armação fica obsoleta
+    e.fired = false;
+    e.sm = sm;
+    e.event = event;
+    e.period = periodic ? (delayTicks == 0 ? 1 : delayTicks) : 0;
+    schedule(idx, delayTicks);
+    return true;
+  }
+
+  /**
+   * @brief Cancela o timer de um evento (nada acontece se ele não estiver armado).
+   */
+  bool cancel(sc_eventid event)
+  {
+    int idx = find(event);
+    if (idx == NONE)
+    {
+      return false;
+    }
+    if (!entries[idx].fired)
+    {
+      unlink(idx);
+      active--;
+    }
+    entries[idx].generation++; // Uma expiração pendente deste timer fica obsoleta
+    entries[idx].used = false;
+    return true;
+  }
+
+  /**
+   * @brief Avança o relógio virtual em um tick e marca os timers expirados como pendentes.
+   * @return Número de timers que expiraram neste tick (retirados com `takeExpired()`).
+   */
+  int tick()
+  {
+    now++;
+    cursor = (cursor + 1) & (TIMER_WHEEL_SLOTS - 1);
+    int count = 0;
+    int idx = buckets[cursor];
+    while (idx != NONE)
+    {
+      Entry &e = entries[idx];
+      int next = e.next;
+      if (e.rounds > 0)
+      {
+        e.rounds--;
+      }
+      else
+      {
+        if (pendingMask & (1UL << idx))
+        {
+          coalesced++;
+        }
+        pendingMask |= 1UL << idx;
+        pendingGeneration[idx] = e.generation;
+        count++;
+        unlink(idx);
+        if (e.period > 0)
+        {
+          schedule(idx, e.period);
+        }
+        else
+        {
+          e.fired = true; // Continua ocupado até a expiração ser retirada
+          active--;
+        }
+      }
+      idx = next;
+    }
+    return count;
+  }
+
+  /**
+   * @brief Retira a próxima expiração pendente que ainda vale.
+   * @param out Expiração a entregar à máquina de estados.
+   * @return false se não há mais expirações pendentes.
+   * @details Expirações de timers cancelados ou rearmados depois do tick (geração diferente) são
+   * descartadas e contadas. Um disparo único retirado libera sua posição.
+   */
+  bool takeExpired(TimerExpiration &out)
+  {
+    while (pendingMask != 0)
+    {
+      int idx = __builtin_ctz(pendingMask);
+      pendingMask &= ~(1UL << idx);
+      Entry &e = entries[idx];
+      if (!e.used || e.generation != pendingGeneration[idx])
+      {
+        stale++;
+        continue;
+      }
+      out.sm = e.sm;
+      out.event = e.event;
+      if (e.fired)
+      {
+        e.used = false;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  uint32_t getNow() const { return now; }                 // Relógio virtual (em ticks)
+  int getActiveCount() const { return active; }           // Timers armados no momento
+  uint32_t getOverflowCount() const { return overflows; } // Armações recusadas por falta de espaço
+  uint32_t getStaleCount() const { return stale; }        // Expirações descartadas (cancelado/rearmado depois do tick)
+  uint32_t getCoalescedCount() const { return coalesced; } // Expirações periódicas somadas a uma ainda pendente
+
+private:
+  static const int NONE = -1;
+
+  /**
+   * @brief Timer armado; encadeado em lista duplamente ligada dentro da posição da roda.
+   */
+  struct Entry
+  {
+    sc::timer::TimedInterface *sm;
+    sc_eventid event;
+    uint32_t rounds; // Voltas completas que ainda faltam até expirar
+    uint32_t period; // Período em ticks (0 = disparo único)
+    int prev;
+    int next;
+    int slot;
+    uint32_t generation; // Incrementada ao armar e ao cancelar
+    bool fired;          // Disparo único expirado, aguardando takeExpired()
+    bool used;
+  };
+
+  /**
+   * @brief Posição inicial de busca: os eventos de tempo são endereços consecutivos
+   * do vetor `timeEvents` da statechart, logo caem em posições distintas da tabela.
+   */
+  static int hash(sc_eventid event)
+  {
+    return (int)((uintptr_t)event % TIMER_WHEEL_MAX_TIMERS);
+  }
+
+  int find(sc_eventid event) const
+  {
+    int h = hash(event);
+    for (int i = 0; i < TIMER_WHEEL_MAX_TIMERS; ++i)
+    {
+      int idx = (h + i) % TIMER_WHEEL_MAX_TIMERS;
+      if (entries[idx].used && entries[idx].event == event)
+      {
+        return idx;
+      }
+    }
+    return NONE;
+  }
+
+  int allocate(sc_eventid event)
+  {
+    int h = hash(event);
+    for (int i = 0; i < TIMER_WHEEL_MAX_TIMERS; ++i)
+    {
+      int idx = (h + i) % TIMER_WHEEL_MAX_TIMERS;
+      if (!entries[idx].used)
+      {
+        entries[idx].used = true;
+        entries[idx].fired = false;
+        return idx;
+      }
+    }
+    return NONE;
+  }
+
+  void schedule(int idx, uint32_t delayTicks)
+  {
+    if (delayTicks == 0)
+    {
+      delayTicks = 1;
+    }
+    Entry &e = entries[idx];
+    e.slot = (int)((cursor + delayTicks) & (TIMER_WHEEL_SLOTS - 1));
+    e.rounds = (delayTicks - 1) / TIMER_WHEEL_SLOTS;
+    e.prev = NONE;
+    e.next = buckets[e.slot];
+    if (e.next != NONE)
+    {
+      entries[e.next].prev = idx;
+    }
+    buckets[e.slot] = idx;
+  }
+
+  void unlink(int idx)
+  {
+    Entry &e = entries[idx];
+    if (e.prev != NONE)
+    {
+      entries[e.prev].next = e.next;
+    }
+    else
+    {
+      buckets[e.slot] = e.next;
+    }
+    if (e.next != NONE)
+    {
+      entries[e.next].prev = e.prev;
+    }
+    e.prev = NONE;
+    e.next = NONE;
+  }
+
+  Entry entries[TIMER_WHEEL_MAX_TIMERS];
+  int buckets[TIMER_WHEEL_SLOTS];
+  uint32_t cursor = 0;
+  uint32_t now = 0;
+  int active = 0;
+  uint32_t overflows = 0;
+  uint32_t pendingMask = 0;                              // Um bit por timer expirado ainda não retirado
+  uint32_t pendingGeneration[TIMER_WHEEL_MAX_TIMERS];    // Geração do timer no tick da expiração
+  uint32_t stale = 0;
+  uint32_t coalesced = 0;
+};
+
+#endif // TIMERWHEEL_H
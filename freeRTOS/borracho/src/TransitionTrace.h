@@ -0,0 +1,200 @@
+/**
+ * @file TransitionTrace.h
+ * @brief Registro (trace) das transições da máquina de estados em um buffer circular na RAM.
+ * @details Opcional: só é compilado com `-D SC_TRACE_ENABLED` (ver platformio.ini). Sem a flag,
+ * a Statechart não chama nenhum hook e as marcações `SC_TRACE_MARK` viram `((void)0)`.
+ * Cada micro step da Statechart que consome um evento ou troca de estado gera um registro com
+ * o evento, os estados de origem e destino e os instantes (micros()) de início e fim do passo,
+ * incluindo as ações de entrada/saída (que enfileiram os comandos de display).
+ * Além das transições, as tarefas registram marcas (tecla lida, display atualizado), o que
+ * permite medir a latência tecla -> tela contra o requisito de 500 ms (RNF10).
+ * O buffer é despejado em binário pela Serial (tecla '#' no IDLE).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef TRANSITIONTRACE_H
+#define TRANSITIONTRACE_H
+
+#ifdef SC_TRACE_ENABLED
+
+// Includes do projeto
+#include "src-gen/Statechart.h"
+#include <Arduino.h>
+
+// FreeRTOS Headers
+#include "freertos/FreeRTOS.h"
+
+// --- PARÂMETROS DO TRACE ---
+#ifndef SC_TRACE_SIZE
+#define SC_TRACE_SIZE 128 // Número de registros do buffer circular (12 bytes cada)
+#endif
+
+#define TRACE_LATENCY_LIMIT_US 500000UL // RNF10: resposta à tecla em até 500 ms
+
+/**
+ * @brief Marcas registradas pelas tarefas (ocupam o campo `event` acima dos eventos da statechart).
+ */
+enum TraceMarker : uint16_t
+{
+  TRACE_MARK_KEY_RECEIVED = 0xFF01,  ///< Tecla lida pela keypadTask (source = tecla)
+  TRACE_MARK_DISPLAY_FLUSHED = 0xFF02 ///< Quadro enviado ao display pela displayFlushTask (source = último comando do lote)
+};
+
+/**
+ * @brief Buffer circular de registros de transição e marcas.
+ * @details Escrito pela stateMachineTask (hook da statechart), pela keypadTask e pela displayTask;
+ * por isso cada escrita é protegida por uma seção crítica curta.
+ */
+class TransitionTrace
+{
+public:
+  typedef Statechart::TraceRecord Entry; // 12 bytes: início, fim, evento, origem, destino
+
+  /**
+   * @brief Instala o hook de trace na statechart (chamar antes de statechart.enter()).
+   */
+  void attach(Statechart &statechart)
+  {
+    statechart.setTraceHook(clock, onStep, this);
+  }
+
+  /**
+   * @brief Registra uma marca de tarefa.
+   * @param marker Tipo da marca.
+   * @param arg Argumento da marca (tecla, tipo de comando, ...), gravado em `source`.
+   */
+  void mark(TraceMarker marker, uint8_t arg)
+  {
+    Entry entry;
+    entry.startMicros = micros();
+    entry.endMicros = entry.startMicros;
+    entry.event = marker;
+    entry.source = arg;
+    entry.target = 0xFF;
+    push(entry);
+  }
+
+  /**
+   * @brief Despeja o buffer em binário (little-endian, como está na RAM).
+   * @details Formato: "SCTR", versão (u8), tamanho do registro (u8), quantidade (u16),
+   * registros perdidos (u32), seguidos dos registros do mais antigo ao mais novo.
+   * O registro fica pausado durante o despejo (sem cópia do buffer na pilha) e,
+   * ao final, o buffer é esvaziado.
+   */
+  void dumpBinary(Print &out)
+  {
+    pause(true);
+    const uint8_t header[4] = {'S', 'C', 'T', 'R'};
+    const uint8_t version = 1;
+    const uint8_t entrySize = sizeof(Entry);
+    out.write(header, sizeof(header));
+    out.write(&version, 1);
+    out.write(&entrySize, 1);
+    out.write((const uint8_t *)&count, sizeof(count));
+    out.write((const uint8_t *)&lost, sizeof(lost));
+    for (uint16_t i = 0; i < count; ++i)
+    {
+      out.write((const uint8_t *)&at(i), sizeof(Entry));
+    }
+    count = 0;
+    lost = 0;
+    pause(false);
+  }
+
+  /**
+   * @brief Imprime a latência tecla -> display atualizado das teclas do buffer (sem esvaziá-lo).
+   * @details Para cada marca de tecla, procura a primeira marca de display atualizado depois dela.
+   */
+  void printLatency(Print &out)
+  {
+    pause(true);
+    uint32_t keys = 0, overLimit = 0, maxLatency = 0;
+    for (uint16_t i = 0; i < count; ++i)
+    {
+      if (at(i).event != TRACE_MARK_KEY_RECEIVED)
+        continue;
+      for (uint16_t j = i + 1; j < count; ++j)
+      {
+        if (at(j).event == TRACE_MARK_DISPLAY_FLUSHED)
+        {
+          uint32_t latency = at(j).endMicros - at(i).startMicros;
+          keys++;
+          if (latency > maxLatency)
+            maxLatency = latency;
+          if (latency > TRACE_LATENCY_LIMIT_US)
+            overLimit++;
+          break;
+        }
+      }
+    }
+    out.printf("Trace: %u registros (%lu perdidos), tecla->tela: %lu teclas, max=%lu us, acima de 500 ms=%lu\n",
+               (unsigned)count, (unsigned long)lost, (unsigned long)keys,
+               (unsigned long)maxLatency, (unsigned long)overLimit);
+    pause(false);
+  }
+
+private:
+  static uint32_t clock()
+  {
+    return micros();
+  }
+
+  static void onStep(void *context, const Entry &record)
+  {
+    static_cast<TransitionTrace *>(context)->push(record);
+  }
+
+  void push(const Entry &entry)
+  {
+    portENTER_CRITICAL(&traceMux);
+    if (paused)
+    {
+      lost++; // Buffer sendo lido: descarta o registro
+    }
+    else
+    {
+      entries[head] = entry;
+      head = (head + 1) % SC_TRACE_SIZE;
+      if (count < SC_TRACE_SIZE)
+        count++;
+      else
+        lost++; // Sobrescreveu o registro mais antigo
+    }
+    portEXIT_CRITICAL(&traceMux);
+  }
+
+  void pause(bool value)
+  {
+    portENTER_CRITICAL(&traceMux);
+    paused = value;
+    portEXIT_CRITICAL(&traceMux);
+  }
+
+  // i-ésimo registro do mais antigo ao mais novo (válido com o registro pausado)
+  const Entry &at(uint16_t i) const
+  {
+    return entries[(head + SC_TRACE_SIZE - count + i) % SC_TRACE_SIZE];
+  }
+
+  Entry entries[SC_TRACE_SIZE];
+  uint16_t head = 0;
+  uint16_t count = 0;
+  uint32_t lost = 0;
+  bool paused = false;
+  portMUX_TYPE traceMux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+// --- TRACE GLOBAL ---
+extern TransitionTrace transitionTrace; // Definido em main.cpp
+
+#define SC_TRACE_MARK(marker, arg) transitionTrace.mark((marker), (uint8_t)(arg))
+
+#else
+
+#define SC_TRACE_MARK(marker, arg) ((void)0)
+
+#endif // SC_TRACE_ENABLED
+
+#endif // TRANSITIONTRACE_H
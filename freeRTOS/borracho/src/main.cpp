@@ -20,6 +20,19 @@
 #include "src-gen/Statechart.h"
 #include "StatechartCallback.h"
 #include "StatechartTimer.h"
+#include "StatechartIngress.h"
+#include "KeypadDispatch.h"
+#include "TransitionTrace.h"
+#include "BrewSnapshot.h"
+#include "I2CBus.h"
+#include "DisplayFlush.h"
+#include "DisplayRender.h"
+#include "GlyphText.h"
+#include "HeapCounter.h"
+#include "ScreenCache.h"
+#include "FramePacer.h"
+#include "ControlLoop.h"
+#include "SpscRing.h"
 
 // FreeRTOS
 #include "freertos/FreeRTOS.h"
@@ -30,7 +43,9 @@
 #include <Wire.h>
 
 // PID
-#include <PID_v1.h>
+#include "FloatPid.h"
+#include "PidGains.h"
+#include "RelayAutoTune.h"
 
 // LittleFS
 #include "FS.h"
@@ -47,14 +62,66 @@ Statechart statechart;        // Instância da máquina de estados Yakindu
 StatechartCallback callback;  // Instância da classe de callbacks para operações do Yakindu
 StatechartTimer timerService; // Instância do serviço de timer para a máquina de estados
 
+// Fila única de entrada da máquina de estados (teclas, eventos e eventos de tempo)
+StatechartIngress statechartIngress;
+
+#ifdef SC_TRACE_ENABLED
+// Trace das transições da statechart (build flag SC_TRACE_ENABLED)
+TransitionTrace transitionTrace;
+#endif
+
+#ifdef HEAP_ALLOC_COUNTER
+// Contador de alocações de heap (build flag HEAP_ALLOC_COUNTER)
+HeapAllocCounter heapAllocCounter;
+#endif
+
+// Snapshot do processo para retomada após queda de energia
+BrewSnapshotStore brewSnapshotStore;
+BrewSnapshot resumeSnapshot;     // Snapshot lido no boot
+bool resumePending = false;      // Há um processo interrompido a retomar
+uint32_t restoreStartMicros = 0; // Início da restauração (leitura do snapshot no setup)
+
+// Auto-tune do PID (tecla '3' no IDLE) e ganhos identificados, gravados no LittleFS
+RelayAutoTune relayAutoTune; // Usado pela controlTask; os ganhos seguem para a loggerTask no ControlRecord
+PidGainsStore pidGainsStore;
+
 // Filas FreeRTOS para comunicação entre tarefas
-QueueHandle_t xKeypadQueue;  // Fila para enviar teclas lidas da keypadTask para a stateMachineTask
+#define DISPLAY_QUEUE_LENGTH 10 // Comandos de display pendentes (também o tamanho do lote da displayTask)
 QueueHandle_t xDisplayQueue; // Fila para enviar comandos de exibição para a displayTask
 QueueHandle_t xControlQueue; // Fila para comandos da controlTask
 QueueHandle_t xSensorQueue;  // Fila para leitura do sensor de temperatura
 
+// Barramento I2C compartilhado pelo display e pelo sensor simulado
+WireTransport wireTransport(Wire);
+I2CBus i2cBus(wireTransport); // Árbitro com prioridade para as leituras do sensor
+
 // Objeto para o display OLED
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+PageGlyphText<Adafruit_SSD1306> display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET); // Texto alinhado às páginas gravado por bytes
+DirtyPageFlusher displayFlusher(i2cBus, OLED_ADDRESS); // Envia ao display só as páginas alteradas
+FrameMailbox displayMailbox;                           // Último quadro desenhado, à espera da displayFlushTask
+TaskHandle_t displayFlushTaskHandle = NULL;            // Notificada a cada quadro publicado
+ScreenCache screenCache;                               // Telas estáticas pré-desenhadas no boot
+DisplayRenderStats displayRenderStats;                 // Custo de desenho por tipo de comando
+TemperatureGraph temperatureGraph;                     // Gráfico de temperatura da tela de processo
+FramePacer displayPacer;                               // Taxa máxima de quadros, prazos e latência tecla -> tela
+
+// Período fixo da controlTask (prazos absolutos, jitter e prazos perdidos)
+ControlLoopScheduler controlLoop(CONTROL_PERIOD_MS);
+
+// Registros da controlTask para as tarefas de menor prioridade (um produtor e um consumidor por fila)
+SpscRing<ControlRecord, CONTROL_RECORD_RING> controlLogRing;    // -> loggerTask (log CSV)
+SpscRing<ControlRecord, CONTROL_RECORD_RING> controlStatusRing; // -> statusTask (tela de status)
+PersistenceMailbox persistenceMailbox;                          // -> loggerTask (snapshot, remoção e ganhos; sem descarte)
+TaskHandle_t loggerTaskHandle = NULL;
+TaskHandle_t statusTaskHandle = NULL;
+
+// Variáveis da receita personalizada da etapa em andamento (escritas e lidas só pela controlTask)
+struct
+{
+  int numSteps;
+  int stepIdx;
+  int receivedValue;
+} activeCustomVars = {};
 
 // --- ENDEREÇO I2C DO SIMULADOR DE SENSOR ---
 /**
@@ -73,10 +140,56 @@ void keypadTask(void *pvParameters);
  * @brief Tarefa para gerenciar a máquina de estados Yakindu.
  */
 void stateMachineTask(void *pvParameters);
+/**
+ * @brief Trata uma tecla recebida pela stateMachineTask, disparando os eventos da statechart.
+ */
+void processKeypadKey(char receivedKey);
+/**
+ * @brief Redesenha a tela do estado ativo (tecla inválida ou timeout do buffer de entrada).
+ */
+void redrawKeyScreen(const StateKeyMap &keyMap);
+/**
+ * @brief Dispara o evento de processo da receita e o início da primeira etapa em um único ciclo.
+ */
+void startRecipeProcess(statechart_events::StatechartEventName processEvent);
+/**
+ * @brief Retoma o processo interrompido a partir do snapshot lido no boot (em vez de statechart.enter()).
+ */
+void resumeFromSnapshot(const BrewSnapshot &snapshot);
+/**
+ * @brief Grava o snapshot do processo em andamento (chamada pela loggerTask).
+ */
+void saveBrewSnapshot(const ControlRecord &record);
+/**
+ * @brief Publica um registro da controlTask para a loggerTask e, com CONTROL_RECORD_STATUS, para a statusTask.
+ */
+void publishControlRecord(uint8_t flags, int recipeIdx, int stepIdx, int targetTemp, int durationMinutes,
+                          uint32_t elapsedMillis, bool setpointReached, float temperature, int remainingSeconds,
+                          const PidGains *gains = nullptr);
 /**
  * @brief Tarefa para gerenciar todas as operações de exibição no display OLED.
  */
 void displayTask(void *pvParameters);
+/**
+ * @brief Tarefa que envia ao display físico os quadros publicados pela displayTask.
+ */
+void displayFlushTask(void *pvParameters);
+/**
+ * @brief Exibe um comando de display no framebuffer: copia a tela do cache ou desenha com a GFX.
+ */
+void renderDisplayCommand(const DisplayCommand &cmd);
+/**
+ * @brief Desenha uma vez cada tela estática e guarda o framebuffer no screenCache.
+ */
+void prerenderStaticScreens();
+/**
+ * @brief Páginas (8 linhas de pixels cada, bit 0 = topo) apagadas por um comando antes de desenhar.
+ */
+uint8_t displayCommandClearedPages(const DisplayCommand &cmd);
+/**
+ * @brief Páginas em que um comando pode desenhar.
+ */
+uint8_t displayCommandDrawnPages(const DisplayCommand &cmd);
 /**
  * @brief Tarefa para gerenciar o processo de aquecimento e contagem regressiva.
  */
@@ -85,6 +198,14 @@ void controlTask(void *pvParameters);
  * @brief Tarefa para ler periodicamente a temperatura do sensor simulado via I2C.
  */
 void temperatureSensorTask(void *pvParameters);
+/**
+ * @brief Tarefa que grava no LittleFS o log CSV e o snapshot a partir dos registros da controlTask.
+ */
+void loggerTask(void *pvParameters);
+/**
+ * @brief Tarefa que monta a tela de status do processo a partir dos registros da controlTask.
+ */
+void statusTask(void *pvParameters);
 
 /**
  * @brief Lê o conteúdo completo do arquivo de log e imprime na Serial.
@@ -93,20 +214,182 @@ void temperatureSensorTask(void *pvParameters);
  */
 void readAndPrintLog();
 
+// --- INSTRUMENTAÇÃO DA STATEMACHINETASK ---
+/**
+ * @brief Estatísticas de custo por tecla processada.
+ * @details Registra quantos ciclos da statechart (run cycles), quantos ciclos de CPU
+ * (ESP.getCycleCount) e quanto tempo cada tecla consome na stateMachineTask.
+ * Impressas junto com o log (tecla '*' no IDLE).
+ */
+struct KeyPressStats
+{
+  uint32_t keyPresses = 0;      // Teclas processadas
+  uint32_t runCycles = 0;       // Total de run cycles disparados pelas teclas
+  uint32_t maxRunCycles = 0;    // Maior número de run cycles em uma única tecla
+  uint64_t totalMicros = 0;     // Tempo total gasto no tratamento das teclas
+  uint32_t maxMicros = 0;       // Maior tempo gasto em uma única tecla
+  uint64_t totalCpuCycles = 0;  // Ciclos de CPU gastos no despacho das teclas
+  uint32_t maxCpuCycles = 0;    // Maior número de ciclos de CPU em uma única tecla
+
+  void record(uint32_t cycles, uint32_t elapsedMicros, uint32_t cpuCycles)
+  {
+    keyPresses++;
+    runCycles += cycles;
+    totalMicros += elapsedMicros;
+    totalCpuCycles += cpuCycles;
+    if (cpuCycles > maxCpuCycles)
+      maxCpuCycles = cpuCycles;
+    if (cycles > maxRunCycles)
+      maxRunCycles = cycles;
+    if (elapsedMicros > maxMicros)
+      maxMicros = elapsedMicros;
+  }
+
+  void print(Print &out)
+  {
+    out.printf("Teclas: %lu processadas, run cycles=%lu (max %lu por tecla), tempo medio=%lu us (max %lu us)\n",
+               (unsigned long)keyPresses, (unsigned long)runCycles, (unsigned long)maxRunCycles,
+               (unsigned long)(keyPresses ? totalMicros / keyPresses : 0), (unsigned long)maxMicros);
+    out.printf("Teclas: ciclos de CPU medio=%lu (max %lu por tecla)\n",
+               (unsigned long)(keyPresses ? totalCpuCycles / keyPresses : 0), (unsigned long)maxCpuCycles);
+  }
+};
+KeyPressStats keyPressStats;
+
+/**
+ * @brief Estatísticas de todas as mensagens processadas pela stateMachineTask.
+ * @details Histograma em potências de 2 dos ciclos de CPU gastos por mensagem (tecla, evento ou
+ * evento de tempo), do qual saem os percentis; taxa de mensagens por segundo; e quantas vezes a
+ * configuração de estados ficou inválida (Statechart::isStateConfigurationValid) após um ciclo.
+ * Impressas junto com o log (tecla '*' no IDLE).
+ */
+struct RunCycleStats
+{
+  static const uint8_t BUCKETS = 24;  // 2^23 ciclos ~ 35 ms a 240 MHz
+  uint32_t histogram[BUCKETS] = {};   // histogram[b]: mensagens com [2^b, 2^(b+1)) ciclos
+  uint32_t messages = 0;              // Mensagens processadas
+  uint32_t invalidConfigurations = 0; // Configurações de estados inválidas detectadas
+  uint32_t firstMillis = 0;           // Instante da primeira mensagem (taxa média)
+
+  void record(uint32_t cpuCycles, bool validConfiguration)
+  {
+    if (messages++ == 0)
+      firstMillis = millis();
+    uint8_t bucket = 31 - __builtin_clz(cpuCycles | 1);
+    histogram[bucket < BUCKETS ? bucket : BUCKETS - 1]++;
+    if (!validConfiguration)
+      invalidConfigurations++;
+  }
+
+  // Limite superior (em ciclos) do balde que contém o percentil pct
+  uint32_t percentile(uint8_t pct) const
+  {
+    uint32_t target = (uint32_t)(((uint64_t)messages * pct + 99) / 100);
+    uint32_t accumulated = 0;
+    for (uint8_t b = 0; b < BUCKETS; ++b)
+    {
+      accumulated += histogram[b];
+      if (accumulated >= target && accumulated > 0)
+        return 2UL << b;
+    }
+    return 0;
+  }
+
+  void print(Print &out)
+  {
+    uint32_t seconds = messages ? (millis() - firstMillis) / 1000 : 0;
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    out.printf("Statechart: %lu mensagens (%lu/s), configuracoes invalidas=%lu, heap minimo=%lu bytes\n",
+               (unsigned long)messages, (unsigned long)(seconds ? messages / seconds : messages),
+               (unsigned long)invalidConfigurations, (unsigned long)ESP.getMinFreeHeap());
+    out.printf("Statechart: ciclos por mensagem p50<=%lu p90<=%lu p99<=%lu (p99<=%lu us)\n",
+               (unsigned long)percentile(50), (unsigned long)percentile(90), (unsigned long)percentile(99),
+               (unsigned long)(mhz ? percentile(99) / mhz : 0));
+  }
+};
+RunCycleStats runCycleStats;
+
+// --- INSTRUMENTAÇÃO DA DISPLAYTASK ---
+/**
+ * @brief Estatísticas da coalescência de comandos de display.
+ * @details A displayTask esvazia a fila a cada quadro e descarta os comandos cujo desenho seria
+ * totalmente apagado por um comando posterior do mesmo lote (ex: status do processo substituído
+ * por um mais novo, "Estado:" reescrito). Registra comandos recebidos, descartados e o
+ * histograma de descartes por quadro. Impressas junto com o log (tecla '*' no IDLE).
+ */
+struct DisplayBatchStats
+{
+  static const uint8_t BUCKETS = 4;  // 0, 1, 2 e 3+ comandos descartados por quadro
+  uint32_t histogram[BUCKETS] = {};  // histogram[n]: quadros com n comandos descartados
+  uint32_t frames = 0;               // Quadros desenhados e enviados
+  uint32_t commands = 0;             // Comandos recebidos
+  uint32_t coalesced = 0;            // Comandos descartados por coalescência
+  uint32_t maxBatch = 0;             // Maior lote retirado da fila em um quadro
+
+  void record(uint32_t batch, uint32_t dropped)
+  {
+    frames++;
+    commands += batch;
+    coalesced += dropped;
+    histogram[dropped < BUCKETS ? dropped : BUCKETS - 1]++;
+    if (batch > maxBatch)
+      maxBatch = batch;
+  }
+
+  void print(Print &out)
+  {
+    out.printf("Display: %lu comandos em %lu quadros (max %lu por quadro), %lu coalescidos\n",
+               (unsigned long)commands, (unsigned long)frames, (unsigned long)maxBatch, (unsigned long)coalesced);
+    out.printf("Display: quadros com 0/1/2/3+ comandos coalescidos = %lu/%lu/%lu/%lu, substituidos antes do envio=%lu\n",
+               (unsigned long)histogram[0], (unsigned long)histogram[1],
+               (unsigned long)histogram[2], (unsigned long)histogram[3],
+               (unsigned long)displayMailbox.replacedFrames());
+  }
+};
+DisplayBatchStats displayBatchStats;
+
+/**
+ * @brief Tempo das gravações no flash feitas pela loggerTask.
+ * @details Comparado com a latência despertar -> PWM da controlTask (ControlLoopScheduler), mostra
+ * que as paradas do LittleFS não chegam mais ao aquecedor. Impresso junto com o log (tecla '*' no IDLE).
+ */
+struct LogWriterStats
+{
+  uint32_t writes = 0;      // Operações no flash (linha do log, snapshot, cabeçalho)
+  uint64_t totalMicros = 0; // Tempo total das operações
+  uint32_t maxMicros = 0;   // Pior operação
+
+  void record(uint32_t elapsedMicros)
+  {
+    writes++;
+    totalMicros += elapsedMicros;
+    if (elapsedMicros > maxMicros)
+      maxMicros = elapsedMicros;
+  }
+
+  void print(Print &out)
+  {
+    out.printf("Log: %lu gravacoes no flash, media=%lu us, max=%lu us (fora da controlTask)\n",
+               (unsigned long)writes, (unsigned long)(writes ? totalMicros / writes : 0), (unsigned long)maxMicros);
+  }
+};
+LogWriterStats logWriterStats;
+
 // --- VARIÁVEIS PID ---
 /**
  * @brief Parâmetros para o controlador PID.
  * @details Define as variáveis de entrada (`Input`), saída (`Output`) e setpoint (`Setpoint`)
- * para o PID, juntamente com os coeficientes Kp, Ki e Kd.
+ * para o PID, juntamente com os coeficientes Kp, Ki e Kd. Em float: a FPU do ESP32 é de precisão simples.
  */
-double Setpoint, Input, Output;
-double Kp = 30, Ki = 5.0, Kd = 0.5; // Coeficiente PID após ajustes finos (Coeficientes PID iniciais Kp=10, Ki=0.1, Kd=0.5)
+float Setpoint, Input, Output;
+float Kp = 30, Ki = 5.0, Kd = 0.5; // Coeficiente PID após ajustes finos (Coeficientes PID iniciais Kp=10, Ki=0.1, Kd=0.5)
 
 /**
  * @brief Objeto do controlador PID.
- * @details Instância da classe PID_v1 configurada para controle de aquecimento.
+ * @details FloatPid (FloatPid.h) configurado para controle de aquecimento, um passo por período da controlTask.
  */
-PID myPID(&Input, &Output, &Setpoint, Kp, Ki, Kd, DIRECT);
+FloatPid myPID(&Input, &Output, &Setpoint, Kp, Ki, Kd, CONTROL_PERIOD_MS);
+GainSchedule gainSchedule; // Ganhos por faixa de setpoint sobre os ganhos base (GainSchedule.h)
 
 // --- SETUP ---
 /**
@@ -122,7 +405,7 @@ void setup()
   Serial.println("Main: Iniciando FreeRTOS Setup...");
 
   // Inicialização do OLED
-  if (!display.begin(SSD1306_SWITCHCAPVCC, 0x3C))
+  if (!display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDRESS))
   {
     Serial.println(F("Main: ERRO! Falha ao inicializar o display no setup. Sistema parado."));
     for (;;)
@@ -132,6 +415,10 @@ void setup()
   {
     display.setTextSize(1);
     display.setTextColor(SSD1306_WHITE);
+#ifdef GLYPH_BENCHMARK
+    display.benchmarkText(Serial, 50); // Ciclos por glifo do texto alinhado x drawChar da GFX (o prerender limpa o framebuffer)
+#endif
+    prerenderStaticScreens(); // Usa o framebuffer antes da primeira mensagem (termina com ele limpo)
     display.setCursor(0, 0);
     display.println("Main: Display OK!");
     display.display();
@@ -141,6 +428,12 @@ void setup()
   // Inicializa I2C como MESTRE
   Wire.begin(21, 22);
   Wire.setClock(100000); // Define a frequência para 100kHz
+  if (!i2cBus.begin() || !displayMailbox.begin())
+  {
+    Serial.println("Main: ERRO! Falha ao criar os mutexes do barramento I2C/display. Sistema parado.");
+    for (;;)
+      ;
+  }
   Serial.println("Main: I2C Master inicializado nos pinos 21 (SDA) e 22 (SCL).");
 
   // Inicializa o LittleFS para o log
@@ -148,8 +441,24 @@ void setup()
   {
     Serial.println("ERRO: Falha ao montar o LittleFS.");
   }
-  LittleFS.remove("/brew_log.csv"); // Apaga o log anterior
-  Serial.println("Log anterior removido.");
+
+  // Verifica se há um processo interrompido por queda de energia antes de apagar o log
+  restoreStartMicros = micros();
+  resumePending = brewSnapshotStore.load(resumeSnapshot) &&
+                  resumeSnapshot.activeState == Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP &&
+                  resumeSnapshot.recipeIdx >= 0 && resumeSnapshot.recipeIdx < NUM_RECIPES &&
+                  resumeSnapshot.stepIdx >= 0 && resumeSnapshot.stepIdx < recipes[resumeSnapshot.recipeIdx].numSteps;
+  if (resumePending)
+  {
+    Serial.printf("Main: Processo interrompido encontrado (receita %d, etapa %d, %lu s cumpridos). Log mantido.\n",
+                  resumeSnapshot.recipeIdx, resumeSnapshot.stepIdx + 1, (unsigned long)(resumeSnapshot.elapsedMillis / 1000));
+  }
+  else
+  {
+    brewSnapshotStore.clear();
+    LittleFS.remove("/brew_log.csv"); // Apaga o log anterior
+    Serial.println("Log anterior removido.");
+  }
 
   // Configura a máquina de estados com seus serviços e callbacks
   statechart.setOperationCallback(&callback);
@@ -161,34 +470,54 @@ void setup()
 
   // Configuração do PID
   // Define os limites de saída do PID para o duty cycle do PWM (0 a 1023 para 10 bits)
-  myPID.SetOutputLimits(0, (double)((1 << statechart.getPwm_resolution_bits()) - 1)); // Max duty cycle
-  myPID.SetMode(AUTOMATIC);                                                           // Inicia o PID no modo automático (ligado)
-  myPID.SetSampleTime(100);                                                           // Define o tempo de amostragem do PID em milissegundos (o mesmo do loop da controlTask)
+  myPID.setOutputLimits(0, (float)((1 << statechart.getPwm_resolution_bits()) - 1)); // Max duty cycle
+  myPID.setMode(PID_AUTOMATIC);                                                      // Inicia o PID no modo automático (ligado)
+#ifdef PID_BENCHMARK
+  benchmarkPid(Serial, 1000); // Ciclos de CPU por cálculo em float x double
+#endif
+  gainSchedule.setBase({Kp, Ki, Kd}); // Ganhos de fábrica
+  PidGains savedGains;
+  if (pidGainsStore.load(savedGains))
+  {
+    gainSchedule.setBase({savedGains.kp, savedGains.ki, savedGains.kd}); // Ganhos do último auto-tune
+    Serial.printf("Main: Ganhos do auto-tune carregados: Kp=%.2f Ki=%.3f Kd=%.2f\n",
+                  (double)savedGains.kp, (double)savedGains.ki, (double)savedGains.kd);
+  }
   Serial.println("Main: Controlador PID inicializado.");
 
   // Cria as filas FreeRTOS
-  xKeypadQueue = xQueueCreate(5, sizeof(char));
-  xDisplayQueue = xQueueCreate(10, sizeof(DisplayCommand));
+  bool ingressOK = statechartIngress.begin();
+  xDisplayQueue = xQueueCreate(DISPLAY_QUEUE_LENGTH, sizeof(DisplayCommand));
   xControlQueue = xQueueCreate(5, sizeof(ControlCommand));
   xSensorQueue = xQueueCreate(1, sizeof(TemperatureData));
 
   // Verifica se as filas foram criadas com sucesso
-  if (xKeypadQueue == NULL || xDisplayQueue == NULL || xControlQueue == NULL || xSensorQueue == NULL)
+  if (!ingressOK || xDisplayQueue == NULL || xControlQueue == NULL || xSensorQueue == NULL)
   {
     Serial.println("Main: ERRO! Falha ao criar filas FreeRTOS. Sistema parado.");
     for (;;)
       ;
   }
 
+  // Inicia o tick periódico da roda de timers da máquina de estados
+  if (!timerService.begin())
+  {
+    Serial.println("Main: ERRO! Falha ao iniciar o servico de timer. Sistema parado.");
+    for (;;)
+      ;
+  }
+
   // Cria as tarefas FreeRTOS com suas prioridades e tamanhos de pilha
   xTaskCreate(keypadTask, "KeypadTask", 2048, NULL, 1, NULL);
+  xTaskCreate(displayFlushTask, "DisplayFlushTask", 2048, NULL, 2, &displayFlushTaskHandle);
   xTaskCreate(displayTask, "DisplayTask", 4096, NULL, 2, NULL);
   xTaskCreate(stateMachineTask, "StateMachineTask", 4096, NULL, 1, NULL);
-  xTaskCreate(controlTask, "ControlTask", 4096, NULL, 1, NULL);
+  xTaskCreate(loggerTask, "LoggerTask", 4096, NULL, 1, &loggerTaskHandle);
+  xTaskCreate(statusTask, "StatusTask", 4096, NULL, 1, &statusTaskHandle);
+  xTaskCreate(controlTask, "ControlTask", 4096, NULL, 3, NULL); // Acima do display e dos consumidores dos seus registros
   xTaskCreate(temperatureSensorTask, "TempSensorTask", 2048, NULL, 1, NULL);
 
-  // Inicia a máquina de estados (entra no estado inicial definido no modelo Yakindu)
-  statechart.enter();
+  // A máquina de estados é iniciada pela própria stateMachineTask (único consumidor da statechart)
 }
 
 // --- LOOP ---
@@ -216,8 +545,9 @@ void keypadTask(void *pvParameters)
   {
     key = callback.readKeypadChar(); // Tenta ler uma tecla
     if (key != NO_KEY)
-    {                                                // Se uma tecla foi pressionada
-      xQueueSend(xKeypadQueue, &key, portMAX_DELAY); // Envia a tecla para a fila (espera indefinidamente se cheia)
+    {                                 // Se uma tecla foi pressionada
+      SC_TRACE_MARK(TRACE_MARK_KEY_RECEIVED, key);
+      statechartIngress.postKey(key); // Envia a tecla para a fila de entrada (espera indefinidamente se cheia)
       Serial.print("KeypadTask: Tecla enviada para fila: ");
       Serial.println(key);
     }
@@ -232,374 +562,602 @@ void keypadTask(void *pvParameters)
 void stateMachineTask(void *pvParameters)
 {
   (void)pvParameters; // Evita warning de parâmetro não utilizado
+  HEAP_ALLOC_TRACK_TASK();
+  callback.inputTask = xTaskGetCurrentTaskHandle(); // Comandos de display enviados daqui levam o instante da tecla
 
-  char receivedKey;
-  for (;;)
-  { // Loop infinito da tarefa
-    // Espera por uma tecla na fila (bloqueia até uma tecla ser recebida)
-    if (xQueueReceive(xKeypadQueue, &receivedKey, portMAX_DELAY) == pdPASS)
-    {
-      Serial.print("StateMachineTask: Tecla recebida: ");
-      Serial.println(receivedKey);
+#ifdef SC_TRACE_ENABLED
+  transitionTrace.attach(statechart); // Registra as transições desde o estado inicial
+#endif
 
-      ControlCommand controlCmd; // Inicializa os comandos fora do escopo das funções
+  if (resumePending)
+  {
+    // Retoma a etapa interrompida por queda de energia direto no CONTROL_PROCESS_LOOP
+    resumeFromSnapshot(resumeSnapshot);
+  }
+  else
+  {
+    // Inicia a máquina de estados (entra no estado inicial definido no modelo Yakindu)
+    statechart.enter();
+  }
 
-      // Atualiza o buffer de entrada do teclado no callback
-      callback.inputBuffer += receivedKey;
-      callback.lastKeyPressTime = millis(); // Timestamp da última tecla (para timeout)
+  // Sair do IDLE (receita, menu ou EXIT) encerra um auto-tune em andamento
+  Statechart::StatechartStates previousLeaf = statechart.getActiveLeafState();
 
-      // Lógica de decisão e disparo de eventos do statechart
-      // Estado IDLE
-      if (statechart.isStateActive(Statechart::main_region_IDLE))
-      {
-        switch (receivedKey)
-        {
-        case '1':
-          statechart.raiseStart_button();
-          callback.inputBuffer = "";
-          break;
-        case '2':
-          statechart.raiseExit_process();
-          callback.inputBuffer = "";
-          break;
-        case '*':
-          readAndPrintLog(); // Chama a função para imprimir o log
-          callback.inputBuffer = "";
-          break;
-        default:
-          // Tecla inválida em IDLE: Apenas redesenha a tela IDLE com o input atualizado
-          callback.showIdleScreen();   // Redesenha a tela "Bem-vindo"
-          callback.printKeypadInput(); // Imprime o "Digitado: " na tela
-          break;
-        }
-      }
-      // Estado MENU (tela de seleção de receitas)
-      else if (statechart.isStateActive(Statechart::main_region_MENU))
-      {
-        switch (receivedKey)
-        {
-        case '1':
-          statechart.raiseRecipe_1();
-          callback.inputBuffer = "";
-          break;
-        case '2':
-          statechart.raiseRecipe_2();
-          callback.inputBuffer = "";
-          break;
-        case '3':
-          statechart.raiseRecipe_3();
-          callback.inputBuffer = "";
-          break;
-        case '4':
-          statechart.raiseRecipe_4();
-          callback.inputBuffer = "";
-          break;
-        case '5':
-          statechart.raiseRecipe_5();
-          callback.inputBuffer = "";
-          break;
-        default:
-          // Tecla inválida em MENU: Redesenha o menu de receitas com o input atualizado
-          callback.showRecipes();      // Redesenha a lista de receitas
-          callback.printKeypadInput(); // Imprime o "Digitado: " na tela
-          break;
-        }
-      }
-      // Estados de DETALHES de Receitas (RECIPE_1 a RECIPE_4)
-      else if (statechart.isStateActive(Statechart::main_region_RECIPE_1))
-      {
-        switch (receivedKey)
-        {
-        case '1':
-          // Define qual receita será processada e dispara o início do processo
-          callback.currentRecipeIdx = 0; // American Pale Ale é índice 0
-          statechart.raiseRecipe_1_process();
-          statechart.raiseStart_first_step(); // Dispara a primeira transição dentro de STANDARD_PROCESS
-          callback.inputBuffer = "";
-          break;
-        case '2':
-          statechart.raiseRecipe_back_menu();
-          callback.inputBuffer = "";
-          break;
-        default:
-          // Tecla inválida em RECIPE_1: Redesenha os detalhes da receita 1 com o input
-          callback.showRecipe(1);      // Passa '1' para showRecipeDetailsScreen
-          callback.printKeypadInput(); // Imprime o "Digitado: " na tela
-          break;
-        }
-      }
-      else if (statechart.isStateActive(Statechart::main_region_RECIPE_2))
+  IngressMessage msg;
+  for (;;)
+  { // Loop infinito da tarefa
+    // Espera pela próxima mensagem da fila de entrada (bloqueia até uma mensagem ser recebida).
+    // Esta é a única tarefa que executa ciclos da statechart.
+    if (statechartIngress.receive(msg, portMAX_DELAY))
+    {
+      uint32_t messageStartCycles = ESP.getCycleCount();
+      switch (msg.type)
       {
-        switch (receivedKey)
-        {
-        case '1':
-          callback.currentRecipeIdx = 1; // Witbier é índice 1
-          statechart.raiseRecipe_2_process();
-          statechart.raiseStart_first_step();
-          callback.inputBuffer = "";
-          break;
-        case '2':
-          statechart.raiseRecipe_back_menu();
-          callback.inputBuffer = "";
-          break;
-        default:
-          callback.showRecipe(2); // Passa '2' para showRecipeDetailsScreen
-          callback.printKeypadInput();
-          break;
-        }
-      }
-      else if (statechart.isStateActive(Statechart::main_region_RECIPE_3))
+      case INGRESS_KEY:
       {
-        switch (receivedKey)
-        {
-        case '1':
-          callback.currentRecipeIdx = 2; // Belgian Dubbel é índice 2
-          statechart.raiseRecipe_3_process();
-          statechart.raiseStart_first_step();
-          callback.inputBuffer = "";
-          break;
-        case '2':
-          statechart.raiseRecipe_back_menu();
-          callback.inputBuffer = "";
-          break;
-        default:
-          callback.showRecipe(3); // Passa '3' para showRecipeDetailsScreen
-          callback.printKeypadInput();
-          break;
-        }
+        uint32_t cyclesBefore = statechart.getRunCycleCount();
+        uint32_t startMicros = micros();
+        uint32_t startCpuCycles = ESP.getCycleCount();
+        callback.inputMicros = msg.postedAtMicros; // Instante em que a keypadTask leu a tecla
+        processKeypadKey(msg.key);
+        callback.inputMicros = 0;
+        uint32_t cpuCycles = ESP.getCycleCount() - startCpuCycles;
+        keyPressStats.record(statechart.getRunCycleCount() - cyclesBefore, micros() - startMicros, cpuCycles);
+        break;
       }
-      else if (statechart.isStateActive(Statechart::main_region_RECIPE_4))
-      {
-        switch (receivedKey)
-        {
-        case '1':
-          callback.currentRecipeIdx = 3; // Bohemian Pilsen é índice 3
-          statechart.raiseRecipe_4_process();
-          statechart.raiseStart_first_step();
-          callback.inputBuffer = "";
-          break;
-        case '2':
-          statechart.raiseRecipe_back_menu();
-          callback.inputBuffer = "";
-          break;
-        default:
-          callback.showRecipe(4); // Passa '4' para showRecipeDetailsScreen
-          callback.printKeypadInput();
-          break;
-        }
+      case INGRESS_EVENT:
+        statechart.raiseEvent(msg.event);
+        break;
+      case INGRESS_TIME_EVENT:
+        break; // Só acorda a tarefa: as expirações são entregues logo abaixo
       }
-      // Lógica para o estado FINISHED_MESSAGE
-      else if (statechart.isStateActive(Statechart::main_region_FINISHED_MESSAGE))
+      // Eventos de tempo pendentes na roda, depois de qualquer mensagem: o aviso do timer pode ter
+      // sido descartado com a fila cheia
+      timerService.dispatchExpired();
+
+      bool validConfiguration = statechart.isStateConfigurationValid();
+      runCycleStats.record(ESP.getCycleCount() - messageStartCycles, validConfiguration);
+      if (!validConfiguration)
       {
-        // Apenas um timeout fará a transição para IDLE. Definido no Itemis
-        // Ignora qualquer tecla pressionada para evitar interferência na mensagem
-        callback.inputBuffer = ""; // Sempre limpa o buffer
-        Serial.println("StateMachineTask: Tecla ignorada no estado FINISHED_MESSAGE.");
+        Serial.printf("StateMachineTask: ERRO! Configuracao de estados invalida (%d).\n", (int)statechart.getActiveLeafState());
       }
+      statechartIngress.markProcessed(msg);
 
-      // TODO: Adicionar o else if para Statechart::main_region_RECIPE_5 (Customizar) quando for implementado
-      // E também para o estado CUSTOM_SETUP (se for um menu com entrada de dados)
-
-      // Lógica para estados onde a entrada de teclado é inesperada (ex: durante um processo de aquecimento)
-      else
+      Statechart::StatechartStates leaf = statechart.getActiveLeafState();
+      if (previousLeaf == Statechart::main_region_IDLE && leaf != Statechart::main_region_IDLE)
       {
-        switch (receivedKey)
-        {
-        case 'A': // Assumindo 'A' como um botão universal para voltar ao MENU principal de receitas
-          // ENVIA COMANDO PARA ABORTAR O PROCESSO!
-          controlCmd.type = CMD_START_RECIPE_STEP;
-          xQueueSend(xControlQueue, &controlCmd, portMAX_DELAY); // Sinaliza para controlTask abortar
-
-          // Depois de sinalizar, a StateMachine pode transitar para IDLE ou um estado de Erro/Abortado
-          statechart.raiseMenu(); // Volta para o menu de receitas
-          callback.inputBuffer = "";
-          Serial.println("StateMachineTask: Tecla 'A' para voltar ao menu (ABORT).");
-          break;
-        default:
-          // Para qualquer outra tecla que não 'A' e não esperada no estado atual:
-          // Apenas limpa o buffer de entrada. Não redesenha a tela
-          // para evitar interromper uma tela de processo/progresso
-          callback.inputBuffer = "";
-          Serial.println("StateMachineTask: Tecla ignorada no estado atual.");
-          break;
-        }
+        ControlCommand controlCmd = {CMD_CANCEL_AUTOTUNE};
+        xQueueSend(xControlQueue, &controlCmd, portMAX_DELAY);
       }
+      previousLeaf = leaf;
     }
 
     // Lógica de limpeza do inputBuffer após um timeout (se o usuário parar de digitar no keypad)
     if (callback.inputBuffer.length() > 0 && (millis() - callback.lastKeyPressTime > 3000))
     {
       callback.inputBuffer = ""; // Limpa o buffer
-      // Redesenha a tela atual para remover o "Digitado: " que estava aparecendo
-      if (statechart.isStateActive(Statechart::main_region_IDLE))
-      {
-        callback.showIdleScreen();
-      }
-      else if (statechart.isStateActive(Statechart::main_region_MENU))
-      {
-        callback.showRecipes();
-      }
-      else if (statechart.isStateActive(Statechart::main_region_RECIPE_1))
-      {
-        callback.showRecipe(1);
-      }
-      else if (statechart.isStateActive(Statechart::main_region_RECIPE_2))
-      {
-        callback.showRecipe(2);
-      }
-      else if (statechart.isStateActive(Statechart::main_region_RECIPE_3))
-      {
-        callback.showRecipe(3);
-      }
-      else if (statechart.isStateActive(Statechart::main_region_RECIPE_4))
-      {
-        callback.showRecipe(4);
-      }
-      else if (statechart.isStateActive(Statechart::main_region_RECIPE_5))
-      {
-        callback.showRecipe(5); // Para Customizar
-      }
-      // Tratamento para o estado FINISHED_MESSAGE
-      else if (statechart.isStateActive(Statechart::main_region_FINISHED_MESSAGE))
-      {
-        // A tela FINISHED_MESSAGE já tem um timer para voltar, não precisa redesenhar por timeout
-        // Se o usuário digitou algo, apenas limpa o buffer sem redesenhar
-      }
+      // Redesenha a tela atual para remover o "Digitado: " que estava aparecendo.
+      // Em FINISHED_MESSAGE a tela não tem redesenho: o timer do modelo volta ao IDLE.
+      redrawKeyScreen(keyMapForState(statechart.getActiveLeafState()));
     }
   }
 }
 
+/**
+ * @brief Trata uma tecla recebida pela stateMachineTask.
+ * @details Atualiza o buffer de entrada e dispara o evento da statechart correspondente
+ * à tecla no estado ativo. Executada apenas no contexto da stateMachineTask.
+ * @param receivedKey Tecla recebida da fila de entrada.
+ */
+void processKeypadKey(char receivedKey)
+{
+  Serial.print("StateMachineTask: Tecla recebida: ");
+  Serial.println(receivedKey);
+
+  // Atualiza o buffer de entrada do teclado no callback
+  callback.inputBuffer += receivedKey;
+  callback.lastKeyPressTime = millis(); // Timestamp da última tecla (para timeout)
+
+  // Consulta O(1) do mapa de teclas do estado ativo (tabela em KeypadDispatch.h)
+  const StateKeyMap &keyMap = keyMapForState(statechart.getActiveLeafState());
+  const KeyBinding *binding = findKeyBinding(keyMap, receivedKey);
+
+  if (binding == nullptr)
+  {
+    switch (keyMap.fallback)
+    {
+    case KEY_FALLBACK_REDRAW:
+      // Tecla inválida: redesenha a tela do estado com o input atualizado
+      redrawKeyScreen(keyMap);
+      callback.printKeypadInput(); // Imprime o "Digitado: " na tela
+      break;
+    case KEY_FALLBACK_IGNORE:
+      // Tecla não esperada no estado atual (ex: durante um processo de aquecimento):
+      // apenas limpa o buffer, sem redesenhar para não interromper a tela de progresso
+      callback.inputBuffer = "";
+      Serial.println("StateMachineTask: Tecla ignorada no estado atual.");
+      break;
+    case KEY_FALLBACK_SILENT:
+      // Ex: FINISHED_MESSAGE, onde apenas o timeout do modelo faz a transição para IDLE
+      callback.inputBuffer = "";
+      Serial.println("StateMachineTask: Tecla ignorada no estado FINISHED_MESSAGE.");
+      break;
+    }
+    return;
+  }
+
+  switch (binding->action)
+  {
+  case KEY_ACTION_RAISE:
+    statechart.raiseEvent((statechart_events::StatechartEventName)binding->event);
+    break;
+  case KEY_ACTION_START_RECIPE:
+    // Define qual receita será processada e dispara o início do processo
+    callback.currentRecipeIdx = binding->arg;
+    startRecipeProcess((statechart_events::StatechartEventName)binding->event); // Processo + primeira etapa em um único ciclo
+    break;
+  case KEY_ACTION_PRINT_LOG:
+    readAndPrintLog();                     // Chama a função para imprimir o log
+    statechartIngress.printStats(Serial); // Estatísticas da fila de entrada (latência, perdas, reordenação)
+    timerService.printStats(Serial);      // Timers armados na roda e armações recusadas
+    keyPressStats.print(Serial);          // Run cycles e tempo por tecla
+    runCycleStats.print(Serial);          // Percentis por mensagem e configurações inválidas
+    brewSnapshotStore.printStats(Serial); // Gravações do snapshot de retomada
+    displayBatchStats.print(Serial);      // Comandos de display coalescidos por quadro
+    displayFlusher.printStats(Serial);    // Bytes e tempo por atualização do display
+    displayPacer.printStats(Serial);      // Cadência, prazos e latência tecla -> tela (RNF10)
+    i2cBus.printStats(Serial);            // Espera/ocupação do barramento e jitter do sensor
+    controlLoop.printStats(Serial);       // Período, jitter e prazos perdidos da controlTask
+    myPID.printStats(Serial);             // Ciclos de CPU por cálculo do PID
+    relayAutoTune.printStats(Serial);     // Situação e resultado do auto-tune
+    gainSchedule.printStats(Serial);      // Ganhos base e os últimos aplicados a uma etapa
+    pidGainsStore.printStats(Serial);     // Gravações dos ganhos do auto-tune
+    logWriterStats.print(Serial);         // Gravações no flash feitas pela loggerTask
+    controlLogRing.printStats(Serial, "log");
+    persistenceMailbox.printStats(Serial); // Snapshots/ganhos substituídos antes da gravação
+    controlStatusRing.printStats(Serial, "status");
+    screenCache.printStats(Serial);       // Desenho com a GFX x cópia do cache por tela
+    displayRenderStats.printStats(Serial); // Custo de desenho por tipo de comando
+    display.printTextStats(Serial);        // Caracteres escritos por bytes x pela GFX
+    temperatureGraph.printStats(Serial);   // Colunas do gráfico desenhadas de forma incremental
+#ifdef SC_TRACE_ENABLED
+    transitionTrace.printLatency(Serial); // Latência tecla -> tela (RNF10)
+#endif
+#ifdef HEAP_ALLOC_COUNTER
+    heapAllocCounter.printStats(Serial); // Alocações por tarefa e dos comandos de display
+#endif
+    break;
+  case KEY_ACTION_DUMP_TRACE:
+#ifdef SC_TRACE_ENABLED
+    transitionTrace.dumpBinary(Serial); // Despejo binário do trace (formato em TransitionTrace.h)
+#else
+    Serial.println("StateMachineTask: Trace desabilitado (compile com -D SC_TRACE_ENABLED).");
+#endif
+    break;
+  case KEY_ACTION_AUTOTUNE:
+  {
+    // O relé roda na controlTask; a statechart continua no IDLE
+    ControlCommand controlCmd = {binding->arg ? CMD_START_AUTOTUNE : CMD_CANCEL_AUTOTUNE};
+    controlCmd.targetTemperature = AUTOTUNE_SETPOINT;
+    xQueueSend(xControlQueue, &controlCmd, portMAX_DELAY);
+    Serial.println(binding->arg ? "StateMachineTask: Auto-tune do PID solicitado." : "StateMachineTask: Auto-tune do PID cancelado.");
+    break;
+  }
+  case KEY_ACTION_ABORT:
+  {
+    // ENVIA COMANDO PARA ABORTAR O PROCESSO!
+    ControlCommand controlCmd = {CMD_ABORT_PROCESS};
+    xQueueSend(xControlQueue, &controlCmd, portMAX_DELAY); // Sinaliza para controlTask abortar
+
+    // Depois de sinalizar, volta para o menu de receitas
+    statechart.raiseEvent((statechart_events::StatechartEventName)binding->event);
+    Serial.println("StateMachineTask: Tecla 'A' para voltar ao menu (ABORT).");
+    break;
+  }
+  }
+  callback.inputBuffer = "";
+}
+
+/**
+ * @brief Redesenha a tela associada ao mapa de teclas do estado ativo.
+ * @param keyMap Mapa de teclas do estado (ver KeypadDispatch.h).
+ */
+void redrawKeyScreen(const StateKeyMap &keyMap)
+{
+  switch (keyMap.screen)
+  {
+  case KEY_SCREEN_IDLE:
+    callback.showIdleScreen(); // Redesenha a tela "Bem-vindo"
+    break;
+  case KEY_SCREEN_RECIPES:
+    callback.showRecipes(); // Redesenha a lista de receitas
+    break;
+  case KEY_SCREEN_RECIPE_DETAILS:
+    callback.showRecipe(keyMap.screenArg); // ID 1-baseado da receita
+    break;
+  case KEY_SCREEN_NONE:
+    break;
+  }
+}
+
+/**
+ * @brief Dispara o início de uma receita usando a API de eventos em lote da statechart.
+ * @details O evento de processo e o `start_first_step` são enfileirados juntos e
+ * processados em um único run cycle, na mesma ordem em que eram disparados antes.
+ * @param processEvent Evento `recipe_N_process` da receita escolhida.
+ */
+void startRecipeProcess(statechart_events::StatechartEventName processEvent)
+{
+  const statechart_events::StatechartEventName events[] = {processEvent, statechart_events::start_first_step};
+  statechart.raiseEvents(events, 2);
+}
+
+/**
+ * @brief Retoma o processo interrompido a partir do snapshot.
+ * @details Restaura o estado folha e as variáveis da statechart sem executar ações de entrada,
+ * restaura a receita/etapa no callback, reinicializa os periféricos e envia à controlTask a
+ * etapa com o tempo já cumprido e o integrador do PID. Executada na stateMachineTask.
+ * @param snapshot Snapshot validado no setup().
+ */
+void resumeFromSnapshot(const BrewSnapshot &snapshot)
+{
+  statechart.setCustom_num_steps(snapshot.customNumSteps);
+  statechart.setCurrent_custom_step_idx(snapshot.currentCustomStepIdx);
+  statechart.setReceived_value(snapshot.receivedValue);
+  if (!statechart.restoreActiveState((Statechart::StatechartStates)snapshot.activeState))
+  {
+    Serial.println("Main: ERRO! Estado do snapshot invalido. Iniciando do IDLE.");
+    brewSnapshotStore.clear();
+    statechart.enter();
+    return;
+  }
+
+  callback.currentRecipeIdx = snapshot.recipeIdx;
+  callback.currentStepIdx = snapshot.stepIdx;
+  callback.resumeHardware();
+
+  ControlCommand controlCmd = {CMD_START_RECIPE_STEP};
+  controlCmd.recipeIndex = snapshot.recipeIdx;
+  controlCmd.stepIndex = snapshot.stepIdx;
+  controlCmd.targetTemperature = snapshot.targetTemperature;
+  controlCmd.durationMinutes = snapshot.durationMinutes;
+  controlCmd.resume = true;
+  controlCmd.resumeElapsedMillis = snapshot.elapsedMillis;
+  controlCmd.resumeSetpointReached = snapshot.setpointReached != 0;
+  controlCmd.resumePidIntegral = snapshot.pidIntegral;
+  controlCmd.customNumSteps = snapshot.customNumSteps;
+  controlCmd.currentCustomStepIdx = snapshot.currentCustomStepIdx;
+  controlCmd.receivedValue = snapshot.receivedValue;
+  xQueueSend(xControlQueue, &controlCmd, portMAX_DELAY);
+
+  Serial.printf("Main: Processo retomado na etapa %d em %lu us.\n",
+                snapshot.stepIdx + 1, (unsigned long)(micros() - restoreStartMicros));
+}
+
+/**
+ * @brief Publica um registro da controlTask sem bloquear.
+ * @param flags CONTROL_RECORD_* (o que os consumidores devem fazer com o registro).
+ * @details As linhas do log (CONTROL_RECORD_LOG/NEW_LOG) vão para a loggerTask e, com
+ * CONTROL_RECORD_STATUS, o registro também vai para a statusTask. Com a fila cheia o registro é
+ * descartado e contado (SpscRing): a controlTask nunca espera pelo flash nem pela tela. Snapshot,
+ * remoção do snapshot e ganhos não podem ser descartados e vão pela persistenceMailbox, que a
+ * loggerTask esvazia a cada despertar. A saída e o integrador do PID são lidos aqui, na própria
+ * controlTask; o integrador gravado no snapshot é o valor real do FloatPid.
+ * @param gains Ganhos do auto-tune copiados no registro (com CONTROL_RECORD_SAVE_GAINS).
+ */
+void publishControlRecord(uint8_t flags, int recipeIdx, int stepIdx, int targetTemp, int durationMinutes,
+                          uint32_t elapsedMillis, bool setpointReached, float temperature, int remainingSeconds,
+                          const PidGains *gains)
+{
+  ControlRecord record = {};
+  record.timestampMillis = millis();
+  record.stepElapsedMillis = elapsedMillis;
+  record.temperature = temperature;
+  record.output = Output;
+  record.pidIntegral = myPID.integral();
+  record.targetTemperature = (int16_t)targetTemp;
+  record.durationMinutes = (int16_t)durationMinutes;
+  record.remainingSeconds = (int16_t)remainingSeconds;
+  record.recipeIdx = (int8_t)recipeIdx;
+  record.stepIdx = (int8_t)stepIdx;
+  record.setpointReached = setpointReached;
+  record.flags = flags;
+  record.customNumSteps = (int8_t)activeCustomVars.numSteps;
+  record.currentCustomStepIdx = (int8_t)activeCustomVars.stepIdx;
+  record.receivedValue = (int16_t)activeCustomVars.receivedValue;
+  if (gains != nullptr)
+  {
+    record.gainKp = gains->kp;
+    record.gainKi = gains->ki;
+    record.gainKd = gains->kd;
+    record.gainUltimate = gains->ultimateGain;
+    record.gainUltimatePeriodSec = gains->ultimatePeriodSec;
+  }
+
+  bool notifyLogger = false;
+  if (flags & CONTROL_RECORD_CLEAR_SNAPSHOT)
+  {
+    persistenceMailbox.postClearSnapshot();
+    notifyLogger = true;
+  }
+  if (flags & CONTROL_RECORD_SNAPSHOT)
+  {
+    persistenceMailbox.postSnapshot(record);
+    notifyLogger = true;
+  }
+  if (flags & CONTROL_RECORD_SAVE_GAINS)
+  {
+    persistenceMailbox.postGains(record);
+    notifyLogger = true;
+  }
+  if ((flags & (CONTROL_RECORD_LOG | CONTROL_RECORD_NEW_LOG)) && controlLogRing.push(record))
+  {
+    notifyLogger = true;
+  }
+  if (notifyLogger)
+  {
+    xTaskNotifyGive(loggerTaskHandle);
+  }
+  if ((flags & CONTROL_RECORD_STATUS) && controlStatusRing.push(record))
+  {
+    xTaskNotifyGive(statusTaskHandle);
+  }
+}
+
+/**
+ * @brief Grava o snapshot do processo em andamento.
+ * @param record Registro publicado pela controlTask no início de cada etapa, ao atingir o setpoint
+ * e a cada BREW_SNAPSHOT_PERIOD_MS.
+ * @details Chamada pela loggerTask. Só lê o registro: as variáveis da receita personalizada vêm
+ * nele (enviadas pela stateMachineTask no CMD_START_RECIPE_STEP), não da statechart.
+ */
+void saveBrewSnapshot(const ControlRecord &record)
+{
+  BrewSnapshot snapshot = {};
+  // Etapas só rodam no CONTROL_PROCESS_LOOP; ler o stateConfVector daqui correria com a ação de
+  // entrada do estado (o comando da etapa é enviado antes de o estado ser marcado como ativo)
+  snapshot.activeState = (uint8_t)Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP;
+  snapshot.recipeIdx = record.recipeIdx;
+  snapshot.stepIdx = record.stepIdx;
+  snapshot.setpointReached = record.setpointReached ? 1 : 0;
+  snapshot.targetTemperature = record.targetTemperature;
+  snapshot.durationMinutes = record.durationMinutes;
+  snapshot.elapsedMillis = record.stepElapsedMillis;
+  snapshot.customNumSteps = record.customNumSteps;
+  snapshot.currentCustomStepIdx = record.currentCustomStepIdx;
+  snapshot.receivedValue = record.receivedValue;
+  snapshot.pidOutput = record.output;
+  snapshot.pidIntegral = record.pidIntegral;
+  if (!brewSnapshotStore.save(snapshot))
+  {
+    Serial.println("ERRO: Nao foi possivel gravar o snapshot do processo.");
+  }
+}
+
 /**
  * @brief Tarefa para gerenciar todas as operações de exibição no display OLED.
  * @param pvParameters Parâmetro da tarefa (não utilizado).
+ * @details A cada quadro, espera o primeiro comando e continua retirando comandos da fila até o
+ * intervalo mínimo entre quadros (DISPLAY_MAX_FPS) passar ou o lote encher. Os comandos cujo desenho
+ * seria apagado por completo por um comando posterior do lote são descartados (o resultado no
+ * framebuffer é o mesmo), os demais são desenhados em ordem e o quadro é publicado na displayMailbox.
+ * O envio I2C fica com a displayFlushTask: enquanto ele acontece, esta tarefa já pode receber e
+ * desenhar o próximo quadro.
  */
 void displayTask(void *pvParameters)
 {
   (void)pvParameters; // Evita warning de parâmetro não utilizado
+  HEAP_ALLOC_TRACK_TASK();
 
-  DisplayCommand cmd;
+  DisplayCommand batch[DISPLAY_QUEUE_LENGTH];
   for (;;)
   {
     // Espera por comandos na fila do display (bloqueia até um comando ser recebido)
-    if (xQueueReceive(xDisplayQueue, &cmd, portMAX_DELAY) == pdPASS)
+    if (xQueueReceive(xDisplayQueue, &batch[0], portMAX_DELAY) != pdPASS)
+    {
+      continue;
+    }
+    uint32_t firstCommandMicros = micros();
+    // Acumula os comandos que chegarem até o próximo quadro poder começar (sem esperar se já pode);
+    // com o lote cheio o quadro começa antes, para não bloquear quem envia
+    uint8_t count = 1;
+    while (count < DISPLAY_QUEUE_LENGTH && xQueueReceive(xDisplayQueue, &batch[count], displayPacer.ticksUntilNextFrame()) == pdPASS)
+    {
+      count++;
+    }
+    uint32_t renderStartMicros = micros();
+    displayPacer.frameStarted(renderStartMicros);
+
+    // Do mais novo para o mais antigo: um comando é descartado se todas as páginas que ele
+    // apaga ou desenha forem apagadas por algum comando posterior
+    bool keep[DISPLAY_QUEUE_LENGTH];
+    uint8_t clearedLater = 0;
+    uint8_t dropped = 0;
+    for (int8_t i = count - 1; i >= 0; --i)
     {
-      if (cmd.clearScreen)
-      { // Limpa a tela apenas se o comando exigir
-        display.clearDisplay();
+      uint8_t touched = displayCommandDrawnPages(batch[i]) | displayCommandClearedPages(batch[i]);
+      keep[i] = (touched & ~clearedLater) != 0;
+      if (!keep[i])
+      {
+        dropped++;
+        continue;
       }
-      display.setCursor(0, 0); // Reinicia o cursor no topo esquerdo para a maioria dos desenhos
+      clearedLater |= displayCommandClearedPages(batch[i]);
+    }
 
-      // Processa o tipo de comando recebido
-      switch (cmd.type)
+    {
+      HEAP_ALLOC_SCOPE(HEAP_SCOPE_DISPLAY_RENDER);
+      for (uint8_t i = 0; i < count; ++i)
       {
-      case CMD_CLEAR_DISPLAY:
-        display.clearDisplay(); // Limpeza explícita
-        break;
-      case CMD_SHOW_STATE_INFO:
-        // Desenha o nome do estado no topo, sem limpar o resto da tela
-        display.fillRect(0, 0, SCREEN_WIDTH, 8, SSD1306_BLACK); // Limpa a linha superior
-        display.setCursor(0, 0);
-        display.print("Estado: ");
-        display.println(cmd.text);
-        break;
-      case CMD_SHOW_MAIN_MENU_SCREEN: // Tela IDLE: "Bem-vindo", "1-Iniciar", "2-Sair"
-        display.println("Bem-vindo!");
-        display.setCursor(0, 16);
-        display.println("1 - Iniciar");
-        display.println("2 - Sair");
-        break;
-      case CMD_SHOW_STARTUP_MESSAGE: // Mensagem de inicialização (apenas texto)
-        display.println("Executando showStartup()");
-        break;
-      case CMD_SHOW_RECIPES_LIST: // Menu de seleção de receitas
-        display.println("Receitas:");
-        display.setCursor(0, 16);
-        display.println("1- American Pale Ale");
-        display.println("2- Witbier");
-        display.println("3- Belgian Dubbel");
-        display.println("4- Bohemian Pilsen");
-        display.println("5- Customizar");
-        break;
-      case CMD_SHOW_RECIPE_DETAILS_SCREEN:
-      { // Detalhes de uma receita específica
-        if (cmd.recipeId >= 0 && cmd.recipeId < NUM_RECIPES)
+        if (keep[i])
         {
-          const Recipe &currentRecipe = recipes[cmd.recipeId];
-
-          display.println(currentRecipe.name);
-          display.print("Etapas: ");
-          display.println(currentRecipe.numSteps);
-          display.println();
-
-          int yPos = 32; // Posição Y inicial para as etapas
-          for (int i = 0; i < currentRecipe.numSteps; ++i)
-          {
-            if (yPos + 8 > SCREEN_HEIGHT - 16)
-            { // Verifica se há espaço antes de imprimir
-              // Se não houver espaço para mais etapas, podemos indicar que há mais
-              display.setCursor(0, yPos);
-              display.println("...mais etapas");
-              break; // Sai do loop para não estourar a tela
-            }
-            display.setCursor(0, yPos);
-            display.print("* ");
-            display.print(currentRecipe.steps[i].name);
-            display.print(" ");
-            display.print(currentRecipe.steps[i].temperature);
-            display.print(" C ");
-            display.print(currentRecipe.steps[i].duration);
-            display.println(" min");
-            yPos += 8; // Avança para a próxima linha
-          }
-          display.println(); // Pula uma linha
-          // Posiciona as opções de iniciar/voltar no final da tela
-          display.setCursor(0, SCREEN_HEIGHT - 16); // 2 linhas de 8 pixels cada
-          display.println("1 - Iniciar Receita");
-          display.println("2 - Voltar as Receitas");
+          renderDisplayCommand(batch[i]);
         }
-        else
+        else if (batch[i].type == CMD_PLOT_TEMPERATURE_SAMPLE)
         {
-          display.println("ERRO: Receita invalida!");
+          temperatureGraph.push(batch[i].sample); // A tela será apagada, mas a amostra fica no histórico
         }
-        break;
       }
-      // CASE para exibir o status do processo
-      case CMD_SHOW_PROCESS_STATUS_SCREEN:
-        display.println("Processo Ativo:");
-        display.setCursor(0, 16);  // Posiciona abaixo do título
-        display.println(cmd.text); // Imprime a string de status preparada
-        break;
-      // CASE para exibir mensagem de conclusão
-      case CMD_SHOW_FINISHED_MESSAGE_SCREEN:
-        display.println("Processo Concluido!");
-        display.setCursor(0, 16);
-        display.println("Receita finalizada.");
-        display.setCursor(0, 32);
-        display.println("Voltando ao menu principal...");
-        break;
-      case CMD_PRINT_KEYPAD_INPUT: // Imprime o texto digitado pelo teclado
-        // Localiza a posição para o texto digitado (geralmente no rodapé)
-        display.fillRect(0, SCREEN_HEIGHT - 8, SCREEN_WIDTH, 8, SSD1306_BLACK); // Limpa a última linha
-        display.setCursor(0, SCREEN_HEIGHT - 8);                                // Última linha do display
-        display.println(cmd.text);
-        break;
-      }
-      display.display(); // Atualiza o display físico com todas as alterações
     }
+
+    FrameInfo info = {};
+    info.firstCommandMicros = firstCommandMicros;
+    info.renderStartMicros = renderStartMicros;
+    info.lastCommandType = batch[count - 1].type;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+      info.addInput(batch[i].inputMicros); // Inclusive comandos coalescidos: a tela já mostra a resposta
+    }
+    displayMailbox.post(display.getBuffer(), info);
+    xTaskNotifyGive(displayFlushTaskHandle);
+    displayBatchStats.record(count, dropped);
     // A tarefa não precisa de delay explícito aqui se está esperando em xQueueReceive com portMAX_DELAY
   }
 }
 
+/**
+ * @brief Tarefa que envia ao display físico os quadros publicados pela displayTask.
+ * @param pvParameters Parâmetro da tarefa (não utilizado).
+ * @details Acorda a cada notificação e envia o quadro mais recente da displayMailbox (só as
+ * páginas alteradas). A transferência I2C do driver do ESP32 é feita por interrupção: durante
+ * ela a tarefa fica bloqueada e a CPU livre para as demais. Ao fim de cada envio registra o prazo
+ * do quadro e a latência tecla -> tela.
+ */
+void displayFlushTask(void *pvParameters)
+{
+  (void)pvParameters; // Evita warning de parâmetro não utilizado
+
+  FrameInfo info;
+  for (;;)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    const uint8_t *frame;
+    while ((frame = displayMailbox.take(info)) != nullptr)
+    {
+      displayFlusher.flush(frame); // Atualiza no display físico apenas as páginas alteradas
+      uint32_t doneMicros = micros();
+      displayPacer.recordFrame(info.firstCommandMicros, info.renderStartMicros, doneMicros);
+      for (uint8_t i = 0; i < info.inputCount; ++i)
+      {
+        displayPacer.recordInput(info.inputMicros[i], doneMicros);
+      }
+      SC_TRACE_MARK(TRACE_MARK_DISPLAY_FLUSHED, info.lastCommandType);
+    }
+  }
+}
+
+/**
+ * @brief Exibe um comando de display no framebuffer (sem enviar ao display físico).
+ * @param cmd Comando recebido pela displayTask.
+ * @details Telas estáticas completas são copiadas do screenCache; os demais comandos são
+ * desenhados por drawDisplayCommand() (DisplayRender.h) e as amostras de temperatura pelo
+ * temperatureGraph. O tempo de cada um entra em displayRenderStats.
+ */
+void renderDisplayCommand(const DisplayCommand &cmd)
+{
+  uint32_t startMicros = micros();
+  if (cmd.type == CMD_PLOT_TEMPERATURE_SAMPLE)
+  {
+    temperatureGraph.plot(cmd.sample, display.getBuffer());
+  }
+  else if (!screenCache.load(ScreenCache::screenFor(cmd), display.getBuffer()))
+  {
+    drawDisplayCommand(display, cmd);
+  }
+
+  if (cmd.type == CMD_SHOW_PROCESS_STATUS_SCREEN)
+  {
+    temperatureGraph.show(display.getBuffer()); // Redesenha o gráfico se a tela anterior era outra
+  }
+  else if (cmd.type != CMD_PLOT_TEMPERATURE_SAMPLE &&
+           ((displayCommandClearedPages(cmd) | displayCommandDrawnPages(cmd)) & TEMP_GRAPH_PAGES_MASK))
+  {
+    temperatureGraph.invalidate();
+  }
+  displayRenderStats.record(cmd.type, micros() - startMicros);
+}
+
+/**
+ * @brief Desenha uma vez cada tela estática e guarda o framebuffer no screenCache.
+ * @details Chamada pelo setup() logo após display.begin(), antes de as tarefas existirem. O desenho
+ * é o mesmo de drawDisplayCommand(), então a tela copiada é idêntica à desenhada.
+ */
+void prerenderStaticScreens()
+{
+  for (int8_t screen = 0; screen < SCREEN_CACHE_SLOTS; ++screen)
+  {
+    DisplayCommand cmd = ScreenCache::commandFor(screen);
+    uint32_t startMicros = micros();
+    drawDisplayCommand(display, cmd); // clearScreen = true: parte do framebuffer limpo
+    screenCache.store(screen, display.getBuffer(), micros() - startMicros);
+  }
+  display.clearDisplay();
+}
+
+/**
+ * @brief Páginas apagadas por um comando antes de desenhar (bit p = linhas 8p a 8p+7).
+ * @param cmd Comando de display.
+ * @return Máscara de páginas cujo conteúdo anterior não sobrevive ao comando.
+ */
+uint8_t displayCommandClearedPages(const DisplayCommand &cmd)
+{
+  if (cmd.clearScreen || cmd.type == CMD_CLEAR_DISPLAY)
+  {
+    return 0xFF; // Tela inteira
+  }
+  switch (cmd.type)
+  {
+  case CMD_SHOW_STATE_INFO:
+    return 0x01; // Linha superior
+  case CMD_PRINT_KEYPAD_INPUT:
+    return 1 << (SCREEN_HEIGHT / 8 - 1); // Última linha
+  case CMD_SHOW_PROCESS_STATUS_SCREEN:
+    return (uint8_t)~TEMP_GRAPH_PAGES_MASK; // Linhas de texto (o gráfico é mantido)
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Páginas em que um comando pode desenhar.
+ * @param cmd Comando de display.
+ * @return Máscara de páginas; telas sem região definida ocupam a tela inteira.
+ */
+uint8_t displayCommandDrawnPages(const DisplayCommand &cmd)
+{
+  const uint16_t charsPerLine = SCREEN_WIDTH / 6; // Fonte padrão 5x7 + espaçamento, tamanho 1
+  switch (cmd.type)
+  {
+  case CMD_SHOW_STATE_INFO:
+  {
+    // "Estado: <nome>" quebra para as linhas seguintes quando não cabe na linha superior
+    uint16_t lines = (strlen("Estado: ") + strlen(cmd.text) + charsPerLine - 1) / charsPerLine;
+    return lines >= SCREEN_HEIGHT / 8 ? 0xFF : (uint8_t)((1 << lines) - 1);
+  }
+  case CMD_PRINT_KEYPAD_INPUT:
+    return 1 << (SCREEN_HEIGHT / 8 - 1); // A quebra de linha passa do fim da tela e não é desenhada
+  case CMD_SHOW_PROCESS_STATUS_SCREEN:
+    return (uint8_t)~TEMP_GRAPH_PAGES_MASK; // Texto sem quebra de linha; o gráfico é redesenhado a partir do histórico
+  case CMD_PLOT_TEMPERATURE_SAMPLE:
+    return TEMP_GRAPH_PAGES_MASK;
+  default:
+    return 0xFF;
+  }
+}
+
 /**
  * @brief Tarefa para gerenciar o processo de cozimento e controle PID.
  * @param pvParameters Parâmetro da tarefa (não utilizado).
  * @details Esta tarefa atua como o "cérebro" do processo de cozimento,
- * executando o PID, monitorando a temperatura, controlando a contagem
- * regressiva e registrando os dados do processo no LittleFS a cada segundo.
+ * executando o PID, monitorando a temperatura e controlando a contagem
+ * regressiva. Roda a cada CONTROL_PERIOD_MS em instantes absolutos (controlLoop) e só lê o sensor,
+ * calcula e aplica o PWM: o log no LittleFS, o snapshot e a tela de status são publicados como
+ * ControlRecord para a loggerTask e a statusTask (publishControlRecord), sem esperar por elas.
  */
 void controlTask(void *pvParameters)
 {
   (void)pvParameters;
+  HEAP_ALLOC_TRACK_TASK();
 
   ControlCommand receivedControlCmd;
   TemperatureData currentSensorTempData;
@@ -616,6 +1174,11 @@ void controlTask(void *pvParameters)
 
   bool logHeaderWritten = false; // NOVO
 
+  unsigned long lastSnapshotMillis = 0; // Última gravação periódica do snapshot
+
+  GainRamp gainRamp; // Troca gradual dos ganhos no início de cada etapa (GainSchedule.h)
+
+  controlLoop.start();
   for (;;)
   {
     // --- Processar Comandos da Fila de Controle (xControlQueue) ---
@@ -624,6 +1187,7 @@ void controlTask(void *pvParameters)
       switch (receivedControlCmd.type)
       {
       case CMD_START_RECIPE_STEP:
+        relayAutoTune.cancel(); // Uma receita tem precedência sobre o auto-tune
         activeRecipeIdx = receivedControlCmd.recipeIndex;
         activeStepIdx = receivedControlCmd.stepIndex;
 
@@ -634,43 +1198,97 @@ void controlTask(void *pvParameters)
           {
             currentTargetTemp = receivedControlCmd.targetTemperature;
             currentDurationMinutes = receivedControlCmd.durationMinutes;
+            activeCustomVars.numSteps = receivedControlCmd.customNumSteps;
+            activeCustomVars.stepIdx = receivedControlCmd.currentCustomStepIdx;
+            activeCustomVars.receivedValue = receivedControlCmd.receivedValue;
 
             stepActive = true;
 
-            Setpoint = (double)currentTargetTemp;
-            myPID.SetMode(AUTOMATIC);
-
+            // Setpoint antes dos ganhos: em AUTOMATIC o FloatPid compensa cada troca no integrador
+            // com o erro do novo setpoint
+            Setpoint = (float)currentTargetTemp;
             setpointReachedForTiming = false;
 
-            Serial.printf("ControlTask: INICIADA ETAPA '%s'. Alvo: %dC, Duracao: %dmin\n",
-                          (activeRecipeIdx == 4 ? "Customizada" : recipes[activeRecipeIdx].steps[activeStepIdx].name.c_str()), currentTargetTemp, currentDurationMinutes);
+            // Ganhos da etapa (RecipeStep::gains ou tabela por setpoint), aplicados em GAIN_RAMP_MS.
+            // Na retomada o integrador gravado é o desses ganhos: entram de uma vez
+            PidTunings tunings = gainSchedule.tuningsFor((float)currentTargetTemp, currentRecipeData.steps[activeStepIdx].gains);
+            if (receivedControlCmd.resume)
+            {
+              myPID.setTunings(tunings.kp, tunings.ki, tunings.kd);
+            }
+            else
+            {
+              gainRamp.start({myPID.getKp(), myPID.getKi(), myPID.getKd()}, tunings, millis());
+            }
 
-            // Lógica para escrever o cabeçalho do log APENAS UMA VEZ por receita
-            if (!logHeaderWritten)
+            if (receivedControlCmd.resume)
             {
-              File file = LittleFS.open("/brew_log.csv", FILE_WRITE); // Cria um novo arquivo (apaga o anterior)
-              if (file)
-              {
-                file.println("TempoSeg;TempAtual;SaidaPWM;Curva");
-                file.close();
-                logHeaderWritten = true;
-              }
-              else
-              {
-                Serial.println("ERRO: Nao foi possivel abrir o arquivo de log para o cabecalho.");
-              }
+              // Retomada após queda de energia: continua a contagem e o integrador do PID
+              setpointReachedForTiming = receivedControlCmd.resumeSetpointReached;
+              stepStartTimeMillis = millis() - receivedControlCmd.resumeElapsedMillis;
+              logHeaderWritten = true; // Mantém o log da receita interrompida
+              Serial.printf("ControlTask: RETOMADA com %lu s cumpridos.\n", (unsigned long)(receivedControlCmd.resumeElapsedMillis / 1000));
             }
+#ifdef HEAP_ALLOC_COUNTER
+            else if (activeStepIdx == 0)
+            {
+              heapAllocCounter.beginWindow(); // Alocações medidas da primeira etapa até o fim da receita
+            }
+#endif
+            myPID.setMode(PID_AUTOMATIC);
+            if (receivedControlCmd.resume)
+            {
+              myPID.setIntegral(receivedControlCmd.resumePidIntegral); // Mesmo que o PID já estivesse em AUTOMATIC
+            }
+
+            Serial.printf("ControlTask: INICIADA ETAPA '%s'. Alvo: %dC, Duracao: %dmin\n",
+                          (activeRecipeIdx == 4 ? "Customizada" : recipes[activeRecipeIdx].steps[activeStepIdx].name), currentTargetTemp, currentDurationMinutes);
+
+            // Início (ou retomada) da etapa: grava o snapshot; o cabeçalho do log APENAS UMA VEZ por receita
+            publishControlRecord(CONTROL_RECORD_SNAPSHOT | (logHeaderWritten ? 0 : CONTROL_RECORD_NEW_LOG),
+                                 activeRecipeIdx, activeStepIdx, currentTargetTemp, currentDurationMinutes,
+                                 setpointReachedForTiming ? millis() - stepStartTimeMillis : 0, setpointReachedForTiming,
+                                 actualCurrentTemp, currentDurationMinutes * 60);
+            logHeaderWritten = true;
+            lastSnapshotMillis = millis();
           }
         }
         break;
       case CMD_ABORT_PROCESS:
         Serial.println("ControlTask: Processo ABORTADO por comando.");
         stepActive = false;
-        myPID.SetMode(MANUAL);
+        myPID.setMode(PID_MANUAL);
         Output = 0;
         callback.controlHeaterPWM(0);
         setpointReachedForTiming = false;
         logHeaderWritten = false;
+        publishControlRecord(CONTROL_RECORD_CLEAR_SNAPSHOT, activeRecipeIdx, activeStepIdx, 0, 0, 0, false, actualCurrentTemp, 0); // Processo abortado: nada a retomar
+        break;
+      case CMD_FINISH_PROCESS:
+        publishControlRecord(CONTROL_RECORD_CLEAR_SNAPSHOT, activeRecipeIdx, activeStepIdx, 0, 0, 0, false, actualCurrentTemp, 0); // Processo concluído: nada a retomar
+#ifdef HEAP_ALLOC_COUNTER
+        heapAllocCounter.printWindow(Serial); // Alocações da receita completa
+#endif
+        break;
+      case CMD_START_AUTOTUNE:
+        if (!stepActive)
+        {
+          relayAutoTune.start((float)receivedControlCmd.targetTemperature,
+                              (float)((1 << statechart.getPwm_resolution_bits()) - 1), millis());
+          Serial.printf("ControlTask: AUTO-TUNE iniciado em %dC.\n", receivedControlCmd.targetTemperature);
+        }
+        break;
+      case CMD_CANCEL_AUTOTUNE:
+        relayAutoTune.cancel();
+        break;
+      case CMD_SHUTDOWN:
+        Serial.println("ControlTask: Sistema DESLIGADO; aquecedor desligado.");
+        relayAutoTune.cancel();
+        stepActive = false;
+        myPID.setMode(PID_MANUAL);
+        Output = 0;
+        callback.controlHeaterPWM(0);
+        setpointReachedForTiming = false;
         break;
       }
     }
@@ -679,7 +1297,7 @@ void controlTask(void *pvParameters)
     if (xQueueReceive(xSensorQueue, &currentSensorTempData, 0) == pdPASS)
     {
       actualCurrentTemp = currentSensorTempData.temperature1;
-      Input = (double)actualCurrentTemp;
+      Input = actualCurrentTemp;
     }
 
     // --- Lógica de Controle/Monitoramento da Etapa ---
@@ -693,12 +1311,13 @@ void controlTask(void *pvParameters)
           setpointReachedForTiming = true;
           stepStartTimeMillis = millis();
           Serial.printf("ControlTask: Setpoint %dC atingido! Iniciando contagem de %d minutos.\n", currentTargetTemp, currentDurationMinutes);
+          publishControlRecord(CONTROL_RECORD_SNAPSHOT, activeRecipeIdx, activeStepIdx, currentTargetTemp,
+                               currentDurationMinutes, 0, true, actualCurrentTemp, currentDurationMinutes * 60);
+          lastSnapshotMillis = millis();
         }
       }
 
       int remainingTimeSeconds;
-      int displayMinutes;
-      int displaySeconds;
 
       if (setpointReachedForTiming)
       {
@@ -706,50 +1325,157 @@ void controlTask(void *pvParameters)
         remainingTimeSeconds = (currentDurationMinutes * 60) - (elapsedTimeMillis / 1000);
         if (remainingTimeSeconds < 0)
           remainingTimeSeconds = 0;
-
-        displayMinutes = remainingTimeSeconds / 60;
-        displaySeconds = remainingTimeSeconds % 60;
       }
       else
       {
         remainingTimeSeconds = currentDurationMinutes * 60;
-        displayMinutes = remainingTimeSeconds / 60;
-        displaySeconds = remainingTimeSeconds % 60;
       }
 
-      myPID.Compute();
+      if (gainRamp.active())
+      {
+        PidTunings rampTunings = gainRamp.at(millis());
+        myPID.setTunings(rampTunings.kp, rampTunings.ki, rampTunings.kd);
+      }
+      if (!myPID.compute())
+      {
+        controlLoop.recordSkippedCompute();
+      }
       int calculated_duty_cycle = (int)Output;
       callback.controlHeaterPWM(calculated_duty_cycle);
+      controlLoop.recordActuation();
 
-      // --- Atualizar Display e SALVAR LOG Periodicamente (a cada 1 segundo) ---
+      // --- Log e tela de status (a cada 1 segundo) e snapshot periódico: publicados para a loggerTask/statusTask ---
       static unsigned long lastDisplayUpdate = 0;
+      uint8_t recordFlags = 0;
       if (millis() - lastDisplayUpdate >= 1000)
       {
         lastDisplayUpdate = millis();
-        const Recipe &recipeForDisplay = recipes[activeRecipeIdx];
-        const char *stepNameForDisplay;
-        if (activeRecipeIdx == 4)
+        recordFlags |= CONTROL_RECORD_LOG | CONTROL_RECORD_STATUS;
+      }
+      if (millis() - lastSnapshotMillis >= BREW_SNAPSHOT_PERIOD_MS)
+      {
+        lastSnapshotMillis = millis();
+        recordFlags |= CONTROL_RECORD_SNAPSHOT;
+      }
+      if (recordFlags != 0)
+      {
+        publishControlRecord(recordFlags, activeRecipeIdx, activeStepIdx, currentTargetTemp, currentDurationMinutes,
+                             setpointReachedForTiming ? millis() - stepStartTimeMillis : 0, setpointReachedForTiming,
+                             actualCurrentTemp, remainingTimeSeconds);
+      }
+
+      // --- Detecção de Término de Etapa ---
+      if (setpointReachedForTiming && remainingTimeSeconds == 0)
+      {
+        Serial.println("ControlTask: ETAPA CONCLUIDA! Disparando step_finished.");
+        stepActive = false;
+        myPID.setMode(PID_MANUAL);
+        Output = 0;
+        callback.controlHeaterPWM(0);
+        statechartIngress.postEvent(statechart_events::step_finished, INGRESS_FROM_CONTROL); // Processado pela stateMachineTask
+      }
+    }
+    else if (relayAutoTune.running())
+    { // Auto-tune: o relé substitui o PID (que fica em MANUAL) até os ganhos serem calculados
+      Output = relayAutoTune.update(actualCurrentTemp, millis());
+      callback.controlHeaterPWM((int)Output);
+      controlLoop.recordActuation();
+      if (relayAutoTune.getState() == AUTOTUNE_DONE)
+      {
+        PidGains gains = relayAutoTune.result();
+        gainSchedule.setBase({gains.kp, gains.ki, gains.kd}); // Aplicados a partir da próxima etapa
+        publishControlRecord(CONTROL_RECORD_SAVE_GAINS, -1, -1, AUTOTUNE_SETPOINT, 0, 0, false, actualCurrentTemp, 0, &gains);
+        Serial.printf("ControlTask: AUTO-TUNE concluido: Ku=%.1f Pu=%.1fs -> Kp=%.2f Ki=%.3f Kd=%.2f\n",
+                      (double)gains.ultimateGain, (double)gains.ultimatePeriodSec,
+                      (double)gains.kp, (double)gains.ki, (double)gains.kd);
+      }
+      else if (relayAutoTune.getState() == AUTOTUNE_FAILED)
+      {
+        Serial.println("ControlTask: AUTO-TUNE falhou; ganhos mantidos ('*' mostra o motivo).");
+      }
+    }
+    else
+    { // Se o processo não está ativo
+      myPID.setMode(PID_MANUAL);
+      Output = 0;
+      callback.controlHeaterPWM(0);
+    }
+
+    controlLoop.waitNextPeriod(); // Próximo período da grade fixa, independente da duração do trabalho
+  }
+}
+
+/**
+ * @brief Tarefa que grava no LittleFS o log CSV, o snapshot e os ganhos a partir da controlTask.
+ * @param pvParameters Parâmetro da tarefa (não utilizado).
+ * @details Único consumidor do controlLogRing e da persistenceMailbox. Roda abaixo da controlTask:
+ * o tempo das gravações no flash (logWriterStats) não atrasa mais o cálculo do PID nem o PWM.
+ * A cada despertar grava primeiro os pedidos da persistenceMailbox (remoção antes do snapshot
+ * posterior a ela), depois as linhas do log.
+ */
+void loggerTask(void *pvParameters)
+{
+  (void)pvParameters; // Evita warning de parâmetro não utilizado
+
+  ControlRecord record;
+  PersistenceMailbox::Pending pending;
+  for (;;)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (persistenceMailbox.take(pending))
+    {
+      uint32_t startMicros = micros();
+      if (pending.clearSnapshot)
+      {
+        brewSnapshotStore.clear();
+      }
+      if (pending.snapshot)
+      {
+        saveBrewSnapshot(pending.snapshotRecord);
+      }
+      if (pending.gains)
+      {
+        // Cópia publicada pela controlTask: o RelayAutoTune pode já ter sido reiniciado
+        PidGains gains = {};
+        gains.kp = pending.gainsRecord.gainKp;
+        gains.ki = pending.gainsRecord.gainKi;
+        gains.kd = pending.gainsRecord.gainKd;
+        gains.ultimateGain = pending.gainsRecord.gainUltimate;
+        gains.ultimatePeriodSec = pending.gainsRecord.gainUltimatePeriodSec;
+        if (!pidGainsStore.save(gains))
+        {
+          Serial.println("ERRO: Nao foi possivel gravar os ganhos do auto-tune.");
+        }
+      }
+      logWriterStats.record(micros() - startMicros);
+    }
+    while (controlLogRing.pop(record))
+    {
+      uint32_t startMicros = micros();
+      if (record.flags & CONTROL_RECORD_NEW_LOG)
+      {
+        File file = LittleFS.open("/brew_log.csv", FILE_WRITE); // Cria um novo arquivo (apaga o anterior)
+        if (file)
         {
-          char tempBuffer[20];
-          sprintf(tempBuffer, "Etapa %d", activeStepIdx + 1);
-          stepNameForDisplay = tempBuffer;
+          file.println("TempoSeg;TempAtual;SaidaPWM;Curva");
+          file.close();
         }
         else
         {
-          stepNameForDisplay = recipeForDisplay.steps[activeStepIdx].name.c_str();
+          Serial.println("ERRO: Nao foi possivel abrir o arquivo de log para o cabecalho.");
         }
-
-        // Salva no arquivo de log
+      }
+      if (record.flags & CONTROL_RECORD_LOG)
+      {
         File file = LittleFS.open("/brew_log.csv", FILE_APPEND);
         if (file)
         {
           char logEntry[150];
-          unsigned long timeInSeconds = millis() / 1000;
-          sprintf(logEntry, "%lu;%.2f;%.0f;%d",
-                  timeInSeconds,
-                  actualCurrentTemp,
-                  Output,
-                  activeStepIdx + 1);
+          snprintf(logEntry, sizeof(logEntry), "%lu;%.2f;%.0f;%d",
+                   (unsigned long)(record.timestampMillis / 1000),
+                   record.temperature,
+                   record.output,
+                   record.stepIdx + 1);
           file.println(logEntry);
           file.close();
         }
@@ -757,37 +1483,58 @@ void controlTask(void *pvParameters)
         {
           Serial.println("ERRO: Nao foi possivel abrir o arquivo de log para escrita.");
         }
-
-        callback.showProcessStatus(
-            static_cast<sc_integer>(actualCurrentTemp),
-            currentTargetTemp,
-            displayMinutes,
-            displaySeconds,
-            const_cast<sc_string>(stepNameForDisplay),
-            activeStepIdx + 1,
-            (activeRecipeIdx == 4 ? statechart.getCustom_num_steps() : recipeForDisplay.numSteps),
-            !setpointReachedForTiming);
       }
+      logWriterStats.record(micros() - startMicros);
+    }
+  }
+}
 
-      // --- Detecção de Término de Etapa ---
-      if (setpointReachedForTiming && remainingTimeSeconds == 0)
+/**
+ * @brief Tarefa que monta a tela de status do processo a partir dos registros da controlTask.
+ * @param pvParameters Parâmetro da tarefa (não utilizado).
+ * @details Único consumidor do controlStatusRing: formata o texto do status e a amostra do gráfico
+ * e os envia para a displayTask. Usa só o registro (receita e número de etapas da receita
+ * personalizada), nada da statechart nem do callback, que são da stateMachineTask.
+ */
+void statusTask(void *pvParameters)
+{
+  (void)pvParameters; // Evita warning de parâmetro não utilizado
+
+  ControlRecord record;
+  for (;;)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (controlStatusRing.pop(record))
+    {
+      if (record.recipeIdx < 0 || record.recipeIdx >= NUM_RECIPES)
       {
-        Serial.println("ControlTask: ETAPA CONCLUIDA! Disparando step_finished.");
-        stepActive = false;
-        myPID.SetMode(MANUAL);
-        Output = 0;
-        callback.controlHeaterPWM(0);
-        statechart.raiseStep_finished();
+        continue;
+      }
+      const Recipe &recipeForDisplay = recipes[record.recipeIdx];
+      const char *stepNameForDisplay;
+      char tempBuffer[20]; // Precisa viver até o showProcessStatusFor abaixo
+      if (record.recipeIdx == 4)
+      {
+        snprintf(tempBuffer, sizeof(tempBuffer), "Etapa %d", record.stepIdx + 1);
+        stepNameForDisplay = tempBuffer;
+      }
+      else
+      {
+        stepNameForDisplay = recipeForDisplay.steps[record.stepIdx].name;
       }
-    }
-    else
-    { // Se o processo não está ativo
-      myPID.SetMode(MANUAL);
-      Output = 0;
-      callback.controlHeaterPWM(0);
-    }
 
-    vTaskDelay(100 / portTICK_PERIOD_MS);
+      callback.showProcessStatusFor(
+          record.recipeIdx,
+          static_cast<int>(record.temperature),
+          record.targetTemperature,
+          record.remainingSeconds / 60,
+          record.remainingSeconds % 60,
+          stepNameForDisplay,
+          record.stepIdx + 1,
+          (record.recipeIdx == 4 ? record.customNumSteps : recipeForDisplay.numSteps),
+          !record.setpointReached);
+      callback.showTemperatureSample(record.temperature, record.targetTemperature);
+    }
   }
 }
 
@@ -807,16 +1554,14 @@ void temperatureSensorTask(void *pvParameters)
   for (;;)
   {
     // Solicita 4 bytes (para um float) do ESP32 escravo no endereço I2C_SLAVE_ADDRESS
-    Wire.requestFrom(I2C_SLAVE_ADDRESS, 4); // Solicita 4 bytes (para um float)
+    // com o barramento reservado (tem precedência sobre as páginas do display)
+    byte i2c_data[4];
+    i2cBus.acquire(I2C_CLIENT_SENSOR);
+    size_t received = i2cBus.read(I2C_SLAVE_ADDRESS, i2c_data, sizeof(i2c_data));
+    i2cBus.release();
 
-    if (Wire.available())
+    if (received == sizeof(i2c_data))
     {
-      // Receber os 4 bytes e reconstruir o float
-      byte i2c_data[4];
-      for (int i = 0; i < 4; i++)
-      {
-        i2c_data[i] = Wire.read();
-      }
       // Reinterpretar os bytes como um float
       memcpy(&tempC, i2c_data, 4);
 
@@ -826,7 +1571,7 @@ void temperatureSensorTask(void *pvParameters)
     }
     else
     {
-      Serial.println("TempSensorTask: ERRO! Nao ha bytes disponiveis para leitura I2C.");
+      Serial.println("TempSensorTask: ERRO! Leitura I2C incompleta.");
       tempDataToSend.temperature1 = -999.0; // Sinaliza erro de leitura
       xQueueOverwrite(xSensorQueue, &tempDataToSend);
     }
@@ -10,22 +10,6 @@ Implementation of the state machine 'Statechart'
 
 
 Statechart::Statechart() :
-	menu_raised(false),
-	standard_process_raised(false),
-	heating_raised(false),
-	resting_raised(false),
-	heating_2_raised(false),
-	resting_2_raised(false),
-	idle_raised(false),
-	custom_setup_raised(false),
-	set_temperature_raised(false),
-	set_time_raised(false),
-	set_temperature_2_raised(false),
-	set_time_2_raised(false),
-	add_step_raised(false),
-	standard_process_custom_raised(false),
-	finish_process_raised(false),
-	finish_process_idle_raised(false),
 	output(1),
 	delay(1000),
 	low(0),
@@ -35,350 +19,88 @@ Statechart::Statechart() :
 	semaphore_red_pin(23),
 	semaphore_yellow_pin(18),
 	semaphore_green_pin(19),
-	start_button_raised(false),
-	exit_process_raised(false),
-	recipe_1_raised(false),
-	recipe_2_raised(false),
-	recipe_3_raised(false),
-	recipe_4_raised(false),
-	recipe_5_raised(false),
-	recipe_back_menu_raised(false),
-	recipe_1_process_raised(false),
-	recipe_2_process_raised(false),
-	recipe_3_process_raised(false),
-	recipe_4_process_raised(false),
-	recipe_5_process_raised(false),
 	heater_pwm_pin(17),
 	pwm_frequency(5000),
 	pwm_resolution_bits(10),
-	start_first_step_raised(false),
-	step_finished_raised(false),
-	finished_process_raised(false),
 	custom_num_steps(0),
 	current_custom_step_idx(0),
 	received_value(0),
-	keypad_input_confirm_raised(false),
-	keypad_input_cancel_raised(false),
-	go_to_loop_raised(false),
-	temp_finished_raised(false),
-	loop_finished_raised(false),
-	start_recipe_custom_raised(false),
-	go_to_menu_raised(false),
 	timerService(sc_null),
 	ifaceOperationCallback(sc_null),
-	isExecuting(false)
+	isExecuting(false),
+	inEventQueueHead(0),
+	inEventQueueCount(0),
+	inEventQueueHighWater(0),
+	inEventQueueOverflows(0),
+	runCycleCount(0),
+	microStepCount(0)
+#ifdef SC_TRACE_ENABLED
+	, traceClock(sc_null),
+	traceHook(sc_null),
+	traceContext(sc_null)
+#endif
 {
 	for (sc_ushort state_vec_pos = 0; state_vec_pos < maxOrthogonalStates; ++state_vec_pos)
 		stateConfVector[state_vec_pos] = Statechart_last_state;
 	
-	clearInEvents();
+	for (sc_ushort i = 0; i < timeEventsCount; ++i)
+		timeEvents[i] = false;
 }
 
 Statechart::~Statechart()
 {
-	while (!inEventQueue.empty()) {
-		statechart_events::SctEvent* nextEvent = inEventQueue.front();
-		inEventQueue.pop_front();
-		delete nextEvent;
-	}
 }
 
 
 using namespace statechart_events;
 
-SctEvent* Statechart::getNextEvent()
+/*
+ * Fixed-capacity ring buffer for incoming events. Events are stored by value
+ * as 8-byte SctEvent records, so raising an event never touches the heap.
+ * When the queue is full the new event is dropped and counted as overflow.
+ */
+sc_boolean Statechart::pushInEvent(StatechartEventName name, uint16_t flags, sc_integer value)
 {
-	SctEvent* nextEvent = 0;
-	
-	if(!inEventQueue.empty()) {
-		nextEvent = inEventQueue.front();
-		inEventQueue.pop_front();
+	if (inEventQueueCount >= inEventQueueCapacity) {
+		++inEventQueueOverflows;
+		return false;
 	}
-	
-	return nextEvent;
+	sc_ushort tail = (sc_ushort)((inEventQueueHead + inEventQueueCount) % inEventQueueCapacity);
+	inEventQueue[tail].name = (uint16_t)name;
+	inEventQueue[tail].flags = flags;
+	inEventQueue[tail].value = value;
+	++inEventQueueCount;
+	if (inEventQueueCount > inEventQueueHighWater) {
+		inEventQueueHighWater = inEventQueueCount;
+	}
+	return true;
 }
 
-sc_boolean Statechart::dispatch_event(SctEvent * event)
+sc_boolean Statechart::getNextEvent(SctEvent & event)
 {
-	if(event == 0) {
+	if (inEventQueueCount == 0) {
 		return false;
 	}
-	switch(event->name)
-	{
-		case menu:
-		case standard_process:
-		case heating:
-		case resting:
-		case heating_2:
-		case resting_2:
-		case idle:
-		case custom_setup:
-		case set_temperature:
-		case set_time:
-		case set_temperature_2:
-		case set_time_2:
-		case add_step:
-		case standard_process_custom:
-		case finish_process:
-		case finish_process_idle:
-		case start_button:
-		case exit_process:
-		case recipe_1:
-		case recipe_2:
-		case recipe_3:
-		case recipe_4:
-		case recipe_5:
-		case recipe_back_menu:
-		case recipe_1_process:
-		case recipe_2_process:
-		case recipe_3_process:
-		case recipe_4_process:
-		case recipe_5_process:
-		case start_first_step:
-		case step_finished:
-		case finished_process:
-		case keypad_input_confirm:
-		case keypad_input_cancel:
-		case go_to_loop:
-		case temp_finished:
-		case loop_finished:
-		case start_recipe_custom:
-		case go_to_menu:
-		{
-			return iface_dispatch_event(event);
-		}
-		case Statechart_main_region_INIT_SYSTEM_time_event_0:
-		{
-			delete event;
-			return timeEvents[0] = true;
-		}
-		case Statechart_main_region_FINISHED_MESSAGE_time_event_0:
-		{
-			delete event;
-			return timeEvents[1] = true;
-		}
-		default:
-			delete event;
-			return false;
-	}
+	event = inEventQueue[inEventQueueHead];
+	inEventQueueHead = (sc_ushort)((inEventQueueHead + 1) % inEventQueueCapacity);
+	--inEventQueueCount;
+	return true;
 }
 
-sc_boolean Statechart::internal_dispatch_event(SctEvent * event)
+sc_integer Statechart::getInEventQueueOverflows() const
 {
-	switch(event->name)
-	{
-		default:
-			delete event;
-			return false;
-	}
-	delete event;
-	return true;
+	return inEventQueueOverflows;
 }
-sc_boolean Statechart::iface_dispatch_event(SctEvent * event)
+
+sc_integer Statechart::getInEventQueueHighWater() const
 {
-	switch(event->name)
-	{
-		case menu:
-		{
-			internal_raiseMenu();
-			break;
-		}
-		case standard_process:
-		{
-			internal_raiseStandard_process();
-			break;
-		}
-		case heating:
-		{
-			internal_raiseHeating();
-			break;
-		}
-		case resting:
-		{
-			internal_raiseResting();
-			break;
-		}
-		case heating_2:
-		{
-			internal_raiseHeating_2();
-			break;
-		}
-		case resting_2:
-		{
-			internal_raiseResting_2();
-			break;
-		}
-		case idle:
-		{
-			internal_raiseIdle();
-			break;
-		}
-		case custom_setup:
-		{
-			internal_raiseCustom_setup();
-			break;
-		}
-		case set_temperature:
-		{
-			internal_raiseSet_temperature();
-			break;
-		}
-		case set_time:
-		{
-			internal_raiseSet_time();
-			break;
-		}
-		case set_temperature_2:
-		{
-			internal_raiseSet_temperature_2();
-			break;
-		}
-		case set_time_2:
-		{
-			internal_raiseSet_time_2();
-			break;
-		}
-		case add_step:
-		{
-			internal_raiseAdd_step();
-			break;
-		}
-		case standard_process_custom:
-		{
-			internal_raiseStandard_process_custom();
-			break;
-		}
-		case finish_process:
-		{
-			internal_raiseFinish_process();
-			break;
-		}
-		case finish_process_idle:
-		{
-			internal_raiseFinish_process_idle();
-			break;
-		}
-		case start_button:
-		{
-			internal_raiseStart_button();
-			break;
-		}
-		case exit_process:
-		{
-			internal_raiseExit_process();
-			break;
-		}
-		case recipe_1:
-		{
-			internal_raiseRecipe_1();
-			break;
-		}
-		case recipe_2:
-		{
-			internal_raiseRecipe_2();
-			break;
-		}
-		case recipe_3:
-		{
-			internal_raiseRecipe_3();
-			break;
-		}
-		case recipe_4:
-		{
-			internal_raiseRecipe_4();
-			break;
-		}
-		case recipe_5:
-		{
-			internal_raiseRecipe_5();
-			break;
-		}
-		case recipe_back_menu:
-		{
-			internal_raiseRecipe_back_menu();
-			break;
-		}
-		case recipe_1_process:
-		{
-			internal_raiseRecipe_1_process();
-			break;
-		}
-		case recipe_2_process:
-		{
-			internal_raiseRecipe_2_process();
-			break;
-		}
-		case recipe_3_process:
-		{
-			internal_raiseRecipe_3_process();
-			break;
-		}
-		case recipe_4_process:
-		{
-			internal_raiseRecipe_4_process();
-			break;
-		}
-		case recipe_5_process:
-		{
-			internal_raiseRecipe_5_process();
-			break;
-		}
-		case start_first_step:
-		{
-			internal_raiseStart_first_step();
-			break;
-		}
-		case step_finished:
-		{
-			internal_raiseStep_finished();
-			break;
-		}
-		case finished_process:
-		{
-			internal_raiseFinished_process();
-			break;
-		}
-		case keypad_input_confirm:
-		{
-			internal_raiseKeypad_input_confirm();
-			break;
-		}
-		case keypad_input_cancel:
-		{
-			internal_raiseKeypad_input_cancel();
-			break;
-		}
-		case go_to_loop:
-		{
-			internal_raiseGo_to_loop();
-			break;
-		}
-		case temp_finished:
-		{
-			internal_raiseTemp_finished();
-			break;
-		}
-		case loop_finished:
-		{
-			internal_raiseLoop_finished();
-			break;
-		}
-		case start_recipe_custom:
-		{
-			internal_raiseStart_recipe_custom();
-			break;
-		}
-		case go_to_menu:
-		{
-			internal_raiseGo_to_menu();
-			break;
-		}
-		default:
-			delete event;
-			return false;
-	}
-	delete event;
-	return true;
+	return inEventQueueHighWater;
+}
+
+/* Events are matched against the transition table in microStep(); only the id is validated here. */
+sc_boolean Statechart::dispatch_event(const SctEvent & event)
+{
+	return event.name > invalid_event && event.name <= Statechart_main_region_FINISHED_MESSAGE_time_event_0;
 }
 
 StatechartEventName Statechart::getTimedEventName(sc_eventid evid)
@@ -436,515 +158,307 @@ void Statechart::raiseTimeEvent(sc_eventid evid)
 {
 	if ((evid >= (sc_eventid)timeEvents) && (evid < (sc_eventid)(&timeEvents[timeEventsCount])))
 	{
-		inEventQueue.push_back(new TimedSctEvent(getTimedEventName(evid)));
+		pushInEvent(getTimedEventName(evid), SCT_EVENT_FLAG_TIME);
 		runCycle();
 	}
 }
 
 
-sc_boolean Statechart::isStateActive(StatechartStates state) const
+Statechart::StatechartStates Statechart::getActiveLeafState() const
+{
+	return stateConfVector[0];
+}
+
+#ifdef SC_TRACE_ENABLED
+void Statechart::setTraceHook(TraceClock clock, TraceHook hook, void * context)
+{
+	traceClock = clock;
+	traceHook = hook;
+	traceContext = context;
+}
+
+void Statechart::traceStep(uint16_t event, StatechartStates source, uint32_t startMicros)
 {
-	switch (state)
+	const StatechartStates target = stateConfVector[0];
+	if (traceHook == sc_null || (event == invalid_event && target == source))
 	{
-		case main_region_IDLE :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_IDLE] == main_region_IDLE);
-			break;
-		}
-		case main_region_MENU :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_MENU] == main_region_MENU);
-			break;
-		}
-		case main_region_EXIT :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_EXIT] == main_region_EXIT);
-			break;
-		}
-		case main_region_STANDARD_PROCESS :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_STANDARD_PROCESS] >= main_region_STANDARD_PROCESS && stateConfVector[SCVI_MAIN_REGION_STANDARD_PROCESS] <= main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP);
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_START_PROCESS :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_STANDARD_PROCESS_STANDARD_PROCESS_START_PROCESS] == main_region_STANDARD_PROCESS_standard_process_START_PROCESS);
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_STANDARD_PROCESS_STANDARD_PROCESS_FINISH_PROCESS] == main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS);
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_STANDARD_PROCESS_STANDARD_PROCESS_CONTROL_PROCESS_LOOP] == main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP);
-			break;
-		}
-		case main_region_CUSTOM_SETUP :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_CUSTOM_SETUP] >= main_region_CUSTOM_SETUP && stateConfVector[SCVI_MAIN_REGION_CUSTOM_SETUP] <= main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME);
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_CUSTOM_SETUP_CUSTOM_SETUP_CUSTOM_SETUP_COMPLETE] == main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE);
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_CUSTOM_SETUP_CUSTOM_SETUP_NUM_STEPS] == main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS);
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_CUSTOM_SETUP_CUSTOM_SETUP_LOOP_TEMP_TIME_STEPS] >= main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS && stateConfVector[SCVI_MAIN_REGION_CUSTOM_SETUP_CUSTOM_SETUP_LOOP_TEMP_TIME_STEPS] <= main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME);
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_CUSTOM_SETUP_CUSTOM_SETUP_LOOP_TEMP_TIME_STEPS_LOOP_STEPS_TEMP] == main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP);
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_CUSTOM_SETUP_CUSTOM_SETUP_LOOP_TEMP_TIME_STEPS_LOOP_STEPS_TIME] == main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME);
-			break;
-		}
-		case main_region_INIT_SYSTEM :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_INIT_SYSTEM] == main_region_INIT_SYSTEM);
-			break;
-		}
-		case main_region_RECIPE_1 :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_RECIPE_1] == main_region_RECIPE_1);
-			break;
-		}
-		case main_region_RECIPE_2 :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_RECIPE_2] == main_region_RECIPE_2);
-			break;
-		}
-		case main_region_RECIPE_3 :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_RECIPE_3] == main_region_RECIPE_3);
-			break;
-		}
-		case main_region_RECIPE_4 :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_RECIPE_4] == main_region_RECIPE_4);
-			break;
-		}
-		case main_region_RECIPE_5 :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_RECIPE_5] == main_region_RECIPE_5);
-			break;
-		}
-		case main_region_FINISHED_MESSAGE :
-		{
-			return (sc_boolean) (stateConfVector[SCVI_MAIN_REGION_FINISHED_MESSAGE] == main_region_FINISHED_MESSAGE);
-			break;
-		}
-		default:
-		{
-			/* State is not active*/
-			return false;
-			break;
-		}
+		return;
 	}
+	TraceRecord record;
+	record.startMicros = startMicros;
+	record.endMicros = traceClock ? traceClock() : 0;
+	record.event = event;
+	record.source = (uint8_t)source;
+	record.target = (uint8_t)target;
+	traceHook(traceContext, record);
 }
+#endif
 
 /* Functions for event menu in interface  */
 void Statechart::raiseMenu()
 {
-	inEventQueue.push_back(new SctEvent__menu(menu));
+	pushInEvent(menu);
         runCycle();
 }
-void Statechart::internal_raiseMenu()
-{
-	menu_raised = true;
-}
 /* Functions for event standard_process in interface  */
 void Statechart::raiseStandard_process()
 {
-	inEventQueue.push_back(new SctEvent__standard_process(standard_process));
+	pushInEvent(standard_process);
         runCycle();
 }
-void Statechart::internal_raiseStandard_process()
-{
-	standard_process_raised = true;
-}
 /* Functions for event heating in interface  */
 void Statechart::raiseHeating()
 {
-	inEventQueue.push_back(new SctEvent__heating(heating));
+	pushInEvent(heating);
         runCycle();
 }
-void Statechart::internal_raiseHeating()
-{
-	heating_raised = true;
-}
 /* Functions for event resting in interface  */
 void Statechart::raiseResting()
 {
-	inEventQueue.push_back(new SctEvent__resting(resting));
+	pushInEvent(resting);
         runCycle();
 }
-void Statechart::internal_raiseResting()
-{
-	resting_raised = true;
-}
 /* Functions for event heating_2 in interface  */
 void Statechart::raiseHeating_2()
 {
-	inEventQueue.push_back(new SctEvent__heating_2(heating_2));
+	pushInEvent(heating_2);
         runCycle();
 }
-void Statechart::internal_raiseHeating_2()
-{
-	heating_2_raised = true;
-}
 /* Functions for event resting_2 in interface  */
 void Statechart::raiseResting_2()
 {
-	inEventQueue.push_back(new SctEvent__resting_2(resting_2));
+	pushInEvent(resting_2);
         runCycle();
 }
-void Statechart::internal_raiseResting_2()
-{
-	resting_2_raised = true;
-}
 /* Functions for event idle in interface  */
 void Statechart::raiseIdle()
 {
-	inEventQueue.push_back(new SctEvent__idle(idle));
+	pushInEvent(idle);
         runCycle();
 }
-void Statechart::internal_raiseIdle()
-{
-	idle_raised = true;
-}
 /* Functions for event custom_setup in interface  */
 void Statechart::raiseCustom_setup()
 {
-	inEventQueue.push_back(new SctEvent__custom_setup(custom_setup));
+	pushInEvent(custom_setup);
         runCycle();
 }
-void Statechart::internal_raiseCustom_setup()
-{
-	custom_setup_raised = true;
-}
 /* Functions for event set_temperature in interface  */
 void Statechart::raiseSet_temperature()
 {
-	inEventQueue.push_back(new SctEvent__set_temperature(set_temperature));
+	pushInEvent(set_temperature);
         runCycle();
 }
-void Statechart::internal_raiseSet_temperature()
-{
-	set_temperature_raised = true;
-}
 /* Functions for event set_time in interface  */
 void Statechart::raiseSet_time()
 {
-	inEventQueue.push_back(new SctEvent__set_time(set_time));
+	pushInEvent(set_time);
         runCycle();
 }
-void Statechart::internal_raiseSet_time()
-{
-	set_time_raised = true;
-}
 /* Functions for event set_temperature_2 in interface  */
 void Statechart::raiseSet_temperature_2()
 {
-	inEventQueue.push_back(new SctEvent__set_temperature_2(set_temperature_2));
+	pushInEvent(set_temperature_2);
         runCycle();
 }
-void Statechart::internal_raiseSet_temperature_2()
-{
-	set_temperature_2_raised = true;
-}
 /* Functions for event set_time_2 in interface  */
 void Statechart::raiseSet_time_2()
 {
-	inEventQueue.push_back(new SctEvent__set_time_2(set_time_2));
+	pushInEvent(set_time_2);
         runCycle();
 }
-void Statechart::internal_raiseSet_time_2()
-{
-	set_time_2_raised = true;
-}
 /* Functions for event add_step in interface  */
 void Statechart::raiseAdd_step()
 {
-	inEventQueue.push_back(new SctEvent__add_step(add_step));
+	pushInEvent(add_step);
         runCycle();
 }
-void Statechart::internal_raiseAdd_step()
-{
-	add_step_raised = true;
-}
 /* Functions for event standard_process_custom in interface  */
 void Statechart::raiseStandard_process_custom()
 {
-	inEventQueue.push_back(new SctEvent__standard_process_custom(standard_process_custom));
+	pushInEvent(standard_process_custom);
         runCycle();
 }
-void Statechart::internal_raiseStandard_process_custom()
-{
-	standard_process_custom_raised = true;
-}
 /* Functions for event finish_process in interface  */
 void Statechart::raiseFinish_process()
 {
-	inEventQueue.push_back(new SctEvent__finish_process(finish_process));
+	pushInEvent(finish_process);
         runCycle();
 }
-void Statechart::internal_raiseFinish_process()
-{
-	finish_process_raised = true;
-}
 /* Functions for event finish_process_idle in interface  */
 void Statechart::raiseFinish_process_idle()
 {
-	inEventQueue.push_back(new SctEvent__finish_process_idle(finish_process_idle));
+	pushInEvent(finish_process_idle);
         runCycle();
 }
-void Statechart::internal_raiseFinish_process_idle()
-{
-	finish_process_idle_raised = true;
-}
 /* Functions for event start_button in interface  */
 void Statechart::raiseStart_button()
 {
-	inEventQueue.push_back(new SctEvent__start_button(start_button));
+	pushInEvent(start_button);
         runCycle();
 }
-void Statechart::internal_raiseStart_button()
-{
-	start_button_raised = true;
-}
 /* Functions for event exit_process in interface  */
 void Statechart::raiseExit_process()
 {
-	inEventQueue.push_back(new SctEvent__exit_process(exit_process));
+	pushInEvent(exit_process);
         runCycle();
 }
-void Statechart::internal_raiseExit_process()
-{
-	exit_process_raised = true;
-}
 /* Functions for event recipe_1 in interface  */
 void Statechart::raiseRecipe_1()
 {
-	inEventQueue.push_back(new SctEvent__recipe_1(recipe_1));
+	pushInEvent(recipe_1);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_1()
-{
-	recipe_1_raised = true;
-}
 /* Functions for event recipe_2 in interface  */
 void Statechart::raiseRecipe_2()
 {
-	inEventQueue.push_back(new SctEvent__recipe_2(recipe_2));
+	pushInEvent(recipe_2);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_2()
-{
-	recipe_2_raised = true;
-}
 /* Functions for event recipe_3 in interface  */
 void Statechart::raiseRecipe_3()
 {
-	inEventQueue.push_back(new SctEvent__recipe_3(recipe_3));
+	pushInEvent(recipe_3);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_3()
-{
-	recipe_3_raised = true;
-}
 /* Functions for event recipe_4 in interface  */
 void Statechart::raiseRecipe_4()
 {
-	inEventQueue.push_back(new SctEvent__recipe_4(recipe_4));
+	pushInEvent(recipe_4);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_4()
-{
-	recipe_4_raised = true;
-}
 /* Functions for event recipe_5 in interface  */
 void Statechart::raiseRecipe_5()
 {
-	inEventQueue.push_back(new SctEvent__recipe_5(recipe_5));
+	pushInEvent(recipe_5);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_5()
-{
-	recipe_5_raised = true;
-}
 /* Functions for event recipe_back_menu in interface  */
 void Statechart::raiseRecipe_back_menu()
 {
-	inEventQueue.push_back(new SctEvent__recipe_back_menu(recipe_back_menu));
+	pushInEvent(recipe_back_menu);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_back_menu()
-{
-	recipe_back_menu_raised = true;
-}
 /* Functions for event recipe_1_process in interface  */
 void Statechart::raiseRecipe_1_process()
 {
-	inEventQueue.push_back(new SctEvent__recipe_1_process(recipe_1_process));
+	pushInEvent(recipe_1_process);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_1_process()
-{
-	recipe_1_process_raised = true;
-}
 /* Functions for event recipe_2_process in interface  */
 void Statechart::raiseRecipe_2_process()
 {
-	inEventQueue.push_back(new SctEvent__recipe_2_process(recipe_2_process));
+	pushInEvent(recipe_2_process);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_2_process()
-{
-	recipe_2_process_raised = true;
-}
 /* Functions for event recipe_3_process in interface  */
 void Statechart::raiseRecipe_3_process()
 {
-	inEventQueue.push_back(new SctEvent__recipe_3_process(recipe_3_process));
+	pushInEvent(recipe_3_process);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_3_process()
-{
-	recipe_3_process_raised = true;
-}
 /* Functions for event recipe_4_process in interface  */
 void Statechart::raiseRecipe_4_process()
 {
-	inEventQueue.push_back(new SctEvent__recipe_4_process(recipe_4_process));
+	pushInEvent(recipe_4_process);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_4_process()
-{
-	recipe_4_process_raised = true;
-}
 /* Functions for event recipe_5_process in interface  */
 void Statechart::raiseRecipe_5_process()
 {
-	inEventQueue.push_back(new SctEvent__recipe_5_process(recipe_5_process));
+	pushInEvent(recipe_5_process);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_5_process()
-{
-	recipe_5_process_raised = true;
-}
 /* Functions for event start_first_step in interface  */
 void Statechart::raiseStart_first_step()
 {
-	inEventQueue.push_back(new SctEvent__start_first_step(start_first_step));
+	pushInEvent(start_first_step);
         runCycle();
 }
-void Statechart::internal_raiseStart_first_step()
-{
-	start_first_step_raised = true;
-}
 /* Functions for event step_finished in interface  */
 void Statechart::raiseStep_finished()
 {
-	inEventQueue.push_back(new SctEvent__step_finished(step_finished));
+	pushInEvent(step_finished);
         runCycle();
 }
-void Statechart::internal_raiseStep_finished()
-{
-	step_finished_raised = true;
-}
 /* Functions for event finished_process in interface  */
 void Statechart::raiseFinished_process()
 {
-	inEventQueue.push_back(new SctEvent__finished_process(finished_process));
+	pushInEvent(finished_process);
         runCycle();
 }
-void Statechart::internal_raiseFinished_process()
-{
-	finished_process_raised = true;
-}
 /* Functions for event keypad_input_confirm in interface  */
 void Statechart::raiseKeypad_input_confirm()
 {
-	inEventQueue.push_back(new SctEvent__keypad_input_confirm(keypad_input_confirm));
+	pushInEvent(keypad_input_confirm);
         runCycle();
 }
-void Statechart::internal_raiseKeypad_input_confirm()
-{
-	keypad_input_confirm_raised = true;
-}
 /* Functions for event keypad_input_cancel in interface  */
 void Statechart::raiseKeypad_input_cancel()
 {
-	inEventQueue.push_back(new SctEvent__keypad_input_cancel(keypad_input_cancel));
+	pushInEvent(keypad_input_cancel);
         runCycle();
 }
-void Statechart::internal_raiseKeypad_input_cancel()
-{
-	keypad_input_cancel_raised = true;
-}
 /* Functions for event go_to_loop in interface  */
 void Statechart::raiseGo_to_loop()
 {
-	inEventQueue.push_back(new SctEvent__go_to_loop(go_to_loop));
+	pushInEvent(go_to_loop);
         runCycle();
 }
-void Statechart::internal_raiseGo_to_loop()
-{
-	go_to_loop_raised = true;
-}
 /* Functions for event temp_finished in interface  */
 void Statechart::raiseTemp_finished()
 {
-	inEventQueue.push_back(new SctEvent__temp_finished(temp_finished));
+	pushInEvent(temp_finished);
         runCycle();
 }
-void Statechart::internal_raiseTemp_finished()
-{
-	temp_finished_raised = true;
-}
 /* Functions for event loop_finished in interface  */
 void Statechart::raiseLoop_finished()
 {
-	inEventQueue.push_back(new SctEvent__loop_finished(loop_finished));
+	pushInEvent(loop_finished);
         runCycle();
 }
-void Statechart::internal_raiseLoop_finished()
-{
-	loop_finished_raised = true;
-}
 /* Functions for event start_recipe_custom in interface  */
 void Statechart::raiseStart_recipe_custom()
 {
-	inEventQueue.push_back(new SctEvent__start_recipe_custom(start_recipe_custom));
+	pushInEvent(start_recipe_custom);
         runCycle();
 }
-void Statechart::internal_raiseStart_recipe_custom()
-{
-	start_recipe_custom_raised = true;
-}
 /* Functions for event go_to_menu in interface  */
 void Statechart::raiseGo_to_menu()
 {
-	inEventQueue.push_back(new SctEvent__go_to_menu(go_to_menu));
+	pushInEvent(go_to_menu);
         runCycle();
 }
-void Statechart::internal_raiseGo_to_menu()
+/* Generic raise for in events, used by clients that carry events by id. */
+void Statechart::raiseEvent(StatechartEventName name)
+{
+	if (name <= invalid_event || name > go_to_menu) {
+		return;
+	}
+	pushInEvent(name);
+	runCycle();
+}
+
+/* Batched raise: all events are queued before a single run cycle processes them in order. */
+void Statechart::raiseEvents(const StatechartEventName * names, sc_integer count)
+{
+	for (sc_integer i = 0; i < count; ++i) {
+		if (names[i] > invalid_event && names[i] <= go_to_menu) {
+			pushInEvent(names[i]);
+		}
+	}
+	runCycle();
+}
+
+sc_integer Statechart::getRunCycleCount() const
+{
+	return runCycleCount;
+}
+
+sc_integer Statechart::getMicroStepCount() const
 {
-	go_to_menu_raised = true;
+	return microStepCount;
 }
+
 sc_integer Statechart::getOutput() const
 {
 	return output
@@ -1100,1371 +614,8 @@ void Statechart::setOperationCallback(OperationCallback* operationCallback)
 	ifaceOperationCallback = operationCallback;
 }
 
-// implementations of all internal functions
-/* Entry action for state 'IDLE'. */
-void Statechart::enact_main_region_IDLE()
-{
-	/* Entry action for state 'IDLE'. */
-	ifaceOperationCallback->beginDisplay();
-	ifaceOperationCallback->beginMatrix();
-	ifaceOperationCallback->showStartup();
-	ifaceOperationCallback->showIdleScreen();
-	ifaceOperationCallback->beginSemaphore();
-	ifaceOperationCallback->digitalWrite(semaphore_green_pin, high);
-	ifaceOperationCallback->digitalWrite(semaphore_red_pin, low);
-	ifaceOperationCallback->digitalWrite(semaphore_yellow_pin, low);
-	ifaceOperationCallback->digitalWrite(led_pin, low);
-}
-
-/* Entry action for state 'MENU'. */
-void Statechart::enact_main_region_MENU()
-{
-	/* Entry action for state 'MENU'. */
-	ifaceOperationCallback->showRecipes();
-	ifaceOperationCallback->digitalWrite(led_pin, low);
-}
-
-/* Entry action for state 'EXIT'. */
-void Statechart::enact_main_region_EXIT()
-{
-	/* Entry action for state 'EXIT'. */
-	ifaceOperationCallback->shutdownSystem();
-}
-
-/* Entry action for state 'STANDARD_PROCESS'. */
-void Statechart::enact_main_region_STANDARD_PROCESS()
-{
-	/* Entry action for state 'STANDARD_PROCESS'. */
-	ifaceOperationCallback->digitalWrite(semaphore_yellow_pin, high);
-	ifaceOperationCallback->digitalWrite(semaphore_red_pin, low);
-	ifaceOperationCallback->digitalWrite(semaphore_green_pin, low);
-}
-
-/* Entry action for state 'START_PROCESS'. */
-void Statechart::enact_main_region_STANDARD_PROCESS_standard_process_START_PROCESS()
-{
-	/* Entry action for state 'START_PROCESS'. */
-	ifaceOperationCallback->initializeProcess();
-}
-
-/* Entry action for state 'FINISH_PROCESS'. */
-void Statechart::enact_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS()
-{
-	/* Entry action for state 'FINISH_PROCESS'. */
-	ifaceOperationCallback->showFinished();
-}
-
-/* Entry action for state 'CONTROL_PROCESS_LOOP'. */
-void Statechart::enact_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP()
-{
-	/* Entry action for state 'CONTROL_PROCESS_LOOP'. */
-	ifaceOperationCallback->startNextRecipeStep(ifaceOperationCallback->getCurrentRecipeIndex());
-}
-
-/* Entry action for state 'CUSTOM_SETUP_COMPLETE'. */
-void Statechart::enact_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE()
-{
-	/* Entry action for state 'CUSTOM_SETUP_COMPLETE'. */
-	ifaceOperationCallback->showCustomSetup_Summary();
-}
-
-/* Entry action for state 'NUM_STEPS'. */
-void Statechart::enact_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS()
-{
-	/* Entry action for state 'NUM_STEPS'. */
-	ifaceOperationCallback->showCustomSetup_GetNumSteps();
-}
-
-/* Entry action for state 'LOOP_TEMP_TIME_STEPS'. */
-void Statechart::enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS()
-{
-	/* Entry action for state 'LOOP_TEMP_TIME_STEPS'. */
-	ifaceOperationCallback->initializeStepDataCollection();
-}
-
-/* Entry action for state 'TEMP'. */
-void Statechart::enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP()
-{
-	/* Entry action for state 'TEMP'. */
-	ifaceOperationCallback->showCustomSetup_PromptTemp(current_custom_step_idx);
-}
-
-/* Entry action for state 'TIME'. */
-void Statechart::enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME()
-{
-	/* Entry action for state 'TIME'. */
-	ifaceOperationCallback->showCustomSetup_PromptTime(current_custom_step_idx);
-}
-
-/* Entry action for state 'INIT_SYSTEM'. */
-void Statechart::enact_main_region_INIT_SYSTEM()
-{
-	/* Entry action for state 'INIT_SYSTEM'. */
-	timerService->setTimer(this, (sc_eventid)(&timeEvents[0]), (((sc_time) 5) * 1000), false);
-	ifaceOperationCallback->pinMode(led_pin, output);
-	ifaceOperationCallback->digitalWrite(led_pin, high);
-	ifaceOperationCallback->beginWaterSensor();
-	ifaceOperationCallback->setupHeaterPWM();
-}
-
-/* Entry action for state 'RECIPE_1'. */
-void Statechart::enact_main_region_RECIPE_1()
-{
-	/* Entry action for state 'RECIPE_1'. */
-	ifaceOperationCallback->showRecipe(1);
-}
-
-/* Entry action for state 'RECIPE_2'. */
-void Statechart::enact_main_region_RECIPE_2()
-{
-	/* Entry action for state 'RECIPE_2'. */
-	ifaceOperationCallback->showRecipe(2);
-}
-
-/* Entry action for state 'RECIPE_3'. */
-void Statechart::enact_main_region_RECIPE_3()
-{
-	/* Entry action for state 'RECIPE_3'. */
-	ifaceOperationCallback->showRecipe(3);
-}
-
-/* Entry action for state 'RECIPE_4'. */
-void Statechart::enact_main_region_RECIPE_4()
-{
-	/* Entry action for state 'RECIPE_4'. */
-	ifaceOperationCallback->showRecipe(4);
-}
-
-/* Entry action for state 'RECIPE_5'. */
-void Statechart::enact_main_region_RECIPE_5()
-{
-	/* Entry action for state 'RECIPE_5'. */
-	ifaceOperationCallback->showRecipe(5);
-}
-
-/* Entry action for state 'FINISHED_MESSAGE'. */
-void Statechart::enact_main_region_FINISHED_MESSAGE()
-{
-	/* Entry action for state 'FINISHED_MESSAGE'. */
-	timerService->setTimer(this, (sc_eventid)(&timeEvents[1]), (((sc_time) 5) * 1000), false);
-	ifaceOperationCallback->showFinishedMessage();
-}
-
-/* Exit action for state 'INIT_SYSTEM'. */
-void Statechart::exact_main_region_INIT_SYSTEM()
-{
-	/* Exit action for state 'INIT_SYSTEM'. */
-	timerService->unsetTimer(this, (sc_eventid)(&timeEvents[0]));
-}
-
-/* Exit action for state 'FINISHED_MESSAGE'. */
-void Statechart::exact_main_region_FINISHED_MESSAGE()
-{
-	/* Exit action for state 'FINISHED_MESSAGE'. */
-	timerService->unsetTimer(this, (sc_eventid)(&timeEvents[1]));
-}
-
-/* 'default' enter sequence for state IDLE */
-void Statechart::enseq_main_region_IDLE_default()
-{
-	/* 'default' enter sequence for state IDLE */
-	enact_main_region_IDLE();
-	stateConfVector[0] = main_region_IDLE;
-}
-
-/* 'default' enter sequence for state MENU */
-void Statechart::enseq_main_region_MENU_default()
-{
-	/* 'default' enter sequence for state MENU */
-	enact_main_region_MENU();
-	stateConfVector[0] = main_region_MENU;
-}
-
-/* 'default' enter sequence for state EXIT */
-void Statechart::enseq_main_region_EXIT_default()
-{
-	/* 'default' enter sequence for state EXIT */
-	enact_main_region_EXIT();
-	stateConfVector[0] = main_region_EXIT;
-}
-
-/* 'default' enter sequence for state STANDARD_PROCESS */
-void Statechart::enseq_main_region_STANDARD_PROCESS_default()
-{
-	/* 'default' enter sequence for state STANDARD_PROCESS */
-	enact_main_region_STANDARD_PROCESS();
-	enseq_main_region_STANDARD_PROCESS_standard_process_default();
-}
-
-/* 'default' enter sequence for state START_PROCESS */
-void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS_default()
-{
-	/* 'default' enter sequence for state START_PROCESS */
-	enact_main_region_STANDARD_PROCESS_standard_process_START_PROCESS();
-	stateConfVector[0] = main_region_STANDARD_PROCESS_standard_process_START_PROCESS;
-}
-
-/* 'default' enter sequence for state FINISH_PROCESS */
-void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_default()
-{
-	/* 'default' enter sequence for state FINISH_PROCESS */
-	enact_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS();
-	stateConfVector[0] = main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS;
-}
-
-/* 'default' enter sequence for state CONTROL_PROCESS_LOOP */
-void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_default()
-{
-	/* 'default' enter sequence for state CONTROL_PROCESS_LOOP */
-	enact_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP();
-	stateConfVector[0] = main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP;
-}
-
-/* 'default' enter sequence for state CUSTOM_SETUP */
-void Statechart::enseq_main_region_CUSTOM_SETUP_default()
-{
-	/* 'default' enter sequence for state CUSTOM_SETUP */
-	enseq_main_region_CUSTOM_SETUP_custom_setup_default();
-}
-
-/* 'default' enter sequence for state CUSTOM_SETUP_COMPLETE */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_default()
-{
-	/* 'default' enter sequence for state CUSTOM_SETUP_COMPLETE */
-	enact_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE();
-	stateConfVector[0] = main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE;
-}
-
-/* 'default' enter sequence for state NUM_STEPS */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_default()
-{
-	/* 'default' enter sequence for state NUM_STEPS */
-	enact_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS();
-	stateConfVector[0] = main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS;
-}
-
-/* 'default' enter sequence for state LOOP_TEMP_TIME_STEPS */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_default()
-{
-	/* 'default' enter sequence for state LOOP_TEMP_TIME_STEPS */
-	enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS();
-	enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_default();
-}
-
-/* 'default' enter sequence for state TEMP */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_default()
-{
-	/* 'default' enter sequence for state TEMP */
-	enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP();
-	stateConfVector[0] = main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP;
-}
-
-/* 'default' enter sequence for state TIME */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_default()
-{
-	/* 'default' enter sequence for state TIME */
-	enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME();
-	stateConfVector[0] = main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME;
-}
-
-/* 'default' enter sequence for state INIT_SYSTEM */
-void Statechart::enseq_main_region_INIT_SYSTEM_default()
-{
-	/* 'default' enter sequence for state INIT_SYSTEM */
-	enact_main_region_INIT_SYSTEM();
-	stateConfVector[0] = main_region_INIT_SYSTEM;
-}
-
-/* 'default' enter sequence for state RECIPE_1 */
-void Statechart::enseq_main_region_RECIPE_1_default()
-{
-	/* 'default' enter sequence for state RECIPE_1 */
-	enact_main_region_RECIPE_1();
-	stateConfVector[0] = main_region_RECIPE_1;
-}
-
-/* 'default' enter sequence for state RECIPE_2 */
-void Statechart::enseq_main_region_RECIPE_2_default()
-{
-	/* 'default' enter sequence for state RECIPE_2 */
-	enact_main_region_RECIPE_2();
-	stateConfVector[0] = main_region_RECIPE_2;
-}
-
-/* 'default' enter sequence for state RECIPE_3 */
-void Statechart::enseq_main_region_RECIPE_3_default()
-{
-	/* 'default' enter sequence for state RECIPE_3 */
-	enact_main_region_RECIPE_3();
-	stateConfVector[0] = main_region_RECIPE_3;
-}
-
-/* 'default' enter sequence for state RECIPE_4 */
-void Statechart::enseq_main_region_RECIPE_4_default()
-{
-	/* 'default' enter sequence for state RECIPE_4 */
-	enact_main_region_RECIPE_4();
-	stateConfVector[0] = main_region_RECIPE_4;
-}
-
-/* 'default' enter sequence for state RECIPE_5 */
-void Statechart::enseq_main_region_RECIPE_5_default()
-{
-	/* 'default' enter sequence for state RECIPE_5 */
-	enact_main_region_RECIPE_5();
-	stateConfVector[0] = main_region_RECIPE_5;
-}
-
-/* 'default' enter sequence for state FINISHED_MESSAGE */
-void Statechart::enseq_main_region_FINISHED_MESSAGE_default()
-{
-	/* 'default' enter sequence for state FINISHED_MESSAGE */
-	enact_main_region_FINISHED_MESSAGE();
-	stateConfVector[0] = main_region_FINISHED_MESSAGE;
-}
-
-/* 'default' enter sequence for region main region */
-void Statechart::enseq_main_region_default()
-{
-	/* 'default' enter sequence for region main region */
-	react_main_region__entry_Default();
-}
-
-/* 'default' enter sequence for region standard_process */
-void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_default()
-{
-	/* 'default' enter sequence for region standard_process */
-	react_main_region_STANDARD_PROCESS_standard_process__entry_Default();
-}
-
-/* 'default' enter sequence for region custom_setup */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_default()
-{
-	/* 'default' enter sequence for region custom_setup */
-	react_main_region_CUSTOM_SETUP_custom_setup__entry_Default();
-}
-
-/* 'default' enter sequence for region loop_steps */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_default()
-{
-	/* 'default' enter sequence for region loop_steps */
-	react_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps__entry_Default();
-}
-
-/* Default exit sequence for state IDLE */
-void Statechart::exseq_main_region_IDLE()
-{
-	/* Default exit sequence for state IDLE */
-	stateConfVector[0] = Statechart_last_state;
-}
-
-/* Default exit sequence for state MENU */
-void Statechart::exseq_main_region_MENU()
-{
-	/* Default exit sequence for state MENU */
-	stateConfVector[0] = Statechart_last_state;
-}
-
-/* Default exit sequence for state EXIT */
-void Statechart::exseq_main_region_EXIT()
-{
-	/* Default exit sequence for state EXIT */
-	stateConfVector[0] = Statechart_last_state;
-}
-
-/* Default exit sequence for state STANDARD_PROCESS */
-void Statechart::exseq_main_region_STANDARD_PROCESS()
-{
-	/* Default exit sequence for state STANDARD_PROCESS */
-	exseq_main_region_STANDARD_PROCESS_standard_process();
-	stateConfVector[0] = Statechart_last_state;
-}
-
-/* Default exit sequence for state START_PROCESS */
-void Statechart::exseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS()
-{
-	/* Default exit sequence for state START_PROCESS */
-	stateConfVector[0] = main_region_STANDARD_PROCESS;
-}
-
-/* Default exit sequence for state FINISH_PROCESS */
-void Statechart::exseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS()
-{
-	/* Default exit sequence for state FINISH_PROCESS */
-	stateConfVector[0] = main_region_STANDARD_PROCESS;
-}
-
-/* Default exit sequence for state CONTROL_PROCESS_LOOP */
-void Statechart::exseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP()
-{
-	/* Default exit sequence for state CONTROL_PROCESS_LOOP */
-	stateConfVector[0] = main_region_STANDARD_PROCESS;
-}
-
-/* Default exit sequence for state CUSTOM_SETUP */
-void Statechart::exseq_main_region_CUSTOM_SETUP()
-{
-	/* Default exit sequence for state CUSTOM_SETUP */
-	exseq_main_region_CUSTOM_SETUP_custom_setup();
-	stateConfVector[0] = Statechart_last_state;
-}
-
-/* Default exit sequence for state CUSTOM_SETUP_COMPLETE */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE()
-{
-	/* Default exit sequence for state CUSTOM_SETUP_COMPLETE */
-	stateConfVector[0] = main_region_CUSTOM_SETUP;
-}
-
-/* Default exit sequence for state NUM_STEPS */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS()
-{
-	/* Default exit sequence for state NUM_STEPS */
-	stateConfVector[0] = main_region_CUSTOM_SETUP;
-}
-
-/* Default exit sequence for state LOOP_TEMP_TIME_STEPS */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS()
-{
-	/* Default exit sequence for state LOOP_TEMP_TIME_STEPS */
-	exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps();
-	stateConfVector[0] = main_region_CUSTOM_SETUP;
-}
-
-/* Default exit sequence for state TEMP */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP()
-{
-	/* Default exit sequence for state TEMP */
-	stateConfVector[0] = main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS;
-}
-
-/* Default exit sequence for state TIME */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME()
-{
-	/* Default exit sequence for state TIME */
-	stateConfVector[0] = main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS;
-}
-
-/* Default exit sequence for state INIT_SYSTEM */
-void Statechart::exseq_main_region_INIT_SYSTEM()
-{
-	/* Default exit sequence for state INIT_SYSTEM */
-	stateConfVector[0] = Statechart_last_state;
-	exact_main_region_INIT_SYSTEM();
-}
-
-/* Default exit sequence for state RECIPE_1 */
-void Statechart::exseq_main_region_RECIPE_1()
-{
-	/* Default exit sequence for state RECIPE_1 */
-	stateConfVector[0] = Statechart_last_state;
-}
-
-/* Default exit sequence for state RECIPE_2 */
-void Statechart::exseq_main_region_RECIPE_2()
-{
-	/* Default exit sequence for state RECIPE_2 */
-	stateConfVector[0] = Statechart_last_state;
-}
-
-/* Default exit sequence for state RECIPE_3 */
-void Statechart::exseq_main_region_RECIPE_3()
-{
-	/* Default exit sequence for state RECIPE_3 */
-	stateConfVector[0] = Statechart_last_state;
-}
-
-/* Default exit sequence for state RECIPE_4 */
-void Statechart::exseq_main_region_RECIPE_4()
-{
-	/* Default exit sequence for state RECIPE_4 */
-	stateConfVector[0] = Statechart_last_state;
-}
-
-/* Default exit sequence for state RECIPE_5 */
-void Statechart::exseq_main_region_RECIPE_5()
-{
-	/* Default exit sequence for state RECIPE_5 */
-	stateConfVector[0] = Statechart_last_state;
-}
-
-/* Default exit sequence for state FINISHED_MESSAGE */
-void Statechart::exseq_main_region_FINISHED_MESSAGE()
-{
-	/* Default exit sequence for state FINISHED_MESSAGE */
-	stateConfVector[0] = Statechart_last_state;
-	exact_main_region_FINISHED_MESSAGE();
-}
-
-/* Default exit sequence for region main region */
-void Statechart::exseq_main_region()
-{
-	/* Default exit sequence for region main region */
-	/* Handle exit of all possible states (of Statechart.main_region) at position 0... */
-	switch(stateConfVector[ 0 ])
-	{
-		case main_region_IDLE :
-		{
-			exseq_main_region_IDLE();
-			break;
-		}
-		case main_region_MENU :
-		{
-			exseq_main_region_MENU();
-			break;
-		}
-		case main_region_EXIT :
-		{
-			exseq_main_region_EXIT();
-			break;
-		}
-		case main_region_STANDARD_PROCESS :
-		{
-			exseq_main_region_STANDARD_PROCESS();
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_START_PROCESS :
-		{
-			exseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS();
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS :
-		{
-			exseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS();
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP :
-		{
-			exseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP();
-			break;
-		}
-		case main_region_CUSTOM_SETUP :
-		{
-			exseq_main_region_CUSTOM_SETUP();
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE();
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS();
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS();
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP();
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME();
-			break;
-		}
-		case main_region_INIT_SYSTEM :
-		{
-			exseq_main_region_INIT_SYSTEM();
-			break;
-		}
-		case main_region_RECIPE_1 :
-		{
-			exseq_main_region_RECIPE_1();
-			break;
-		}
-		case main_region_RECIPE_2 :
-		{
-			exseq_main_region_RECIPE_2();
-			break;
-		}
-		case main_region_RECIPE_3 :
-		{
-			exseq_main_region_RECIPE_3();
-			break;
-		}
-		case main_region_RECIPE_4 :
-		{
-			exseq_main_region_RECIPE_4();
-			break;
-		}
-		case main_region_RECIPE_5 :
-		{
-			exseq_main_region_RECIPE_5();
-			break;
-		}
-		case main_region_FINISHED_MESSAGE :
-		{
-			exseq_main_region_FINISHED_MESSAGE();
-			break;
-		}
-		default:
-			/* do nothing */
-			break;
-	}
-}
-
-/* Default exit sequence for region standard_process */
-void Statechart::exseq_main_region_STANDARD_PROCESS_standard_process()
-{
-	/* Default exit sequence for region standard_process */
-	/* Handle exit of all possible states (of Statechart.main_region.STANDARD_PROCESS.standard_process) at position 0... */
-	switch(stateConfVector[ 0 ])
-	{
-		case main_region_STANDARD_PROCESS_standard_process_START_PROCESS :
-		{
-			exseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS();
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS :
-		{
-			exseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS();
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP :
-		{
-			exseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP();
-			break;
-		}
-		default:
-			/* do nothing */
-			break;
-	}
-}
-
-/* Default exit sequence for region custom_setup */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup()
-{
-	/* Default exit sequence for region custom_setup */
-	/* Handle exit of all possible states (of Statechart.main_region.CUSTOM_SETUP.custom_setup) at position 0... */
-	switch(stateConfVector[ 0 ])
-	{
-		case main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE();
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS();
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS();
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP();
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME();
-			break;
-		}
-		default:
-			/* do nothing */
-			break;
-	}
-}
-
-/* Default exit sequence for region loop_steps */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps()
-{
-	/* Default exit sequence for region loop_steps */
-	/* Handle exit of all possible states (of Statechart.main_region.CUSTOM_SETUP.custom_setup.LOOP_TEMP_TIME_STEPS.loop_steps) at position 0... */
-	switch(stateConfVector[ 0 ])
-	{
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP();
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME :
-		{
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME();
-			break;
-		}
-		default:
-			/* do nothing */
-			break;
-	}
-}
-
-/* Default react sequence for initial entry  */
-void Statechart::react_main_region_STANDARD_PROCESS_standard_process__entry_Default()
-{
-	/* Default react sequence for initial entry  */
-	enseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS_default();
-}
-
-/* Default react sequence for initial entry  */
-void Statechart::react_main_region_CUSTOM_SETUP_custom_setup__entry_Default()
-{
-	/* Default react sequence for initial entry  */
-	enseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_default();
-}
-
-/* Default react sequence for initial entry  */
-void Statechart::react_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps__entry_Default()
-{
-	/* Default react sequence for initial entry  */
-	enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_default();
-}
-
-/* Default react sequence for initial entry  */
-void Statechart::react_main_region__entry_Default()
-{
-	/* Default react sequence for initial entry  */
-	enseq_main_region_IDLE_default();
-}
-
-sc_integer Statechart::main_region_IDLE_react(const sc_integer transitioned_before) {
-	/* The reactions of state IDLE. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (start_button_raised)
-		{ 
-			exseq_main_region_IDLE();
-			enseq_main_region_INIT_SYSTEM_default();
-			transitioned_after = 0;
-		}  else
-		{
-			if (exit_process_raised)
-			{ 
-				exseq_main_region_IDLE();
-				enseq_main_region_EXIT_default();
-				transitioned_after = 0;
-			} 
-		}
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_MENU_react(const sc_integer transitioned_before) {
-	/* The reactions of state MENU. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (recipe_1_raised)
-		{ 
-			exseq_main_region_MENU();
-			enseq_main_region_RECIPE_1_default();
-			transitioned_after = 0;
-		}  else
-		{
-			if (recipe_2_raised)
-			{ 
-				exseq_main_region_MENU();
-				enseq_main_region_RECIPE_2_default();
-				transitioned_after = 0;
-			}  else
-			{
-				if (recipe_3_raised)
-				{ 
-					exseq_main_region_MENU();
-					enseq_main_region_RECIPE_3_default();
-					transitioned_after = 0;
-				}  else
-				{
-					if (recipe_4_raised)
-					{ 
-						exseq_main_region_MENU();
-						enseq_main_region_RECIPE_4_default();
-						transitioned_after = 0;
-					}  else
-					{
-						if (recipe_5_raised)
-						{ 
-							exseq_main_region_MENU();
-							enseq_main_region_RECIPE_5_default();
-							transitioned_after = 0;
-						} 
-					}
-				}
-			}
-		}
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_STANDARD_PROCESS_standard_process_START_PROCESS_react(const sc_integer transitioned_before) {
-	/* The reactions of state START_PROCESS. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (start_first_step_raised)
-		{ 
-			exseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS();
-			enseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_default();
-			transitioned_after = 0;
-		} 
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_react(const sc_integer transitioned_before) {
-	/* The reactions of state FINISH_PROCESS. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (finished_process_raised)
-		{ 
-			exseq_main_region_STANDARD_PROCESS();
-			enseq_main_region_FINISHED_MESSAGE_default();
-			transitioned_after = 0;
-		} 
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_react(const sc_integer transitioned_before) {
-	/* The reactions of state CONTROL_PROCESS_LOOP. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (((step_finished_raised)) && ((ifaceOperationCallback->hasMoreSteps())))
-		{ 
-			exseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP();
-			enseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_default();
-			transitioned_after = 0;
-		}  else
-		{
-			if (((step_finished_raised)) && ((!(ifaceOperationCallback->hasMoreSteps()))))
-			{ 
-				exseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP();
-				enseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_default();
-				transitioned_after = 0;
-			} 
-		}
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_CUSTOM_SETUP_react(const sc_integer transitioned_before) {
-	/* The reactions of state CUSTOM_SETUP. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (keypad_input_cancel_raised)
-		{ 
-			exseq_main_region_CUSTOM_SETUP();
-			enseq_main_region_MENU_default();
-			transitioned_after = 0;
-		} 
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_react(const sc_integer transitioned_before) {
-	/* The reactions of state CUSTOM_SETUP_COMPLETE. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (start_recipe_custom_raised)
-		{ 
-			exseq_main_region_CUSTOM_SETUP();
-			inEventQueue.push_back(new SctEvent__recipe_5_process(recipe_5_process));
-			;
-			enseq_main_region_STANDARD_PROCESS_default();
-			transitioned_after = 0;
-		}  else
-		{
-			if (go_to_menu_raised)
-			{ 
-				exseq_main_region_CUSTOM_SETUP();
-				inEventQueue.push_back(new SctEvent__recipe_back_menu(recipe_back_menu));
-				;
-				enseq_main_region_MENU_default();
-				transitioned_after = 0;
-			} 
-		}
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = main_region_CUSTOM_SETUP_react(transitioned_before);
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_react(const sc_integer transitioned_before) {
-	/* The reactions of state NUM_STEPS. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (((keypad_input_confirm_raised)) && ((ifaceOperationCallback->isValidNumSteps(received_value))))
-		{ 
-			exseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS();
-			ifaceOperationCallback->setNumCustomSteps(received_value);
-			inEventQueue.push_back(new SctEvent__go_to_loop(go_to_loop));
-			;
-			enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_default();
-			main_region_CUSTOM_SETUP_react(0);
-			transitioned_after = 0;
-		} 
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = main_region_CUSTOM_SETUP_react(transitioned_before);
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_react(const sc_integer transitioned_before) {
-	/* The reactions of state LOOP_TEMP_TIME_STEPS. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (((loop_finished_raised)) && ((ifaceOperationCallback->hasMoreStepsToDefine())))
-		{ 
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS();
-			enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_default();
-			main_region_CUSTOM_SETUP_react(0);
-			transitioned_after = 0;
-		}  else
-		{
-			if (((loop_finished_raised)) && ((ifaceOperationCallback->hasMoreStepsToDefine())))
-			{ 
-				exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS();
-				ifaceOperationCallback->advanceToNextCustomStep();
-				enseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_default();
-				main_region_CUSTOM_SETUP_react(0);
-				transitioned_after = 0;
-			} 
-		}
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = main_region_CUSTOM_SETUP_react(transitioned_before);
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_react(const sc_integer transitioned_before) {
-	/* The reactions of state TEMP. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (((keypad_input_confirm_raised)) && ((ifaceOperationCallback->isValidDataInput(received_value))))
-		{ 
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP();
-			ifaceOperationCallback->processTemperature(current_custom_step_idx, received_value);
-			inEventQueue.push_back(new SctEvent__temp_finished(temp_finished));
-			;
-			enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_default();
-			main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_react(0);
-			transitioned_after = 0;
-		} 
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_react(transitioned_before);
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_react(const sc_integer transitioned_before) {
-	/* The reactions of state TIME. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (((keypad_input_confirm_raised)) && ((ifaceOperationCallback->isValidDataInput(received_value))))
-		{ 
-			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS();
-			ifaceOperationCallback->processDuration(current_custom_step_idx, received_value);
-			inEventQueue.push_back(new SctEvent__loop_finished(loop_finished));
-			;
-			enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_default();
-			main_region_CUSTOM_SETUP_react(0);
-			transitioned_after = 0;
-		} 
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_react(transitioned_before);
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_INIT_SYSTEM_react(const sc_integer transitioned_before) {
-	/* The reactions of state INIT_SYSTEM. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (timeEvents[0])
-		{ 
-			exseq_main_region_INIT_SYSTEM();
-			timeEvents[0] = false;
-			enseq_main_region_MENU_default();
-			transitioned_after = 0;
-		} 
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_RECIPE_1_react(const sc_integer transitioned_before) {
-	/* The reactions of state RECIPE_1. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (recipe_back_menu_raised)
-		{ 
-			exseq_main_region_RECIPE_1();
-			enseq_main_region_MENU_default();
-			transitioned_after = 0;
-		}  else
-		{
-			if (recipe_1_process_raised)
-			{ 
-				exseq_main_region_RECIPE_1();
-				enseq_main_region_STANDARD_PROCESS_default();
-				transitioned_after = 0;
-			} 
-		}
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_RECIPE_2_react(const sc_integer transitioned_before) {
-	/* The reactions of state RECIPE_2. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (recipe_back_menu_raised)
-		{ 
-			exseq_main_region_RECIPE_2();
-			enseq_main_region_MENU_default();
-			transitioned_after = 0;
-		}  else
-		{
-			if (recipe_2_process_raised)
-			{ 
-				exseq_main_region_RECIPE_2();
-				enseq_main_region_STANDARD_PROCESS_default();
-				transitioned_after = 0;
-			} 
-		}
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_RECIPE_3_react(const sc_integer transitioned_before) {
-	/* The reactions of state RECIPE_3. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (recipe_back_menu_raised)
-		{ 
-			exseq_main_region_RECIPE_3();
-			enseq_main_region_MENU_default();
-			transitioned_after = 0;
-		}  else
-		{
-			if (recipe_3_process_raised)
-			{ 
-				exseq_main_region_RECIPE_3();
-				enseq_main_region_STANDARD_PROCESS_default();
-				transitioned_after = 0;
-			} 
-		}
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_RECIPE_4_react(const sc_integer transitioned_before) {
-	/* The reactions of state RECIPE_4. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (recipe_back_menu_raised)
-		{ 
-			exseq_main_region_RECIPE_4();
-			enseq_main_region_MENU_default();
-			transitioned_after = 0;
-		}  else
-		{
-			if (recipe_4_process_raised)
-			{ 
-				exseq_main_region_RECIPE_4();
-				enseq_main_region_STANDARD_PROCESS_default();
-				transitioned_after = 0;
-			} 
-		}
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_RECIPE_5_react(const sc_integer transitioned_before) {
-	/* The reactions of state RECIPE_5. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (recipe_back_menu_raised)
-		{ 
-			exseq_main_region_RECIPE_5();
-			enseq_main_region_MENU_default();
-			transitioned_after = 0;
-		}  else
-		{
-			if (recipe_5_process_raised)
-			{ 
-				exseq_main_region_RECIPE_5();
-				enseq_main_region_CUSTOM_SETUP_default();
-				transitioned_after = 0;
-			} 
-		}
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-sc_integer Statechart::main_region_FINISHED_MESSAGE_react(const sc_integer transitioned_before) {
-	/* The reactions of state FINISHED_MESSAGE. */
-	sc_integer transitioned_after = transitioned_before;
-	if ((transitioned_after) < (0))
-	{ 
-		if (timeEvents[1])
-		{ 
-			exseq_main_region_FINISHED_MESSAGE();
-			timeEvents[1] = false;
-			enseq_main_region_IDLE_default();
-			transitioned_after = 0;
-		} 
-	} 
-	/* If no transition was taken */
-	if ((transitioned_after) == (transitioned_before))
-	{ 
-		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
-	} 
-	return transitioned_after;
-}
-
-void Statechart::clearInEvents() {
-	menu_raised = false;
-	standard_process_raised = false;
-	heating_raised = false;
-	resting_raised = false;
-	heating_2_raised = false;
-	resting_2_raised = false;
-	idle_raised = false;
-	custom_setup_raised = false;
-	set_temperature_raised = false;
-	set_time_raised = false;
-	set_temperature_2_raised = false;
-	set_time_2_raised = false;
-	add_step_raised = false;
-	standard_process_custom_raised = false;
-	finish_process_raised = false;
-	finish_process_idle_raised = false;
-	start_button_raised = false;
-	exit_process_raised = false;
-	recipe_1_raised = false;
-	recipe_2_raised = false;
-	recipe_3_raised = false;
-	recipe_4_raised = false;
-	recipe_5_raised = false;
-	recipe_back_menu_raised = false;
-	recipe_1_process_raised = false;
-	recipe_2_process_raised = false;
-	recipe_3_process_raised = false;
-	recipe_4_process_raised = false;
-	recipe_5_process_raised = false;
-	start_first_step_raised = false;
-	step_finished_raised = false;
-	finished_process_raised = false;
-	keypad_input_confirm_raised = false;
-	keypad_input_cancel_raised = false;
-	go_to_loop_raised = false;
-	temp_finished_raised = false;
-	loop_finished_raised = false;
-	start_recipe_custom_raised = false;
-	go_to_menu_raised = false;
-	timeEvents[0] = false;
-	timeEvents[1] = false;
-}
-
-void Statechart::microStep() {
-	switch(stateConfVector[ 0 ])
-	{
-		case main_region_IDLE :
-		{
-			main_region_IDLE_react(-1);
-			break;
-		}
-		case main_region_MENU :
-		{
-			main_region_MENU_react(-1);
-			break;
-		}
-		case main_region_EXIT :
-		{
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_START_PROCESS :
-		{
-			main_region_STANDARD_PROCESS_standard_process_START_PROCESS_react(-1);
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS :
-		{
-			main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_react(-1);
-			break;
-		}
-		case main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP :
-		{
-			main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_react(-1);
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE :
-		{
-			main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_react(-1);
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS :
-		{
-			main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_react(-1);
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP :
-		{
-			main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_react(-1);
-			break;
-		}
-		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME :
-		{
-			main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_react(-1);
-			break;
-		}
-		case main_region_INIT_SYSTEM :
-		{
-			main_region_INIT_SYSTEM_react(-1);
-			break;
-		}
-		case main_region_RECIPE_1 :
-		{
-			main_region_RECIPE_1_react(-1);
-			break;
-		}
-		case main_region_RECIPE_2 :
-		{
-			main_region_RECIPE_2_react(-1);
-			break;
-		}
-		case main_region_RECIPE_3 :
-		{
-			main_region_RECIPE_3_react(-1);
-			break;
-		}
-		case main_region_RECIPE_4 :
-		{
-			main_region_RECIPE_4_react(-1);
-			break;
-		}
-		case main_region_RECIPE_5 :
-		{
-			main_region_RECIPE_5_react(-1);
-			break;
-		}
-		case main_region_FINISHED_MESSAGE :
-		{
-			main_region_FINISHED_MESSAGE_react(-1);
-			break;
-		}
-		default:
-			/* do nothing */
-			break;
-	}
-}
+// tables, actions and interpreter generated from the model by tools/sct_tablegen.py
+#include "StatechartModel.h"
 
 void Statechart::runCycle() {
 	/* Performs a 'run to completion' step. */
@@ -2473,12 +624,23 @@ void Statechart::runCycle() {
 		return;
 	} 
 	isExecuting = true;
-	dispatch_event(getNextEvent());
+	++runCycleCount;
+	SctEvent nextEvent = {invalid_event, SCT_EVENT_FLAG_NONE, 0};
+	if (getNextEvent(nextEvent)) {
+		dispatch_event(nextEvent);
+	}
 	do
 	{ 
-		microStep();
-		clearInEvents();
-	} while (dispatch_event(getNextEvent()));
+#ifdef SC_TRACE_ENABLED
+		const StatechartStates traceSource = stateConfVector[0];
+		const uint32_t traceStart = traceClock ? traceClock() : 0;
+#endif
+		microStep(nextEvent.name);
+		++microStepCount;
+#ifdef SC_TRACE_ENABLED
+		traceStep(nextEvent.name, traceSource, traceStart);
+#endif
+	} while (getNextEvent(nextEvent) && dispatch_event(nextEvent));
 	isExecuting = false;
 }
 
@@ -2489,8 +651,14 @@ void Statechart::enter() {
 		return;
 	} 
 	isExecuting = true;
+#ifdef SC_TRACE_ENABLED
+	const uint32_t traceStart = traceClock ? traceClock() : 0;
+#endif
 	/* Default enter sequence for statechart Statechart */
-	enseq_main_region_default();
+	enterInitialState();
+#ifdef SC_TRACE_ENABLED
+	traceStep(invalid_event, Statechart_last_state, traceStart);
+#endif
 	isExecuting = false;
 }
 
@@ -2502,8 +670,7 @@ void Statechart::exit() {
 	} 
 	isExecuting = true;
 	/* Default exit sequence for statechart Statechart */
-	exseq_main_region();
-	stateConfVector[0] = Statechart_last_state;
+	exitAllStates();
 	isExecuting = false;
 }
 
@@ -8,8 +8,13 @@ Forward declaration for the Statechart state machine.
 */
 class Statechart;
 
+/*! Forward declaration of the generated model tables (StatechartModel.h). */
+namespace statechart_model
+{
+struct TransitionInfo;
+}
+
 
-#include <deque>
 #include "sc_types.h"
 #include "sc_statemachine.h"
 #include "sc_eventdriven.h"
@@ -26,6 +31,9 @@ Header of the state machine 'Statechart'.
 #ifndef SC_INVALID_EVENT_VALUE
 #define SC_INVALID_EVENT_VALUE 0
 #endif
+#ifndef SC_IN_EVENT_QUEUE_SIZE
+#define SC_IN_EVENT_QUEUE_SIZE 16
+#endif
 
 namespace statechart_events
 {
@@ -74,228 +82,24 @@ typedef enum  {
 	Statechart_main_region_FINISHED_MESSAGE_time_event_0
 } StatechartEventName;
 
-class SctEvent
-{
-	public:
-		SctEvent(StatechartEventName name_) : name(name_){}
-		virtual ~SctEvent(){}
-		const StatechartEventName name;
-		
-};
-		
-template <typename T>
-class TypedSctEvent : public SctEvent
-{
-	public:
-		TypedSctEvent(StatechartEventName name_, T value_) :
-			SctEvent(name_),
-			value(value_)
-			{}
-		virtual ~TypedSctEvent(){}
-		const T value;
-};
+/*! Flags of a queued event. */
+#define SCT_EVENT_FLAG_NONE 0x0000u
+#define SCT_EVENT_FLAG_TIME 0x0001u  /* raised by the timer service */
+#define SCT_EVENT_FLAG_VALUE 0x0002u /* 'value' carries a payload */
 
-class SctEvent__menu : public SctEvent
-{
-	public:
-		SctEvent__menu(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__standard_process : public SctEvent
-{
-	public:
-		SctEvent__standard_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__heating : public SctEvent
-{
-	public:
-		SctEvent__heating(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__resting : public SctEvent
-{
-	public:
-		SctEvent__resting(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__heating_2 : public SctEvent
-{
-	public:
-		SctEvent__heating_2(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__resting_2 : public SctEvent
-{
-	public:
-		SctEvent__resting_2(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__idle : public SctEvent
-{
-	public:
-		SctEvent__idle(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__custom_setup : public SctEvent
-{
-	public:
-		SctEvent__custom_setup(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__set_temperature : public SctEvent
-{
-	public:
-		SctEvent__set_temperature(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__set_time : public SctEvent
-{
-	public:
-		SctEvent__set_time(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__set_temperature_2 : public SctEvent
-{
-	public:
-		SctEvent__set_temperature_2(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__set_time_2 : public SctEvent
-{
-	public:
-		SctEvent__set_time_2(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__add_step : public SctEvent
-{
-	public:
-		SctEvent__add_step(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__standard_process_custom : public SctEvent
-{
-	public:
-		SctEvent__standard_process_custom(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__finish_process : public SctEvent
-{
-	public:
-		SctEvent__finish_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__finish_process_idle : public SctEvent
-{
-	public:
-		SctEvent__finish_process_idle(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__start_button : public SctEvent
-{
-	public:
-		SctEvent__start_button(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__exit_process : public SctEvent
-{
-	public:
-		SctEvent__exit_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_1 : public SctEvent
-{
-	public:
-		SctEvent__recipe_1(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_2 : public SctEvent
-{
-	public:
-		SctEvent__recipe_2(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_3 : public SctEvent
-{
-	public:
-		SctEvent__recipe_3(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_4 : public SctEvent
-{
-	public:
-		SctEvent__recipe_4(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_5 : public SctEvent
-{
-	public:
-		SctEvent__recipe_5(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_back_menu : public SctEvent
-{
-	public:
-		SctEvent__recipe_back_menu(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_1_process : public SctEvent
-{
-	public:
-		SctEvent__recipe_1_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_2_process : public SctEvent
-{
-	public:
-		SctEvent__recipe_2_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_3_process : public SctEvent
-{
-	public:
-		SctEvent__recipe_3_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_4_process : public SctEvent
+/*! Compact, tagged event record moved through the in-event queue.
+ * Plain data, 8 bytes, no per-event class and no virtual dispatch: the tag
+ * is matched against the transition table in microStep(). */
+struct SctEvent
 {
-	public:
-		SctEvent__recipe_4_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_5_process : public SctEvent
-{
-	public:
-		SctEvent__recipe_5_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__start_first_step : public SctEvent
-{
-	public:
-		SctEvent__start_first_step(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__step_finished : public SctEvent
-{
-	public:
-		SctEvent__step_finished(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__finished_process : public SctEvent
-{
-	public:
-		SctEvent__finished_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__keypad_input_confirm : public SctEvent
-{
-	public:
-		SctEvent__keypad_input_confirm(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__keypad_input_cancel : public SctEvent
-{
-	public:
-		SctEvent__keypad_input_cancel(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__go_to_loop : public SctEvent
-{
-	public:
-		SctEvent__go_to_loop(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__temp_finished : public SctEvent
-{
-	public:
-		SctEvent__temp_finished(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__loop_finished : public SctEvent
-{
-	public:
-		SctEvent__loop_finished(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__start_recipe_custom : public SctEvent
-{
-	public:
-		SctEvent__start_recipe_custom(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__go_to_menu : public SctEvent
-{
-	public:
-		SctEvent__go_to_menu(StatechartEventName name_) : SctEvent(name_){};
-};
-class TimedSctEvent : public SctEvent
-{
-	public:
-		TimedSctEvent(StatechartEventName name_) : SctEvent(name_){};
+	uint16_t name;    /* StatechartEventName */
+	uint16_t flags;   /* SCT_EVENT_FLAG_* */
+	sc_integer value; /* payload slot for valued events */
 };
 
+static_assert(sizeof(SctEvent) == 8, "SctEvent must stay an 8-byte POD");
+static_assert(Statechart_main_region_FINISHED_MESSAGE_time_event_0 <= 0xFFFF, "event id must fit the 16-bit tag");
+
 }
 #endif /* SCT_EVENTS_STATECHART_H */
 
@@ -476,6 +280,18 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 		/*! Raises the in event 'go_to_menu' that is defined in the default interface scope. */
 		void raiseGo_to_menu();
 		
+		/*! Raises the in event identified by 'name' (same effect as the corresponding raise method). Time events are ignored. */
+		void raiseEvent(statechart_events::StatechartEventName name);
+		
+		/*! Queues 'count' in events in order and processes all of them in a single run cycle. Time events are ignored. */
+		void raiseEvents(const statechart_events::StatechartEventName * names, sc_integer count);
+		
+		/*! Returns how many run cycles were executed since the state machine was created. */
+		sc_integer getRunCycleCount() const;
+		
+		/*! Returns how many micro steps were executed since the state machine was created. */
+		sc_integer getMicroStepCount() const;
+		
 		/*! Gets the value of the variable 'output' that is defined in the default interface scope. */
 		sc_integer getOutput() const;
 		/*! Sets the value of the variable 'output' that is defined in the default interface scope. */
@@ -670,12 +486,49 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 		/*! Checks if the specified state is active (until 2.4.1 the used method for states was calles isActive()). */
 		sc_boolean isStateActive(StatechartStates state) const;
 		
+		/*! Returns the active leaf state of the main region in O(1) (Statechart_last_state if the state machine is inactive). */
+		StatechartStates getActiveLeafState() const;
+		
+		/*! Activates the state machine directly in the leaf 'state' without running entry actions (resume after a power loss).
+		 *  Only allowed while the state machine is inactive. Time events of the restored states are not re-armed. */
+		sc_boolean restoreActiveState(StatechartStates state);
+		
+		/*! Checks that the state configuration holds either no state (inactive) or a leaf state of the model. */
+		sc_boolean isStateConfigurationValid() const;
+		
+#ifdef SC_TRACE_ENABLED
+		/*! Trace record of one micro step: the event consumed, the leaf state before
+		 *  and after the step, and trace clock readings around it (entry/exit actions included). */
+		struct TraceRecord
+		{
+			uint32_t startMicros;
+			uint32_t endMicros;
+			uint16_t event;  /* StatechartEventName (invalid_event for completion steps) */
+			uint8_t source;  /* StatechartStates before the step */
+			uint8_t target;  /* StatechartStates after the step */
+		};
+		typedef uint32_t (*TraceClock)();
+		typedef void (*TraceHook)(void * context, const TraceRecord & record);
+		
+		/*! Installs the trace sink. Steps that consume an event or change the active state are reported. */
+		void setTraceHook(TraceClock clock, TraceHook hook, void * context);
+#endif
+		
 		//! number of time events used by the state machine.
 		static const sc_integer timeEventsCount = 2;
 		
 		//! number of time events that can be active at once.
 		static const sc_integer parallelTimeEventsCount = 1;
 		
+		//! capacity of the in-event queue (events raised while the queue is full are dropped).
+		static const sc_ushort inEventQueueCapacity = SC_IN_EVENT_QUEUE_SIZE;
+		
+		/*! Returns the number of events dropped because the in-event queue was full. */
+		sc_integer getInEventQueueOverflows() const;
+		
+		/*! Returns the highest number of events that were pending in the in-event queue at once. */
+		sc_integer getInEventQueueHighWater() const;
+		
 		
 	protected:
 		
@@ -684,56 +537,7 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 		Statechart(const Statechart &rhs);
 		Statechart& operator=(const Statechart&);
 		
-		sc_boolean internal_dispatch_event(statechart_events::SctEvent * event);
 		
-		/*! Raises the in event 'menu' that is defined in the default interface scope. */
-		void internal_raiseMenu();
-		sc_boolean menu_raised;
-		/*! Raises the in event 'standard_process' that is defined in the default interface scope. */
-		void internal_raiseStandard_process();
-		sc_boolean standard_process_raised;
-		/*! Raises the in event 'heating' that is defined in the default interface scope. */
-		void internal_raiseHeating();
-		sc_boolean heating_raised;
-		/*! Raises the in event 'resting' that is defined in the default interface scope. */
-		void internal_raiseResting();
-		sc_boolean resting_raised;
-		/*! Raises the in event 'heating_2' that is defined in the default interface scope. */
-		void internal_raiseHeating_2();
-		sc_boolean heating_2_raised;
-		/*! Raises the in event 'resting_2' that is defined in the default interface scope. */
-		void internal_raiseResting_2();
-		sc_boolean resting_2_raised;
-		/*! Raises the in event 'idle' that is defined in the default interface scope. */
-		void internal_raiseIdle();
-		sc_boolean idle_raised;
-		/*! Raises the in event 'custom_setup' that is defined in the default interface scope. */
-		void internal_raiseCustom_setup();
-		sc_boolean custom_setup_raised;
-		/*! Raises the in event 'set_temperature' that is defined in the default interface scope. */
-		void internal_raiseSet_temperature();
-		sc_boolean set_temperature_raised;
-		/*! Raises the in event 'set_time' that is defined in the default interface scope. */
-		void internal_raiseSet_time();
-		sc_boolean set_time_raised;
-		/*! Raises the in event 'set_temperature_2' that is defined in the default interface scope. */
-		void internal_raiseSet_temperature_2();
-		sc_boolean set_temperature_2_raised;
-		/*! Raises the in event 'set_time_2' that is defined in the default interface scope. */
-		void internal_raiseSet_time_2();
-		sc_boolean set_time_2_raised;
-		/*! Raises the in event 'add_step' that is defined in the default interface scope. */
-		void internal_raiseAdd_step();
-		sc_boolean add_step_raised;
-		/*! Raises the in event 'standard_process_custom' that is defined in the default interface scope. */
-		void internal_raiseStandard_process_custom();
-		sc_boolean standard_process_custom_raised;
-		/*! Raises the in event 'finish_process' that is defined in the default interface scope. */
-		void internal_raiseFinish_process();
-		sc_boolean finish_process_raised;
-		/*! Raises the in event 'finish_process_idle' that is defined in the default interface scope. */
-		void internal_raiseFinish_process_idle();
-		sc_boolean finish_process_idle_raised;
 		sc_integer output;
 		sc_integer delay;
 		sc_integer low;
@@ -743,82 +547,12 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 		sc_integer semaphore_red_pin;
 		sc_integer semaphore_yellow_pin;
 		sc_integer semaphore_green_pin;
-		/*! Raises the in event 'start_button' that is defined in the default interface scope. */
-		void internal_raiseStart_button();
-		sc_boolean start_button_raised;
-		/*! Raises the in event 'exit_process' that is defined in the default interface scope. */
-		void internal_raiseExit_process();
-		sc_boolean exit_process_raised;
-		/*! Raises the in event 'recipe_1' that is defined in the default interface scope. */
-		void internal_raiseRecipe_1();
-		sc_boolean recipe_1_raised;
-		/*! Raises the in event 'recipe_2' that is defined in the default interface scope. */
-		void internal_raiseRecipe_2();
-		sc_boolean recipe_2_raised;
-		/*! Raises the in event 'recipe_3' that is defined in the default interface scope. */
-		void internal_raiseRecipe_3();
-		sc_boolean recipe_3_raised;
-		/*! Raises the in event 'recipe_4' that is defined in the default interface scope. */
-		void internal_raiseRecipe_4();
-		sc_boolean recipe_4_raised;
-		/*! Raises the in event 'recipe_5' that is defined in the default interface scope. */
-		void internal_raiseRecipe_5();
-		sc_boolean recipe_5_raised;
-		/*! Raises the in event 'recipe_back_menu' that is defined in the default interface scope. */
-		void internal_raiseRecipe_back_menu();
-		sc_boolean recipe_back_menu_raised;
-		/*! Raises the in event 'recipe_1_process' that is defined in the default interface scope. */
-		void internal_raiseRecipe_1_process();
-		sc_boolean recipe_1_process_raised;
-		/*! Raises the in event 'recipe_2_process' that is defined in the default interface scope. */
-		void internal_raiseRecipe_2_process();
-		sc_boolean recipe_2_process_raised;
-		/*! Raises the in event 'recipe_3_process' that is defined in the default interface scope. */
-		void internal_raiseRecipe_3_process();
-		sc_boolean recipe_3_process_raised;
-		/*! Raises the in event 'recipe_4_process' that is defined in the default interface scope. */
-		void internal_raiseRecipe_4_process();
-		sc_boolean recipe_4_process_raised;
-		/*! Raises the in event 'recipe_5_process' that is defined in the default interface scope. */
-		void internal_raiseRecipe_5_process();
-		sc_boolean recipe_5_process_raised;
 		sc_integer heater_pwm_pin;
 		sc_integer pwm_frequency;
 		sc_integer pwm_resolution_bits;
-		/*! Raises the in event 'start_first_step' that is defined in the default interface scope. */
-		void internal_raiseStart_first_step();
-		sc_boolean start_first_step_raised;
-		/*! Raises the in event 'step_finished' that is defined in the default interface scope. */
-		void internal_raiseStep_finished();
-		sc_boolean step_finished_raised;
-		/*! Raises the in event 'finished_process' that is defined in the default interface scope. */
-		void internal_raiseFinished_process();
-		sc_boolean finished_process_raised;
 		sc_integer custom_num_steps;
 		sc_integer current_custom_step_idx;
 		sc_integer received_value;
-		/*! Raises the in event 'keypad_input_confirm' that is defined in the default interface scope. */
-		void internal_raiseKeypad_input_confirm();
-		sc_boolean keypad_input_confirm_raised;
-		/*! Raises the in event 'keypad_input_cancel' that is defined in the default interface scope. */
-		void internal_raiseKeypad_input_cancel();
-		sc_boolean keypad_input_cancel_raised;
-		/*! Raises the in event 'go_to_loop' that is defined in the default interface scope. */
-		void internal_raiseGo_to_loop();
-		sc_boolean go_to_loop_raised;
-		/*! Raises the in event 'temp_finished' that is defined in the default interface scope. */
-		void internal_raiseTemp_finished();
-		sc_boolean temp_finished_raised;
-		/*! Raises the in event 'loop_finished' that is defined in the default interface scope. */
-		void internal_raiseLoop_finished();
-		sc_boolean loop_finished_raised;
-		/*! Raises the in event 'start_recipe_custom' that is defined in the default interface scope. */
-		void internal_raiseStart_recipe_custom();
-		sc_boolean start_recipe_custom_raised;
-		/*! Raises the in event 'go_to_menu' that is defined in the default interface scope. */
-		void internal_raiseGo_to_menu();
-		sc_boolean go_to_menu_raised;
-		sc_boolean iface_dispatch_event(statechart_events::SctEvent * event);
 		
 		
 		//! the maximum number of orthogonal states defines the dimension of the state configuration vector.
@@ -840,106 +574,37 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 		
 		// prototypes of all internal functions
 		
-		void enact_main_region_IDLE();
-		void enact_main_region_MENU();
-		void enact_main_region_EXIT();
-		void enact_main_region_STANDARD_PROCESS();
-		void enact_main_region_STANDARD_PROCESS_standard_process_START_PROCESS();
-		void enact_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS();
-		void enact_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP();
-		void enact_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE();
-		void enact_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS();
-		void enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS();
-		void enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP();
-		void enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME();
-		void enact_main_region_INIT_SYSTEM();
-		void enact_main_region_RECIPE_1();
-		void enact_main_region_RECIPE_2();
-		void enact_main_region_RECIPE_3();
-		void enact_main_region_RECIPE_4();
-		void enact_main_region_RECIPE_5();
-		void enact_main_region_FINISHED_MESSAGE();
-		void exact_main_region_INIT_SYSTEM();
-		void exact_main_region_FINISHED_MESSAGE();
-		void enseq_main_region_IDLE_default();
-		void enseq_main_region_MENU_default();
-		void enseq_main_region_EXIT_default();
-		void enseq_main_region_STANDARD_PROCESS_default();
-		void enseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS_default();
-		void enseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_default();
-		void enseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_default();
-		void enseq_main_region_CUSTOM_SETUP_default();
-		void enseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_default();
-		void enseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_default();
-		void enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_default();
-		void enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_default();
-		void enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_default();
-		void enseq_main_region_INIT_SYSTEM_default();
-		void enseq_main_region_RECIPE_1_default();
-		void enseq_main_region_RECIPE_2_default();
-		void enseq_main_region_RECIPE_3_default();
-		void enseq_main_region_RECIPE_4_default();
-		void enseq_main_region_RECIPE_5_default();
-		void enseq_main_region_FINISHED_MESSAGE_default();
-		void enseq_main_region_default();
-		void enseq_main_region_STANDARD_PROCESS_standard_process_default();
-		void enseq_main_region_CUSTOM_SETUP_custom_setup_default();
-		void enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_default();
-		void exseq_main_region_IDLE();
-		void exseq_main_region_MENU();
-		void exseq_main_region_EXIT();
-		void exseq_main_region_STANDARD_PROCESS();
-		void exseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS();
-		void exseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS();
-		void exseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP();
-		void exseq_main_region_CUSTOM_SETUP();
-		void exseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE();
-		void exseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS();
-		void exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS();
-		void exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP();
-		void exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME();
-		void exseq_main_region_INIT_SYSTEM();
-		void exseq_main_region_RECIPE_1();
-		void exseq_main_region_RECIPE_2();
-		void exseq_main_region_RECIPE_3();
-		void exseq_main_region_RECIPE_4();
-		void exseq_main_region_RECIPE_5();
-		void exseq_main_region_FINISHED_MESSAGE();
-		void exseq_main_region();
-		void exseq_main_region_STANDARD_PROCESS_standard_process();
-		void exseq_main_region_CUSTOM_SETUP_custom_setup();
-		void exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps();
-		void react_main_region_STANDARD_PROCESS_standard_process__entry_Default();
-		void react_main_region_CUSTOM_SETUP_custom_setup__entry_Default();
-		void react_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps__entry_Default();
-		void react_main_region__entry_Default();
-		sc_integer main_region_IDLE_react(const sc_integer transitioned_before);
-		sc_integer main_region_MENU_react(const sc_integer transitioned_before);
-		sc_integer main_region_STANDARD_PROCESS_standard_process_START_PROCESS_react(const sc_integer transitioned_before);
-		sc_integer main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_react(const sc_integer transitioned_before);
-		sc_integer main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_react(const sc_integer transitioned_before);
-		sc_integer main_region_CUSTOM_SETUP_react(const sc_integer transitioned_before);
-		sc_integer main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_react(const sc_integer transitioned_before);
-		sc_integer main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_react(const sc_integer transitioned_before);
-		sc_integer main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_react(const sc_integer transitioned_before);
-		sc_integer main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_react(const sc_integer transitioned_before);
-		sc_integer main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_react(const sc_integer transitioned_before);
-		sc_integer main_region_INIT_SYSTEM_react(const sc_integer transitioned_before);
-		sc_integer main_region_RECIPE_1_react(const sc_integer transitioned_before);
-		sc_integer main_region_RECIPE_2_react(const sc_integer transitioned_before);
-		sc_integer main_region_RECIPE_3_react(const sc_integer transitioned_before);
-		sc_integer main_region_RECIPE_4_react(const sc_integer transitioned_before);
-		sc_integer main_region_RECIPE_5_react(const sc_integer transitioned_before);
-		sc_integer main_region_FINISHED_MESSAGE_react(const sc_integer transitioned_before);
-		void clearInEvents();
-		void microStep();
+		// actions, guards and interpreter generated into StatechartModel.h
+		void executeAction(sc_ushort action);
+		sc_boolean evaluateGuard(sc_ushort guard);
+		void enterStateDefault(sc_ushort state);
+		void enterStatePath(sc_ushort outer, sc_ushort target);
+		void exitStatesUpTo(sc_ushort outermost);
+		void takeTransition(const statechart_model::TransitionInfo & transition);
+		sc_boolean microStep(sc_ushort event);
+		void enterInitialState();
+		void exitAllStates();
 		void runCycle();
 		
 		
-		statechart_events::SctEvent* getNextEvent();
-		sc_boolean dispatch_event(statechart_events::SctEvent * event);
+		sc_boolean pushInEvent(statechart_events::StatechartEventName name, uint16_t flags = SCT_EVENT_FLAG_NONE, sc_integer value = 0);
+		sc_boolean getNextEvent(statechart_events::SctEvent & event);
+		sc_boolean dispatch_event(const statechart_events::SctEvent & event);
 		statechart_events::StatechartEventName getTimedEventName(sc_eventid evid);
-		std::deque<statechart_events::SctEvent*> inEventQueue;
+		statechart_events::SctEvent inEventQueue[inEventQueueCapacity];
+		sc_ushort inEventQueueHead;
+		sc_ushort inEventQueueCount;
+		sc_ushort inEventQueueHighWater;
+		sc_integer inEventQueueOverflows;
+		sc_integer runCycleCount;
+		sc_integer microStepCount;
+		
+#ifdef SC_TRACE_ENABLED
+		TraceClock traceClock;
+		TraceHook traceHook;
+		void * traceContext;
+		void traceStep(uint16_t event, StatechartStates source, uint32_t startMicros);
+#endif
 		
 		
 		
@@ -0,0 +1,488 @@
+/* Generated by tools/sct_tablegen.py from Statechart.ysc. Do not edit. */
+
+#ifndef STATECHARTMODEL_H_
+#define STATECHARTMODEL_H_
+
+/*! \file
+Tables, actions and interpreter of the state machine 'Statechart'.
+Included only by Statechart.cpp.
+*/
+
+#include "Statechart.h"
+
+namespace statechart_model
+{
+
+/*! Static description of a state. Indices are StatechartStates values. */
+struct StateInfo
+{
+	uint8_t parent;          /* enclosing state, NO_STATE for the main region */
+	uint8_t initial;         /* default child of a composite state, NO_STATE for leaves */
+	uint8_t lastDescendant;  /* states are numbered in pre-order: [state, lastDescendant] is the subtree */
+	uint8_t entryAction;
+	uint8_t exitAction;
+	uint8_t firstTransition; /* outgoing transitions, in model priority order */
+	uint8_t transitionCount;
+};
+
+/*! Outgoing transition of a state. */
+struct TransitionInfo
+{
+	uint16_t event;  /* StatechartEventName that triggers the transition */
+	uint8_t guard;
+	uint8_t target;
+	uint8_t effect;
+	uint8_t exitTop; /* outermost state left: child of the least common ancestor, or the target itself */
+};
+
+static const uint8_t NO_STATE = 0xFF;
+static const uint8_t ROOT_INITIAL = Statechart::main_region_IDLE;
+
+enum ActionId : uint8_t
+{
+	ACTION_NONE,
+	ACTION_ENTRY_main_region_IDLE,
+	ACTION_ENTRY_main_region_MENU,
+	ACTION_ENTRY_main_region_EXIT,
+	ACTION_ENTRY_main_region_STANDARD_PROCESS,
+	ACTION_ENTRY_main_region_STANDARD_PROCESS_standard_process_START_PROCESS,
+	ACTION_ENTRY_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS,
+	ACTION_ENTRY_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP,
+	ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE,
+	ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_0,
+	ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_1,
+	ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS,
+	ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_0,
+	ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS,
+	ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_1,
+	ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP,
+	ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_0,
+	ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME,
+	ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_0,
+	ACTION_ENTRY_main_region_INIT_SYSTEM,
+	ACTION_EXIT_main_region_INIT_SYSTEM,
+	ACTION_ENTRY_main_region_RECIPE_1,
+	ACTION_ENTRY_main_region_RECIPE_2,
+	ACTION_ENTRY_main_region_RECIPE_3,
+	ACTION_ENTRY_main_region_RECIPE_4,
+	ACTION_ENTRY_main_region_RECIPE_5,
+	ACTION_ENTRY_main_region_FINISHED_MESSAGE,
+	ACTION_EXIT_main_region_FINISHED_MESSAGE,
+};
+
+enum GuardId : uint8_t
+{
+	GUARD_NONE,
+	GUARD_1,
+	GUARD_2,
+	GUARD_3,
+	GUARD_4,
+	GUARD_5,
+};
+
+constexpr StateInfo states[Statechart::numStates + 1] = {
+	{NO_STATE, NO_STATE, 0, ACTION_NONE, ACTION_NONE, 0, 0}, /* Statechart_last_state */
+	{NO_STATE, NO_STATE, 1, ACTION_ENTRY_main_region_IDLE, ACTION_NONE, 0, 2}, /* main_region_IDLE */
+	{NO_STATE, NO_STATE, 2, ACTION_ENTRY_main_region_MENU, ACTION_NONE, 2, 5}, /* main_region_MENU */
+	{NO_STATE, NO_STATE, 3, ACTION_ENTRY_main_region_EXIT, ACTION_NONE, 7, 0}, /* main_region_EXIT */
+	{NO_STATE, Statechart::main_region_STANDARD_PROCESS_standard_process_START_PROCESS, 7, ACTION_ENTRY_main_region_STANDARD_PROCESS, ACTION_NONE, 7, 1}, /* main_region_STANDARD_PROCESS */
+	{Statechart::main_region_STANDARD_PROCESS, NO_STATE, 5, ACTION_ENTRY_main_region_STANDARD_PROCESS_standard_process_START_PROCESS, ACTION_NONE, 8, 1}, /* main_region_STANDARD_PROCESS_standard_process_START_PROCESS */
+	{Statechart::main_region_STANDARD_PROCESS, NO_STATE, 6, ACTION_ENTRY_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS, ACTION_NONE, 9, 1}, /* main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS */
+	{Statechart::main_region_STANDARD_PROCESS, NO_STATE, 7, ACTION_ENTRY_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP, ACTION_NONE, 10, 2}, /* main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP */
+	{NO_STATE, Statechart::main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS, 13, ACTION_NONE, ACTION_NONE, 12, 1}, /* main_region_CUSTOM_SETUP */
+	{Statechart::main_region_CUSTOM_SETUP, NO_STATE, 9, ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE, ACTION_NONE, 13, 2}, /* main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE */
+	{Statechart::main_region_CUSTOM_SETUP, NO_STATE, 10, ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS, ACTION_NONE, 15, 1}, /* main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS */
+	{Statechart::main_region_CUSTOM_SETUP, Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP, 13, ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS, ACTION_NONE, 16, 2}, /* main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS */
+	{Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS, NO_STATE, 12, ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP, ACTION_NONE, 18, 1}, /* main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP */
+	{Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS, NO_STATE, 13, ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME, ACTION_NONE, 19, 1}, /* main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME */
+	{NO_STATE, NO_STATE, 14, ACTION_ENTRY_main_region_INIT_SYSTEM, ACTION_EXIT_main_region_INIT_SYSTEM, 20, 1}, /* main_region_INIT_SYSTEM */
+	{NO_STATE, NO_STATE, 15, ACTION_ENTRY_main_region_RECIPE_1, ACTION_NONE, 21, 2}, /* main_region_RECIPE_1 */
+	{NO_STATE, NO_STATE, 16, ACTION_ENTRY_main_region_RECIPE_2, ACTION_NONE, 23, 2}, /* main_region_RECIPE_2 */
+	{NO_STATE, NO_STATE, 17, ACTION_ENTRY_main_region_RECIPE_3, ACTION_NONE, 25, 2}, /* main_region_RECIPE_3 */
+	{NO_STATE, NO_STATE, 18, ACTION_ENTRY_main_region_RECIPE_4, ACTION_NONE, 27, 2}, /* main_region_RECIPE_4 */
+	{NO_STATE, NO_STATE, 19, ACTION_ENTRY_main_region_RECIPE_5, ACTION_NONE, 29, 2}, /* main_region_RECIPE_5 */
+	{NO_STATE, NO_STATE, 20, ACTION_ENTRY_main_region_FINISHED_MESSAGE, ACTION_EXIT_main_region_FINISHED_MESSAGE, 31, 1}, /* main_region_FINISHED_MESSAGE */
+};
+
+constexpr TransitionInfo transitions[] = {
+	{statechart_events::start_button, GUARD_NONE, Statechart::main_region_INIT_SYSTEM, ACTION_NONE, Statechart::main_region_IDLE}, /* from IDLE */
+	{statechart_events::exit_process, GUARD_NONE, Statechart::main_region_EXIT, ACTION_NONE, Statechart::main_region_IDLE}, /* from IDLE */
+	{statechart_events::recipe_1, GUARD_NONE, Statechart::main_region_RECIPE_1, ACTION_NONE, Statechart::main_region_MENU}, /* from MENU */
+	{statechart_events::recipe_2, GUARD_NONE, Statechart::main_region_RECIPE_2, ACTION_NONE, Statechart::main_region_MENU}, /* from MENU */
+	{statechart_events::recipe_3, GUARD_NONE, Statechart::main_region_RECIPE_3, ACTION_NONE, Statechart::main_region_MENU}, /* from MENU */
+	{statechart_events::recipe_4, GUARD_NONE, Statechart::main_region_RECIPE_4, ACTION_NONE, Statechart::main_region_MENU}, /* from MENU */
+	{statechart_events::recipe_5, GUARD_NONE, Statechart::main_region_RECIPE_5, ACTION_NONE, Statechart::main_region_MENU}, /* from MENU */
+	{statechart_events::menu, GUARD_NONE, Statechart::main_region_MENU, ACTION_NONE, Statechart::main_region_STANDARD_PROCESS}, /* from STANDARD_PROCESS */
+	{statechart_events::start_first_step, GUARD_NONE, Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP, ACTION_NONE, Statechart::main_region_STANDARD_PROCESS_standard_process_START_PROCESS}, /* from START_PROCESS */
+	{statechart_events::finished_process, GUARD_NONE, Statechart::main_region_FINISHED_MESSAGE, ACTION_NONE, Statechart::main_region_STANDARD_PROCESS}, /* from FINISH_PROCESS */
+	{statechart_events::step_finished, GUARD_1, Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP, ACTION_NONE, Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP}, /* from CONTROL_PROCESS_LOOP */
+	{statechart_events::step_finished, GUARD_2, Statechart::main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS, ACTION_NONE, Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP}, /* from CONTROL_PROCESS_LOOP */
+	{statechart_events::keypad_input_cancel, GUARD_NONE, Statechart::main_region_MENU, ACTION_NONE, Statechart::main_region_CUSTOM_SETUP}, /* from CUSTOM_SETUP */
+	{statechart_events::start_recipe_custom, GUARD_NONE, Statechart::main_region_STANDARD_PROCESS, ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_0, Statechart::main_region_CUSTOM_SETUP}, /* from CUSTOM_SETUP_COMPLETE */
+	{statechart_events::go_to_menu, GUARD_NONE, Statechart::main_region_MENU, ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_1, Statechart::main_region_CUSTOM_SETUP}, /* from CUSTOM_SETUP_COMPLETE */
+	{statechart_events::keypad_input_confirm, GUARD_3, Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS, ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_0, Statechart::main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS}, /* from NUM_STEPS */
+	{statechart_events::loop_finished, GUARD_4, Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS, ACTION_NONE, Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS}, /* from LOOP_TEMP_TIME_STEPS */
+	{statechart_events::loop_finished, GUARD_4, Statechart::main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE, ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_1, Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS}, /* from LOOP_TEMP_TIME_STEPS */
+	{statechart_events::keypad_input_confirm, GUARD_5, Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME, ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_0, Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP}, /* from TEMP */
+	{statechart_events::keypad_input_confirm, GUARD_5, Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS, ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_0, Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS}, /* from TIME */
+	{statechart_events::Statechart_main_region_INIT_SYSTEM_time_event_0, GUARD_NONE, Statechart::main_region_MENU, ACTION_NONE, Statechart::main_region_INIT_SYSTEM}, /* from INIT_SYSTEM */
+	{statechart_events::recipe_back_menu, GUARD_NONE, Statechart::main_region_MENU, ACTION_NONE, Statechart::main_region_RECIPE_1}, /* from RECIPE_1 */
+	{statechart_events::recipe_1_process, GUARD_NONE, Statechart::main_region_STANDARD_PROCESS, ACTION_NONE, Statechart::main_region_RECIPE_1}, /* from RECIPE_1 */
+	{statechart_events::recipe_back_menu, GUARD_NONE, Statechart::main_region_MENU, ACTION_NONE, Statechart::main_region_RECIPE_2}, /* from RECIPE_2 */
+	{statechart_events::recipe_2_process, GUARD_NONE, Statechart::main_region_STANDARD_PROCESS, ACTION_NONE, Statechart::main_region_RECIPE_2}, /* from RECIPE_2 */
+	{statechart_events::recipe_back_menu, GUARD_NONE, Statechart::main_region_MENU, ACTION_NONE, Statechart::main_region_RECIPE_3}, /* from RECIPE_3 */
+	{statechart_events::recipe_3_process, GUARD_NONE, Statechart::main_region_STANDARD_PROCESS, ACTION_NONE, Statechart::main_region_RECIPE_3}, /* from RECIPE_3 */
+	{statechart_events::recipe_back_menu, GUARD_NONE, Statechart::main_region_MENU, ACTION_NONE, Statechart::main_region_RECIPE_4}, /* from RECIPE_4 */
+	{statechart_events::recipe_4_process, GUARD_NONE, Statechart::main_region_STANDARD_PROCESS, ACTION_NONE, Statechart::main_region_RECIPE_4}, /* from RECIPE_4 */
+	{statechart_events::recipe_back_menu, GUARD_NONE, Statechart::main_region_MENU, ACTION_NONE, Statechart::main_region_RECIPE_5}, /* from RECIPE_5 */
+	{statechart_events::recipe_5_process, GUARD_NONE, Statechart::main_region_CUSTOM_SETUP, ACTION_NONE, Statechart::main_region_RECIPE_5}, /* from RECIPE_5 */
+	{statechart_events::Statechart_main_region_FINISHED_MESSAGE_time_event_0, GUARD_NONE, Statechart::main_region_IDLE, ACTION_NONE, Statechart::main_region_FINISHED_MESSAGE}, /* from FINISHED_MESSAGE */
+};
+
+/* The hand-kept Statechart.h must match the model. */
+static_assert(Statechart::numStates == 20, "Statechart.h is out of date with the model");
+static_assert(Statechart::timeEventsCount == 2, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_IDLE == 1, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_MENU == 2, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_EXIT == 3, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_STANDARD_PROCESS == 4, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_STANDARD_PROCESS_standard_process_START_PROCESS == 5, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS == 6, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP == 7, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_CUSTOM_SETUP == 8, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE == 9, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS == 10, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS == 11, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP == 12, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME == 13, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_INIT_SYSTEM == 14, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_RECIPE_1 == 15, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_RECIPE_2 == 16, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_RECIPE_3 == 17, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_RECIPE_4 == 18, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_RECIPE_5 == 19, "Statechart.h is out of date with the model");
+static_assert(Statechart::main_region_FINISHED_MESSAGE == 20, "Statechart.h is out of date with the model");
+static_assert(statechart_events::menu == 1, "Statechart.h is out of date with the model");
+static_assert(statechart_events::standard_process == 2, "Statechart.h is out of date with the model");
+static_assert(statechart_events::heating == 3, "Statechart.h is out of date with the model");
+static_assert(statechart_events::resting == 4, "Statechart.h is out of date with the model");
+static_assert(statechart_events::heating_2 == 5, "Statechart.h is out of date with the model");
+static_assert(statechart_events::resting_2 == 6, "Statechart.h is out of date with the model");
+static_assert(statechart_events::idle == 7, "Statechart.h is out of date with the model");
+static_assert(statechart_events::custom_setup == 8, "Statechart.h is out of date with the model");
+static_assert(statechart_events::set_temperature == 9, "Statechart.h is out of date with the model");
+static_assert(statechart_events::set_time == 10, "Statechart.h is out of date with the model");
+static_assert(statechart_events::set_temperature_2 == 11, "Statechart.h is out of date with the model");
+static_assert(statechart_events::set_time_2 == 12, "Statechart.h is out of date with the model");
+static_assert(statechart_events::add_step == 13, "Statechart.h is out of date with the model");
+static_assert(statechart_events::standard_process_custom == 14, "Statechart.h is out of date with the model");
+static_assert(statechart_events::finish_process == 15, "Statechart.h is out of date with the model");
+static_assert(statechart_events::finish_process_idle == 16, "Statechart.h is out of date with the model");
+static_assert(statechart_events::start_button == 17, "Statechart.h is out of date with the model");
+static_assert(statechart_events::exit_process == 18, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_1 == 19, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_2 == 20, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_3 == 21, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_4 == 22, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_5 == 23, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_back_menu == 24, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_1_process == 25, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_2_process == 26, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_3_process == 27, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_4_process == 28, "Statechart.h is out of date with the model");
+static_assert(statechart_events::recipe_5_process == 29, "Statechart.h is out of date with the model");
+static_assert(statechart_events::start_first_step == 30, "Statechart.h is out of date with the model");
+static_assert(statechart_events::step_finished == 31, "Statechart.h is out of date with the model");
+static_assert(statechart_events::finished_process == 32, "Statechart.h is out of date with the model");
+static_assert(statechart_events::keypad_input_confirm == 33, "Statechart.h is out of date with the model");
+static_assert(statechart_events::keypad_input_cancel == 34, "Statechart.h is out of date with the model");
+static_assert(statechart_events::go_to_loop == 35, "Statechart.h is out of date with the model");
+static_assert(statechart_events::temp_finished == 36, "Statechart.h is out of date with the model");
+static_assert(statechart_events::loop_finished == 37, "Statechart.h is out of date with the model");
+static_assert(statechart_events::start_recipe_custom == 38, "Statechart.h is out of date with the model");
+static_assert(statechart_events::go_to_menu == 39, "Statechart.h is out of date with the model");
+static_assert(statechart_events::Statechart_main_region_INIT_SYSTEM_time_event_0 == 40, "Statechart.h is out of date with the model");
+static_assert(statechart_events::Statechart_main_region_FINISHED_MESSAGE_time_event_0 == 41, "Statechart.h is out of date with the model");
+
+} /* namespace statechart_model */
+
+
+/* Actions of the model (entry/exit actions and transition effects). */
+void Statechart::executeAction(sc_ushort action)
+{
+	switch (action)
+	{
+		case statechart_model::ACTION_ENTRY_main_region_IDLE:
+			ifaceOperationCallback->beginDisplay();
+			ifaceOperationCallback->beginMatrix();
+			ifaceOperationCallback->showStartup();
+			ifaceOperationCallback->showIdleScreen();
+			ifaceOperationCallback->beginSemaphore();
+			ifaceOperationCallback->digitalWrite(semaphore_green_pin, high);
+			ifaceOperationCallback->digitalWrite(semaphore_red_pin, low);
+			ifaceOperationCallback->digitalWrite(semaphore_yellow_pin, low);
+			ifaceOperationCallback->digitalWrite(led_pin, low);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_MENU:
+			ifaceOperationCallback->showRecipes();
+			ifaceOperationCallback->digitalWrite(led_pin, low);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_EXIT:
+			ifaceOperationCallback->shutdownSystem();
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_STANDARD_PROCESS:
+			ifaceOperationCallback->digitalWrite(semaphore_yellow_pin, high);
+			ifaceOperationCallback->digitalWrite(semaphore_red_pin, low);
+			ifaceOperationCallback->digitalWrite(semaphore_green_pin, low);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_STANDARD_PROCESS_standard_process_START_PROCESS:
+			ifaceOperationCallback->initializeProcess();
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS:
+			ifaceOperationCallback->showFinished();
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP:
+			ifaceOperationCallback->startNextRecipeStep(ifaceOperationCallback->getCurrentRecipeIndex());
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE:
+			ifaceOperationCallback->showCustomSetup_Summary();
+			break;
+		case statechart_model::ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_0:
+			pushInEvent(recipe_5_process);
+			break;
+		case statechart_model::ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_1:
+			pushInEvent(recipe_back_menu);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS:
+			ifaceOperationCallback->showCustomSetup_GetNumSteps();
+			break;
+		case statechart_model::ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_0:
+			ifaceOperationCallback->setNumCustomSteps(received_value);
+			pushInEvent(go_to_loop);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS:
+			ifaceOperationCallback->initializeStepDataCollection();
+			break;
+		case statechart_model::ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_1:
+			ifaceOperationCallback->advanceToNextCustomStep();
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP:
+			ifaceOperationCallback->showCustomSetup_PromptTemp(current_custom_step_idx);
+			break;
+		case statechart_model::ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_0:
+			ifaceOperationCallback->processTemperature(current_custom_step_idx, received_value);
+			pushInEvent(temp_finished);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME:
+			ifaceOperationCallback->showCustomSetup_PromptTime(current_custom_step_idx);
+			break;
+		case statechart_model::ACTION_EFFECT_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_0:
+			ifaceOperationCallback->processDuration(current_custom_step_idx, received_value);
+			pushInEvent(loop_finished);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_INIT_SYSTEM:
+			timerService->setTimer(this, (sc_eventid)(&timeEvents[0]), 5000, false);
+			ifaceOperationCallback->pinMode(led_pin, output);
+			ifaceOperationCallback->digitalWrite(led_pin, high);
+			ifaceOperationCallback->beginWaterSensor();
+			ifaceOperationCallback->setupHeaterPWM();
+			break;
+		case statechart_model::ACTION_EXIT_main_region_INIT_SYSTEM:
+			timerService->unsetTimer(this, (sc_eventid)(&timeEvents[0]));
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_RECIPE_1:
+			ifaceOperationCallback->showRecipe(1);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_RECIPE_2:
+			ifaceOperationCallback->showRecipe(2);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_RECIPE_3:
+			ifaceOperationCallback->showRecipe(3);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_RECIPE_4:
+			ifaceOperationCallback->showRecipe(4);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_RECIPE_5:
+			ifaceOperationCallback->showRecipe(5);
+			break;
+		case statechart_model::ACTION_ENTRY_main_region_FINISHED_MESSAGE:
+			timerService->setTimer(this, (sc_eventid)(&timeEvents[1]), 5000, false);
+			ifaceOperationCallback->showFinishedMessage();
+			break;
+		case statechart_model::ACTION_EXIT_main_region_FINISHED_MESSAGE:
+			timerService->unsetTimer(this, (sc_eventid)(&timeEvents[1]));
+			break;
+		default:
+			break;
+	}
+}
+
+/* Guards of the model. */
+sc_boolean Statechart::evaluateGuard(sc_ushort guard)
+{
+	switch (guard)
+	{
+		case statechart_model::GUARD_1:
+			return ifaceOperationCallback->hasMoreSteps();
+		case statechart_model::GUARD_2:
+			return !ifaceOperationCallback->hasMoreSteps();
+		case statechart_model::GUARD_3:
+			return ifaceOperationCallback->isValidNumSteps(received_value);
+		case statechart_model::GUARD_4:
+			return ifaceOperationCallback->hasMoreStepsToDefine();
+		case statechart_model::GUARD_5:
+			return ifaceOperationCallback->isValidDataInput(received_value);
+		default:
+			return true;
+	}
+}
+
+/*
+ * Interpreter. Single region per composite state, so the state configuration
+ * vector holds only the active leaf; ancestors are implied by the tables.
+ */
+
+static inline sc_boolean isAncestorOrSelf(sc_ushort ancestor, sc_ushort state)
+{
+	return state >= ancestor && state <= statechart_model::states[ancestor].lastDescendant;
+}
+
+/* Enters 'state' (running its entry action) and descends into the default children. */
+inline void Statechart::enterStateDefault(sc_ushort state)
+{
+	for (;;)
+	{
+		const statechart_model::StateInfo & info = statechart_model::states[state];
+		if (info.entryAction != statechart_model::ACTION_NONE)
+		{
+			executeAction(info.entryAction);
+		}
+		if (info.initial == statechart_model::NO_STATE)
+		{
+			stateConfVector[0] = (StatechartStates) state;
+			return;
+		}
+		state = info.initial;
+	}
+}
+
+/* Enters 'target' coming from 'outer' (exclusive): entry actions run from the outside in. */
+inline void Statechart::enterStatePath(sc_ushort outer, sc_ushort target)
+{
+	if (statechart_model::states[target].parent != outer)
+	{
+		sc_ushort path[numStates];
+		sc_ushort depth = 0;
+		for (sc_ushort s = statechart_model::states[target].parent; s != outer; s = statechart_model::states[s].parent)
+		{
+			path[depth++] = s;
+		}
+		while (depth > 0)
+		{
+			const sc_ushort action = statechart_model::states[path[--depth]].entryAction;
+			if (action != statechart_model::ACTION_NONE)
+			{
+				executeAction(action);
+			}
+		}
+	}
+	enterStateDefault(target);
+}
+
+/* Exits the active leaf and its ancestors up to and including 'outermost' (innermost first). */
+inline void Statechart::exitStatesUpTo(sc_ushort outermost)
+{
+	sc_ushort s = stateConfVector[0];
+	while (s != Statechart_last_state && s != statechart_model::NO_STATE)
+	{
+		const statechart_model::StateInfo & info = statechart_model::states[s];
+		if (info.exitAction != statechart_model::ACTION_NONE)
+		{
+			executeAction(info.exitAction);
+		}
+		stateConfVector[0] = (info.parent == statechart_model::NO_STATE) ? Statechart_last_state : (StatechartStates) info.parent;
+		if (s == outermost)
+		{
+			return;
+		}
+		s = info.parent;
+	}
+}
+
+/* External transition: exit up to the precomputed scope, run the effect, enter the target. */
+inline void Statechart::takeTransition(const statechart_model::TransitionInfo & transition)
+{
+	exitStatesUpTo(transition.exitTop);
+	if (transition.effect != statechart_model::ACTION_NONE)
+	{
+		executeAction(transition.effect);
+	}
+	enterStatePath(statechart_model::states[transition.exitTop].parent, transition.target);
+}
+
+/* Child-first search for the first enabled transition, from the active leaf outwards. */
+sc_boolean Statechart::microStep(sc_ushort event)
+{
+	if (event == invalid_event)
+	{
+		return false;
+	}
+	for (sc_ushort s = stateConfVector[0]; s != Statechart_last_state && s != statechart_model::NO_STATE; s = statechart_model::states[s].parent)
+	{
+		const statechart_model::StateInfo & info = statechart_model::states[s];
+		const statechart_model::TransitionInfo * transition = &statechart_model::transitions[info.firstTransition];
+		const statechart_model::TransitionInfo * const end = transition + info.transitionCount;
+		for (; transition != end; ++transition)
+		{
+			if (transition->event == event
+				&& (transition->guard == statechart_model::GUARD_NONE || evaluateGuard(transition->guard)))
+			{
+				takeTransition(*transition);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void Statechart::enterInitialState()
+{
+	enterStatePath(statechart_model::NO_STATE, statechart_model::ROOT_INITIAL);
+}
+
+void Statechart::exitAllStates()
+{
+	exitStatesUpTo(statechart_model::NO_STATE);
+}
+
+sc_boolean Statechart::restoreActiveState(StatechartStates state)
+{
+	if (isExecuting || isActive() || state <= Statechart_last_state || state > numStates
+		|| statechart_model::states[state].initial != statechart_model::NO_STATE)
+	{
+		return false;
+	}
+	stateConfVector[0] = state;
+	return true;
+}
+
+sc_boolean Statechart::isStateConfigurationValid() const
+{
+	const sc_ushort state = stateConfVector[0];
+	if (state == Statechart_last_state)
+	{
+		return true;
+	}
+	return state <= numStates && statechart_model::states[state].initial == statechart_model::NO_STATE;
+}
+
+sc_boolean Statechart::isStateActive(StatechartStates state) const
+{
+	if (state <= Statechart_last_state || state > numStates)
+	{
+		return false;
+	}
+	return isAncestorOrSelf(state, stateConfVector[0]);
+}
+
+#endif /* STATECHARTMODEL_H_ */
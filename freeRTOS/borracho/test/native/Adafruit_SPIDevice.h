@@ -0,0 +1,14 @@
+/**
+ * @file Adafruit_SPIDevice.h
+ * @brief Vazio no host: a Adafruit_GFX inclui a BusIO, mas o desenho não a usa (lib_ignore no env:native).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_ADAFRUIT_SPIDEVICE_H
+#define HOST_ADAFRUIT_SPIDEVICE_H
+
+#include <Arduino.h>
+
+#endif // HOST_ADAFRUIT_SPIDEVICE_H
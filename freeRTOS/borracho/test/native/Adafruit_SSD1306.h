@@ -0,0 +1,21 @@
+/**
+ * @file Adafruit_SSD1306.h
+ * @brief Constantes do SSD1306 usadas pelos headers de src/ nos testes no host (sem o driver).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_ADAFRUIT_SSD1306_H
+#define HOST_ADAFRUIT_SSD1306_H
+
+#include <Arduino.h>
+
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_INVERSE 2
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+
+#endif // HOST_ADAFRUIT_SSD1306_H
@@ -0,0 +1,329 @@
+/**
+ * @file Arduino.h
+ * @brief Núcleo Arduino mínimo para os testes no host (env:native).
+ * @details Só o que os headers de src/ testados no host usam: tipos, Print, String, Serial, ESP e
+ * funções de tempo. O tempo é um relógio virtual: millis()/micros() só andam com delay() ou
+ * hostAdvanceMicros(), o que deixa latências e intervalos medidos pelos módulos determinísticos.
+ * getCycleCount() é o único valor real (para benchmarks), convertido para ciclos de 240 MHz.
+ * HostPrint guarda em memória o que os printStats() imprimem, para o teste conferir.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define F(s) (s)
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+#define pgm_read_pointer(addr) (*(void *const *)(addr))
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+template <typename T, typename L, typename H>
+inline T constrain(T value, L low, H high)
+{
+  return value < (T)low ? (T)low : (value > (T)high ? (T)high : value);
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// --- RELÓGIO VIRTUAL ---
+inline std::atomic<uint64_t> hostClockMicros{0};
+
+/**
+ * @brief Avança o relógio virtual (millis()/micros()).
+ */
+inline void hostAdvanceMicros(uint64_t deltaMicros)
+{
+  hostClockMicros.fetch_add(deltaMicros);
+}
+
+inline void hostResetClock()
+{
+  hostClockMicros.store(0);
+}
+
+inline unsigned long micros()
+{
+  return (uint32_t)hostClockMicros.load(); // 32 bits, como no ESP32 (dá a volta em ~71 min)
+}
+
+inline unsigned long millis()
+{
+  return (uint32_t)(hostClockMicros.load() / 1000);
+}
+
+inline void delay(uint32_t ms)
+{
+  hostAdvanceMicros((uint64_t)ms * 1000);
+}
+
+inline void delayMicroseconds(uint32_t us)
+{
+  hostAdvanceMicros(us);
+}
+
+// --- GPIO / PWM (sem efeito no host) ---
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline double ledcSetup(uint8_t, double frequency, uint8_t) { return frequency; }
+inline void ledcAttachPin(uint8_t, uint8_t) {}
+inline void ledcWrite(uint8_t, uint32_t) {}
+
+/**
+ * @brief String do Arduino sobre std::string (só o que o firmware usa).
+ */
+class String
+{
+public:
+  String() {}
+  String(const char *text) : value(text ? text : "") {}
+  String(const std::string &text) : value(text) {}
+  String(char c) : value(1, c) {}
+  String(int number) : value(std::to_string(number)) {}
+  String(unsigned int number) : value(std::to_string(number)) {}
+  String(long number) : value(std::to_string(number)) {}
+  String(unsigned long number) : value(std::to_string(number)) {}
+  String(double number, unsigned int decimals = 2)
+  {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, number);
+    value = buffer;
+  }
+
+  unsigned int length() const { return (unsigned int)value.size(); }
+  const char *c_str() const { return value.c_str(); }
+  bool isEmpty() const { return value.empty(); }
+  char charAt(unsigned int index) const { return index < value.size() ? value[index] : 0; }
+  char operator[](unsigned int index) const { return charAt(index); }
+  long toInt() const { return strtol(value.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(value.c_str(), nullptr); }
+  String substring(unsigned int from) const { return from < value.size() ? String(value.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const
+  {
+    return from < to && from < value.size() ? String(value.substr(from, to - from)) : String();
+  }
+  int indexOf(char c) const
+  {
+    size_t pos = value.find(c);
+    return pos == std::string::npos ? -1 : (int)pos;
+  }
+  bool equals(const String &other) const { return value == other.value; }
+  bool operator==(const String &other) const { return value == other.value; }
+  bool operator==(const char *other) const { return value == (other ? other : ""); }
+  bool operator!=(const String &other) const { return value != other.value; }
+  String &operator+=(const String &other)
+  {
+    value += other.value;
+    return *this;
+  }
+  String &operator+=(const char *other)
+  {
+    value += other ? other : "";
+    return *this;
+  }
+  String &operator+=(char c)
+  {
+    value += c;
+    return *this;
+  }
+  friend String operator+(const String &a, const String &b) { return String(a.value + b.value); }
+  friend String operator+(const String &a, const char *b) { return String(a.value + (b ? b : "")); }
+  friend String operator+(const char *a, const String &b) { return String((a ? a : "") + b.value); }
+
+private:
+  std::string value;
+};
+
+/**
+ * @brief Print do Arduino: mesma formatação de print()/println()/printf().
+ */
+class Print
+{
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size)
+  {
+    size_t n = 0;
+    while (size--)
+    {
+      if (!write(*buffer++))
+        break;
+      n++;
+    }
+    return n;
+  }
+  size_t write(const char *text) { return text ? write((const uint8_t *)text, strlen(text)) : 0; }
+  size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+  {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length < 0)
+      return 0;
+    if ((size_t)length < sizeof(buffer))
+      return write((const uint8_t *)buffer, length);
+    std::string big(length + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&big[0], big.size(), format, args);
+    va_end(args);
+    return write((const uint8_t *)big.data(), length);
+  }
+
+  size_t print(const char text[]) { return write(text); }
+  size_t print(const String &text) { return write(text.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(long n, int base = DEC)
+  {
+    if (base == DEC && n < 0)
+      return print('-') + printNumber(0UL - (unsigned long)n, DEC);
+    return printNumber((unsigned long)n, base);
+  }
+  size_t print(unsigned long n, int base = DEC) { return printNumber(n, base); }
+  size_t print(double n, int digits = 2)
+  {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, n);
+    return write(buffer);
+  }
+
+  size_t println() { return write("\r\n"); }
+  template <typename T>
+  size_t println(const T &value)
+  {
+    return print(value) + println();
+  }
+  template <typename T>
+  size_t println(const T &value, int format)
+  {
+    return print(value, format) + println();
+  }
+  size_t println(const char text[]) { return print(text) + println(); }
+
+private:
+  size_t printNumber(unsigned long n, int base)
+  {
+    char buffer[8 * sizeof(long) + 1];
+    char *p = &buffer[sizeof(buffer) - 1];
+    *p = '\0';
+    if (base < 2)
+      base = 10;
+    do
+    {
+      unsigned long digit = n % base;
+      n /= base;
+      *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+    } while (n);
+    return write(p);
+  }
+};
+
+class Stream : public Print
+{
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+};
+
+/**
+ * @brief Serial do host: escreve na saída padrão.
+ */
+class HardwareSerial : public Stream
+{
+public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+  using Print::write;
+  operator bool() const { return true; }
+};
+
+inline HardwareSerial Serial;
+
+/**
+ * @brief Print em memória: guarda o texto impresso (saída dos printStats()).
+ */
+class HostPrint : public Print
+{
+public:
+  size_t write(uint8_t c) override
+  {
+    text += (char)c;
+    return 1;
+  }
+  size_t write(const uint8_t *buffer, size_t size) override
+  {
+    text.append((const char *)buffer, size);
+    return size;
+  }
+  using Print::write;
+
+  std::string text;
+};
+
+/**
+ * @brief ESP do host: ciclos de CPU derivados do relógio real (240 MHz) e heap fictício.
+ */
+class EspClass
+{
+public:
+  uint32_t getCycleCount()
+  {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint32_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() * 240 / 1000);
+  }
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getFreeHeap() { return 200000; }
+  uint32_t getMinFreeHeap() { return 200000; }
+  void restart() { abort(); }
+};
+
+inline EspClass ESP;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,123 @@
+/**
+ * @file FS.h
+ * @brief Sistema de arquivos em memória para os testes no host (env:native).
+ * @details Só o que BrewSnapshotStore e PidGainsStore usam: open() para leitura ou escrita, read(),
+ * write(), size(), close(), exists(), remove() e rename(). Cada arquivo é um vetor de bytes; a
+ * escrita só aparece no arquivo no close(), como um arquivo fechado no LittleFS.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <Arduino.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+typedef std::map<std::string, std::vector<uint8_t>> HostFileMap;
+
+/**
+ * @brief Arquivo aberto: cópia do conteúdo, devolvida ao mapa no close() se foi escrito.
+ */
+class File : public Stream
+{
+public:
+  File() {}
+  File(HostFileMap *files, const std::string &path, bool writable, std::vector<uint8_t> data)
+      : files(files), path(path), writable(writable), data(std::move(data)), open(true) {}
+
+  explicit operator bool() const { return open; }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size) override
+  {
+    if (!open || !writable)
+      return 0;
+    data.insert(data.end(), buffer, buffer + size);
+    return size;
+  }
+  using Print::write;
+
+  int available() override { return open ? (int)(data.size() - position) : 0; }
+  int read() override
+  {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+  size_t read(uint8_t *buffer, size_t size)
+  {
+    size_t n = open ? std::min(size, data.size() - position) : 0;
+    memcpy(buffer, data.data() + position, n);
+    position += n;
+    return n;
+  }
+  size_t size() const { return data.size(); }
+  void flush() {}
+  void close()
+  {
+    if (open && writable)
+      (*files)[path] = data;
+    open = false;
+  }
+
+private:
+  HostFileMap *files = nullptr;
+  std::string path;
+  bool writable = false;
+  std::vector<uint8_t> data;
+  size_t position = 0;
+  bool open = false;
+};
+
+namespace fs
+{
+  /**
+   * @brief Conjunto de arquivos em memória.
+   */
+  class FS
+  {
+  public:
+    File open(const char *path, const char *mode = FILE_READ)
+    {
+      auto it = files.find(path);
+      if (mode[0] == 'r')
+      {
+        return it == files.end() ? File() : File(&files, path, false, it->second);
+      }
+      std::vector<uint8_t> data;
+      if (mode[0] == 'a' && it != files.end())
+        data = it->second;
+      return File(&files, path, true, data);
+    }
+    bool exists(const char *path) { return files.count(path) != 0; }
+    bool remove(const char *path) { return files.erase(path) != 0; }
+    bool rename(const char *from, const char *to)
+    {
+      auto it = files.find(from);
+      if (it == files.end())
+        return false;
+      files[to] = it->second;
+      files.erase(from);
+      return true;
+    }
+
+    /**
+     * @brief Apaga todos os arquivos (setUp dos testes).
+     */
+    void hostFormat() { files.clear(); }
+
+  private:
+    HostFileMap files;
+  };
+}
+
+#endif // HOST_FS_H
@@ -0,0 +1,24 @@
+/**
+ * @file Keypad.h
+ * @brief Teclado matricial sem hardware para os testes no host (nenhuma tecla pressionada).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_KEYPAD_H
+#define HOST_KEYPAD_H
+
+#include <Arduino.h>
+
+#define NO_KEY '\0'
+#define makeKeymap(x) ((char *)x)
+
+class Keypad
+{
+public:
+  Keypad(char *, byte *, byte *, byte, byte) {}
+  char getKey() { return NO_KEY; }
+};
+
+#endif // HOST_KEYPAD_H
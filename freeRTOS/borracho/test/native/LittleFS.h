@@ -0,0 +1,22 @@
+/**
+ * @file LittleFS.h
+ * @brief LittleFS do host: o sistema de arquivos em memória de FS.h.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "FS.h"
+
+class LittleFSFS : public fs::FS
+{
+public:
+  bool begin(bool = false) { return true; }
+};
+
+inline LittleFSFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
@@ -0,0 +1,9 @@
+/**
+ * @file Print.h
+ * @brief Host: a classe Print fica no Arduino.h de test/native (incluído pela Adafruit_GFX).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <Arduino.h>
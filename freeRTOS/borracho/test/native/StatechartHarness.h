@@ -0,0 +1,129 @@
+/**
+ * @file StatechartHarness.h
+ * @brief Callback falso e serviço de timers com relógio virtual para rodar a Statechart no host.
+ * @details Compartilhado pelos testes do env:native que despacham eventos na statechart gerada.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef STATECHARTHARNESS_H
+#define STATECHARTHARNESS_H
+
+// Includes do projeto
+#include "TimerWheel.h"
+#include "src-gen/Statechart.h"
+
+/**
+ * @brief Callback falso: guarda receita e etapa como o StatechartCallback e adia o
+ * finished_process, que no firmware passa pela fila de entrada.
+ * @tparam Machine Classe gerada cujo OperationCallback é implementado (a Statechart ou outra
+ * saída do gerador com as mesmas operações).
+ */
+template <class Machine>
+class MockCallbackFor : public Machine::OperationCallback
+{
+public:
+  void shutdownSystem() override { shutdowns++; }
+  void heat(sc_integer) override {}
+  void time(sc_integer) override {}
+  void setTemperature(sc_integer) override {}
+  void setTime(sc_integer) override {}
+  void initializeSetupProcess() override {}
+  void showState(sc_string) override {}
+  void digitalWrite(sc_integer, sc_integer) override {}
+  void pinMode(sc_integer, sc_integer) override {}
+  void beginWaterSensor() override {}
+  void setupHeaterPWM() override {}
+  void showStartup() override {}
+  void showIdleScreen() override {}
+  void beginDisplay() override {}
+  void beginMatrix() override {}
+  void beginSemaphore() override {}
+  void showRecipes() override {}
+  void showRecipe(sc_integer) override {}
+  void initializeProcess() override {}
+  void showFinished() override
+  {
+    finishedPending = true; // showFinished() posta finished_process na fila de entrada
+    currentRecipeIdx = -1;
+    currentStepIdx = -1;
+  }
+  void startNextRecipeStep(sc_integer recipeIndex) override
+  {
+    if (currentRecipeIdx != recipeIndex)
+    {
+      currentRecipeIdx = recipeIndex;
+      currentStepIdx = 0;
+    }
+    else
+    {
+      currentStepIdx++;
+    }
+  }
+  sc_boolean hasMoreSteps() override { return currentRecipeIdx >= 0 && currentStepIdx + 1 < stepsPerRecipe; }
+  sc_integer getCurrentRecipeIndex() override { return currentRecipeIdx; }
+  sc_integer getCurrentStepIndex() override { return currentStepIdx; }
+  void showProcessStatus(sc_integer, sc_integer, sc_integer, sc_integer, sc_string, sc_integer, sc_integer, sc_boolean) override {}
+  void controlHeaterPWM(sc_integer) override {}
+  void showCustomSetup_GetNumSteps() override {}
+  sc_boolean isValidNumSteps(sc_integer) override { return false; }
+  void setNumCustomSteps(sc_integer) override {}
+  void initializeStepDataCollection() override {}
+  void showCustomSetup_PromptTemp(sc_integer) override {}
+  void showCustomSetup_PromptTime(sc_integer) override {}
+  sc_boolean isValidDataInput(sc_integer) override { return false; }
+  void processTemperature(sc_integer, sc_integer) override {}
+  void processDuration(sc_integer, sc_integer) override {}
+  sc_boolean hasMoreStepsToDefine() override { return false; }
+  void advanceToNextCustomStep() override {}
+  void showCustomSetup_Summary() override {}
+  void showFinishedMessage() override {}
+
+  int stepsPerRecipe = 3;
+  sc_integer currentRecipeIdx = -1; // Definido pela tecla, como na processKeypadKey()
+  sc_integer currentStepIdx = -1;
+  bool finishedPending = false;
+  unsigned long shutdowns = 0;
+};
+
+typedef MockCallbackFor<Statechart> MockCallback;
+
+/**
+ * @brief Serviço de timers sobre a TimerWheel; tick() avança o relógio virtual e entrega as
+ * expirações pendentes direto à statechart (no firmware a stateMachineTask as entrega com
+ * StatechartTimer::dispatchExpired() depois do aviso na fila de entrada).
+ */
+class VirtualTimerService : public sc::timer::TimerServiceInterface
+{
+public:
+  void setTimer(sc::timer::TimedInterface *statemachine, sc_eventid event, sc_time time_ms, sc_boolean isPeriodic) override
+  {
+    wheel.arm(statemachine, event, TimerWheel::msToTicks(time_ms), isPeriodic);
+  }
+
+  void unsetTimer(sc::timer::TimedInterface *, sc_eventid event) override
+  {
+    wheel.cancel(event);
+  }
+
+  /**
+   * @return Número de eventos de tempo entregues.
+   */
+  int tick()
+  {
+    wheel.tick();
+    int count = 0;
+    TimerExpiration expired;
+    while (wheel.takeExpired(expired))
+    {
+      expired.sm->raiseTimeEvent(expired.event);
+      count++;
+    }
+    return count;
+  }
+
+  TimerWheel wheel;
+};
+
+#endif // STATECHARTHARNESS_H
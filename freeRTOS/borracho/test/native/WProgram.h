@@ -0,0 +1,14 @@
+/**
+ * @file WProgram.h
+ * @brief Nome antigo do núcleo Arduino, incluído pela Adafruit_GFX quando ARDUINO não está definido (host).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_WPROGRAM_H
+#define HOST_WPROGRAM_H
+
+#include <Arduino.h>
+
+#endif // HOST_WPROGRAM_H
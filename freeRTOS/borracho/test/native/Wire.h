@@ -0,0 +1,29 @@
+/**
+ * @file Wire.h
+ * @brief TwoWire sem hardware para os testes no host (o I2C é simulado por um I2CTransport).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire : public Stream
+{
+public:
+  bool begin(int = -1, int = -1, uint32_t = 0) { return true; }
+  void setClock(uint32_t) {}
+  void beginTransmission(uint8_t) {}
+  uint8_t endTransmission(bool = true) { return 2; } // NACK: não há escravo no host
+  uint8_t requestFrom(uint8_t, uint8_t) { return 0; }
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t *, size_t size) override { return size; }
+  using Print::write;
+};
+
+inline TwoWire Wire;
+
+#endif // HOST_WIRE_H
@@ -0,0 +1,106 @@
+/**
+ * @file queue.h
+ * @brief Filas do FreeRTOS sobre std::mutex e std::condition_variable, para os testes no host.
+ * @details Mesma semântica de cópia byte a byte do FreeRTOS: cada item tem o tamanho fixo dado na
+ * criação. Timeouts em ticks de 1 ms de tempo real (o relógio virtual do Arduino.h não anda).
+ * O armazenamento é alocado uma vez no xQueueCreate(), como o do FreeRTOS: enviar e receber não
+ * usam o heap, então os testes que contam alocações podem passar pela fila.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string.h>
+#include <vector>
+
+struct HostQueue
+{
+  std::mutex lock;
+  std::condition_variable changed;
+  std::vector<uint8_t> storage; // length * itemSize bytes, anel
+  UBaseType_t head = 0;          // Próximo item a receber
+  UBaseType_t count = 0;         // Itens na fila
+  UBaseType_t length;
+  UBaseType_t itemSize;
+};
+
+typedef HostQueue *QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+  HostQueue *queue = new HostQueue();
+  queue->length = length;
+  queue->itemSize = itemSize;
+  queue->storage.resize((size_t)length * itemSize);
+  return queue;
+}
+
+inline void vQueueDelete(QueueHandle_t queue)
+{
+  delete queue;
+}
+
+// Espera a condição por até ticksToWait ms (portMAX_DELAY: sem limite)
+template <class Predicate>
+inline bool hostQueueWait(HostQueue *queue, std::unique_lock<std::mutex> &guard, TickType_t ticksToWait, Predicate ready)
+{
+  if (ticksToWait == portMAX_DELAY)
+  {
+    queue->changed.wait(guard, ready);
+    return true;
+  }
+  return queue->changed.wait_for(guard, std::chrono::milliseconds(ticksToWait), ready);
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticksToWait)
+{
+  std::unique_lock<std::mutex> guard(queue->lock);
+  if (!hostQueueWait(queue, guard, ticksToWait, [queue] { return queue->count < queue->length; }))
+    return errQUEUE_FULL;
+  UBaseType_t tail = (queue->head + queue->count) % queue->length;
+  memcpy(&queue->storage[(size_t)tail * queue->itemSize], item, queue->itemSize);
+  queue->count++;
+  guard.unlock();
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+inline BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticksToWait)
+{
+  return xQueueSend(queue, item, ticksToWait);
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticksToWait)
+{
+  std::unique_lock<std::mutex> guard(queue->lock);
+  if (!hostQueueWait(queue, guard, ticksToWait, [queue] { return queue->count > 0; }))
+    return pdFALSE;
+  memcpy(item, &queue->storage[(size_t)queue->head * queue->itemSize], queue->itemSize);
+  queue->head = (queue->head + 1) % queue->length;
+  queue->count--;
+  guard.unlock();
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+  std::lock_guard<std::mutex> guard(queue->lock);
+  return queue->count;
+}
+
+inline UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue)
+{
+  std::lock_guard<std::mutex> guard(queue->lock);
+  return queue->length - queue->count;
+}
+
+#endif // HOST_FREERTOS_QUEUE_H
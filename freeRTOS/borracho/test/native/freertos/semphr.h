@@ -0,0 +1,87 @@
+/**
+ * @file semphr.h
+ * @brief Mutex e semáforo binário do FreeRTOS para os testes no host.
+ * @details hostSemaphoreWaiters conta as threads bloqueadas em xSemaphoreTake(): o teste usa o
+ * contador para saber que uma tarefa já está esperando antes de seguir com outra.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+struct HostSemaphore
+{
+  std::mutex lock;
+  std::condition_variable available;
+  UBaseType_t count;
+};
+
+typedef HostSemaphore *SemaphoreHandle_t;
+
+inline std::atomic<int> hostSemaphoreWaiters{0};
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+  HostSemaphore *semaphore = new HostSemaphore();
+  semaphore->count = 1;
+  return semaphore;
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary()
+{
+  HostSemaphore *semaphore = new HostSemaphore();
+  semaphore->count = 0;
+  return semaphore;
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+  delete semaphore;
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait)
+{
+  std::unique_lock<std::mutex> guard(semaphore->lock);
+  if (semaphore->count == 0)
+  {
+    if (ticksToWait == 0)
+      return pdFALSE;
+    hostSemaphoreWaiters++;
+    if (ticksToWait == portMAX_DELAY)
+    {
+      semaphore->available.wait(guard, [semaphore] { return semaphore->count > 0; });
+    }
+    else if (!semaphore->available.wait_for(guard, std::chrono::milliseconds(ticksToWait),
+                                            [semaphore] { return semaphore->count > 0; }))
+    {
+      hostSemaphoreWaiters--;
+      return pdFALSE;
+    }
+    hostSemaphoreWaiters--;
+  }
+  semaphore->count--;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+  {
+    std::lock_guard<std::mutex> guard(semaphore->lock);
+    if (semaphore->count > 0)
+      return pdFALSE;
+    semaphore->count = 1;
+  }
+  semaphore->available.notify_one();
+  return pdTRUE;
+}
+
+#endif // HOST_FREERTOS_SEMPHR_H
@@ -0,0 +1,56 @@
+/**
+ * @file task.h
+ * @brief Atrasos e identificação de tarefas do FreeRTOS para os testes no host.
+ * @details vTaskDelay() dorme de verdade (cede a CPU às outras threads) mas não avança o relógio
+ * virtual do Arduino.h: o tempo medido pelos módulos só anda quando o teste quer.
+ * xTaskGetTickCount() é o millis() virtual; vTaskDelayUntil() leva o relógio virtual até o
+ * despertar pedido (ControlLoopScheduler), sem dormir.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+#include <Arduino.h>
+
+#include <chrono>
+#include <thread>
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+inline void vTaskDelay(TickType_t ticks)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+inline TickType_t xTaskGetTickCount()
+{
+  return (TickType_t)millis();
+}
+
+inline void vTaskDelayUntil(TickType_t *previousWake, TickType_t increment)
+{
+  *previousWake += increment;
+  TickType_t now = xTaskGetTickCount();
+  if ((int32_t)(*previousWake - now) > 0)
+  {
+    hostAdvanceMicros((uint64_t)(*previousWake - now) * 1000);
+  }
+}
+
+inline void taskYIELD()
+{
+  std::this_thread::yield();
+}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+  static thread_local char handle;
+  return &handle;
+}
+
+#endif // HOST_FREERTOS_TASK_H
@@ -0,0 +1,253 @@
+/**
+ * @file test_main.cpp
+ * @brief BrewSnapshotStore e PidGainsStore no host, sobre o LittleFS em memória de test/native.
+ * @details Os registros são gravados e relidos por outra instância, como no boot depois de uma
+ * queda de energia: tempo cumprido da etapa, setpoint atingido, integrador (devolvido a um
+ * FloatPid como na retomada da controlTask) e variáveis da receita personalizada voltam iguais.
+ * Arquivos com CRC, magic, versão ou tamanho errados (cada um com o CRC refeito, para ser
+ * recusado só pelo campo alterado) e arquivos truncados são descartados. Um .tmp deixado por uma
+ * gravação interrompida antes do rename não substitui o registro anterior.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <string.h>
+#include <vector>
+
+// Includes do projeto
+#include "BrewSnapshot.h"
+#include "FloatPid.h"
+#include "PidGains.h"
+#include "src-gen/Statechart.h"
+
+#define SNAPSHOT_OUTPUT_MAX 1023 // Limites de saída do PID da controlTask
+
+void setUp(void)
+{
+  LittleFS.hostFormat();
+}
+
+void tearDown(void) {}
+
+// Registro como o saveBrewSnapshot() da loggerTask monta a partir de um ControlRecord
+static BrewSnapshot stepInProgress()
+{
+  BrewSnapshot snapshot = {};
+  snapshot.activeState = (uint8_t)Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP;
+  snapshot.recipeIdx = 4;
+  snapshot.stepIdx = 2;
+  snapshot.setpointReached = 1;
+  snapshot.targetTemperature = 72;
+  snapshot.durationMinutes = 45;
+  snapshot.elapsedMillis = 1234567;
+  snapshot.customNumSteps = 5;
+  snapshot.currentCustomStepIdx = 3;
+  snapshot.receivedValue = -1;
+  snapshot.pidOutput = 640.5f;
+  snapshot.pidIntegral = 587.25f;
+  return snapshot;
+}
+
+static PidGains tunedGains()
+{
+  PidGains gains = {};
+  gains.kp = 41.5f;
+  gains.ki = 0.82f;
+  gains.kd = 12.25f;
+  gains.ultimateGain = 69.2f;
+  gains.ultimatePeriodSec = 118.0f;
+  return gains;
+}
+
+static std::vector<uint8_t> readFile(const char *path)
+{
+  File file = LittleFS.open(path, FILE_READ);
+  std::vector<uint8_t> data(file ? file.size() : 0);
+  if (file)
+  {
+    file.read(data.data(), data.size());
+    file.close();
+  }
+  return data;
+}
+
+static void writeFile(const char *path, const void *data, size_t size)
+{
+  File file = LittleFS.open(path, FILE_WRITE);
+  file.write((const uint8_t *)data, size);
+  file.close();
+}
+
+void test_snapshot_round_trip_keeps_the_step_progress(void)
+{
+  BrewSnapshotStore writer;
+  BrewSnapshot saved = stepInProgress();
+  TEST_ASSERT_TRUE(writer.save(saved));
+  TEST_ASSERT_TRUE(writer.save(saved)); // Gravação periódica seguinte
+  TEST_ASSERT_EQUAL_UINT32(2, saved.sequence);
+  TEST_ASSERT_FALSE(LittleFS.exists(BREW_SNAPSHOT_TMP_FILE));
+  TEST_ASSERT_EQUAL(sizeof(BrewSnapshot), readFile(BREW_SNAPSHOT_FILE).size());
+
+  // Boot seguinte: outra instância lê o que ficou no flash
+  BrewSnapshotStore reader;
+  BrewSnapshot loaded = {};
+  TEST_ASSERT_TRUE(reader.load(loaded));
+  TEST_ASSERT_EQUAL_MEMORY(&saved, &loaded, sizeof(BrewSnapshot));
+  TEST_ASSERT_EQUAL_UINT32(1234567, loaded.elapsedMillis);
+  TEST_ASSERT_EQUAL_UINT(1, loaded.setpointReached);
+  TEST_ASSERT_EQUAL_FLOAT(587.25f, loaded.pidIntegral);
+  TEST_ASSERT_EQUAL_INT(5, loaded.customNumSteps);
+  TEST_ASSERT_EQUAL_INT(3, loaded.currentCustomStepIdx);
+  TEST_ASSERT_EQUAL_INT(-1, loaded.receivedValue);
+
+  // A sequência continua de onde parou
+  TEST_ASSERT_TRUE(reader.save(loaded));
+  TEST_ASSERT_EQUAL_UINT32(3, loaded.sequence);
+
+  // Retomada: setMode(PID_AUTOMATIC) e depois o integrador, como no CMD_START_RECIPE_STEP
+  float input = loaded.targetTemperature, output = 0, setpoint = loaded.targetTemperature;
+  FloatPid pid(&input, &output, &setpoint, 30.0f, 5.0f, 0.0f, 100);
+  pid.setOutputLimits(0, SNAPSHOT_OUTPUT_MAX);
+  pid.setMode(PID_AUTOMATIC);
+  pid.setIntegral(loaded.pidIntegral);
+  TEST_ASSERT_EQUAL_FLOAT(587.25f, pid.integral());
+  TEST_ASSERT_TRUE(pid.compute());
+  TEST_ASSERT_EQUAL_FLOAT(587.25f, output); // Erro zero: a saída é o integrador retomado
+
+  reader.clear();
+  TEST_ASSERT_FALSE(LittleFS.exists(BREW_SNAPSHOT_FILE));
+  TEST_ASSERT_FALSE(reader.load(loaded));
+}
+
+void test_corrupted_snapshot_is_rejected(void)
+{
+  BrewSnapshotStore store;
+  BrewSnapshot valid = stepInProgress();
+  TEST_ASSERT_TRUE(store.save(valid));
+
+  BrewSnapshot loaded;
+  BrewSnapshot bad = valid;
+  bad.elapsedMillis += 1000; // Conteúdo alterado, CRC antigo
+  writeFile(BREW_SNAPSHOT_FILE, &bad, sizeof(bad));
+  TEST_ASSERT_FALSE_MESSAGE(store.load(loaded), "CRC errado aceito");
+
+  bad = valid;
+  bad.magic ^= 1;
+  bad.crc = BrewSnapshotStore::crc32((const uint8_t *)&bad, offsetof(BrewSnapshot, crc));
+  writeFile(BREW_SNAPSHOT_FILE, &bad, sizeof(bad));
+  TEST_ASSERT_FALSE_MESSAGE(store.load(loaded), "magic errado aceito");
+
+  bad = valid;
+  bad.version = BREW_SNAPSHOT_VERSION + 1;
+  bad.crc = BrewSnapshotStore::crc32((const uint8_t *)&bad, offsetof(BrewSnapshot, crc));
+  writeFile(BREW_SNAPSHOT_FILE, &bad, sizeof(bad));
+  TEST_ASSERT_FALSE_MESSAGE(store.load(loaded), "versao errada aceita");
+
+  bad = valid;
+  bad.size = sizeof(BrewSnapshot) - 4; // Registro de um layout anterior
+  bad.crc = BrewSnapshotStore::crc32((const uint8_t *)&bad, offsetof(BrewSnapshot, crc));
+  writeFile(BREW_SNAPSHOT_FILE, &bad, sizeof(bad));
+  TEST_ASSERT_FALSE_MESSAGE(store.load(loaded), "campo size errado aceito");
+
+  writeFile(BREW_SNAPSHOT_FILE, &valid, sizeof(valid) - 1);
+  TEST_ASSERT_FALSE_MESSAGE(store.load(loaded), "arquivo truncado aceito");
+
+  writeFile(BREW_SNAPSHOT_FILE, &valid, sizeof(valid)); // O registro intacto volta a ser aceito
+  TEST_ASSERT_TRUE(store.load(loaded));
+}
+
+void test_stale_tmp_does_not_replace_the_snapshot(void)
+{
+  BrewSnapshotStore store;
+  BrewSnapshot first = stepInProgress();
+  TEST_ASSERT_TRUE(store.save(first));
+
+  // Queda de energia antes do rename: o .tmp completo (ou parcial) fica para trás
+  BrewSnapshot newer = first;
+  newer.elapsedMillis = first.elapsedMillis + BREW_SNAPSHOT_PERIOD_MS;
+  newer.sequence = first.sequence + 1;
+  newer.crc = BrewSnapshotStore::crc32((const uint8_t *)&newer, offsetof(BrewSnapshot, crc));
+  writeFile(BREW_SNAPSHOT_TMP_FILE, &newer, sizeof(newer));
+  BrewSnapshotStore afterReboot;
+  BrewSnapshot loaded;
+  TEST_ASSERT_TRUE(afterReboot.load(loaded));
+  TEST_ASSERT_EQUAL_UINT32(first.elapsedMillis, loaded.elapsedMillis);
+  TEST_ASSERT_EQUAL_UINT32(first.sequence, loaded.sequence);
+
+  writeFile(BREW_SNAPSHOT_TMP_FILE, &newer, sizeof(newer) / 2);
+  TEST_ASSERT_TRUE(afterReboot.load(loaded));
+  TEST_ASSERT_EQUAL_MEMORY(&first, &loaded, sizeof(BrewSnapshot));
+
+  // A gravação seguinte reescreve o .tmp inteiro antes de renomear
+  TEST_ASSERT_TRUE(afterReboot.save(newer));
+  TEST_ASSERT_FALSE(LittleFS.exists(BREW_SNAPSHOT_TMP_FILE));
+  TEST_ASSERT_TRUE(store.load(loaded));
+  TEST_ASSERT_EQUAL_UINT32(first.elapsedMillis + BREW_SNAPSHOT_PERIOD_MS, loaded.elapsedMillis);
+
+  HostPrint out;
+  afterReboot.printStats(out);
+  TEST_ASSERT_TRUE_MESSAGE(out.text.find("1 gravacoes, 0 falhas") != std::string::npos, out.text.c_str());
+}
+
+void test_pid_gains_round_trip_and_rejection(void)
+{
+  PidGainsStore writer;
+  PidGains saved = tunedGains();
+  TEST_ASSERT_TRUE(writer.save(saved));
+  TEST_ASSERT_FALSE(LittleFS.exists(PID_GAINS_TMP_FILE));
+
+  PidGainsStore reader;
+  PidGains loaded = {};
+  TEST_ASSERT_TRUE(reader.load(loaded));
+  TEST_ASSERT_EQUAL_MEMORY(&saved, &loaded, sizeof(PidGains));
+
+  PidGains bad = saved;
+  bad.kp *= 2; // Conteúdo alterado, CRC antigo
+  writeFile(PID_GAINS_FILE, &bad, sizeof(bad));
+  TEST_ASSERT_FALSE_MESSAGE(reader.load(loaded), "CRC errado aceito");
+
+  bad = saved;
+  bad.magic = BREW_SNAPSHOT_MAGIC; // Arquivo de outro registro
+  bad.crc = BrewSnapshotStore::crc32((const uint8_t *)&bad, offsetof(PidGains, crc));
+  writeFile(PID_GAINS_FILE, &bad, sizeof(bad));
+  TEST_ASSERT_FALSE_MESSAGE(reader.load(loaded), "magic errado aceito");
+
+  bad = saved;
+  bad.size = sizeof(PidGains) + 4;
+  bad.crc = BrewSnapshotStore::crc32((const uint8_t *)&bad, offsetof(PidGains, crc));
+  writeFile(PID_GAINS_FILE, &bad, sizeof(bad));
+  TEST_ASSERT_FALSE_MESSAGE(reader.load(loaded), "campo size errado aceito");
+
+  bad = saved;
+  bad.ki = -0.5f; // Íntegro, mas inutilizável
+  bad.crc = BrewSnapshotStore::crc32((const uint8_t *)&bad, offsetof(PidGains, crc));
+  writeFile(PID_GAINS_FILE, &bad, sizeof(bad));
+  TEST_ASSERT_FALSE_MESSAGE(reader.load(loaded), "ganho negativo aceito");
+
+  writeFile(PID_GAINS_FILE, &saved, sizeof(saved) - 1);
+  TEST_ASSERT_FALSE_MESSAGE(reader.load(loaded), "arquivo truncado aceito");
+
+  // Gravação interrompida antes do rename: os ganhos anteriores continuam valendo
+  writeFile(PID_GAINS_FILE, &saved, sizeof(saved));
+  PidGains retuned = saved;
+  retuned.kp = 55.0f;
+  retuned.crc = BrewSnapshotStore::crc32((const uint8_t *)&retuned, offsetof(PidGains, crc));
+  writeFile(PID_GAINS_TMP_FILE, &retuned, sizeof(retuned));
+  TEST_ASSERT_TRUE(reader.load(loaded));
+  TEST_ASSERT_EQUAL_FLOAT(41.5f, loaded.kp);
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_snapshot_round_trip_keeps_the_step_progress);
+  RUN_TEST(test_corrupted_snapshot_is_rejected);
+  RUN_TEST(test_stale_tmp_does_not_replace_the_snapshot);
+  RUN_TEST(test_pid_gains_round_trip_and_rejection);
+  return UNITY_END();
+}
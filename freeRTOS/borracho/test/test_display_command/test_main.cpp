@@ -0,0 +1,278 @@
+/**
+ * @file test_main.cpp
+ * @brief Receita completa no host sem nenhuma alocação de heap na montagem e no desenho das telas.
+ * @details A Statechart roda a primeira receita com o MockCallback do StatechartHarness.h, mas as
+ * operações de tela e de etapa passam para um StatechartCallback de verdade: os DisplayCommand são
+ * montados pelo mesmo código do firmware (showRecipes, showRecipe, startNextRecipeStep,
+ * showProcessStatus...) e atravessam xDisplayQueue e xControlQueue. A cada segundo do relógio
+ * virtual o teste faz o que a statusTask faz com um ControlRecord (showProcessStatusFor() e
+ * showTemperatureSample()) e esvazia a fila de display como a displayTask, desenhando cada comando
+ * num HeadlessDisplay (drawDisplayCommand() e TemperatureGraph). operator new e, com a glibc, malloc,
+ * calloc e realloc são contados do primeiro evento até a volta ao IDLE: qualquer alocação falha o
+ * teste. A fila do host aloca o armazenamento só na criação, como a do FreeRTOS.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Includes do projeto
+#include "DisplayRender.h"
+#include "HeadlessDisplay.h"
+#include "StatechartHarness.h"
+#include "TemperatureGraph.h"
+
+// --- PARÂMETROS DO TESTE ---
+#define DISPLAY_TEST_QUEUE_LENGTH 16 // Comandos pendentes na fila de display (esvaziada a cada segundo)
+#define DISPLAY_TEST_RAMP_SECONDS 20 // Segundos de rampa antes do setpoint em cada etapa
+
+// --- CONTAGEM DE ALOCAÇÕES ---
+static volatile bool countAllocations = false;
+static volatile unsigned long heapAllocations = 0;
+
+void *operator new(size_t size)
+{
+  if (countAllocations)
+    heapAllocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+#ifdef __GLIBC__
+// malloc direto (String, snprintf do host...) também conta; repassado ao alocador da glibc
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *p, size_t size);
+
+extern "C" void *malloc(size_t size)
+{
+  if (countAllocations)
+    heapAllocations++;
+  return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+  if (countAllocations)
+    heapAllocations++;
+  return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *p, size_t size)
+{
+  if (countAllocations)
+    heapAllocations++;
+  return __libc_realloc(p, size);
+}
+#endif
+
+// Globais que o StatechartCallback usa (definidos no main.cpp do firmware)
+QueueHandle_t xDisplayQueue = NULL;
+QueueHandle_t xControlQueue = NULL;
+QueueHandle_t xSensorQueue = NULL;
+StatechartIngress statechartIngress;
+
+using namespace statechart_events;
+
+/**
+ * @brief MockCallback cujas telas e etapas são as do StatechartCallback do firmware.
+ */
+class DisplayingCallback : public MockCallback
+{
+public:
+  void showStartup() override { view.showStartup(); }
+  void showIdleScreen() override { view.showIdleScreen(); }
+  void showState(sc_string state) override { view.showState(state); }
+  void showRecipes() override { view.showRecipes(); }
+  void showRecipe(sc_integer recipeId) override { view.showRecipe(recipeId); }
+  void startNextRecipeStep(sc_integer recipeIndex) override { view.startNextRecipeStep(recipeIndex); }
+  sc_boolean hasMoreSteps() override { return view.hasMoreSteps(); }
+  sc_integer getCurrentRecipeIndex() override { return view.getCurrentRecipeIndex(); }
+  sc_integer getCurrentStepIndex() override { return view.getCurrentStepIndex(); }
+  void showProcessStatus(sc_integer currentTemp, sc_integer targetTemp, sc_integer remainingMinutes, sc_integer remainingSeconds,
+                         sc_string stepName, sc_integer stepNum, sc_integer totalSteps, sc_boolean isRamping) override
+  {
+    view.showProcessStatus(currentTemp, targetTemp, remainingMinutes, remainingSeconds, stepName, stepNum, totalSteps, isRamping);
+  }
+  void showFinished() override
+  {
+    MockCallback::showFinished(); // finished_process fica pendente, como na fila de entrada
+    view.currentRecipeIdx = -1;
+    view.currentStepIdx = -1;
+  }
+  void showFinishedMessage() override { view.showFinishedMessage(); }
+
+  StatechartCallback view;
+};
+
+static Statechart *statechart;
+static DisplayingCallback *callback;
+static VirtualTimerService *timerService;
+static HeadlessDisplay *display;
+static TemperatureGraph *graph;
+static unsigned long displayCommands = 0;
+
+void setUp(void)
+{
+  xDisplayQueue = xQueueCreate(DISPLAY_TEST_QUEUE_LENGTH, sizeof(DisplayCommand));
+  xControlQueue = xQueueCreate(DISPLAY_TEST_QUEUE_LENGTH, sizeof(ControlCommand));
+  statechart = new Statechart();
+  callback = new DisplayingCallback();
+  timerService = new VirtualTimerService();
+  display = new HeadlessDisplay();
+  graph = new TemperatureGraph();
+  callback->view.setStatechart(statechart);
+  statechart->setOperationCallback(callback);
+  statechart->setTimerService(timerService);
+  displayCommands = 0;
+  Serial.println("Teste: inicio"); // Buffer da saída padrão alocado fora da contagem
+}
+
+void tearDown(void)
+{
+  countAllocations = false;
+  delete statechart;
+  delete callback;
+  delete timerService;
+  delete display;
+  delete graph;
+  vQueueDelete(xDisplayQueue);
+  vQueueDelete(xControlQueue);
+}
+
+// Esvazia a fila de display como a displayTask: cada comando desenhado no framebuffer
+static void drainDisplayQueue()
+{
+  DisplayCommand cmd;
+  while (xQueueReceive(xDisplayQueue, &cmd, 0) == pdPASS)
+  {
+    displayCommands++;
+    if (cmd.type == CMD_PLOT_TEMPERATURE_SAMPLE)
+    {
+      graph->plot(cmd.sample, display->getBuffer());
+    }
+    else
+    {
+      drawDisplayCommand(*display, cmd);
+      if (cmd.type == CMD_SHOW_PROCESS_STATUS_SCREEN)
+        graph->show(display->getBuffer());
+    }
+  }
+}
+
+// Entrega o próximo evento de tempo armado, desenhando o que as ações de entrada publicaram
+static bool raiseArmedTimeEvent()
+{
+  for (int i = 0; i < 100000; ++i)
+  {
+    if (timerService->tick() > 0)
+    {
+      drainDisplayQueue();
+      return true;
+    }
+  }
+  return false;
+}
+
+static void raise(StatechartEventName event)
+{
+  statechart->raiseEvent(event);
+  drainDisplayQueue();
+}
+
+/**
+ * @brief Uma etapa recebida pela controlTask, com um ControlRecord por segundo para a "statusTask".
+ * @return Telas de status montadas.
+ */
+static unsigned long runStep(const ControlCommand &step)
+{
+  const Recipe &recipe = recipes[step.recipeIndex];
+  unsigned long statusScreens = 0;
+  float temperature = (float)step.targetTemperature - DISPLAY_TEST_RAMP_SECONDS * 0.5f;
+  for (int second = 0; second < DISPLAY_TEST_RAMP_SECONDS + step.durationMinutes * 60; ++second)
+  {
+    bool ramping = second < DISPLAY_TEST_RAMP_SECONDS;
+    int remaining = ramping ? step.durationMinutes * 60 : step.durationMinutes * 60 - (second - DISPLAY_TEST_RAMP_SECONDS);
+    if (ramping)
+      temperature += 0.5f;
+    callback->view.showProcessStatusFor(step.recipeIndex, (int)temperature, step.targetTemperature, remaining / 60,
+                                        remaining % 60, recipe.steps[step.stepIndex].name, step.stepIndex + 1,
+                                        recipe.numSteps, ramping);
+    callback->view.showTemperatureSample(temperature, step.targetTemperature);
+    statusScreens++;
+    drainDisplayQueue();
+    hostAdvanceMicros(1000000);
+  }
+  return statusScreens;
+}
+
+void test_full_recipe_without_heap_allocations(void)
+{
+  statechart->enter();
+  drainDisplayQueue();
+
+  heapAllocations = 0;
+  countAllocations = true;
+  raise(start_button);                 // IDLE -> INIT_SYSTEM
+  TEST_ASSERT_TRUE(raiseArmedTimeEvent()); // -> MENU
+  raise(recipe_1);                     // -> RECIPE_1 (detalhes da receita)
+  callback->view.currentRecipeIdx = 0; // KEY_ACTION_START_RECIPE da tecla da receita 1
+  const StatechartEventName start[] = {recipe_1_process, start_first_step};
+  statechart->raiseEvents(start, 2); // -> CONTROL_PROCESS_LOOP, primeira etapa enviada à controlTask
+  drainDisplayQueue();
+
+  unsigned long steps = 0, statusScreens = 0;
+  ControlCommand controlCmd;
+  while (xQueueReceive(xControlQueue, &controlCmd, 0) == pdPASS)
+  {
+    TEST_ASSERT_EQUAL(CMD_START_RECIPE_STEP, controlCmd.type);
+    TEST_ASSERT_EQUAL(0, controlCmd.recipeIndex);
+    TEST_ASSERT_EQUAL((int)steps, controlCmd.stepIndex);
+    statusScreens += runStep(controlCmd);
+    steps++;
+    raise(step_finished); // Próxima etapa (nova mensagem na xControlQueue) ou FINISH_PROCESS
+  }
+  TEST_ASSERT_TRUE(callback->finishedPending);
+  callback->finishedPending = false;
+  raise(finished_process);                 // -> FINISHED_MESSAGE
+  TEST_ASSERT_TRUE(raiseArmedTimeEvent()); // -> IDLE
+  countAllocations = false;
+
+  char report[200];
+  snprintf(report, sizeof(report), "%lu etapas, %lu telas de status, %lu comandos de display: %lu alocacoes",
+           steps, statusScreens, displayCommands, heapAllocations);
+  TEST_MESSAGE(report);
+
+  TEST_ASSERT_EQUAL(Statechart::main_region_IDLE, statechart->getActiveLeafState());
+  TEST_ASSERT_EQUAL((unsigned long)recipes[0].numSteps, steps);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2 * statusScreens, displayCommands);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, heapAllocations, "alocacao de heap ao montar ou desenhar as telas");
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_full_recipe_without_heap_allocations);
+  return UNITY_END();
+}
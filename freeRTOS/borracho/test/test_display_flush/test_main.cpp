@@ -0,0 +1,233 @@
+/**
+ * @file test_main.cpp
+ * @brief Envio de quadros no host: FrameMailbox + DirtyPageFlusher sobre um SSD1306 simulado.
+ * @details O transporte do I2CBus é um SSD1306 de mentira: interpreta a janela (PAGEADDR /
+ * COLUMNADDR) e os blocos de dados (controle 0x40) numa GDDRAM de DISPLAY_FRAME_SIZE bytes e gasta
+ * no relógio virtual o tempo de cada transação no clock aplicado. Uma thread faz o papel da
+ * displayTask (desenha e publica quadros) e outra o da displayFlushTask (retira e envia), como
+ * no firmware. O benchmark mede a vazão da caixa no host (quadros publicados por segundo) e a do
+ * barramento a 400 kHz (quadros por segundo no relógio virtual) e confere que a GDDRAM termina
+ * igual ao último quadro publicado. Ajustes por -D: DISPLAY_BENCH_FRAMES,
+ * DISPLAY_MIN_POSTS_PER_SEC e DISPLAY_MIN_BUS_FRAMES_PER_SEC.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// No firmware SCREEN_WIDTH/HEIGHT vêm do StatechartCallback.h, incluído antes
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+
+// Includes do projeto
+#include "DisplayFlush.h"
+#include "I2CBus.h"
+
+// --- PARÂMETROS DO TESTE ---
+#ifndef DISPLAY_BENCH_FRAMES
+#define DISPLAY_BENCH_FRAMES 20000UL // Quadros publicados pela thread produtora
+#endif
+#ifndef DISPLAY_MIN_POSTS_PER_SEC
+#define DISPLAY_MIN_POSTS_PER_SEC 20000UL // Piso da vazão da caixa no host
+#endif
+#ifndef DISPLAY_MIN_BUS_FRAMES_PER_SEC
+#define DISPLAY_MIN_BUS_FRAMES_PER_SEC 30UL // Piso de quadros de uma linha por segundo a 400 kHz
+#endif
+
+#define DISPLAY_ADDRESS 0x3C
+
+/**
+ * @brief SSD1306 simulado no barramento: janela de endereçamento horizontal e GDDRAM.
+ */
+class Ssd1306Transport : public I2CTransport
+{
+public:
+  void setClock(uint32_t hz) override
+  {
+    clock = hz;
+  }
+
+  uint8_t write(uint8_t address, const uint8_t *data, size_t length) override
+  {
+    hostAdvanceMicros((uint32_t)(((length + 1) * 9 + 2) * 1000000ULL / clock));
+    if (address != DISPLAY_ADDRESS || length == 0)
+      return 2; // NACK
+    transactions++;
+    bytes += length;
+    if (data[0] == 0x40)
+    {
+      for (size_t i = 1; i < length; ++i)
+        writeData(data[i]);
+      return 0;
+    }
+    for (size_t i = 1; i + 2 < length; i += 3)
+    {
+      if (data[i] == SSD1306_PAGEADDR)
+      {
+        pageStart = page = data[i + 1];
+        pageEnd = data[i + 2];
+      }
+      else if (data[i] == SSD1306_COLUMNADDR)
+      {
+        columnStart = column = data[i + 1];
+        columnEnd = data[i + 2];
+      }
+    }
+    return 0;
+  }
+
+  size_t read(uint8_t, uint8_t *, size_t) override
+  {
+    return 0;
+  }
+
+  uint8_t gddram[DISPLAY_FRAME_SIZE] = {};
+  uint32_t transactions = 0;
+  uint64_t bytes = 0;
+
+private:
+  // Endereçamento horizontal: coluna avança e, no fim da janela, passa à página seguinte
+  void writeData(uint8_t value)
+  {
+    gddram[page * SCREEN_WIDTH + column] = value;
+    if (column++ == columnEnd)
+    {
+      column = columnStart;
+      page = page == pageEnd ? pageStart : page + 1;
+    }
+  }
+
+  uint32_t clock = 100000;
+  uint8_t page = 0, pageStart = 0, pageEnd = SCREEN_HEIGHT / 8 - 1;
+  uint8_t column = 0, columnStart = 0, columnEnd = SCREEN_WIDTH - 1;
+};
+
+static Ssd1306Transport *transport;
+static I2CBus *bus;
+static DirtyPageFlusher *flusher;
+static FrameMailbox *mailbox;
+
+void setUp(void)
+{
+  hostResetClock();
+  transport = new Ssd1306Transport();
+  bus = new I2CBus(*transport);
+  TEST_ASSERT_TRUE(bus->begin());
+  flusher = new DirtyPageFlusher(*bus, DISPLAY_ADDRESS);
+  mailbox = new FrameMailbox();
+  TEST_ASSERT_TRUE(mailbox->begin());
+}
+
+void tearDown(void)
+{
+  delete mailbox;
+  delete flusher;
+  delete bus;
+  delete transport;
+}
+
+// Quadro n: tela fixa com uma "linha de texto" (páginas 2 e 3, 60 colunas) que muda a cada quadro
+static void drawFrame(uint8_t *frame, uint32_t n)
+{
+  for (size_t i = 0; i < DISPLAY_FRAME_SIZE; ++i)
+    frame[i] = (uint8_t)(i * 13);
+  for (uint8_t page = 2; page < 4; ++page)
+    for (uint8_t x = 10; x < 70; ++x)
+      frame[page * SCREEN_WIDTH + x] = (uint8_t)(n * 31 + x * page);
+}
+
+void test_dirty_pages_reach_the_display(void)
+{
+  uint8_t frame[DISPLAY_FRAME_SIZE];
+  drawFrame(frame, 0);
+  uint32_t full = flusher->flush(frame);
+  TEST_ASSERT_EQUAL_MEMORY(frame, transport->gddram, DISPLAY_FRAME_SIZE);
+
+  frame[5 * SCREEN_WIDTH + 100] ^= 0x5A; // Uma coluna de uma página
+  uint32_t one = flusher->flush(frame);
+  TEST_ASSERT_EQUAL_MEMORY(frame, transport->gddram, DISPLAY_FRAME_SIZE);
+  TEST_ASSERT_EQUAL_UINT32(7 + 1 + 1, one); // Janela + controle + 1 byte
+  TEST_ASSERT_EQUAL_UINT32(0, flusher->flush(frame));
+  TEST_ASSERT_TRUE(full > 100 * one);
+}
+
+void test_mailbox_and_flush_throughput(void)
+{
+  SemaphoreHandle_t wake = xSemaphoreCreateBinary(); // Faz o papel do xTaskNotifyGive
+  std::atomic<bool> done{false};
+  uint32_t taken = 0;
+  uint8_t lastType = 0xFF;
+  uint32_t busMicros = 0;
+
+  // displayFlushTask: acorda a cada publicação e envia o quadro mais recente
+  std::thread flushTask([&] {
+    FrameInfo info;
+    const uint8_t *frame;
+    for (;;)
+    {
+      xSemaphoreTake(wake, portMAX_DELAY);
+      bool last = done.load();
+      while ((frame = mailbox->take(info)) != nullptr)
+      {
+        uint32_t start = micros();
+        flusher->flush(frame);
+        busMicros += micros() - start;
+        taken++;
+        lastType = info.lastCommandType;
+      }
+      if (last)
+        break;
+    }
+  });
+
+  // displayTask: desenha e publica sem esperar o envio
+  static uint8_t frame[DISPLAY_FRAME_SIZE];
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t n = 0; n < DISPLAY_BENCH_FRAMES; ++n)
+  {
+    drawFrame(frame, n);
+    FrameInfo info = {};
+    info.lastCommandType = (uint8_t)(n % 200);
+    mailbox->post(frame, info);
+    xSemaphoreGive(wake);
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  done = true;
+  xSemaphoreGive(wake);
+  flushTask.join();
+  vSemaphoreDelete(wake);
+
+  double postsPerSec = DISPLAY_BENCH_FRAMES / seconds;
+  double busFramesPerSec = busMicros ? taken * 1e6 / busMicros : 0;
+  char message[200];
+  snprintf(message, sizeof(message),
+           "%lu quadros publicados: %.0f quadros/s na caixa, %lu enviados (%lu substituidos), %.0f quadros/s a 400 kHz",
+           (unsigned long)DISPLAY_BENCH_FRAMES, postsPerSec, (unsigned long)taken,
+           (unsigned long)mailbox->replacedFrames(), busFramesPerSec);
+  TEST_MESSAGE(message);
+  HostPrint stats;
+  flusher->printStats(stats);
+  bus->printStats(stats);
+  TEST_MESSAGE(stats.text.c_str());
+
+  TEST_ASSERT_EQUAL_UINT32(DISPLAY_BENCH_FRAMES, taken + mailbox->replacedFrames());
+  TEST_ASSERT_EQUAL_UINT8((DISPLAY_BENCH_FRAMES - 1) % 200, lastType);
+  TEST_ASSERT_EQUAL_MEMORY(frame, transport->gddram, DISPLAY_FRAME_SIZE);
+  TEST_ASSERT_TRUE_MESSAGE(postsPerSec >= DISPLAY_MIN_POSTS_PER_SEC, "vazao da caixa abaixo do piso");
+  TEST_ASSERT_TRUE_MESSAGE(busFramesPerSec >= DISPLAY_MIN_BUS_FRAMES_PER_SEC, "vazao do barramento abaixo do piso");
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_dirty_pages_reach_the_display);
+  RUN_TEST(test_mailbox_and_flush_throughput);
+  return UNITY_END();
+}
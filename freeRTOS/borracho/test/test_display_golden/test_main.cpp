@@ -0,0 +1,232 @@
+/**
+ * @file test_main.cpp
+ * @brief Telas de referência: cada DisplayCommandType desenhado no HeadlessDisplay e comparado com um PBM.
+ * @details Para cada tipo de comando há uma imagem em golden/ (PBM binário 128x64, o mesmo formato
+ * de HeadlessDisplay::writePbm). O desenho segue a displayTask: texto tamanho 1 e branco,
+ * drawDisplayCommand() para os comandos e TemperatureGraph para as amostras do gráfico. Comandos
+ * que desenham por cima da tela atual (clearScreen = false) partem do menu principal, para a
+ * imagem mostrar o que apagam. Cada tela é desenhada duas vezes, pela Adafruit_GFX pura e pelo
+ * PageGlyphText, e as duas precisam bater com a referência.
+ * Numa diferença o teste grava <nome>.actual.pbm ao lado da referência e informa quantos pixels
+ * mudaram. Uma mudança intencional de tela é aceita recompilando com `-D GOLDEN_UPDATE`, que
+ * regrava as referências (conferir as imagens antes de versionar):
+ * `PLATFORMIO_BUILD_FLAGS=-DGOLDEN_UPDATE pio test -e native -f test_display_golden`.
+ * As referências só valem geradas pela Adafruit_GFX do lib_deps (fonte glcdfont da biblioteca);
+ * enquanto uma delas não estiver versionada, a tela correspondente é ignorada com esse aviso em
+ * vez de falhar.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Includes do projeto
+#include "DisplayRender.h"
+#include "GlyphText.h"
+#include "HeadlessDisplay.h"
+#include "TemperatureGraph.h"
+
+// Filas declaradas (extern) no StatechartCallback.h; o desenho não as usa
+QueueHandle_t xDisplayQueue = NULL;
+QueueHandle_t xControlQueue = NULL;
+QueueHandle_t xSensorQueue = NULL;
+
+// --- PARÂMETROS DO TESTE ---
+#define GOLDEN_PLOT_SAMPLES 160 // Amostras do gráfico (mais que as 128 colunas: desloca e refaz a escala)
+
+/**
+ * @brief Uma tela de referência: o comando e a imagem esperada.
+ */
+struct GoldenScreen
+{
+  const char *file;      // Nome do PBM em golden/
+  DisplayCommand cmd;    // Comando desenhado
+  bool overMainMenu;     // Desenhado por cima do menu principal
+};
+
+static GoldenScreen screens[DISPLAY_COMMAND_TYPES];
+
+// Pasta golden/ ao lado deste arquivo
+static std::string goldenPath(const char *file)
+{
+  std::string dir = __FILE__;
+  size_t slash = dir.find_last_of("/\\");
+  dir = slash == std::string::npos ? std::string() : dir.substr(0, slash + 1);
+  return dir + "golden/" + file;
+}
+
+static DisplayCommand command(DisplayCommandType type, bool clearScreen, const char *text = "", int recipeId = 0)
+{
+  DisplayCommand cmd = {type};
+  cmd.clearScreen = clearScreen;
+  cmd.recipeId = recipeId;
+  cmd.setText(text);
+  return cmd;
+}
+
+void setUp(void)
+{
+  // Textos como os montados pelo StatechartCallback
+  screens[CMD_CLEAR_DISPLAY] = {"00_clear_display.pbm", command(CMD_CLEAR_DISPLAY, false), true};
+  screens[CMD_SHOW_STATE_INFO] = {"01_show_state_info.pbm", command(CMD_SHOW_STATE_INFO, false, "IDLE"), true};
+  screens[CMD_SHOW_MAIN_MENU_SCREEN] = {"02_show_main_menu_screen.pbm", command(CMD_SHOW_MAIN_MENU_SCREEN, true), false};
+  screens[CMD_SHOW_STARTUP_MESSAGE] = {"03_show_startup_message.pbm", command(CMD_SHOW_STARTUP_MESSAGE, true), false};
+  screens[CMD_SHOW_RECIPES_LIST] = {"04_show_recipes_list.pbm", command(CMD_SHOW_RECIPES_LIST, true), false};
+  screens[CMD_SHOW_RECIPE_DETAILS_SCREEN] = {"05_show_recipe_details_screen.pbm",
+                                             command(CMD_SHOW_RECIPE_DETAILS_SCREEN, true, "", 3), false}; // 5 etapas: "...mais etapas"
+  screens[CMD_PRINT_KEYPAD_INPUT] = {"06_print_keypad_input.pbm", command(CMD_PRINT_KEYPAD_INPUT, false, "Tecla: 1"), true};
+  screens[CMD_SHOW_PROCESS_STATUS_SCREEN] = {"07_show_process_status_screen.pbm",
+                                             command(CMD_SHOW_PROCESS_STATUS_SCREEN, false,
+                                                     "Receita: Witbier\nEtapa 2/3: Curva 2\nTemp: 68C / 68C\nTempo: 41 m 07 s"),
+                                             false};
+  screens[CMD_SHOW_FINISHED_MESSAGE_SCREEN] = {"08_show_finished_message_screen.pbm",
+                                               command(CMD_SHOW_FINISHED_MESSAGE_SCREEN, true), false};
+  screens[CMD_PLOT_TEMPERATURE_SAMPLE] = {"09_plot_temperature_sample.pbm", command(CMD_PLOT_TEMPERATURE_SAMPLE, false), false};
+}
+
+void tearDown(void)
+{
+}
+
+// Desenha uma tela como a displayTask: fundo, comando e, na tela de processo, o gráfico
+template <class Display>
+static void render(Display &display, const GoldenScreen &screen)
+{
+  display.setTextSize(1);
+  display.setTextColor(SSD1306_WHITE);
+  display.clearDisplay();
+  if (screen.overMainMenu)
+  {
+    drawDisplayCommand(display, command(CMD_SHOW_MAIN_MENU_SCREEN, true));
+  }
+  if (screen.cmd.type != CMD_PLOT_TEMPERATURE_SAMPLE)
+  {
+    drawDisplayCommand(display, screen.cmd);
+    return;
+  }
+
+  // Tela de processo seguida das amostras de uma rampa de 50 para 68 °C com sobressinal
+  TemperatureGraph graph;
+  drawDisplayCommand(display, screens[CMD_SHOW_PROCESS_STATUS_SCREEN].cmd);
+  graph.show(display.getBuffer());
+  for (int i = 0; i < GOLDEN_PLOT_SAMPLES; ++i)
+  {
+    DisplayCommand sample = screen.cmd;
+    int16_t tenths = i < 60 ? 500 + i * 3 : 680 + (int16_t)(25 * sin(i / 9.0) * exp(-(i - 60) / 40.0));
+    sample.sample = {tenths, 680};
+    graph.plot(sample.sample, display.getBuffer());
+  }
+}
+
+#ifndef GOLDEN_UPDATE
+static std::string readFile(const std::string &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+#endif
+
+static void writeFile(const std::string &path, const std::string &content)
+{
+  std::ofstream out(path, std::ios::binary);
+  out << content;
+}
+
+#ifndef GOLDEN_UPDATE
+// Converte um PBM 128x64 de volta para o formato do framebuffer (para contar os pixels diferentes)
+static bool decodePbm(const std::string &pbm, uint8_t *frame)
+{
+  const std::string header = "P4\n128 64\n";
+  if (pbm.size() != header.size() + HEADLESS_FRAME_SIZE || pbm.compare(0, header.size(), header) != 0)
+    return false;
+  memset(frame, 0, HEADLESS_FRAME_SIZE);
+  for (uint8_t y = 0; y < HEADLESS_HEIGHT; ++y)
+    for (uint8_t x = 0; x < HEADLESS_WIDTH; ++x)
+      if ((uint8_t)pbm[header.size() + y * (HEADLESS_WIDTH / 8) + x / 8] & (0x80 >> (x & 7)))
+        frame[(y / 8) * HEADLESS_WIDTH + x] |= 1 << (y & 7);
+  return true;
+}
+#endif
+
+// Compara o framebuffer com a referência (ou a regrava com GOLDEN_UPDATE)
+static void checkGolden(HeadlessDisplay &display, const GoldenScreen &screen, const char *path)
+{
+  HostPrint image;
+  display.writePbm(image);
+  std::string file = goldenPath(screen.file);
+#ifdef GOLDEN_UPDATE
+  std::filesystem::create_directories(std::filesystem::path(file).parent_path());
+  writeFile(file, image.text);
+  (void)path;
+#else
+  std::string golden = readFile(file);
+  if (golden.empty())
+  {
+    char message[200];
+    snprintf(message, sizeof(message), "%s sem referencia: gerar com -D GOLDEN_UPDATE pela Adafruit_GFX real e conferir a imagem",
+             screen.file);
+    TEST_IGNORE_MESSAGE(message);
+  }
+  if (golden == image.text)
+    return;
+  writeFile(file.substr(0, file.size() - 4) + ".actual.pbm", image.text);
+  uint8_t expected[HEADLESS_FRAME_SIZE];
+  char message[200];
+  if (decodePbm(golden, expected))
+    snprintf(message, sizeof(message), "%s (%s): %lu pixels diferentes da referencia", screen.file, path,
+             (unsigned long)display.diffPixels(expected));
+  else
+    snprintf(message, sizeof(message), "%s (%s): referencia invalida em %s", screen.file, path, file.c_str());
+  TEST_FAIL_MESSAGE(message);
+#endif
+}
+
+static void checkScreen(DisplayCommandType type)
+{
+  const GoldenScreen &screen = screens[type];
+  HeadlessDisplay gfx;
+  render(gfx, screen);
+  checkGolden(gfx, screen, "Adafruit_GFX");
+
+  PageGlyphText<HeadlessDisplay> glyphs;
+  render(glyphs, screen);
+  checkGolden(glyphs, screen, "PageGlyphText");
+}
+
+void test_clear_display(void) { checkScreen(CMD_CLEAR_DISPLAY); }
+void test_show_state_info(void) { checkScreen(CMD_SHOW_STATE_INFO); }
+void test_show_main_menu_screen(void) { checkScreen(CMD_SHOW_MAIN_MENU_SCREEN); }
+void test_show_startup_message(void) { checkScreen(CMD_SHOW_STARTUP_MESSAGE); }
+void test_show_recipes_list(void) { checkScreen(CMD_SHOW_RECIPES_LIST); }
+void test_show_recipe_details_screen(void) { checkScreen(CMD_SHOW_RECIPE_DETAILS_SCREEN); }
+void test_print_keypad_input(void) { checkScreen(CMD_PRINT_KEYPAD_INPUT); }
+void test_show_process_status_screen(void) { checkScreen(CMD_SHOW_PROCESS_STATUS_SCREEN); }
+void test_show_finished_message_screen(void) { checkScreen(CMD_SHOW_FINISHED_MESSAGE_SCREEN); }
+void test_plot_temperature_sample(void) { checkScreen(CMD_PLOT_TEMPERATURE_SAMPLE); }
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_clear_display);
+  RUN_TEST(test_show_state_info);
+  RUN_TEST(test_show_main_menu_screen);
+  RUN_TEST(test_show_startup_message);
+  RUN_TEST(test_show_recipes_list);
+  RUN_TEST(test_show_recipe_details_screen);
+  RUN_TEST(test_print_keypad_input);
+  RUN_TEST(test_show_process_status_screen);
+  RUN_TEST(test_show_finished_message_screen);
+  RUN_TEST(test_plot_temperature_sample);
+  return UNITY_END();
+}
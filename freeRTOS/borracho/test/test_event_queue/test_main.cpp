@@ -0,0 +1,179 @@
+/**
+ * @file test_main.cpp
+ * @brief Fila de eventos da statechart no host: ordem, estouro, vazão e alocações por evento.
+ * @details A fila de entrada da Statechart é um anel de SC_IN_EVENT_QUEUE_SIZE eventos de 8 bytes
+ * (SctEvent), sem heap. O benchmark percorre uma receita inteira em laço (teclas, lote
+ * processo + primeira etapa, fins de etapa e os dois eventos de tempo) e mede eventos/s com
+ * raiseEvent(), raiseEvents() e raiseTimeEvent(); qualquer alocação (operator new contado)
+ * falha o teste. Ajustes por -D: EVENT_QUEUE_BENCH_LAPS e EVENT_QUEUE_MIN_EVENTS_PER_SEC.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Includes do projeto
+#include "StatechartHarness.h"
+
+// --- PARÂMETROS DO TESTE ---
+#ifndef EVENT_QUEUE_BENCH_LAPS
+#define EVENT_QUEUE_BENCH_LAPS 200000UL // Receitas completas (LAP_EVENTS eventos cada)
+#endif
+#ifndef EVENT_QUEUE_MIN_EVENTS_PER_SEC
+#define EVENT_QUEUE_MIN_EVENTS_PER_SEC 500000UL // Piso da vazão (o host faz milhões)
+#endif
+
+// --- CONTAGEM DE ALOCAÇÕES ---
+static volatile unsigned long heapAllocations = 0;
+
+void *operator new(size_t size)
+{
+  heapAllocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+using namespace statechart_events;
+
+static Statechart *statechart;
+static MockCallback *callback;
+static VirtualTimerService *timerService;
+
+void setUp(void)
+{
+  statechart = new Statechart();
+  callback = new MockCallback();
+  timerService = new VirtualTimerService();
+  statechart->setOperationCallback(callback);
+  statechart->setTimerService(timerService);
+  statechart->enter();
+}
+
+void tearDown(void)
+{
+  delete statechart;
+  delete callback;
+  delete timerService;
+}
+
+// Entrega o próximo evento de tempo armado sem esperar pelos ticks
+static bool raiseArmedTimeEvent()
+{
+  for (sc_integer i = 0; i < 100000; ++i)
+  {
+    if (timerService->tick() > 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void test_batched_events_are_processed_in_fifo_order(void)
+{
+  statechart->raiseEvent(start_button);
+  TEST_ASSERT_TRUE(raiseArmedTimeEvent());
+  TEST_ASSERT_EQUAL(Statechart::main_region_MENU, statechart->getActiveLeafState());
+
+  // Um só run cycle: MENU -> RECIPE_2 -> MENU -> RECIPE_3
+  const StatechartEventName events[] = {recipe_2, recipe_back_menu, recipe_3};
+  sc_integer cyclesBefore = statechart->getRunCycleCount();
+  statechart->raiseEvents(events, 3);
+  TEST_ASSERT_EQUAL(1, statechart->getRunCycleCount() - cyclesBefore);
+  TEST_ASSERT_EQUAL(Statechart::main_region_RECIPE_3, statechart->getActiveLeafState());
+  TEST_ASSERT_EQUAL(3, statechart->getInEventQueueHighWater());
+}
+
+void test_overflow_is_counted_and_keeps_the_oldest_events(void)
+{
+  statechart->raiseEvent(start_button);
+  TEST_ASSERT_TRUE(raiseArmedTimeEvent());
+
+  // recipe_4 entra primeiro; os eventos além da capacidade são descartados e contados
+  StatechartEventName events[Statechart::inEventQueueCapacity + 4];
+  events[0] = recipe_4;
+  for (unsigned i = 1; i < sizeof(events) / sizeof(events[0]); ++i)
+  {
+    events[i] = recipe_back_menu;
+  }
+  events[Statechart::inEventQueueCapacity] = recipe_1; // Primeiro descartado
+  statechart->raiseEvents(events, sizeof(events) / sizeof(events[0]));
+  TEST_ASSERT_EQUAL(4, statechart->getInEventQueueOverflows());
+  TEST_ASSERT_EQUAL(Statechart::inEventQueueCapacity, statechart->getInEventQueueHighWater());
+  TEST_ASSERT_EQUAL(Statechart::main_region_MENU, statechart->getActiveLeafState());
+  TEST_ASSERT_TRUE(statechart->isStateConfigurationValid());
+
+  // A fila foi esvaziada: o próximo evento é processado normalmente
+  statechart->raiseEvent(recipe_1);
+  TEST_ASSERT_EQUAL(Statechart::main_region_RECIPE_1, statechart->getActiveLeafState());
+}
+
+void test_event_throughput_without_heap_allocations(void)
+{
+  const unsigned long LAP_EVENTS = 8 + callback->stepsPerRecipe; // 8 fixos + um step_finished por etapa
+  unsigned long timeEvents = 0;
+  unsigned long allocationsBefore = heapAllocations;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned long lap = 0; lap < EVENT_QUEUE_BENCH_LAPS; ++lap)
+  {
+    statechart->raiseEvent(start_button); // IDLE -> INIT_SYSTEM
+    timeEvents += raiseArmedTimeEvent();  // -> MENU
+    statechart->raiseEvent(recipe_1);
+    const StatechartEventName start[] = {recipe_1_process, start_first_step};
+    statechart->raiseEvents(start, 2); // -> CONTROL_PROCESS_LOOP
+    for (int i = 0; i < callback->stepsPerRecipe; ++i)
+    {
+      statechart->raiseEvent(step_finished);
+    }
+    callback->finishedPending = false;
+    statechart->raiseEvent(finished_process); // -> FINISHED_MESSAGE
+    timeEvents += raiseArmedTimeEvent();      // -> IDLE
+    statechart->raiseEvent(heating);          // Sem transição no IDLE: só fila e run cycle
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  unsigned long allocations = heapAllocations - allocationsBefore;
+  unsigned long events = EVENT_QUEUE_BENCH_LAPS * LAP_EVENTS;
+  unsigned long eventsPerSec = (unsigned long)(events / seconds);
+
+  char report[200];
+  snprintf(report, sizeof(report), "%lu eventos (%lu de tempo) em %.3f s: %lu eventos/s, %.3f alocacoes por evento",
+           events, timeEvents, seconds, eventsPerSec, (double)allocations / events);
+  TEST_MESSAGE(report);
+
+  TEST_ASSERT_EQUAL(Statechart::main_region_IDLE, statechart->getActiveLeafState());
+  TEST_ASSERT_EQUAL_UINT32(2 * EVENT_QUEUE_BENCH_LAPS, timeEvents);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, allocations, "alocacao de heap por evento");
+  TEST_ASSERT_EQUAL_UINT32(0, statechart->getInEventQueueOverflows());
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(EVENT_QUEUE_MIN_EVENTS_PER_SEC, eventsPerSec, "vazao abaixo do piso");
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_batched_events_are_processed_in_fifo_order);
+  RUN_TEST(test_overflow_is_counted_and_keeps_the_oldest_events);
+  RUN_TEST(test_event_throughput_without_heap_allocations);
+  return UNITY_END();
+}
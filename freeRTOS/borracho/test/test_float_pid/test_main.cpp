@@ -0,0 +1,240 @@
+/**
+ * @file test_main.cpp
+ * @brief FloatPid x PID_v1 no host: as mesmas entradas nos dois controladores, saídas comparadas.
+ * @details O PID_v1 (br3ttb/PID, o controlador que o FloatPid substituiu) roda em double sobre o
+ * relógio virtual: cada passo avança millis() um SampleTime, então todo Compute() calcula. O
+ * BasicPid<float> recebe a mesma entrada, o mesmo setpoint e as mesmas trocas de modo; a
+ * temperatura vem de uma planta de primeira ordem movida pela saída do PID_v1. Os casos cobrem a
+ * saturação com anti-windup, a derivada sobre a medição (sem "chute" na troca de setpoint), a
+ * transferência MANUAL -> AUTOMATIC e a troca de ganhos em AUTOMATIC, única diferença
+ * intencional: o FloatPid compensa o termo proporcional no integrador e o PID_v1 não.
+ * Tolerância por -D PID_TOLERANCE (contagens de duty).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <math.h>
+
+// Includes do projeto
+#include "FloatPid.h"
+#include <PID_v1.h>
+
+// --- PARÂMETROS DO TESTE ---
+#ifndef PID_TOLERANCE
+#define PID_TOLERANCE 0.05 // Diferença máxima float x double na saída (contagens de duty)
+#endif
+#define PID_SAMPLE_MS 100   // Período da controlTask (CONTROL_PERIOD_MS)
+#define PID_OUTPUT_MAX 1023 // PWM de 10 bits, como no firmware
+#define PID_KP 30.0
+#define PID_KI 5.0
+#define PID_KD 0.5
+
+/**
+ * @brief Os dois controladores ligados às suas variáveis, com a mesma configuração.
+ */
+struct PidPair
+{
+  double refInput = 25, refOutput = 0, refSetpoint = 65;
+  float input = 25, output = 0, setpoint = 65;
+  PID reference;
+  FloatPid pid;
+
+  PidPair()
+      : reference(&refInput, &refOutput, &refSetpoint, PID_KP, PID_KI, PID_KD, DIRECT),
+        pid(&input, &output, &setpoint, PID_KP, PID_KI, PID_KD, PID_SAMPLE_MS)
+  {
+    reference.SetSampleTime(PID_SAMPLE_MS);
+    reference.SetOutputLimits(0, PID_OUTPUT_MAX);
+    pid.setOutputLimits(0, PID_OUTPUT_MAX);
+  }
+
+  void setSetpoint(double value)
+  {
+    refSetpoint = value;
+    setpoint = (float)value;
+  }
+
+  void setMode(bool automatic)
+  {
+    reference.SetMode(automatic ? AUTOMATIC : MANUAL);
+    pid.setMode(automatic ? PID_AUTOMATIC : PID_MANUAL);
+  }
+
+  void setOutput(double value)
+  {
+    refOutput = value;
+    output = (float)value;
+  }
+
+  // Um período: a mesma entrada nos dois, um cálculo de cada
+  void step(double temperature)
+  {
+    refInput = temperature;
+    input = (float)temperature;
+    hostAdvanceMicros(PID_SAMPLE_MS * 1000UL);
+    bool computed = reference.Compute();
+    TEST_ASSERT_EQUAL(computed, pid.compute());
+  }
+
+  double difference() const
+  {
+    return fabs((double)output - refOutput);
+  }
+};
+
+// Planta de primeira ordem: aquecimento proporcional ao duty, perda proporcional à diferença para 25 °C
+static double plant(double temperature, double duty)
+{
+  return temperature + duty * 0.0004 - (temperature - 25) * 0.002;
+}
+
+static void assertClose(const PidPair &pair, int stepIndex)
+{
+  if (pair.difference() > PID_TOLERANCE)
+  {
+    char message[120];
+    snprintf(message, sizeof(message), "passo %d: FloatPid=%.4f PID_v1=%.4f", stepIndex, (double)pair.output, pair.refOutput);
+    TEST_FAIL_MESSAGE(message);
+  }
+}
+
+void setUp(void)
+{
+  hostResetClock();
+  hostAdvanceMicros(1000000); // millis() > SampleTime: o PID_v1 calcula já no primeiro passo
+}
+
+void tearDown(void)
+{
+}
+
+void test_saturation_and_anti_windup_match(void)
+{
+  PidPair pair;
+  pair.setMode(true);
+  double temperature = 25;
+  int saturated = 0, firstUnsaturated = -1;
+  for (int i = 0; i < 20000; ++i)
+  {
+    pair.step(temperature);
+    assertClose(pair, i);
+    TEST_ASSERT_TRUE(pair.pid.integral() <= PID_OUTPUT_MAX && pair.pid.integral() >= 0);
+    if (pair.refOutput >= PID_OUTPUT_MAX)
+      saturated++;
+    else if (firstUnsaturated < 0 && saturated > 0)
+      firstUnsaturated = i;
+    temperature = plant(temperature, pair.refOutput);
+  }
+  // A rampa de 25 para 65 °C satura a saída; o integrador limitado a deixa sair da saturação
+  // antes de a temperatura passar do setpoint por muito
+  TEST_ASSERT_TRUE(saturated > 100);
+  TEST_ASSERT_TRUE(firstUnsaturated > 0);
+  TEST_ASSERT_TRUE(fabs(temperature - 65) < 0.5);
+}
+
+void test_setpoint_step_has_no_derivative_kick(void)
+{
+  PidPair pair;
+  pair.setOutput(300);
+  pair.setMode(true);
+  const double held = 60; // Entrada constante: só o setpoint muda
+  for (int i = 0; i < 10; ++i)
+    pair.step(held);
+  double before = pair.output;
+
+  pair.setSetpoint(70);
+  pair.step(held);
+  assertClose(pair, 10);
+  // Com derivada sobre a medição o salto é só Kp * dSetpoint + Ki * dt * erro novo; derivada sobre
+  // o erro somaria Kd / dt * 5 = 25
+  double expected = PID_KP * 5 + PID_KI * PID_SAMPLE_MS / 1000.0 * (70 - held);
+  TEST_ASSERT_TRUE(fabs((pair.output - before) - expected) < PID_TOLERANCE);
+
+  // A derivada só age quando a medição muda: -Kd / dt * dInput
+  double beforeRise = pair.output;
+  pair.step(held + 0.2);
+  assertClose(pair, 11);
+  double rise = PID_KP * -0.2 + PID_KI * PID_SAMPLE_MS / 1000.0 * (70 - held - 0.2) - PID_KD / (PID_SAMPLE_MS / 1000.0) * 0.2;
+  TEST_ASSERT_TRUE(fabs((pair.output - beforeRise) - rise) < PID_TOLERANCE);
+}
+
+void test_manual_to_automatic_transfer_matches(void)
+{
+  PidPair pair;
+  pair.setMode(true);
+  double temperature = 25;
+  for (int i = 0; i < 3000; ++i)
+  {
+    pair.step(temperature);
+    assertClose(pair, i);
+    temperature = plant(temperature, pair.refOutput);
+  }
+
+  // Em MANUAL quem chama define a saída e o cálculo não a altera
+  pair.setMode(false);
+  pair.setOutput(300);
+  for (int i = 0; i < 50; ++i)
+  {
+    pair.step(temperature);
+    TEST_ASSERT_EQUAL_FLOAT(300, pair.output);
+    temperature = plant(temperature, 300);
+  }
+
+  // De volta a AUTOMATIC: o integrador parte da saída atual e a derivada da entrada atual
+  pair.setMode(true);
+  TEST_ASSERT_EQUAL_FLOAT(300, pair.pid.integral());
+  for (int i = 0; i < 3000; ++i)
+  {
+    pair.step(temperature);
+    assertClose(pair, 3050 + i);
+    temperature = plant(temperature, pair.refOutput);
+  }
+}
+
+void test_set_tunings_is_compensated_in_the_integrator(void)
+{
+  PidPair pair;
+  pair.setOutput(300);
+  pair.setMode(true);
+  const double held = 63; // Erro de 2 °C, saída longe dos limites
+  for (int i = 0; i < 20; ++i)
+  {
+    pair.step(held);
+    assertClose(pair, i);
+  }
+  double lastOutput = pair.output;
+  double lastReference = pair.refOutput;
+
+  // Mesma troca nos dois; o FloatPid soma (Kp antigo - Kp novo) * erro ao integrador
+  const double newKp = 12, newKi = 2, newKd = 0.5;
+  pair.reference.SetTunings(newKp, newKi, newKd);
+  pair.pid.setTunings(newKp, newKi, newKd);
+  const double compensation = (PID_KP - newKp) * (65 - held);
+  for (int i = 0; i < 50; ++i)
+  {
+    pair.step(held);
+    TEST_ASSERT_TRUE(fabs((pair.output - pair.refOutput) - compensation) < PID_TOLERANCE);
+    if (i == 0)
+    {
+      // Sem solavanco: o FloatPid só anda o passo do integrador, o PID_v1 perde (Kp - Kp novo) * erro
+      double integralStep = newKi * PID_SAMPLE_MS / 1000.0 * (65 - held);
+      TEST_ASSERT_TRUE(fabs((pair.output - lastOutput) - integralStep) < PID_TOLERANCE);
+      TEST_ASSERT_TRUE(fabs((pair.refOutput - lastReference) - (integralStep - compensation)) < PID_TOLERANCE);
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_saturation_and_anti_windup_match);
+  RUN_TEST(test_setpoint_step_has_no_derivative_kick);
+  RUN_TEST(test_manual_to_automatic_transfer_matches);
+  RUN_TEST(test_set_tunings_is_compensated_in_the_integrator);
+  return UNITY_END();
+}
@@ -0,0 +1,209 @@
+/**
+ * @file test_main.cpp
+ * @brief GainSchedule e GainRamp no host: interpolação entre as faixas e continuidade da saída na troca de etapa.
+ * @details A tabela é conferida nas linhas, entre elas, fora dela e dos dois lados de cada linha;
+ * o override da RecipeStep vence a tabela. A troca de etapa repete a sequência da controlTask no
+ * CMD_START_RECIPE_STEP (Setpoint primeiro, depois os ganhos pelo GainRamp, um setTunings() por
+ * período) com o FloatPid sobre uma planta de primeira ordem, e compara a saída com a de um PID
+ * que mantém os ganhos da etapa anterior: a diferença entre as duas tem de crescer aos poucos,
+ * sem degrau no instante da troca nem em nenhum período da janela. A troca de uma vez (retomada)
+ * só pode acrescentar o passo maior do integral, o que falha se o setpoint vier depois dos ganhos.
+ * Tolerância por -D GAIN_STEP_TOLERANCE (contagens de duty por período).
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <math.h>
+#include <string>
+
+// Includes do projeto
+#include "FloatPid.h"
+#include "GainSchedule.h"
+
+// --- PARÂMETROS DO TESTE ---
+#ifndef GAIN_STEP_TOLERANCE
+#define GAIN_STEP_TOLERANCE 1.0f // Variação extra da saída aceita por período (contagens de duty)
+#endif
+#define STEP_PERIOD_MS 100 // Período da controlTask (CONTROL_PERIOD_MS)
+#define STEP_OUTPUT_MAX 1023
+
+static const PidTunings BASE = {30.0f, 5.0f, 0.5f}; // Ganhos de fábrica
+
+static GainSchedule *schedule;
+
+void setUp(void)
+{
+  schedule = new GainSchedule();
+  schedule->setBase(BASE);
+}
+
+void tearDown(void)
+{
+  delete schedule;
+}
+
+static void assertTunings(const PidTunings &expected, const PidTunings &actual)
+{
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, expected.kp, actual.kp);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, expected.ki, actual.ki);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, expected.kd, actual.kd);
+}
+
+void test_interpolation_across_bands(void)
+{
+  // Nas linhas: fatores da tabela
+  for (uint8_t i = 0; i < GAIN_SCHEDULE_BANDS; ++i)
+  {
+    const GainBand &band = GAIN_SCHEDULE[i];
+    assertTunings({BASE.kp * band.kpScale, BASE.ki * band.kiScale, BASE.kd * band.kdScale},
+                  schedule->tuningsFor(band.setpoint, nullptr));
+  }
+  // Fora da tabela: a linha mais próxima
+  assertTunings(schedule->tuningsFor(45, nullptr), schedule->tuningsFor(30, nullptr));
+  assertTunings(schedule->tuningsFor(76, nullptr), schedule->tuningsFor(95, nullptr));
+  // Entre duas linhas: linear pelo setpoint
+  assertTunings({30.0f, 3.75f, 0.5f}, schedule->tuningsFor(55, nullptr));   // 45 -> 65, meio
+  assertTunings({33.0f, 6.25f, 0.5f}, schedule->tuningsFor(70.5f, nullptr)); // 65 -> 76, meio
+  assertTunings({31.2f, 5.5f, 0.5f}, schedule->tuningsFor(67.2f, nullptr));  // 65 -> 76, 20 %
+
+  // Sem salto dos dois lados de cada linha
+  for (uint8_t i = 0; i < GAIN_SCHEDULE_BANDS; ++i)
+  {
+    PidTunings below = schedule->tuningsFor(GAIN_SCHEDULE[i].setpoint - 0.01f, nullptr);
+    PidTunings above = schedule->tuningsFor(GAIN_SCHEDULE[i].setpoint + 0.01f, nullptr);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, below.kp, above.kp);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, below.ki, above.ki);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, below.kd, above.kd);
+  }
+
+  // Ganhos próprios da etapa substituem a tabela
+  const PidTunings own = {12.0f, 0.4f, 8.0f};
+  assertTunings(own, schedule->tuningsFor(76, &own));
+  HostPrint out;
+  schedule->printStats(out);
+  TEST_ASSERT_TRUE_MESSAGE(out.text.find(" pela tabela, 1 da etapa") != std::string::npos, out.text.c_str());
+}
+
+void test_ramp_moves_linearly_to_the_step_gains(void)
+{
+  const PidTunings from = {30.0f, 5.0f, 0.5f}, to = {36.0f, 7.5f, 2.5f};
+  GainRamp ramp;
+  TEST_ASSERT_FALSE(ramp.active());
+
+  // Começa perto da volta do millis(): a janela é medida pela diferença
+  const uint32_t start = UINT32_MAX - GAIN_RAMP_MS / 4;
+  ramp.start(from, to, start);
+  TEST_ASSERT_TRUE(ramp.active());
+  assertTunings(from, ramp.at(start));
+  assertTunings({33.0f, 6.25f, 1.5f}, ramp.at((uint32_t)(start + GAIN_RAMP_MS / 2)));
+  TEST_ASSERT_TRUE(ramp.active());
+  assertTunings(to, ramp.at((uint32_t)(start + GAIN_RAMP_MS)));
+  TEST_ASSERT_FALSE(ramp.active());
+}
+
+/**
+ * @brief PID e planta de primeira ordem na mesma situação, avançados período a período.
+ */
+struct ControlledPot
+{
+  float input = 25, output = 0, setpoint = 0;
+  FloatPid pid;
+
+  explicit ControlledPot(const PidTunings &tunings)
+      : pid(&input, &output, &setpoint, tunings.kp, tunings.ki, tunings.kd, STEP_PERIOD_MS)
+  {
+    pid.setOutputLimits(0, STEP_OUTPUT_MAX);
+  }
+
+  void step()
+  {
+    pid.compute();
+    input += output * 0.0004f - (input - 25) * 0.002f; // Mesma planta do benchmarkPidCycles()
+  }
+};
+
+/**
+ * @brief Maior variação da saída por período que a troca de ganhos acrescenta a uma troca de etapa.
+ * @param ramped true: GainRamp como na controlTask; false: setTunings() de uma vez.
+ */
+static float worstExtraStep(float nextSetpoint, const PidTunings *stepGains, bool ramped)
+{
+  // Etapa anterior (65 °C) até o regime, nos dois PIDs
+  PidTunings first = schedule->tuningsFor(65, nullptr);
+  ControlledPot pot(first), reference(first);
+  pot.setpoint = reference.setpoint = 65;
+  pot.pid.setMode(PID_AUTOMATIC);
+  reference.pid.setMode(PID_AUTOMATIC);
+  for (int i = 0; i < 20000; ++i)
+  {
+    pot.step();
+    reference.step();
+  }
+
+  // CMD_START_RECIPE_STEP: setpoint primeiro, depois os ganhos; a referência mantém os anteriores
+  uint32_t now = 0;
+  pot.setpoint = reference.setpoint = nextSetpoint;
+  PidTunings tunings = schedule->tuningsFor(nextSetpoint, stepGains);
+  GainRamp ramp;
+  if (ramped)
+    ramp.start({pot.pid.getKp(), pot.pid.getKi(), pot.pid.getKd()}, tunings, now);
+  else
+    pot.pid.setTunings(tunings.kp, tunings.ki, tunings.kd);
+
+  float worst = 0;
+  float lastGap = 0; // Saída com a troca - saída da referência
+  for (uint32_t i = 0; i < 2 * GAIN_RAMP_MS / STEP_PERIOD_MS; ++i, now += STEP_PERIOD_MS)
+  {
+    if (ramp.active())
+    {
+      PidTunings current = ramp.at(now);
+      pot.pid.setTunings(current.kp, current.ki, current.kd);
+    }
+    pot.step();
+    reference.step();
+    float gap = pot.output - reference.output;
+    worst = fmaxf(worst, fabsf(gap - lastGap));
+    lastGap = gap;
+  }
+  TEST_ASSERT_FALSE(ramp.active());
+  assertTunings(tunings, {pot.pid.getKp(), pot.pid.getKi(), pot.pid.getKd()});
+  return worst;
+}
+
+void test_output_is_continuous_across_a_step_change(void)
+{
+  // Mash-out pela tabela (Kp e Ki maiores) e uma etapa com ganhos próprios (Kd bem maior)
+  const PidTunings own = {45.0f, 2.0f, 20.0f};
+  float scheduled = worstExtraStep(76, nullptr, true);
+  float overridden = worstExtraStep(76, &own, true);
+  float resumed = worstExtraStep(76, nullptr, false); // Retomada: ganhos de uma vez
+  float abrupt = worstExtraStep(76, &own, false);
+
+  char report[200];
+  snprintf(report, sizeof(report), "variacao extra por periodo: tabela %.3f, etapa %.3f, tabela de uma vez %.3f, etapa de uma vez %.3f",
+           (double)scheduled, (double)overridden, (double)resumed, (double)abrupt);
+  TEST_MESSAGE(report);
+  TEST_ASSERT_LESS_THAN_FLOAT_MESSAGE(GAIN_STEP_TOLERANCE, scheduled, "degrau na troca pela tabela");
+  TEST_ASSERT_LESS_THAN_FLOAT_MESSAGE(GAIN_STEP_TOLERANCE, overridden, "degrau na troca pelos ganhos da etapa");
+  // De uma vez, o Kp é compensado com o erro do novo setpoint; sobra só o passo maior do integral
+  // (Ki novo * dt * erro) no primeiro período. Com o setpoint depois dos ganhos o Kp daria degrau
+  PidTunings before = schedule->tuningsFor(65, nullptr), after = schedule->tuningsFor(76, nullptr);
+  float integralStep = (after.ki - before.ki) * STEP_PERIOD_MS / 1000.0f * (76 - 65);
+  TEST_ASSERT_LESS_THAN_FLOAT_MESSAGE(integralStep + GAIN_STEP_TOLERANCE, resumed, "degrau na troca de uma vez (setpoint depois dos ganhos?)");
+  // O Kd entra de uma vez sem a rampa
+  TEST_ASSERT_GREATER_THAN_FLOAT(10 * GAIN_STEP_TOLERANCE, abrupt);
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_interpolation_across_bands);
+  RUN_TEST(test_ramp_moves_linearly_to_the_step_gains);
+  RUN_TEST(test_output_is_continuous_across_a_step_change);
+  return UNITY_END();
+}
@@ -0,0 +1,123 @@
+/**
+ * @file test_main.cpp
+ * @brief PageGlyphText no host: mesmos pixels que o drawChar da Adafruit_GFX e benchmark dos dois caminhos.
+ * @details Todos os 256 caracteres são escritos nas oito linhas alinhadas às páginas, com cp437
+ * ligado e desligado e com o cursor cortando a borda direita, pelo PageGlyphText e pela GFX pura
+ * sobre um HeadlessDisplay: os framebuffers têm de ser iguais byte a byte. Cursor desalinhado e
+ * texto de tamanho 2 precisam cair no caminho da GFX. O benchmark é o mesmo do GLYPH_BENCHMARK do
+ * firmware (measureText(), em ciclos de CPU do host convertidos para 240 MHz) e falha se o caminho
+ * por bytes não for GLYPH_MIN_SPEEDUP vezes mais rápido que o drawChar.
+ * Ajustes por -D: GLYPH_BENCH_ROUNDS e GLYPH_MIN_SPEEDUP.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <string.h>
+
+// Includes do projeto
+#include "GlyphText.h"
+#include "HeadlessDisplay.h"
+
+// --- PARÂMETROS DO TESTE ---
+#ifndef GLYPH_BENCH_ROUNDS
+#define GLYPH_BENCH_ROUNDS 2000 // Telas cheias por caminho (168 glifos cada)
+#endif
+#ifndef GLYPH_MIN_SPEEDUP
+#define GLYPH_MIN_SPEEDUP 3.0f // Piso de ciclos GFX / ciclos alinhado (35 drawPixel x 5 OR por glifo)
+#endif
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Uma tela cheia de caracteres a partir de `first` (os 256 em duas telas), cada linha começando em
+// `startX` (negativo ou perto da borda corta o glifo); '\n' e '\r' viram espaço
+template <class Display>
+static void writeCharset(Display &display, int first, int16_t startX, bool cp437)
+{
+  display.clearDisplay();
+  display.setTextSize(1);
+  display.setTextColor(SSD1306_WHITE);
+  display.cp437(cp437);
+  display.setTextWrap(true);
+  int c = first;
+  for (int16_t y = 0; y < HEADLESS_HEIGHT; y += GLYPH_HEIGHT)
+  {
+    display.setCursor(startX, y);
+    for (int i = 0; i < HEADLESS_WIDTH / GLYPH_WIDTH && c < 256; ++i, ++c)
+      display.write(c == '\n' || c == '\r' ? ' ' : (uint8_t)c);
+  }
+}
+
+void test_aligned_text_matches_draw_char(void)
+{
+  const int16_t starts[] = {0, 3, 125, -4};
+  for (int cp437 = 0; cp437 < 2; ++cp437)
+  {
+    for (int16_t startX : starts)
+    {
+      for (int first = 0; first < 256; first += (HEADLESS_HEIGHT / GLYPH_HEIGHT) * (HEADLESS_WIDTH / GLYPH_WIDTH))
+      {
+        HeadlessDisplay gfx;
+        PageGlyphText<HeadlessDisplay> glyphs;
+        writeCharset(gfx, first, startX, cp437);
+        writeCharset(glyphs, first, startX, cp437);
+        char message[80];
+        snprintf(message, sizeof(message), "cp437=%d x=%d a partir de %d", cp437, startX, first);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, glyphs.diffPixels(gfx.getBuffer()), message);
+      }
+    }
+  }
+}
+
+void test_unaligned_or_scaled_text_uses_the_gfx_path(void)
+{
+  HeadlessDisplay gfx;
+  PageGlyphText<HeadlessDisplay> glyphs;
+  for (Adafruit_GFX *display : {(Adafruit_GFX *)&gfx, (Adafruit_GFX *)&glyphs})
+  {
+    display->setTextColor(SSD1306_WHITE);
+    display->setTextSize(1);
+    display->setCursor(2, 3); // Fora do topo de uma página
+    display->print("Rampa: 66C / 67C");
+    display->setTextSize(2);
+    display->setCursor(0, 24);
+    display->print("OK");
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, glyphs.diffPixels(gfx.getBuffer()));
+  HostPrint out;
+  glyphs.printTextStats(out);
+  TEST_ASSERT_TRUE_MESSAGE(out.text.find(" 0 glifos alinhados, 18 pela GFX") != std::string::npos, out.text.c_str());
+}
+
+void test_aligned_text_benchmark(void)
+{
+  PageGlyphText<HeadlessDisplay> display;
+  display.setTextSize(1);
+  display.setTextColor(SSD1306_WHITE);
+  GlyphBenchmark result = display.measureText(GLYPH_BENCH_ROUNDS);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)GLYPH_BENCH_ROUNDS * 8 * 21, result.glyphs);
+
+  HostPrint out;
+  display.benchmarkText(out, GLYPH_BENCH_ROUNDS); // A mesma linha que o GLYPH_BENCHMARK imprime no boot
+  out.text.pop_back();
+  TEST_MESSAGE(out.text.c_str());
+  float speedup = (float)result.gfxCycles / (float)(result.alignedCycles ? result.alignedCycles : 1);
+  char report[80];
+  snprintf(report, sizeof(report), "GFX / alinhado = %.1fx", (double)speedup);
+  TEST_MESSAGE(report);
+  TEST_ASSERT_GREATER_THAN_FLOAT_MESSAGE(GLYPH_MIN_SPEEDUP, speedup, "texto alinhado sem ganho sobre o drawChar");
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_aligned_text_matches_draw_char);
+  RUN_TEST(test_unaligned_or_scaled_text_uses_the_gfx_path);
+  RUN_TEST(test_aligned_text_benchmark);
+  return UNITY_END();
+}
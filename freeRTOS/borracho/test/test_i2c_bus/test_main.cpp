@@ -0,0 +1,271 @@
+/**
+ * @file test_main.cpp
+ * @brief Árbitro do barramento I2C no host: prioridade do sensor entre páginas do display.
+ * @details O I2CBus roda sobre um I2CTransport simulado que registra cada transação (endereço,
+ * tamanho, clock em uso e instante) e avança o relógio virtual pelo tempo de barramento
+ * (9 bits por byte mais início/parada, no clock aplicado). O display envia um quadro cheio pelo
+ * DirtyPageFlusher (uma reserva por página); no meio da página 0 uma leitura do sensor é pedida
+ * de outra thread. O teste confere que a leitura entra logo depois da última transação dessa
+ * página e antes da janela da página 1, com o clock de 100 kHz, e que a espera e o jitter
+ * impressos pelo printStats() são os do registro.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// No firmware SCREEN_WIDTH/HEIGHT vêm do StatechartCallback.h, incluído antes
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+
+// Includes do projeto
+#include "DisplayFlush.h"
+#include "I2CBus.h"
+
+#define DISPLAY_ADDRESS 0x3C
+#define SENSOR_ADDRESS 0x08
+
+/**
+ * @brief Transação vista pelo barramento simulado.
+ */
+struct BusTransaction
+{
+  uint32_t startMicros; // Relógio virtual no início da transação
+  uint8_t address;
+  bool read;
+  uint16_t length;
+  uint32_t clock;   // Clock aplicado pelo I2CBus
+  uint8_t control;  // Primeiro byte escrito (0x00 comando, 0x40 dados)
+  uint8_t page;     // Página da janela (comandos PAGEADDR)
+};
+
+/**
+ * @brief Barramento simulado: registra as transações e gasta o tempo delas no relógio virtual.
+ */
+class MockTransport : public I2CTransport
+{
+public:
+  void setClock(uint32_t hz) override
+  {
+    clock = hz;
+    clockChanges++;
+  }
+
+  uint8_t write(uint8_t address, const uint8_t *data, size_t length) override
+  {
+    BusTransaction t = {(uint32_t)micros(), address, false, (uint16_t)length, clock, data[0],
+                        (uint8_t)(length > 2 && data[1] == SSD1306_PAGEADDR ? data[2] : 0xFF)};
+    if (beforeTransfer)
+      beforeTransfer(t);
+    record(t);
+    if (failWrites > 0)
+    {
+      failWrites--;
+      return 2; // NACK do endereço
+    }
+    return 0;
+  }
+
+  size_t read(uint8_t address, uint8_t *data, size_t length) override
+  {
+    BusTransaction t = {(uint32_t)micros(), address, true, (uint16_t)length, clock, 0, 0xFF};
+    record(t);
+    float celsius = 65.5f;
+    memcpy(data, &celsius, length < sizeof(celsius) ? length : sizeof(celsius));
+    return length;
+  }
+
+  /**
+   * @brief Duração de uma transação: endereço + dados, 9 bits cada, mais início e parada.
+   */
+  static uint32_t transferMicros(size_t length, uint32_t hz)
+  {
+    return (uint32_t)(((length + 1) * 9 + 2) * 1000000ULL / hz);
+  }
+
+  std::vector<BusTransaction> log;
+  std::function<void(const BusTransaction &)> beforeTransfer; // Chamado com o barramento reservado
+  uint32_t clock = 0;
+  int clockChanges = 0;
+  int failWrites = 0;
+
+private:
+  void record(const BusTransaction &t)
+  {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      log.push_back(t);
+    }
+    hostAdvanceMicros(transferMicros(t.length, t.clock));
+  }
+
+  std::mutex lock;
+};
+
+static MockTransport *transport;
+static I2CBus *bus;
+static DirtyPageFlusher *flusher;
+static uint8_t frame[DISPLAY_FRAME_SIZE];
+
+void setUp(void)
+{
+  hostResetClock();
+  transport = new MockTransport();
+  bus = new I2CBus(*transport);
+  TEST_ASSERT_TRUE(bus->begin());
+  flusher = new DirtyPageFlusher(*bus, DISPLAY_ADDRESS);
+  for (size_t i = 0; i < sizeof(frame); ++i)
+    frame[i] = (uint8_t)(i * 7 + 1);
+}
+
+void tearDown(void)
+{
+  delete flusher;
+  delete bus;
+  delete transport;
+}
+
+// Leitura do sensor como na temperatureSensorTask
+static void readSensor()
+{
+  uint8_t data[4];
+  bus->acquire(I2C_CLIENT_SENSOR);
+  bus->read(SENSOR_ADDRESS, data, sizeof(data));
+  bus->release();
+}
+
+static bool waitForBlockedTakers(int count)
+{
+  for (int i = 0; i < 2000; ++i)
+  {
+    if (hostSemaphoreWaiters.load() >= count)
+      return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+
+// Procura uma linha do printStats() e extrai os números com o formato dado
+static int scanStats(const std::string &text, const char *prefix, const char *format, unsigned long *a,
+                     unsigned long *b, unsigned long *c, unsigned long *d)
+{
+  size_t pos = text.find(prefix);
+  if (pos == std::string::npos)
+    return 0;
+  return sscanf(text.c_str() + pos, format, a, b, c, d);
+}
+
+void test_sensor_read_preempts_display_between_pages(void)
+{
+  hostAdvanceMicros(1000);
+  readSensor(); // Primeira leitura: referência do intervalo
+
+  uint32_t requestMicros = 0;
+  std::thread sensor;
+  bool sensorBlocked = false;
+  int displayWrites = 0;
+  transport->beforeTransfer = [&](const BusTransaction &t) {
+    // Segundo bloco de dados da página 0: o sensor pede o barramento no meio da página
+    if (t.address == DISPLAY_ADDRESS && ++displayWrites == 3)
+    {
+      requestMicros = micros();
+      sensor = std::thread(readSensor);
+      sensorBlocked = waitForBlockedTakers(1);
+    }
+  };
+
+  uint32_t bytes = flusher->flush(frame);
+  sensor.join();
+  transport->beforeTransfer = nullptr;
+  TEST_ASSERT_TRUE_MESSAGE(sensorBlocked, "o sensor nao chegou a esperar pelo barramento");
+  TEST_ASSERT_EQUAL_UINT32(8 * (7 + SCREEN_WIDTH + (SCREEN_WIDTH - 1) / DISPLAY_FLUSH_CHUNK + 1), bytes);
+
+  hostAdvanceMicros(30000);
+  readSensor(); // Terceira leitura, fora do quadro
+
+  // A leitura preemptiva vem logo depois da última transação da página 0
+  const std::vector<BusTransaction> &log = transport->log;
+  size_t preempting = 0;
+  for (size_t i = 1; i < log.size(); ++i)
+  {
+    if (log[i].read)
+    {
+      preempting = i;
+      break;
+    }
+  }
+  const size_t pageTransactions = 1 + (SCREEN_WIDTH + DISPLAY_FLUSH_CHUNK - 1) / DISPLAY_FLUSH_CHUNK; // Janela + dados
+  TEST_ASSERT_EQUAL_UINT32(1 + pageTransactions, preempting);
+  TEST_ASSERT_EQUAL_UINT8(0, log[1].page);
+  for (size_t i = 1; i < preempting; ++i)
+  {
+    TEST_ASSERT_EQUAL_UINT8(DISPLAY_ADDRESS, log[i].address);
+    TEST_ASSERT_EQUAL_UINT32(I2C_CLOCK_DISPLAY, log[i].clock);
+  }
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_ADDRESS, log[preempting].address);
+  TEST_ASSERT_EQUAL_UINT32(I2C_CLOCK_SENSOR, log[preempting].clock);
+  TEST_ASSERT_EQUAL_UINT8(1, log[preempting + 1].page);
+  TEST_ASSERT_EQUAL_UINT32(I2C_CLOCK_DISPLAY, log[preempting + 1].clock);
+  TEST_ASSERT_EQUAL_UINT32(1 + 8 * pageTransactions + 2, log.size());
+
+  // Espera e jitter do sensor impressos a partir do relógio virtual
+  uint32_t waited = log[preempting].startMicros - requestMicros;
+  uint32_t first = log[preempting].startMicros - log[0].startMicros;
+  uint32_t second = log.back().startMicros - log[preempting].startMicros;
+  HostPrint stats;
+  bus->printStats(stats);
+  TEST_MESSAGE(stats.text.c_str());
+
+  unsigned long transactions, averageWait, maxWait, unused;
+  TEST_ASSERT_EQUAL_INT(3, scanStats(stats.text, "I2C sensor: ", "I2C sensor: %lu transacoes, espera media=%lu us (max %lu us)",
+                                     &transactions, &averageWait, &maxWait, &unused));
+  TEST_ASSERT_EQUAL_UINT32(3, transactions);
+  TEST_ASSERT_TRUE(waited > 0);
+  TEST_ASSERT_EQUAL_UINT32(waited, maxWait);
+  TEST_ASSERT_EQUAL_UINT32(waited / 3, averageWait);
+
+  unsigned long minInterval, maxInterval, jitter, yields;
+  TEST_ASSERT_EQUAL_INT(4, scanStats(stats.text, "I2C sensor: intervalo",
+                                     "I2C sensor: intervalo entre leituras min=%lu us max=%lu us (jitter %lu us), "
+                                     "display cedeu a vez %lu vezes",
+                                     &minInterval, &maxInterval, &jitter, &yields));
+  TEST_ASSERT_EQUAL_UINT32(std::min(first, second), minInterval);
+  TEST_ASSERT_EQUAL_UINT32(std::max(first, second), maxInterval);
+  TEST_ASSERT_EQUAL_UINT32(maxInterval - minInterval, jitter);
+}
+
+void test_write_error_is_counted_and_forces_a_full_frame(void)
+{
+  TEST_ASSERT_TRUE(flusher->flush(frame) > 0);
+  frame[3 * SCREEN_WIDTH + 10] ^= 0xFF; // Só a página 3 muda
+
+  transport->failWrites = 1;
+  flusher->flush(frame);
+  size_t before = transport->log.size();
+  flusher->flush(frame); // Conteúdo incerto: reenvia as 8 páginas
+  size_t windows = 0;
+  for (size_t i = before; i < transport->log.size(); ++i)
+    windows += transport->log[i].page != 0xFF ? 1 : 0;
+  TEST_ASSERT_EQUAL_UINT32(8, windows);
+
+  HostPrint stats;
+  bus->printStats(stats);
+  TEST_ASSERT_TRUE(stats.text.find("erros=1\n") != std::string::npos);
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_sensor_read_preempts_display_between_pages);
+  RUN_TEST(test_write_error_is_counted_and_forces_a_full_frame);
+  return UNITY_END();
+}
@@ -0,0 +1,107 @@
+/**
+ * @file test_main.cpp
+ * @brief PersistenceMailbox no host: snapshot, remoção e ganhos não se perdem com o log cheio.
+ * @details Repete o que a controlTask publica em uma receita sem a loggerTask drenar nada: o
+ * controlLogRing enche e descarta linhas do log, enquanto a remoção do snapshot e os ganhos
+ * continuam pendentes na mailbox. Confere também a ordem entregue à loggerTask (a remoção
+ * descarta o snapshot anterior a ela, o snapshot posterior é mantido) e que take() esvazia tudo.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+// Includes do projeto
+#include "ControlLoop.h"
+#include "SpscRing.h"
+
+static PersistenceMailbox *mailbox;
+
+void setUp(void)
+{
+  mailbox = new PersistenceMailbox();
+}
+
+void tearDown(void)
+{
+  delete mailbox;
+}
+
+static ControlRecord recordAt(uint32_t elapsedMillis)
+{
+  ControlRecord record = {};
+  record.stepElapsedMillis = elapsedMillis;
+  record.recipeIdx = 1;
+  record.stepIdx = 2;
+  record.customNumSteps = 3;
+  return record;
+}
+
+void test_clear_survives_a_full_log_ring(void)
+{
+  SpscRing<ControlRecord, CONTROL_RECORD_RING> logRing;
+  for (uint32_t i = 0; i < 4 * CONTROL_RECORD_RING; ++i)
+  {
+    logRing.push(recordAt(i * 1000)); // Linha do log a cada segundo; a loggerTask está presa no flash
+    if (i % 30 == 0)
+      mailbox->postSnapshot(recordAt(i * 1000));
+  }
+  mailbox->postClearSnapshot(); // Processo abortado com a fila do log cheia
+  TEST_ASSERT_FALSE(logRing.push(recordAt(0)));
+
+  PersistenceMailbox::Pending pending;
+  TEST_ASSERT_TRUE(mailbox->take(pending));
+  TEST_ASSERT_TRUE(pending.clearSnapshot);
+  TEST_ASSERT_FALSE_MESSAGE(pending.snapshot, "snapshot anterior a remocao recriaria o /brew_state.bin");
+  TEST_ASSERT_FALSE(pending.gains);
+  TEST_ASSERT_FALSE(mailbox->take(pending));
+}
+
+void test_snapshot_after_clear_is_kept_and_newest_wins(void)
+{
+  mailbox->postSnapshot(recordAt(1000));
+  mailbox->postClearSnapshot();
+  mailbox->postSnapshot(recordAt(2000)); // Nova receita antes da loggerTask acordar
+  mailbox->postSnapshot(recordAt(3000));
+
+  PersistenceMailbox::Pending pending;
+  TEST_ASSERT_TRUE(mailbox->take(pending));
+  TEST_ASSERT_TRUE(pending.clearSnapshot); // Gravada antes do snapshot
+  TEST_ASSERT_TRUE(pending.snapshot);
+  TEST_ASSERT_EQUAL_UINT32(3000, pending.snapshotRecord.stepElapsedMillis);
+  TEST_ASSERT_EQUAL_INT(3, pending.snapshotRecord.customNumSteps);
+
+  HostPrint out;
+  mailbox->printStats(out);
+  TEST_ASSERT_TRUE_MESSAGE(out.text.find(" 2 pedidos substituidos") != std::string::npos, out.text.c_str());
+}
+
+void test_gains_stay_pending_until_taken(void)
+{
+  ControlRecord record = recordAt(0);
+  record.gainKp = 41.5f;
+  record.gainKi = 0.8f;
+  mailbox->postGains(record);
+  mailbox->postSnapshot(recordAt(5000));
+
+  PersistenceMailbox::Pending pending;
+  TEST_ASSERT_TRUE(mailbox->take(pending));
+  TEST_ASSERT_FALSE(pending.clearSnapshot);
+  TEST_ASSERT_TRUE(pending.snapshot);
+  TEST_ASSERT_TRUE(pending.gains);
+  TEST_ASSERT_EQUAL_FLOAT(41.5f, pending.gainsRecord.gainKp);
+  TEST_ASSERT_EQUAL_FLOAT(0.8f, pending.gainsRecord.gainKi);
+  TEST_ASSERT_FALSE(mailbox->take(pending));
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_clear_survives_a_full_log_ring);
+  RUN_TEST(test_snapshot_after_clear_is_kept_and_newest_wins);
+  RUN_TEST(test_gains_stay_pending_until_taken);
+  return UNITY_END();
+}
@@ -0,0 +1,324 @@
+/**
+ * @file test_main.cpp
+ * @brief RelayAutoTune no host contra uma planta de primeira ordem com tempo morto (FOPDT).
+ * @details A panela é modelada como ganho K (°C por contagem de duty), constante de tempo tau e
+ * tempo morto theta, discretizada de forma exata com o duty constante em cada período da
+ * controlTask (CONTROL_PERIOD_MS). Para essa planta o ciclo limite do relé com histerese tem
+ * solução fechada: o aquecedor continua agindo theta depois de cada chaveamento, então os
+ * extremos e os tempos de subida e descida saem das exponenciais (relayLimitCycle()). O teste
+ * confere a amplitude e o período medidos pelo RelayAutoTune com esse ciclo, o Ku com a fórmula
+ * do relé sobre a amplitude esperada e os ganhos com Ziegler–Nichols "sem sobressinal". Os ganhos
+ * identificados controlam a mesma planta com o FloatPid melhor que os de fábrica, e o registro
+ * gravado a partir da cópia do ControlRecord é relido pelo PidGainsStore. Os caminhos de falha
+ * (sobressinal, sensor, tempo) e o cancelamento também são cobertos.
+ * Tolerâncias por -D: AUTOTUNE_PERIOD_TOLERANCE e AUTOTUNE_AMPLITUDE_TOLERANCE.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+// Includes do projeto
+#include "ControlLoop.h"
+#include "FloatPid.h"
+#include "RelayAutoTune.h"
+
+// --- PARÂMETROS DO TESTE ---
+#ifndef AUTOTUNE_PERIOD_TOLERANCE
+#define AUTOTUNE_PERIOD_TOLERANCE 0.01f // Erro relativo aceito no Pu (chaveamento a cada 100 ms)
+#endif
+#ifndef AUTOTUNE_AMPLITUDE_TOLERANCE
+#define AUTOTUNE_AMPLITUDE_TOLERANCE 0.02f // Erro relativo aceito na amplitude e no Ku
+#endif
+#define PLANT_AMBIENT 25.0f  // °C
+#define PLANT_GAIN 0.08f     // °C por contagem de duty em regime (1023 -> 107 °C)
+#define PLANT_TAU_SEC 600.0f // Constante de tempo da panela
+#define PLANT_DEAD_SEC 15.0f // Atraso entre o aquecedor e o sensor
+#define DUTY_MAX 1023.0f     // PWM de 10 bits, como no firmware
+#define FACTORY_KP 30.0f     // Ganhos de fábrica do main.cpp
+#define FACTORY_KI 5.0f
+#define FACTORY_KD 0.5f
+
+/**
+ * @brief Planta FOPDT discretizada no período da controlTask.
+ */
+class FopdtPlant
+{
+public:
+  FopdtPlant(float gain, float tauSec, float deadSec, float start = PLANT_AMBIENT)
+      : gain(gain), decay(expf(-CONTROL_PERIOD_MS / 1000.0f / tauSec)),
+        pending((size_t)lroundf(deadSec * 1000 / CONTROL_PERIOD_MS), 0.0f), temperature(start)
+  {
+  }
+
+  float read() const
+  {
+    return temperature;
+  }
+
+  // Um período: o duty aplicado agora só chega à temperatura depois do tempo morto
+  void step(float duty)
+  {
+    float delayed = duty;
+    if (!pending.empty())
+    {
+      delayed = pending[head];
+      pending[head] = duty;
+      head = (head + 1) % pending.size();
+    }
+    float target = PLANT_AMBIENT + gain * delayed;
+    temperature = target + (temperature - target) * decay;
+  }
+
+private:
+  float gain;
+  float decay;                // exp(-dt / tau)
+  std::vector<float> pending; // Duty aplicado nos últimos theta / dt períodos
+  float temperature;
+  size_t head = 0;
+};
+
+/**
+ * @brief Ciclo limite do relé com histerese sobre a FOPDT (tempo contínuo).
+ */
+struct LimitCycle
+{
+  float amplitude; // (máximo - mínimo) / 2 (°C)
+  float periodSec;
+};
+
+static LimitCycle relayLimitCycle(float setpoint, float outputHigh)
+{
+  // Temperaturas relativas ao ambiente; o relé desliga em setpoint + ε e religa em setpoint - ε
+  const float high = PLANT_GAIN * outputHigh;
+  const float upper = setpoint + AUTOTUNE_HYSTERESIS - PLANT_AMBIENT;
+  const float lower = setpoint - AUTOTUNE_HYSTERESIS - PLANT_AMBIENT;
+  const float lag = expf(-PLANT_DEAD_SEC / PLANT_TAU_SEC);
+  float peak = high - (high - upper) * lag; // Aquecedor ainda ligado por theta após desligar
+  float valley = lower * lag;               // E ainda desligado por theta após religar
+  float rise = PLANT_TAU_SEC * logf((high - valley) / (high - upper));
+  float fall = PLANT_TAU_SEC * logf(peak / lower);
+  return {(peak - valley) / 2, 2 * PLANT_DEAD_SEC + rise + fall};
+}
+
+// Fórmula do relé (RelayAutoTune::computeGains)
+static float relayUltimateGain(float amplitude, float outputHigh)
+{
+  return 4 * (outputHigh / 2) /
+         ((float)M_PI * sqrtf(amplitude * amplitude - AUTOTUNE_HYSTERESIS * AUTOTUNE_HYSTERESIS));
+}
+
+/**
+ * @brief Roda o relé sobre a planta até sair de RUNNING (ou até maxMillis).
+ * @return Instante em que o auto-tune terminou.
+ */
+static uint32_t runAutoTune(RelayAutoTune &tune, FopdtPlant &plant, uint32_t maxMillis,
+                            float sensorOffset = 0, uint32_t sensorFailAtMillis = UINT32_MAX)
+{
+  uint32_t now = 0;
+  tune.start(AUTOTUNE_SETPOINT, DUTY_MAX, now);
+  while (tune.running() && now < maxMillis)
+  {
+    float input = now >= sensorFailAtMillis ? -127.0f : plant.read() + sensorOffset;
+    plant.step(tune.update(input, now));
+    now += CONTROL_PERIOD_MS;
+  }
+  return now;
+}
+
+/**
+ * @brief Resposta em malha fechada do FloatPid sobre a planta, do ambiente a AUTOTUNE_SETPOINT.
+ */
+struct ClosedLoopResponse
+{
+  float peak;      // Maior temperatura (°C)
+  float lateError; // Maior |erro| na segunda hora (°C)
+};
+
+static ClosedLoopResponse closedLoopResponse(float kp, float ki, float kd)
+{
+  float input = PLANT_AMBIENT, output = 0, setpoint = AUTOTUNE_SETPOINT;
+  FloatPid pid(&input, &output, &setpoint, kp, ki, kd, CONTROL_PERIOD_MS);
+  pid.setOutputLimits(0, DUTY_MAX);
+  pid.setMode(PID_AUTOMATIC);
+  FopdtPlant plant(PLANT_GAIN, PLANT_TAU_SEC, PLANT_DEAD_SEC);
+  ClosedLoopResponse response = {0, 0};
+  const uint32_t steps = 2 * 3600UL * 1000 / CONTROL_PERIOD_MS;
+  for (uint32_t i = 0; i < steps; ++i)
+  {
+    input = plant.read();
+    pid.compute();
+    plant.step(output);
+    response.peak = fmaxf(response.peak, input);
+    if (i >= steps / 2)
+      response.lateError = fmaxf(response.lateError, fabsf(input - setpoint));
+  }
+  return response;
+}
+
+static void assertRelative(float expected, float actual, float tolerance, const char *what)
+{
+  char message[120];
+  snprintf(message, sizeof(message), "%s: esperado %.3f, medido %.3f", what, (double)expected, (double)actual);
+  TEST_ASSERT_TRUE_MESSAGE(fabsf(actual - expected) <= tolerance * fabsf(expected), message);
+}
+
+void setUp(void)
+{
+  LittleFS.hostFormat();
+}
+
+void tearDown(void) {}
+
+void test_identified_ultimate_gain_and_period_match_the_limit_cycle(void)
+{
+  RelayAutoTune tune;
+  FopdtPlant plant(PLANT_GAIN, PLANT_TAU_SEC, PLANT_DEAD_SEC);
+  uint32_t finishedMillis = runAutoTune(tune, plant, AUTOTUNE_TIMEOUT_MS + 60000UL);
+  TEST_ASSERT_EQUAL_MESSAGE(AUTOTUNE_DONE, tune.getState(), "o relé não convergiu");
+
+  LimitCycle expected = relayLimitCycle(AUTOTUNE_SETPOINT, DUTY_MAX);
+  const PidGains &gains = tune.result();
+  char report[200];
+  snprintf(report, sizeof(report), "FOPDT K=%.2f tau=%.0fs theta=%.0fs: a=%.2f C, Pu=%.1f s (medido %.1f s), Ku=%.1f em %lu s",
+           (double)PLANT_GAIN, (double)PLANT_TAU_SEC, (double)PLANT_DEAD_SEC, (double)expected.amplitude,
+           (double)expected.periodSec, (double)gains.ultimatePeriodSec, (double)gains.ultimateGain,
+           (unsigned long)(finishedMillis / 1000));
+  TEST_MESSAGE(report);
+
+  assertRelative(expected.periodSec, gains.ultimatePeriodSec, AUTOTUNE_PERIOD_TOLERANCE, "Pu");
+  assertRelative(relayUltimateGain(expected.amplitude, DUTY_MAX), gains.ultimateGain,
+                 AUTOTUNE_AMPLITUDE_TOLERANCE, "Ku");
+}
+
+void test_gains_follow_ziegler_nichols_no_overshoot(void)
+{
+  RelayAutoTune tune;
+  FopdtPlant plant(PLANT_GAIN, PLANT_TAU_SEC, PLANT_DEAD_SEC);
+  runAutoTune(tune, plant, AUTOTUNE_TIMEOUT_MS);
+  TEST_ASSERT_EQUAL(AUTOTUNE_DONE, tune.getState());
+
+  const PidGains &gains = tune.result();
+  const float ku = gains.ultimateGain, pu = gains.ultimatePeriodSec;
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f * ku, 0.2f * ku, gains.kp);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f * gains.ki, 0.2f * ku / (pu / 2), gains.ki);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f * gains.kd, 0.2f * ku * pu / 3, gains.kd);
+
+  // Do ambiente ao setpoint na mesma planta: menos sobressinal que os ganhos de fábrica e acomodado
+  // em ±0,5 °C na segunda hora (os de fábrica continuam oscilando)
+  ClosedLoopResponse tuned = closedLoopResponse(gains.kp, gains.ki, gains.kd);
+  ClosedLoopResponse factory = closedLoopResponse(FACTORY_KP, FACTORY_KI, FACTORY_KD);
+  char report[160];
+  snprintf(report, sizeof(report), "Kp=%.1f Ki=%.3f Kd=%.0f: pico %.2f C, erro %.2f C (fabrica: pico %.2f C, erro %.2f C)",
+           (double)gains.kp, (double)gains.ki, (double)gains.kd, (double)tuned.peak, (double)tuned.lateError,
+           (double)factory.peak, (double)factory.lateError);
+  TEST_MESSAGE(report);
+  TEST_ASSERT_LESS_THAN_FLOAT_MESSAGE(factory.peak, tuned.peak, "sobressinal maior que o dos ganhos de fabrica");
+  TEST_ASSERT_LESS_THAN_FLOAT_MESSAGE(0.5f, tuned.lateError, "nao acomodou no setpoint");
+}
+
+void test_saved_gains_come_from_the_control_record_copy(void)
+{
+  RelayAutoTune tune;
+  FopdtPlant plant(PLANT_GAIN, PLANT_TAU_SEC, PLANT_DEAD_SEC);
+  runAutoTune(tune, plant, AUTOTUNE_TIMEOUT_MS);
+  TEST_ASSERT_EQUAL(AUTOTUNE_DONE, tune.getState());
+
+  // O que a controlTask publica (publishControlRecord) ...
+  PidGains identified = tune.result();
+  ControlRecord record = {};
+  record.flags = CONTROL_RECORD_SAVE_GAINS;
+  record.gainKp = identified.kp;
+  record.gainKi = identified.ki;
+  record.gainKd = identified.kd;
+  record.gainUltimate = identified.ultimateGain;
+  record.gainUltimatePeriodSec = identified.ultimatePeriodSec;
+
+  // ... continua valendo depois que o RelayAutoTune é reiniciado, antes de a loggerTask gravar
+  tune.start(AUTOTUNE_SETPOINT, DUTY_MAX, 0);
+  tune.cancel();
+
+  PidGains copy = {};
+  copy.kp = record.gainKp;
+  copy.ki = record.gainKi;
+  copy.kd = record.gainKd;
+  copy.ultimateGain = record.gainUltimate;
+  copy.ultimatePeriodSec = record.gainUltimatePeriodSec;
+  PidGainsStore store;
+  TEST_ASSERT_TRUE(store.save(copy));
+
+  PidGains loaded = {};
+  TEST_ASSERT_TRUE(store.load(loaded));
+  TEST_ASSERT_EQUAL_FLOAT(identified.kp, loaded.kp);
+  TEST_ASSERT_EQUAL_FLOAT(identified.ki, loaded.ki);
+  TEST_ASSERT_EQUAL_FLOAT(identified.kd, loaded.kd);
+  TEST_ASSERT_EQUAL_FLOAT(identified.ultimateGain, loaded.ultimateGain);
+  TEST_ASSERT_EQUAL_FLOAT(identified.ultimatePeriodSec, loaded.ultimatePeriodSec);
+}
+
+void test_overshoot_aborts_with_heater_off(void)
+{
+  // Tempo morto longo: a temperatura passa de setpoint + AUTOTUNE_MAX_OVERSHOOT antes do relé agir
+  RelayAutoTune tune;
+  FopdtPlant plant(PLANT_GAIN, 60.0f, 60.0f);
+  runAutoTune(tune, plant, AUTOTUNE_TIMEOUT_MS);
+  TEST_ASSERT_EQUAL(AUTOTUNE_FAILED, tune.getState());
+  TEST_ASSERT_GREATER_THAN_FLOAT(AUTOTUNE_SETPOINT + AUTOTUNE_MAX_OVERSHOOT, plant.read());
+  TEST_ASSERT_EQUAL_FLOAT(0, tune.update(plant.read(), 0));
+}
+
+void test_sensor_failure_aborts(void)
+{
+  RelayAutoTune tune;
+  FopdtPlant plant(PLANT_GAIN, PLANT_TAU_SEC, PLANT_DEAD_SEC);
+  uint32_t failedMillis = runAutoTune(tune, plant, AUTOTUNE_TIMEOUT_MS, 0, 5UL * 60000UL);
+  TEST_ASSERT_EQUAL(AUTOTUNE_FAILED, tune.getState());
+  TEST_ASSERT_EQUAL_UINT32(5UL * 60000UL + CONTROL_PERIOD_MS, failedMillis);
+}
+
+void test_timeout_when_setpoint_is_never_reached(void)
+{
+  // Aquecedor fraco: em regime a panela fica em 25 + 0,03 * 1023 ≈ 56 °C
+  RelayAutoTune tune;
+  FopdtPlant plant(0.03f, PLANT_TAU_SEC, PLANT_DEAD_SEC);
+  uint32_t failedMillis = runAutoTune(tune, plant, AUTOTUNE_TIMEOUT_MS + 60000UL);
+  TEST_ASSERT_EQUAL(AUTOTUNE_FAILED, tune.getState());
+  TEST_ASSERT_UINT32_WITHIN(CONTROL_PERIOD_MS, AUTOTUNE_TIMEOUT_MS + 2 * CONTROL_PERIOD_MS, failedMillis);
+}
+
+void test_cancel_keeps_previous_result(void)
+{
+  RelayAutoTune tune;
+  FopdtPlant plant(PLANT_GAIN, PLANT_TAU_SEC, PLANT_DEAD_SEC);
+  runAutoTune(tune, plant, AUTOTUNE_TIMEOUT_MS);
+  PidGains before = tune.result();
+
+  // Um novo auto-tune cancelado (saída do IDLE) não altera os ganhos nem aciona o aquecedor
+  tune.start(AUTOTUNE_SETPOINT, DUTY_MAX, 0);
+  TEST_ASSERT_EQUAL_FLOAT(DUTY_MAX, tune.update(PLANT_AMBIENT, 0));
+  tune.cancel();
+  TEST_ASSERT_EQUAL(AUTOTUNE_IDLE, tune.getState());
+  TEST_ASSERT_EQUAL_FLOAT(0, tune.update(PLANT_AMBIENT, CONTROL_PERIOD_MS));
+  TEST_ASSERT_EQUAL_FLOAT(before.kp, tune.result().kp);
+  TEST_ASSERT_EQUAL_FLOAT(before.ultimateGain, tune.result().ultimateGain);
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_identified_ultimate_gain_and_period_match_the_limit_cycle);
+  RUN_TEST(test_gains_follow_ziegler_nichols_no_overshoot);
+  RUN_TEST(test_saved_gains_come_from_the_control_record_copy);
+  RUN_TEST(test_overshoot_aborts_with_heater_off);
+  RUN_TEST(test_sensor_failure_aborts);
+  RUN_TEST(test_timeout_when_setpoint_is_never_reached);
+  RUN_TEST(test_cancel_keeps_previous_result);
+  return UNITY_END();
+}
@@ -0,0 +1,336 @@
+/**
+ * @file test_main.cpp
+ * @brief Fuzz e vazão da statechart gerada, no host (pio test -e native).
+ * @details A Statechart roda com um OperationCallback falso (só guarda receita e etapa, como o
+ * StatechartCallback) e um TimerServiceInterface sobre a TimerWheel, com relógio virtual: o tempo
+ * só passa quando o teste chama tick(). Milhões de eventos aleatórios são despachados como a
+ * stateMachineTask faria: teclas pelas tabelas do KeypadDispatch.h, eventos da controlTask/do
+ * callback (step_finished, finished_process), eventos quaisquer do modelo e ticks do relógio.
+ * Depois de cada despacho a configuração de estados é validada. São medidos eventos/s, percentis
+ * do tempo por despacho e alocações de heap (operator new contado); uma regressão em qualquer um
+ * deles falha o `pio test -e native`. Os limites podem ser ajustados com -D no build_flags:
+ * STATECHART_FUZZ_EVENTS, STATECHART_FUZZ_SEED, STATECHART_MIN_EVENTS_PER_SEC e
+ * STATECHART_MAX_P99_NS.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+// Includes do projeto
+#include "KeypadDispatch.h"
+#include "StatechartHarness.h"
+
+// --- PARÂMETROS DO TESTE ---
+#ifndef STATECHART_FUZZ_EVENTS
+#define STATECHART_FUZZ_EVENTS 2000000UL // Despachos aleatórios
+#endif
+#ifndef STATECHART_FUZZ_SEED
+#define STATECHART_FUZZ_SEED 0x5EED2025UL
+#endif
+#ifndef STATECHART_MIN_EVENTS_PER_SEC
+#define STATECHART_MIN_EVENTS_PER_SEC 200000UL // Piso da vazão (o host faz alguns milhões)
+#endif
+#ifndef STATECHART_MAX_P99_NS
+#define STATECHART_MAX_P99_NS 20000UL // Teto do percentil 99 por despacho
+#endif
+
+// --- CONTAGEM DE ALOCAÇÕES ---
+static volatile unsigned long heapAllocations = 0;
+
+void *operator new(size_t size)
+{
+  heapAllocations++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+/**
+ * @brief Gerador xorshift32: determinístico e sem alocação.
+ */
+struct FuzzRandom
+{
+  uint32_t state;
+
+  uint32_t next()
+  {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+
+  uint32_t below(uint32_t n)
+  {
+    return next() % n;
+  }
+};
+
+static const char KEYPAD_KEYS[] = "123A456B789C*0#D";
+
+static Statechart *statechart;
+static MockCallback *callback;
+static VirtualTimerService *timerService;
+
+void setUp(void)
+{
+  statechart = new Statechart();
+  callback = new MockCallback();
+  timerService = new VirtualTimerService();
+  statechart->setOperationCallback(callback);
+  statechart->setTimerService(timerService);
+  statechart->enter();
+}
+
+void tearDown(void)
+{
+  delete statechart;
+  delete callback;
+  delete timerService;
+}
+
+// Avança o relógio virtual até um evento de tempo disparar (ou o limite de ticks)
+static bool tickUntilTimeEvent(uint32_t maxTicks)
+{
+  for (uint32_t i = 0; i < maxTicks; ++i)
+  {
+    if (timerService->tick() > 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Trata uma tecla como a processKeypadKey() da stateMachineTask
+static void dispatchKey(Statechart &machine, MockCallback &operations, char key)
+{
+  const KeyBinding *binding = findKeyBinding(keyMapForState(machine.getActiveLeafState()), key);
+  if (binding == nullptr)
+  {
+    return;
+  }
+  switch (binding->action)
+  {
+  case KEY_ACTION_RAISE:
+  case KEY_ACTION_ABORT:
+    machine.raiseEvent((statechart_events::StatechartEventName)binding->event);
+    break;
+  case KEY_ACTION_START_RECIPE:
+  {
+    operations.currentRecipeIdx = binding->arg;
+    const statechart_events::StatechartEventName events[] = {
+        (statechart_events::StatechartEventName)binding->event, statechart_events::start_first_step};
+    machine.raiseEvents(events, 2);
+    break;
+  }
+  default:
+    break; // Log, trace e auto-tune não passam pela statechart
+  }
+}
+
+static void dispatchKey(char key)
+{
+  dispatchKey(*statechart, *callback, key);
+}
+
+// Percentil de amostras já ordenadas
+static uint32_t percentile(const std::vector<uint32_t> &sorted, double p)
+{
+  size_t idx = (size_t)(p * (sorted.size() - 1));
+  return sorted[idx];
+}
+
+void test_recipe_runs_to_finished_message_and_back_to_idle(void)
+{
+  TEST_ASSERT_EQUAL(Statechart::main_region_IDLE, statechart->getActiveLeafState());
+  dispatchKey('1');
+  TEST_ASSERT_EQUAL(Statechart::main_region_INIT_SYSTEM, statechart->getActiveLeafState());
+  TEST_ASSERT_TRUE(tickUntilTimeEvent(TimerWheel::msToTicks(10000)));
+  TEST_ASSERT_EQUAL(Statechart::main_region_MENU, statechart->getActiveLeafState());
+  dispatchKey('2');
+  dispatchKey('1');
+  TEST_ASSERT_EQUAL(Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP,
+                    statechart->getActiveLeafState());
+  TEST_ASSERT_EQUAL(1, callback->currentRecipeIdx);
+  TEST_ASSERT_EQUAL(0, callback->currentStepIdx);
+  for (int i = 0; i < callback->stepsPerRecipe; ++i)
+  {
+    statechart->raiseEvent(statechart_events::step_finished);
+  }
+  TEST_ASSERT_TRUE(callback->finishedPending);
+  callback->finishedPending = false;
+  statechart->raiseEvent(statechart_events::finished_process);
+  TEST_ASSERT_EQUAL(Statechart::main_region_FINISHED_MESSAGE, statechart->getActiveLeafState());
+  TEST_ASSERT_TRUE(tickUntilTimeEvent(TimerWheel::msToTicks(60000)));
+  TEST_ASSERT_EQUAL(Statechart::main_region_IDLE, statechart->getActiveLeafState());
+  TEST_ASSERT_EQUAL(0, timerService->wheel.getActiveCount());
+  TEST_ASSERT_TRUE(statechart->isStateConfigurationValid());
+}
+
+// Uma tecla associada a um evento sem transição no estado seria uma tecla morta
+void test_every_bound_key_leaves_its_state(void)
+{
+  int checked = 0;
+  for (int state = Statechart::main_region_IDLE; state <= Statechart::numStates; ++state)
+  {
+    const StateKeyMap &map = keyMapForState((Statechart::StatechartStates)state);
+    for (uint8_t i = 0; i < map.count; ++i)
+    {
+      const KeyBinding &binding = map.bindings[i];
+      if (binding.action != KEY_ACTION_RAISE && binding.action != KEY_ACTION_START_RECIPE &&
+          binding.action != KEY_ACTION_ABORT)
+      {
+        continue;
+      }
+      Statechart machine;
+      MockCallback operations;
+      VirtualTimerService timers;
+      machine.setOperationCallback(&operations);
+      machine.setTimerService(&timers);
+      if (!machine.restoreActiveState((Statechart::StatechartStates)state))
+      {
+        continue; // Estado composto: nunca é a folha ativa
+      }
+      dispatchKey(machine, operations, binding.key);
+      char message[64];
+      snprintf(message, sizeof(message), "tecla '%c' sem transicao no estado %d", binding.key, state);
+      TEST_ASSERT_TRUE_MESSAGE(machine.getActiveLeafState() != state, message);
+      TEST_ASSERT_TRUE(machine.isStateConfigurationValid());
+      checked++;
+    }
+  }
+  TEST_ASSERT_TRUE(checked > 0);
+}
+
+void test_random_events_keep_a_valid_configuration_without_allocating(void)
+{
+  std::vector<uint32_t> dispatchNanos;
+  dispatchNanos.reserve(STATECHART_FUZZ_EVENTS);
+  bool visited[Statechart::numStates + 1] = {};
+  FuzzRandom random = {STATECHART_FUZZ_SEED};
+  unsigned long invalidConfigurations = 0;
+  unsigned long restarts = 0;
+  unsigned long timeEvents = 0;
+
+  unsigned long allocationsBefore = heapAllocations;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < STATECHART_FUZZ_EVENTS; ++i)
+  {
+    uint32_t dice = random.below(100);
+    auto before = std::chrono::steady_clock::now();
+    if (callback->finishedPending)
+    {
+      callback->finishedPending = false;
+      statechart->raiseEvent(statechart_events::finished_process);
+    }
+    else if (dice < 55)
+    {
+      dispatchKey(KEYPAD_KEYS[random.below(sizeof(KEYPAD_KEYS) - 1)]);
+    }
+    else if (dice < 70)
+    {
+      statechart->raiseEvent(statechart_events::step_finished); // Fim de etapa vindo da controlTask
+    }
+    else if (dice < 75)
+    {
+      // Evento qualquer do modelo, inclusive os que nenhuma tecla dispara
+      statechart->raiseEvent((statechart_events::StatechartEventName)(1 + random.below(statechart_events::go_to_menu)));
+    }
+    else
+    {
+      for (uint32_t ticks = 1 + random.below(50); ticks > 0; --ticks)
+      {
+        timeEvents += timerService->tick();
+      }
+    }
+    dispatchNanos.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - before)
+                                .count());
+
+    Statechart::StatechartStates leaf = statechart->getActiveLeafState();
+    if (!statechart->isStateConfigurationValid() || leaf <= Statechart::Statechart_last_state || leaf > Statechart::numStates)
+    {
+      invalidConfigurations++;
+      continue;
+    }
+    visited[leaf] = true;
+    if (leaf == Statechart::main_region_EXIT)
+    {
+      // EXIT é final (desligamento): recomeça como num novo boot
+      statechart->exit();
+      statechart->enter();
+      restarts++;
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  unsigned long allocations = heapAllocations - allocationsBefore;
+
+  std::sort(dispatchNanos.begin(), dispatchNanos.end());
+  unsigned long eventsPerSec = (unsigned long)(STATECHART_FUZZ_EVENTS / seconds);
+  int visitedCount = 0;
+  for (int s = 1; s <= Statechart::numStates; ++s)
+  {
+    visitedCount += visited[s] ? 1 : 0;
+  }
+
+  char report[256];
+  snprintf(report, sizeof(report),
+           "%lu despachos em %.2f s: %lu eventos/s, p50=%lu ns p90=%lu ns p99=%lu ns max=%lu ns",
+           (unsigned long)STATECHART_FUZZ_EVENTS, seconds, eventsPerSec,
+           (unsigned long)percentile(dispatchNanos, 0.50), (unsigned long)percentile(dispatchNanos, 0.90),
+           (unsigned long)percentile(dispatchNanos, 0.99), (unsigned long)dispatchNanos.back());
+  TEST_MESSAGE(report);
+  snprintf(report, sizeof(report),
+           "%lu run cycles, %lu micro-passos, %lu eventos de tempo, %d estados visitados, %lu reinicios, "
+           "%lu configuracoes invalidas, %lu alocacoes, fila: pico %lu, %lu estouros",
+           (unsigned long)statechart->getRunCycleCount(), (unsigned long)statechart->getMicroStepCount(), timeEvents,
+           visitedCount, restarts, invalidConfigurations, allocations,
+           (unsigned long)statechart->getInEventQueueHighWater(), (unsigned long)statechart->getInEventQueueOverflows());
+  TEST_MESSAGE(report);
+
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, invalidConfigurations, "configuracao de estados invalida");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, allocations, "alocacao de heap durante o despacho");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, statechart->getInEventQueueOverflows(), "fila de eventos da statechart estourou");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, timerService->wheel.getOverflowCount(), "timer recusado pela roda");
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(STATECHART_MIN_EVENTS_PER_SEC, eventsPerSec, "vazao abaixo do piso");
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(STATECHART_MAX_P99_NS, percentile(dispatchNanos, 0.99), "p99 acima do teto");
+  // Os estados de processo e as duas saídas por tempo precisam ter sido exercitados
+  TEST_ASSERT_TRUE(visited[Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP]);
+  TEST_ASSERT_TRUE(visited[Statechart::main_region_FINISHED_MESSAGE]);
+  TEST_ASSERT_TRUE(visited[Statechart::main_region_EXIT]);
+  TEST_ASSERT_TRUE(timeEvents > 0);
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_recipe_runs_to_finished_message_and_back_to_idle);
+  RUN_TEST(test_every_bound_key_leaves_its_state);
+  RUN_TEST(test_random_events_keep_a_valid_configuration_without_allocating);
+  return UNITY_END();
+}
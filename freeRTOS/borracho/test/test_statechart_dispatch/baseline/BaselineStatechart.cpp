@@ -1,15 +1,18 @@
 /* Generated by itemis CREATE code generator. */
+/* Saída do itemis CREATE que o sct_tablegen.py substituiu, com a classe renomeada para
+   BaselineStatechart e com a transição STANDARD_PROCESS -menu-> MENU acrescentada à mão (o modelo
+   a ganhou depois): referência do test_statechart_dispatch, fora do firmware. */
 
-#include "Statechart.h"
+#include "BaselineStatechart.h"
 
 /*! \file
-Implementation of the state machine 'Statechart'
+Implementation of the state machine 'BaselineStatechart'
 */
 
 
 
 
-Statechart::Statechart() :
+BaselineStatechart::BaselineStatechart() :
 	menu_raised(false),
 	standard_process_raised(false),
 	heating_raised(false),
@@ -66,7 +69,18 @@ Statechart::Statechart() :
 	go_to_menu_raised(false),
 	timerService(sc_null),
 	ifaceOperationCallback(sc_null),
-	isExecuting(false)
+	isExecuting(false),
+	inEventQueueHead(0),
+	inEventQueueCount(0),
+	inEventQueueHighWater(0),
+	inEventQueueOverflows(0),
+	runCycleCount(0),
+	microStepCount(0)
+#ifdef SC_TRACE_ENABLED
+	, traceClock(sc_null),
+	traceHook(sc_null),
+	traceContext(sc_null)
+#endif
 {
 	for (sc_ushort state_vec_pos = 0; state_vec_pos < maxOrthogonalStates; ++state_vec_pos)
 		stateConfVector[state_vec_pos] = Statechart_last_state;
@@ -74,36 +88,59 @@ Statechart::Statechart() :
 	clearInEvents();
 }
 
-Statechart::~Statechart()
+BaselineStatechart::~BaselineStatechart()
 {
-	while (!inEventQueue.empty()) {
-		statechart_events::SctEvent* nextEvent = inEventQueue.front();
-		inEventQueue.pop_front();
-		delete nextEvent;
-	}
 }
 
 
 using namespace statechart_events;
 
-SctEvent* Statechart::getNextEvent()
+/*
+ * Fixed-capacity ring buffer for incoming events. Events are stored by value
+ * as 8-byte SctEvent records, so raising an event never touches the heap.
+ * When the queue is full the new event is dropped and counted as overflow.
+ */
+sc_boolean BaselineStatechart::pushInEvent(StatechartEventName name, uint16_t flags, sc_integer value)
 {
-	SctEvent* nextEvent = 0;
-	
-	if(!inEventQueue.empty()) {
-		nextEvent = inEventQueue.front();
-		inEventQueue.pop_front();
+	if (inEventQueueCount >= inEventQueueCapacity) {
+		++inEventQueueOverflows;
+		return false;
 	}
-	
-	return nextEvent;
+	sc_ushort tail = (sc_ushort)((inEventQueueHead + inEventQueueCount) % inEventQueueCapacity);
+	inEventQueue[tail].name = (uint16_t)name;
+	inEventQueue[tail].flags = flags;
+	inEventQueue[tail].value = value;
+	++inEventQueueCount;
+	if (inEventQueueCount > inEventQueueHighWater) {
+		inEventQueueHighWater = inEventQueueCount;
+	}
+	return true;
 }
 
-sc_boolean Statechart::dispatch_event(SctEvent * event)
+sc_boolean BaselineStatechart::getNextEvent(SctEvent & event)
 {
-	if(event == 0) {
+	if (inEventQueueCount == 0) {
 		return false;
 	}
-	switch(event->name)
+	event = inEventQueue[inEventQueueHead];
+	inEventQueueHead = (sc_ushort)((inEventQueueHead + 1) % inEventQueueCapacity);
+	--inEventQueueCount;
+	return true;
+}
+
+sc_integer BaselineStatechart::getInEventQueueOverflows() const
+{
+	return inEventQueueOverflows;
+}
+
+sc_integer BaselineStatechart::getInEventQueueHighWater() const
+{
+	return inEventQueueHighWater;
+}
+
+sc_boolean BaselineStatechart::dispatch_event(const SctEvent & event)
+{
+	switch(event.name)
 	{
 		case menu:
 		case standard_process:
@@ -149,34 +186,29 @@ sc_boolean Statechart::dispatch_event(SctEvent * event)
 		}
 		case Statechart_main_region_INIT_SYSTEM_time_event_0:
 		{
-			delete event;
 			return timeEvents[0] = true;
 		}
 		case Statechart_main_region_FINISHED_MESSAGE_time_event_0:
 		{
-			delete event;
 			return timeEvents[1] = true;
 		}
 		default:
-			delete event;
 			return false;
 	}
 }
 
-sc_boolean Statechart::internal_dispatch_event(SctEvent * event)
+sc_boolean BaselineStatechart::internal_dispatch_event(const SctEvent & event)
 {
-	switch(event->name)
+	switch(event.name)
 	{
 		default:
-			delete event;
 			return false;
 	}
-	delete event;
 	return true;
 }
-sc_boolean Statechart::iface_dispatch_event(SctEvent * event)
+sc_boolean BaselineStatechart::iface_dispatch_event(const SctEvent & event)
 {
-	switch(event->name)
+	switch(event.name)
 	{
 		case menu:
 		{
@@ -374,14 +406,12 @@ sc_boolean Statechart::iface_dispatch_event(SctEvent * event)
 			break;
 		}
 		default:
-			delete event;
 			return false;
 	}
-	delete event;
 	return true;
 }
 
-StatechartEventName Statechart::getTimedEventName(sc_eventid evid)
+StatechartEventName BaselineStatechart::getTimedEventName(sc_eventid evid)
 {
 	if (evid == (sc_eventid)(&timeEvents[0])) {
 		return Statechart_main_region_INIT_SYSTEM_time_event_0;
@@ -394,7 +424,7 @@ StatechartEventName Statechart::getTimedEventName(sc_eventid evid)
 
 
 
-sc_boolean Statechart::isActive() const
+sc_boolean BaselineStatechart::isActive() const
 {
 	return stateConfVector[0] != Statechart_last_state;
 }
@@ -402,12 +432,12 @@ sc_boolean Statechart::isActive() const
 /* 
  * Always returns 'false' since this state machine can never become final.
  */
-sc_boolean Statechart::isFinal() const
+sc_boolean BaselineStatechart::isFinal() const
 {
 	   return false;
 }
 
-sc_boolean Statechart::check(){
+sc_boolean BaselineStatechart::check(){
 	if(timerService == sc_null) {
 		return false;
 	}
@@ -418,31 +448,31 @@ sc_boolean Statechart::check(){
 }
 
 
-void Statechart::setTimerService(sc::timer::TimerServiceInterface* timerService_)
+void BaselineStatechart::setTimerService(sc::timer::TimerServiceInterface* timerService_)
 {
 	this->timerService = timerService_;
 }
 
-sc::timer::TimerServiceInterface* Statechart::getTimerService()
+sc::timer::TimerServiceInterface* BaselineStatechart::getTimerService()
 {
 	return timerService;
 }
 
-sc_integer Statechart::getNumberOfParallelTimeEvents() {
+sc_integer BaselineStatechart::getNumberOfParallelTimeEvents() {
 	return parallelTimeEventsCount;
 }
 
-void Statechart::raiseTimeEvent(sc_eventid evid)
+void BaselineStatechart::raiseTimeEvent(sc_eventid evid)
 {
 	if ((evid >= (sc_eventid)timeEvents) && (evid < (sc_eventid)(&timeEvents[timeEventsCount])))
 	{
-		inEventQueue.push_back(new TimedSctEvent(getTimedEventName(evid)));
+		pushInEvent(getTimedEventName(evid), SCT_EVENT_FLAG_TIME);
 		runCycle();
 	}
 }
 
 
-sc_boolean Statechart::isStateActive(StatechartStates state) const
+sc_boolean BaselineStatechart::isStateActive(StatechartStates state) const
 {
 	switch (state)
 	{
@@ -555,554 +585,615 @@ sc_boolean Statechart::isStateActive(StatechartStates state) const
 	}
 }
 
+BaselineStatechart::StatechartStates BaselineStatechart::getActiveLeafState() const
+{
+	return stateConfVector[0];
+}
+
+#ifdef SC_TRACE_ENABLED
+void BaselineStatechart::setTraceHook(TraceClock clock, TraceHook hook, void * context)
+{
+	traceClock = clock;
+	traceHook = hook;
+	traceContext = context;
+}
+
+void BaselineStatechart::traceStep(uint16_t event, StatechartStates source, uint32_t startMicros)
+{
+	const StatechartStates target = stateConfVector[0];
+	if (traceHook == sc_null || (event == invalid_event && target == source))
+	{
+		return;
+	}
+	TraceRecord record;
+	record.startMicros = startMicros;
+	record.endMicros = traceClock ? traceClock() : 0;
+	record.event = event;
+	record.source = (uint8_t)source;
+	record.target = (uint8_t)target;
+	traceHook(traceContext, record);
+}
+#endif
+
 /* Functions for event menu in interface  */
-void Statechart::raiseMenu()
+void BaselineStatechart::raiseMenu()
 {
-	inEventQueue.push_back(new SctEvent__menu(menu));
+	pushInEvent(menu);
         runCycle();
 }
-void Statechart::internal_raiseMenu()
+void BaselineStatechart::internal_raiseMenu()
 {
 	menu_raised = true;
 }
 /* Functions for event standard_process in interface  */
-void Statechart::raiseStandard_process()
+void BaselineStatechart::raiseStandard_process()
 {
-	inEventQueue.push_back(new SctEvent__standard_process(standard_process));
+	pushInEvent(standard_process);
         runCycle();
 }
-void Statechart::internal_raiseStandard_process()
+void BaselineStatechart::internal_raiseStandard_process()
 {
 	standard_process_raised = true;
 }
 /* Functions for event heating in interface  */
-void Statechart::raiseHeating()
+void BaselineStatechart::raiseHeating()
 {
-	inEventQueue.push_back(new SctEvent__heating(heating));
+	pushInEvent(heating);
         runCycle();
 }
-void Statechart::internal_raiseHeating()
+void BaselineStatechart::internal_raiseHeating()
 {
 	heating_raised = true;
 }
 /* Functions for event resting in interface  */
-void Statechart::raiseResting()
+void BaselineStatechart::raiseResting()
 {
-	inEventQueue.push_back(new SctEvent__resting(resting));
+	pushInEvent(resting);
         runCycle();
 }
-void Statechart::internal_raiseResting()
+void BaselineStatechart::internal_raiseResting()
 {
 	resting_raised = true;
 }
 /* Functions for event heating_2 in interface  */
-void Statechart::raiseHeating_2()
+void BaselineStatechart::raiseHeating_2()
 {
-	inEventQueue.push_back(new SctEvent__heating_2(heating_2));
+	pushInEvent(heating_2);
         runCycle();
 }
-void Statechart::internal_raiseHeating_2()
+void BaselineStatechart::internal_raiseHeating_2()
 {
 	heating_2_raised = true;
 }
 /* Functions for event resting_2 in interface  */
-void Statechart::raiseResting_2()
+void BaselineStatechart::raiseResting_2()
 {
-	inEventQueue.push_back(new SctEvent__resting_2(resting_2));
+	pushInEvent(resting_2);
         runCycle();
 }
-void Statechart::internal_raiseResting_2()
+void BaselineStatechart::internal_raiseResting_2()
 {
 	resting_2_raised = true;
 }
 /* Functions for event idle in interface  */
-void Statechart::raiseIdle()
+void BaselineStatechart::raiseIdle()
 {
-	inEventQueue.push_back(new SctEvent__idle(idle));
+	pushInEvent(idle);
         runCycle();
 }
-void Statechart::internal_raiseIdle()
+void BaselineStatechart::internal_raiseIdle()
 {
 	idle_raised = true;
 }
 /* Functions for event custom_setup in interface  */
-void Statechart::raiseCustom_setup()
+void BaselineStatechart::raiseCustom_setup()
 {
-	inEventQueue.push_back(new SctEvent__custom_setup(custom_setup));
+	pushInEvent(custom_setup);
         runCycle();
 }
-void Statechart::internal_raiseCustom_setup()
+void BaselineStatechart::internal_raiseCustom_setup()
 {
 	custom_setup_raised = true;
 }
 /* Functions for event set_temperature in interface  */
-void Statechart::raiseSet_temperature()
+void BaselineStatechart::raiseSet_temperature()
 {
-	inEventQueue.push_back(new SctEvent__set_temperature(set_temperature));
+	pushInEvent(set_temperature);
         runCycle();
 }
-void Statechart::internal_raiseSet_temperature()
+void BaselineStatechart::internal_raiseSet_temperature()
 {
 	set_temperature_raised = true;
 }
 /* Functions for event set_time in interface  */
-void Statechart::raiseSet_time()
+void BaselineStatechart::raiseSet_time()
 {
-	inEventQueue.push_back(new SctEvent__set_time(set_time));
+	pushInEvent(set_time);
         runCycle();
 }
-void Statechart::internal_raiseSet_time()
+void BaselineStatechart::internal_raiseSet_time()
 {
 	set_time_raised = true;
 }
 /* Functions for event set_temperature_2 in interface  */
-void Statechart::raiseSet_temperature_2()
+void BaselineStatechart::raiseSet_temperature_2()
 {
-	inEventQueue.push_back(new SctEvent__set_temperature_2(set_temperature_2));
+	pushInEvent(set_temperature_2);
         runCycle();
 }
-void Statechart::internal_raiseSet_temperature_2()
+void BaselineStatechart::internal_raiseSet_temperature_2()
 {
 	set_temperature_2_raised = true;
 }
 /* Functions for event set_time_2 in interface  */
-void Statechart::raiseSet_time_2()
+void BaselineStatechart::raiseSet_time_2()
 {
-	inEventQueue.push_back(new SctEvent__set_time_2(set_time_2));
+	pushInEvent(set_time_2);
         runCycle();
 }
-void Statechart::internal_raiseSet_time_2()
+void BaselineStatechart::internal_raiseSet_time_2()
 {
 	set_time_2_raised = true;
 }
 /* Functions for event add_step in interface  */
-void Statechart::raiseAdd_step()
+void BaselineStatechart::raiseAdd_step()
 {
-	inEventQueue.push_back(new SctEvent__add_step(add_step));
+	pushInEvent(add_step);
         runCycle();
 }
-void Statechart::internal_raiseAdd_step()
+void BaselineStatechart::internal_raiseAdd_step()
 {
 	add_step_raised = true;
 }
 /* Functions for event standard_process_custom in interface  */
-void Statechart::raiseStandard_process_custom()
+void BaselineStatechart::raiseStandard_process_custom()
 {
-	inEventQueue.push_back(new SctEvent__standard_process_custom(standard_process_custom));
+	pushInEvent(standard_process_custom);
         runCycle();
 }
-void Statechart::internal_raiseStandard_process_custom()
+void BaselineStatechart::internal_raiseStandard_process_custom()
 {
 	standard_process_custom_raised = true;
 }
 /* Functions for event finish_process in interface  */
-void Statechart::raiseFinish_process()
+void BaselineStatechart::raiseFinish_process()
 {
-	inEventQueue.push_back(new SctEvent__finish_process(finish_process));
+	pushInEvent(finish_process);
         runCycle();
 }
-void Statechart::internal_raiseFinish_process()
+void BaselineStatechart::internal_raiseFinish_process()
 {
 	finish_process_raised = true;
 }
 /* Functions for event finish_process_idle in interface  */
-void Statechart::raiseFinish_process_idle()
+void BaselineStatechart::raiseFinish_process_idle()
 {
-	inEventQueue.push_back(new SctEvent__finish_process_idle(finish_process_idle));
+	pushInEvent(finish_process_idle);
         runCycle();
 }
-void Statechart::internal_raiseFinish_process_idle()
+void BaselineStatechart::internal_raiseFinish_process_idle()
 {
 	finish_process_idle_raised = true;
 }
 /* Functions for event start_button in interface  */
-void Statechart::raiseStart_button()
+void BaselineStatechart::raiseStart_button()
 {
-	inEventQueue.push_back(new SctEvent__start_button(start_button));
+	pushInEvent(start_button);
         runCycle();
 }
-void Statechart::internal_raiseStart_button()
+void BaselineStatechart::internal_raiseStart_button()
 {
 	start_button_raised = true;
 }
 /* Functions for event exit_process in interface  */
-void Statechart::raiseExit_process()
+void BaselineStatechart::raiseExit_process()
 {
-	inEventQueue.push_back(new SctEvent__exit_process(exit_process));
+	pushInEvent(exit_process);
         runCycle();
 }
-void Statechart::internal_raiseExit_process()
+void BaselineStatechart::internal_raiseExit_process()
 {
 	exit_process_raised = true;
 }
 /* Functions for event recipe_1 in interface  */
-void Statechart::raiseRecipe_1()
+void BaselineStatechart::raiseRecipe_1()
 {
-	inEventQueue.push_back(new SctEvent__recipe_1(recipe_1));
+	pushInEvent(recipe_1);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_1()
+void BaselineStatechart::internal_raiseRecipe_1()
 {
 	recipe_1_raised = true;
 }
 /* Functions for event recipe_2 in interface  */
-void Statechart::raiseRecipe_2()
+void BaselineStatechart::raiseRecipe_2()
 {
-	inEventQueue.push_back(new SctEvent__recipe_2(recipe_2));
+	pushInEvent(recipe_2);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_2()
+void BaselineStatechart::internal_raiseRecipe_2()
 {
 	recipe_2_raised = true;
 }
 /* Functions for event recipe_3 in interface  */
-void Statechart::raiseRecipe_3()
+void BaselineStatechart::raiseRecipe_3()
 {
-	inEventQueue.push_back(new SctEvent__recipe_3(recipe_3));
+	pushInEvent(recipe_3);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_3()
+void BaselineStatechart::internal_raiseRecipe_3()
 {
 	recipe_3_raised = true;
 }
 /* Functions for event recipe_4 in interface  */
-void Statechart::raiseRecipe_4()
+void BaselineStatechart::raiseRecipe_4()
 {
-	inEventQueue.push_back(new SctEvent__recipe_4(recipe_4));
+	pushInEvent(recipe_4);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_4()
+void BaselineStatechart::internal_raiseRecipe_4()
 {
 	recipe_4_raised = true;
 }
 /* Functions for event recipe_5 in interface  */
-void Statechart::raiseRecipe_5()
+void BaselineStatechart::raiseRecipe_5()
 {
-	inEventQueue.push_back(new SctEvent__recipe_5(recipe_5));
+	pushInEvent(recipe_5);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_5()
+void BaselineStatechart::internal_raiseRecipe_5()
 {
 	recipe_5_raised = true;
 }
 /* Functions for event recipe_back_menu in interface  */
-void Statechart::raiseRecipe_back_menu()
+void BaselineStatechart::raiseRecipe_back_menu()
 {
-	inEventQueue.push_back(new SctEvent__recipe_back_menu(recipe_back_menu));
+	pushInEvent(recipe_back_menu);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_back_menu()
+void BaselineStatechart::internal_raiseRecipe_back_menu()
 {
 	recipe_back_menu_raised = true;
 }
 /* Functions for event recipe_1_process in interface  */
-void Statechart::raiseRecipe_1_process()
+void BaselineStatechart::raiseRecipe_1_process()
 {
-	inEventQueue.push_back(new SctEvent__recipe_1_process(recipe_1_process));
+	pushInEvent(recipe_1_process);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_1_process()
+void BaselineStatechart::internal_raiseRecipe_1_process()
 {
 	recipe_1_process_raised = true;
 }
 /* Functions for event recipe_2_process in interface  */
-void Statechart::raiseRecipe_2_process()
+void BaselineStatechart::raiseRecipe_2_process()
 {
-	inEventQueue.push_back(new SctEvent__recipe_2_process(recipe_2_process));
+	pushInEvent(recipe_2_process);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_2_process()
+void BaselineStatechart::internal_raiseRecipe_2_process()
 {
 	recipe_2_process_raised = true;
 }
 /* Functions for event recipe_3_process in interface  */
-void Statechart::raiseRecipe_3_process()
+void BaselineStatechart::raiseRecipe_3_process()
 {
-	inEventQueue.push_back(new SctEvent__recipe_3_process(recipe_3_process));
+	pushInEvent(recipe_3_process);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_3_process()
+void BaselineStatechart::internal_raiseRecipe_3_process()
 {
 	recipe_3_process_raised = true;
 }
 /* Functions for event recipe_4_process in interface  */
-void Statechart::raiseRecipe_4_process()
+void BaselineStatechart::raiseRecipe_4_process()
 {
-	inEventQueue.push_back(new SctEvent__recipe_4_process(recipe_4_process));
+	pushInEvent(recipe_4_process);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_4_process()
+void BaselineStatechart::internal_raiseRecipe_4_process()
 {
 	recipe_4_process_raised = true;
 }
 /* Functions for event recipe_5_process in interface  */
-void Statechart::raiseRecipe_5_process()
+void BaselineStatechart::raiseRecipe_5_process()
 {
-	inEventQueue.push_back(new SctEvent__recipe_5_process(recipe_5_process));
+	pushInEvent(recipe_5_process);
         runCycle();
 }
-void Statechart::internal_raiseRecipe_5_process()
+void BaselineStatechart::internal_raiseRecipe_5_process()
 {
 	recipe_5_process_raised = true;
 }
 /* Functions for event start_first_step in interface  */
-void Statechart::raiseStart_first_step()
+void BaselineStatechart::raiseStart_first_step()
 {
-	inEventQueue.push_back(new SctEvent__start_first_step(start_first_step));
+	pushInEvent(start_first_step);
         runCycle();
 }
-void Statechart::internal_raiseStart_first_step()
+void BaselineStatechart::internal_raiseStart_first_step()
 {
 	start_first_step_raised = true;
 }
 /* Functions for event step_finished in interface  */
-void Statechart::raiseStep_finished()
+void BaselineStatechart::raiseStep_finished()
 {
-	inEventQueue.push_back(new SctEvent__step_finished(step_finished));
+	pushInEvent(step_finished);
         runCycle();
 }
-void Statechart::internal_raiseStep_finished()
+void BaselineStatechart::internal_raiseStep_finished()
 {
 	step_finished_raised = true;
 }
 /* Functions for event finished_process in interface  */
-void Statechart::raiseFinished_process()
+void BaselineStatechart::raiseFinished_process()
 {
-	inEventQueue.push_back(new SctEvent__finished_process(finished_process));
+	pushInEvent(finished_process);
         runCycle();
 }
-void Statechart::internal_raiseFinished_process()
+void BaselineStatechart::internal_raiseFinished_process()
 {
 	finished_process_raised = true;
 }
 /* Functions for event keypad_input_confirm in interface  */
-void Statechart::raiseKeypad_input_confirm()
+void BaselineStatechart::raiseKeypad_input_confirm()
 {
-	inEventQueue.push_back(new SctEvent__keypad_input_confirm(keypad_input_confirm));
+	pushInEvent(keypad_input_confirm);
         runCycle();
 }
-void Statechart::internal_raiseKeypad_input_confirm()
+void BaselineStatechart::internal_raiseKeypad_input_confirm()
 {
 	keypad_input_confirm_raised = true;
 }
 /* Functions for event keypad_input_cancel in interface  */
-void Statechart::raiseKeypad_input_cancel()
+void BaselineStatechart::raiseKeypad_input_cancel()
 {
-	inEventQueue.push_back(new SctEvent__keypad_input_cancel(keypad_input_cancel));
+	pushInEvent(keypad_input_cancel);
         runCycle();
 }
-void Statechart::internal_raiseKeypad_input_cancel()
+void BaselineStatechart::internal_raiseKeypad_input_cancel()
 {
 	keypad_input_cancel_raised = true;
 }
 /* Functions for event go_to_loop in interface  */
-void Statechart::raiseGo_to_loop()
+void BaselineStatechart::raiseGo_to_loop()
 {
-	inEventQueue.push_back(new SctEvent__go_to_loop(go_to_loop));
+	pushInEvent(go_to_loop);
         runCycle();
 }
-void Statechart::internal_raiseGo_to_loop()
+void BaselineStatechart::internal_raiseGo_to_loop()
 {
 	go_to_loop_raised = true;
 }
 /* Functions for event temp_finished in interface  */
-void Statechart::raiseTemp_finished()
+void BaselineStatechart::raiseTemp_finished()
 {
-	inEventQueue.push_back(new SctEvent__temp_finished(temp_finished));
+	pushInEvent(temp_finished);
         runCycle();
 }
-void Statechart::internal_raiseTemp_finished()
+void BaselineStatechart::internal_raiseTemp_finished()
 {
 	temp_finished_raised = true;
 }
 /* Functions for event loop_finished in interface  */
-void Statechart::raiseLoop_finished()
+void BaselineStatechart::raiseLoop_finished()
 {
-	inEventQueue.push_back(new SctEvent__loop_finished(loop_finished));
+	pushInEvent(loop_finished);
         runCycle();
 }
-void Statechart::internal_raiseLoop_finished()
+void BaselineStatechart::internal_raiseLoop_finished()
 {
 	loop_finished_raised = true;
 }
 /* Functions for event start_recipe_custom in interface  */
-void Statechart::raiseStart_recipe_custom()
+void BaselineStatechart::raiseStart_recipe_custom()
 {
-	inEventQueue.push_back(new SctEvent__start_recipe_custom(start_recipe_custom));
+	pushInEvent(start_recipe_custom);
         runCycle();
 }
-void Statechart::internal_raiseStart_recipe_custom()
+void BaselineStatechart::internal_raiseStart_recipe_custom()
 {
 	start_recipe_custom_raised = true;
 }
 /* Functions for event go_to_menu in interface  */
-void Statechart::raiseGo_to_menu()
+void BaselineStatechart::raiseGo_to_menu()
 {
-	inEventQueue.push_back(new SctEvent__go_to_menu(go_to_menu));
+	pushInEvent(go_to_menu);
         runCycle();
 }
-void Statechart::internal_raiseGo_to_menu()
+void BaselineStatechart::internal_raiseGo_to_menu()
 {
 	go_to_menu_raised = true;
 }
-sc_integer Statechart::getOutput() const
+/* Generic raise for in events, used by clients that carry events by id. */
+void BaselineStatechart::raiseEvent(StatechartEventName name)
+{
+	if (name <= invalid_event || name > go_to_menu) {
+		return;
+	}
+	pushInEvent(name);
+	runCycle();
+}
+
+/* Batched raise: all events are queued before a single run cycle processes them in order. */
+void BaselineStatechart::raiseEvents(const StatechartEventName * names, sc_integer count)
+{
+	for (sc_integer i = 0; i < count; ++i) {
+		if (names[i] > invalid_event && names[i] <= go_to_menu) {
+			pushInEvent(names[i]);
+		}
+	}
+	runCycle();
+}
+
+sc_integer BaselineStatechart::getRunCycleCount() const
+{
+	return runCycleCount;
+}
+
+sc_integer BaselineStatechart::getMicroStepCount() const
+{
+	return microStepCount;
+}
+
+sc_integer BaselineStatechart::getOutput() const
 {
 	return output
 	;
 }
 
-void Statechart::setOutput(sc_integer output_)
+void BaselineStatechart::setOutput(sc_integer output_)
 {
 	this->output = output_;
 }
-sc_integer Statechart::getDelay() const
+sc_integer BaselineStatechart::getDelay() const
 {
 	return delay
 	;
 }
 
-void Statechart::setDelay(sc_integer delay_)
+void BaselineStatechart::setDelay(sc_integer delay_)
 {
 	this->delay = delay_;
 }
-sc_integer Statechart::getLow() const
+sc_integer BaselineStatechart::getLow() const
 {
 	return low
 	;
 }
 
-void Statechart::setLow(sc_integer low_)
+void BaselineStatechart::setLow(sc_integer low_)
 {
 	this->low = low_;
 }
-sc_integer Statechart::getHigh() const
+sc_integer BaselineStatechart::getHigh() const
 {
 	return high
 	;
 }
 
-void Statechart::setHigh(sc_integer high_)
+void BaselineStatechart::setHigh(sc_integer high_)
 {
 	this->high = high_;
 }
-sc_integer Statechart::getLed_pin() const
+sc_integer BaselineStatechart::getLed_pin() const
 {
 	return led_pin
 	;
 }
 
-void Statechart::setLed_pin(sc_integer led_pin_)
+void BaselineStatechart::setLed_pin(sc_integer led_pin_)
 {
 	this->led_pin = led_pin_;
 }
-sc_integer Statechart::getWater_sensor_pin() const
+sc_integer BaselineStatechart::getWater_sensor_pin() const
 {
 	return water_sensor_pin
 	;
 }
 
-void Statechart::setWater_sensor_pin(sc_integer water_sensor_pin_)
+void BaselineStatechart::setWater_sensor_pin(sc_integer water_sensor_pin_)
 {
 	this->water_sensor_pin = water_sensor_pin_;
 }
-sc_integer Statechart::getSemaphore_red_pin() const
+sc_integer BaselineStatechart::getSemaphore_red_pin() const
 {
 	return semaphore_red_pin
 	;
 }
 
-void Statechart::setSemaphore_red_pin(sc_integer semaphore_red_pin_)
+void BaselineStatechart::setSemaphore_red_pin(sc_integer semaphore_red_pin_)
 {
 	this->semaphore_red_pin = semaphore_red_pin_;
 }
-sc_integer Statechart::getSemaphore_yellow_pin() const
+sc_integer BaselineStatechart::getSemaphore_yellow_pin() const
 {
 	return semaphore_yellow_pin
 	;
 }
 
-void Statechart::setSemaphore_yellow_pin(sc_integer semaphore_yellow_pin_)
+void BaselineStatechart::setSemaphore_yellow_pin(sc_integer semaphore_yellow_pin_)
 {
 	this->semaphore_yellow_pin = semaphore_yellow_pin_;
 }
-sc_integer Statechart::getSemaphore_green_pin() const
+sc_integer BaselineStatechart::getSemaphore_green_pin() const
 {
 	return semaphore_green_pin
 	;
 }
 
-void Statechart::setSemaphore_green_pin(sc_integer semaphore_green_pin_)
+void BaselineStatechart::setSemaphore_green_pin(sc_integer semaphore_green_pin_)
 {
 	this->semaphore_green_pin = semaphore_green_pin_;
 }
-sc_integer Statechart::getHeater_pwm_pin() const
+sc_integer BaselineStatechart::getHeater_pwm_pin() const
 {
 	return heater_pwm_pin
 	;
 }
 
-void Statechart::setHeater_pwm_pin(sc_integer heater_pwm_pin_)
+void BaselineStatechart::setHeater_pwm_pin(sc_integer heater_pwm_pin_)
 {
 	this->heater_pwm_pin = heater_pwm_pin_;
 }
-sc_integer Statechart::getPwm_frequency() const
+sc_integer BaselineStatechart::getPwm_frequency() const
 {
 	return pwm_frequency
 	;
 }
 
-void Statechart::setPwm_frequency(sc_integer pwm_frequency_)
+void BaselineStatechart::setPwm_frequency(sc_integer pwm_frequency_)
 {
 	this->pwm_frequency = pwm_frequency_;
 }
-sc_integer Statechart::getPwm_resolution_bits() const
+sc_integer BaselineStatechart::getPwm_resolution_bits() const
 {
 	return pwm_resolution_bits
 	;
 }
 
-void Statechart::setPwm_resolution_bits(sc_integer pwm_resolution_bits_)
+void BaselineStatechart::setPwm_resolution_bits(sc_integer pwm_resolution_bits_)
 {
 	this->pwm_resolution_bits = pwm_resolution_bits_;
 }
-sc_integer Statechart::getCustom_num_steps() const
+sc_integer BaselineStatechart::getCustom_num_steps() const
 {
 	return custom_num_steps
 	;
 }
 
-void Statechart::setCustom_num_steps(sc_integer custom_num_steps_)
+void BaselineStatechart::setCustom_num_steps(sc_integer custom_num_steps_)
 {
 	this->custom_num_steps = custom_num_steps_;
 }
-sc_integer Statechart::getCurrent_custom_step_idx() const
+sc_integer BaselineStatechart::getCurrent_custom_step_idx() const
 {
 	return current_custom_step_idx
 	;
 }
 
-void Statechart::setCurrent_custom_step_idx(sc_integer current_custom_step_idx_)
+void BaselineStatechart::setCurrent_custom_step_idx(sc_integer current_custom_step_idx_)
 {
 	this->current_custom_step_idx = current_custom_step_idx_;
 }
-sc_integer Statechart::getReceived_value() const
+sc_integer BaselineStatechart::getReceived_value() const
 {
 	return received_value
 	;
 }
 
-void Statechart::setReceived_value(sc_integer received_value_)
+void BaselineStatechart::setReceived_value(sc_integer received_value_)
 {
 	this->received_value = received_value_;
 }
-void Statechart::setOperationCallback(OperationCallback* operationCallback)
+void BaselineStatechart::setOperationCallback(OperationCallback* operationCallback)
 {
 	ifaceOperationCallback = operationCallback;
 }
 
 // implementations of all internal functions
 /* Entry action for state 'IDLE'. */
-void Statechart::enact_main_region_IDLE()
+void BaselineStatechart::enact_main_region_IDLE()
 {
 	/* Entry action for state 'IDLE'. */
 	ifaceOperationCallback->beginDisplay();
@@ -1117,7 +1208,7 @@ void Statechart::enact_main_region_IDLE()
 }
 
 /* Entry action for state 'MENU'. */
-void Statechart::enact_main_region_MENU()
+void BaselineStatechart::enact_main_region_MENU()
 {
 	/* Entry action for state 'MENU'. */
 	ifaceOperationCallback->showRecipes();
@@ -1125,14 +1216,14 @@ void Statechart::enact_main_region_MENU()
 }
 
 /* Entry action for state 'EXIT'. */
-void Statechart::enact_main_region_EXIT()
+void BaselineStatechart::enact_main_region_EXIT()
 {
 	/* Entry action for state 'EXIT'. */
 	ifaceOperationCallback->shutdownSystem();
 }
 
 /* Entry action for state 'STANDARD_PROCESS'. */
-void Statechart::enact_main_region_STANDARD_PROCESS()
+void BaselineStatechart::enact_main_region_STANDARD_PROCESS()
 {
 	/* Entry action for state 'STANDARD_PROCESS'. */
 	ifaceOperationCallback->digitalWrite(semaphore_yellow_pin, high);
@@ -1141,63 +1232,63 @@ void Statechart::enact_main_region_STANDARD_PROCESS()
 }
 
 /* Entry action for state 'START_PROCESS'. */
-void Statechart::enact_main_region_STANDARD_PROCESS_standard_process_START_PROCESS()
+void BaselineStatechart::enact_main_region_STANDARD_PROCESS_standard_process_START_PROCESS()
 {
 	/* Entry action for state 'START_PROCESS'. */
 	ifaceOperationCallback->initializeProcess();
 }
 
 /* Entry action for state 'FINISH_PROCESS'. */
-void Statechart::enact_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS()
+void BaselineStatechart::enact_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS()
 {
 	/* Entry action for state 'FINISH_PROCESS'. */
 	ifaceOperationCallback->showFinished();
 }
 
 /* Entry action for state 'CONTROL_PROCESS_LOOP'. */
-void Statechart::enact_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP()
+void BaselineStatechart::enact_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP()
 {
 	/* Entry action for state 'CONTROL_PROCESS_LOOP'. */
 	ifaceOperationCallback->startNextRecipeStep(ifaceOperationCallback->getCurrentRecipeIndex());
 }
 
 /* Entry action for state 'CUSTOM_SETUP_COMPLETE'. */
-void Statechart::enact_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE()
+void BaselineStatechart::enact_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE()
 {
 	/* Entry action for state 'CUSTOM_SETUP_COMPLETE'. */
 	ifaceOperationCallback->showCustomSetup_Summary();
 }
 
 /* Entry action for state 'NUM_STEPS'. */
-void Statechart::enact_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS()
+void BaselineStatechart::enact_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS()
 {
 	/* Entry action for state 'NUM_STEPS'. */
 	ifaceOperationCallback->showCustomSetup_GetNumSteps();
 }
 
 /* Entry action for state 'LOOP_TEMP_TIME_STEPS'. */
-void Statechart::enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS()
+void BaselineStatechart::enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS()
 {
 	/* Entry action for state 'LOOP_TEMP_TIME_STEPS'. */
 	ifaceOperationCallback->initializeStepDataCollection();
 }
 
 /* Entry action for state 'TEMP'. */
-void Statechart::enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP()
+void BaselineStatechart::enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP()
 {
 	/* Entry action for state 'TEMP'. */
 	ifaceOperationCallback->showCustomSetup_PromptTemp(current_custom_step_idx);
 }
 
 /* Entry action for state 'TIME'. */
-void Statechart::enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME()
+void BaselineStatechart::enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME()
 {
 	/* Entry action for state 'TIME'. */
 	ifaceOperationCallback->showCustomSetup_PromptTime(current_custom_step_idx);
 }
 
 /* Entry action for state 'INIT_SYSTEM'. */
-void Statechart::enact_main_region_INIT_SYSTEM()
+void BaselineStatechart::enact_main_region_INIT_SYSTEM()
 {
 	/* Entry action for state 'INIT_SYSTEM'. */
 	timerService->setTimer(this, (sc_eventid)(&timeEvents[0]), (((sc_time) 5) * 1000), false);
@@ -1208,42 +1299,42 @@ void Statechart::enact_main_region_INIT_SYSTEM()
 }
 
 /* Entry action for state 'RECIPE_1'. */
-void Statechart::enact_main_region_RECIPE_1()
+void BaselineStatechart::enact_main_region_RECIPE_1()
 {
 	/* Entry action for state 'RECIPE_1'. */
 	ifaceOperationCallback->showRecipe(1);
 }
 
 /* Entry action for state 'RECIPE_2'. */
-void Statechart::enact_main_region_RECIPE_2()
+void BaselineStatechart::enact_main_region_RECIPE_2()
 {
 	/* Entry action for state 'RECIPE_2'. */
 	ifaceOperationCallback->showRecipe(2);
 }
 
 /* Entry action for state 'RECIPE_3'. */
-void Statechart::enact_main_region_RECIPE_3()
+void BaselineStatechart::enact_main_region_RECIPE_3()
 {
 	/* Entry action for state 'RECIPE_3'. */
 	ifaceOperationCallback->showRecipe(3);
 }
 
 /* Entry action for state 'RECIPE_4'. */
-void Statechart::enact_main_region_RECIPE_4()
+void BaselineStatechart::enact_main_region_RECIPE_4()
 {
 	/* Entry action for state 'RECIPE_4'. */
 	ifaceOperationCallback->showRecipe(4);
 }
 
 /* Entry action for state 'RECIPE_5'. */
-void Statechart::enact_main_region_RECIPE_5()
+void BaselineStatechart::enact_main_region_RECIPE_5()
 {
 	/* Entry action for state 'RECIPE_5'. */
 	ifaceOperationCallback->showRecipe(5);
 }
 
 /* Entry action for state 'FINISHED_MESSAGE'. */
-void Statechart::enact_main_region_FINISHED_MESSAGE()
+void BaselineStatechart::enact_main_region_FINISHED_MESSAGE()
 {
 	/* Entry action for state 'FINISHED_MESSAGE'. */
 	timerService->setTimer(this, (sc_eventid)(&timeEvents[1]), (((sc_time) 5) * 1000), false);
@@ -1251,21 +1342,21 @@ void Statechart::enact_main_region_FINISHED_MESSAGE()
 }
 
 /* Exit action for state 'INIT_SYSTEM'. */
-void Statechart::exact_main_region_INIT_SYSTEM()
+void BaselineStatechart::exact_main_region_INIT_SYSTEM()
 {
 	/* Exit action for state 'INIT_SYSTEM'. */
 	timerService->unsetTimer(this, (sc_eventid)(&timeEvents[0]));
 }
 
 /* Exit action for state 'FINISHED_MESSAGE'. */
-void Statechart::exact_main_region_FINISHED_MESSAGE()
+void BaselineStatechart::exact_main_region_FINISHED_MESSAGE()
 {
 	/* Exit action for state 'FINISHED_MESSAGE'. */
 	timerService->unsetTimer(this, (sc_eventid)(&timeEvents[1]));
 }
 
 /* 'default' enter sequence for state IDLE */
-void Statechart::enseq_main_region_IDLE_default()
+void BaselineStatechart::enseq_main_region_IDLE_default()
 {
 	/* 'default' enter sequence for state IDLE */
 	enact_main_region_IDLE();
@@ -1273,7 +1364,7 @@ void Statechart::enseq_main_region_IDLE_default()
 }
 
 /* 'default' enter sequence for state MENU */
-void Statechart::enseq_main_region_MENU_default()
+void BaselineStatechart::enseq_main_region_MENU_default()
 {
 	/* 'default' enter sequence for state MENU */
 	enact_main_region_MENU();
@@ -1281,7 +1372,7 @@ void Statechart::enseq_main_region_MENU_default()
 }
 
 /* 'default' enter sequence for state EXIT */
-void Statechart::enseq_main_region_EXIT_default()
+void BaselineStatechart::enseq_main_region_EXIT_default()
 {
 	/* 'default' enter sequence for state EXIT */
 	enact_main_region_EXIT();
@@ -1289,7 +1380,7 @@ void Statechart::enseq_main_region_EXIT_default()
 }
 
 /* 'default' enter sequence for state STANDARD_PROCESS */
-void Statechart::enseq_main_region_STANDARD_PROCESS_default()
+void BaselineStatechart::enseq_main_region_STANDARD_PROCESS_default()
 {
 	/* 'default' enter sequence for state STANDARD_PROCESS */
 	enact_main_region_STANDARD_PROCESS();
@@ -1297,7 +1388,7 @@ void Statechart::enseq_main_region_STANDARD_PROCESS_default()
 }
 
 /* 'default' enter sequence for state START_PROCESS */
-void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS_default()
+void BaselineStatechart::enseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS_default()
 {
 	/* 'default' enter sequence for state START_PROCESS */
 	enact_main_region_STANDARD_PROCESS_standard_process_START_PROCESS();
@@ -1305,7 +1396,7 @@ void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_START_PROCE
 }
 
 /* 'default' enter sequence for state FINISH_PROCESS */
-void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_default()
+void BaselineStatechart::enseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_default()
 {
 	/* 'default' enter sequence for state FINISH_PROCESS */
 	enact_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS();
@@ -1313,7 +1404,7 @@ void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROC
 }
 
 /* 'default' enter sequence for state CONTROL_PROCESS_LOOP */
-void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_default()
+void BaselineStatechart::enseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_default()
 {
 	/* 'default' enter sequence for state CONTROL_PROCESS_LOOP */
 	enact_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP();
@@ -1321,14 +1412,14 @@ void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PRO
 }
 
 /* 'default' enter sequence for state CUSTOM_SETUP */
-void Statechart::enseq_main_region_CUSTOM_SETUP_default()
+void BaselineStatechart::enseq_main_region_CUSTOM_SETUP_default()
 {
 	/* 'default' enter sequence for state CUSTOM_SETUP */
 	enseq_main_region_CUSTOM_SETUP_custom_setup_default();
 }
 
 /* 'default' enter sequence for state CUSTOM_SETUP_COMPLETE */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_default()
+void BaselineStatechart::enseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_default()
 {
 	/* 'default' enter sequence for state CUSTOM_SETUP_COMPLETE */
 	enact_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE();
@@ -1336,7 +1427,7 @@ void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLE
 }
 
 /* 'default' enter sequence for state NUM_STEPS */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_default()
+void BaselineStatechart::enseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_default()
 {
 	/* 'default' enter sequence for state NUM_STEPS */
 	enact_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS();
@@ -1344,7 +1435,7 @@ void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_default()
 }
 
 /* 'default' enter sequence for state LOOP_TEMP_TIME_STEPS */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_default()
+void BaselineStatechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_default()
 {
 	/* 'default' enter sequence for state LOOP_TEMP_TIME_STEPS */
 	enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS();
@@ -1352,7 +1443,7 @@ void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEP
 }
 
 /* 'default' enter sequence for state TEMP */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_default()
+void BaselineStatechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_default()
 {
 	/* 'default' enter sequence for state TEMP */
 	enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP();
@@ -1360,7 +1451,7 @@ void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEP
 }
 
 /* 'default' enter sequence for state TIME */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_default()
+void BaselineStatechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_default()
 {
 	/* 'default' enter sequence for state TIME */
 	enact_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME();
@@ -1368,7 +1459,7 @@ void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEP
 }
 
 /* 'default' enter sequence for state INIT_SYSTEM */
-void Statechart::enseq_main_region_INIT_SYSTEM_default()
+void BaselineStatechart::enseq_main_region_INIT_SYSTEM_default()
 {
 	/* 'default' enter sequence for state INIT_SYSTEM */
 	enact_main_region_INIT_SYSTEM();
@@ -1376,7 +1467,7 @@ void Statechart::enseq_main_region_INIT_SYSTEM_default()
 }
 
 /* 'default' enter sequence for state RECIPE_1 */
-void Statechart::enseq_main_region_RECIPE_1_default()
+void BaselineStatechart::enseq_main_region_RECIPE_1_default()
 {
 	/* 'default' enter sequence for state RECIPE_1 */
 	enact_main_region_RECIPE_1();
@@ -1384,7 +1475,7 @@ void Statechart::enseq_main_region_RECIPE_1_default()
 }
 
 /* 'default' enter sequence for state RECIPE_2 */
-void Statechart::enseq_main_region_RECIPE_2_default()
+void BaselineStatechart::enseq_main_region_RECIPE_2_default()
 {
 	/* 'default' enter sequence for state RECIPE_2 */
 	enact_main_region_RECIPE_2();
@@ -1392,7 +1483,7 @@ void Statechart::enseq_main_region_RECIPE_2_default()
 }
 
 /* 'default' enter sequence for state RECIPE_3 */
-void Statechart::enseq_main_region_RECIPE_3_default()
+void BaselineStatechart::enseq_main_region_RECIPE_3_default()
 {
 	/* 'default' enter sequence for state RECIPE_3 */
 	enact_main_region_RECIPE_3();
@@ -1400,7 +1491,7 @@ void Statechart::enseq_main_region_RECIPE_3_default()
 }
 
 /* 'default' enter sequence for state RECIPE_4 */
-void Statechart::enseq_main_region_RECIPE_4_default()
+void BaselineStatechart::enseq_main_region_RECIPE_4_default()
 {
 	/* 'default' enter sequence for state RECIPE_4 */
 	enact_main_region_RECIPE_4();
@@ -1408,7 +1499,7 @@ void Statechart::enseq_main_region_RECIPE_4_default()
 }
 
 /* 'default' enter sequence for state RECIPE_5 */
-void Statechart::enseq_main_region_RECIPE_5_default()
+void BaselineStatechart::enseq_main_region_RECIPE_5_default()
 {
 	/* 'default' enter sequence for state RECIPE_5 */
 	enact_main_region_RECIPE_5();
@@ -1416,7 +1507,7 @@ void Statechart::enseq_main_region_RECIPE_5_default()
 }
 
 /* 'default' enter sequence for state FINISHED_MESSAGE */
-void Statechart::enseq_main_region_FINISHED_MESSAGE_default()
+void BaselineStatechart::enseq_main_region_FINISHED_MESSAGE_default()
 {
 	/* 'default' enter sequence for state FINISHED_MESSAGE */
 	enact_main_region_FINISHED_MESSAGE();
@@ -1424,56 +1515,56 @@ void Statechart::enseq_main_region_FINISHED_MESSAGE_default()
 }
 
 /* 'default' enter sequence for region main region */
-void Statechart::enseq_main_region_default()
+void BaselineStatechart::enseq_main_region_default()
 {
 	/* 'default' enter sequence for region main region */
 	react_main_region__entry_Default();
 }
 
 /* 'default' enter sequence for region standard_process */
-void Statechart::enseq_main_region_STANDARD_PROCESS_standard_process_default()
+void BaselineStatechart::enseq_main_region_STANDARD_PROCESS_standard_process_default()
 {
 	/* 'default' enter sequence for region standard_process */
 	react_main_region_STANDARD_PROCESS_standard_process__entry_Default();
 }
 
 /* 'default' enter sequence for region custom_setup */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_default()
+void BaselineStatechart::enseq_main_region_CUSTOM_SETUP_custom_setup_default()
 {
 	/* 'default' enter sequence for region custom_setup */
 	react_main_region_CUSTOM_SETUP_custom_setup__entry_Default();
 }
 
 /* 'default' enter sequence for region loop_steps */
-void Statechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_default()
+void BaselineStatechart::enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_default()
 {
 	/* 'default' enter sequence for region loop_steps */
 	react_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps__entry_Default();
 }
 
 /* Default exit sequence for state IDLE */
-void Statechart::exseq_main_region_IDLE()
+void BaselineStatechart::exseq_main_region_IDLE()
 {
 	/* Default exit sequence for state IDLE */
 	stateConfVector[0] = Statechart_last_state;
 }
 
 /* Default exit sequence for state MENU */
-void Statechart::exseq_main_region_MENU()
+void BaselineStatechart::exseq_main_region_MENU()
 {
 	/* Default exit sequence for state MENU */
 	stateConfVector[0] = Statechart_last_state;
 }
 
 /* Default exit sequence for state EXIT */
-void Statechart::exseq_main_region_EXIT()
+void BaselineStatechart::exseq_main_region_EXIT()
 {
 	/* Default exit sequence for state EXIT */
 	stateConfVector[0] = Statechart_last_state;
 }
 
 /* Default exit sequence for state STANDARD_PROCESS */
-void Statechart::exseq_main_region_STANDARD_PROCESS()
+void BaselineStatechart::exseq_main_region_STANDARD_PROCESS()
 {
 	/* Default exit sequence for state STANDARD_PROCESS */
 	exseq_main_region_STANDARD_PROCESS_standard_process();
@@ -1481,28 +1572,28 @@ void Statechart::exseq_main_region_STANDARD_PROCESS()
 }
 
 /* Default exit sequence for state START_PROCESS */
-void Statechart::exseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS()
+void BaselineStatechart::exseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS()
 {
 	/* Default exit sequence for state START_PROCESS */
 	stateConfVector[0] = main_region_STANDARD_PROCESS;
 }
 
 /* Default exit sequence for state FINISH_PROCESS */
-void Statechart::exseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS()
+void BaselineStatechart::exseq_main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS()
 {
 	/* Default exit sequence for state FINISH_PROCESS */
 	stateConfVector[0] = main_region_STANDARD_PROCESS;
 }
 
 /* Default exit sequence for state CONTROL_PROCESS_LOOP */
-void Statechart::exseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP()
+void BaselineStatechart::exseq_main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP()
 {
 	/* Default exit sequence for state CONTROL_PROCESS_LOOP */
 	stateConfVector[0] = main_region_STANDARD_PROCESS;
 }
 
 /* Default exit sequence for state CUSTOM_SETUP */
-void Statechart::exseq_main_region_CUSTOM_SETUP()
+void BaselineStatechart::exseq_main_region_CUSTOM_SETUP()
 {
 	/* Default exit sequence for state CUSTOM_SETUP */
 	exseq_main_region_CUSTOM_SETUP_custom_setup();
@@ -1510,21 +1601,21 @@ void Statechart::exseq_main_region_CUSTOM_SETUP()
 }
 
 /* Default exit sequence for state CUSTOM_SETUP_COMPLETE */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE()
+void BaselineStatechart::exseq_main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE()
 {
 	/* Default exit sequence for state CUSTOM_SETUP_COMPLETE */
 	stateConfVector[0] = main_region_CUSTOM_SETUP;
 }
 
 /* Default exit sequence for state NUM_STEPS */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS()
+void BaselineStatechart::exseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS()
 {
 	/* Default exit sequence for state NUM_STEPS */
 	stateConfVector[0] = main_region_CUSTOM_SETUP;
 }
 
 /* Default exit sequence for state LOOP_TEMP_TIME_STEPS */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS()
+void BaselineStatechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS()
 {
 	/* Default exit sequence for state LOOP_TEMP_TIME_STEPS */
 	exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps();
@@ -1532,21 +1623,21 @@ void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEP
 }
 
 /* Default exit sequence for state TEMP */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP()
+void BaselineStatechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP()
 {
 	/* Default exit sequence for state TEMP */
 	stateConfVector[0] = main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS;
 }
 
 /* Default exit sequence for state TIME */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME()
+void BaselineStatechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME()
 {
 	/* Default exit sequence for state TIME */
 	stateConfVector[0] = main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS;
 }
 
 /* Default exit sequence for state INIT_SYSTEM */
-void Statechart::exseq_main_region_INIT_SYSTEM()
+void BaselineStatechart::exseq_main_region_INIT_SYSTEM()
 {
 	/* Default exit sequence for state INIT_SYSTEM */
 	stateConfVector[0] = Statechart_last_state;
@@ -1554,42 +1645,42 @@ void Statechart::exseq_main_region_INIT_SYSTEM()
 }
 
 /* Default exit sequence for state RECIPE_1 */
-void Statechart::exseq_main_region_RECIPE_1()
+void BaselineStatechart::exseq_main_region_RECIPE_1()
 {
 	/* Default exit sequence for state RECIPE_1 */
 	stateConfVector[0] = Statechart_last_state;
 }
 
 /* Default exit sequence for state RECIPE_2 */
-void Statechart::exseq_main_region_RECIPE_2()
+void BaselineStatechart::exseq_main_region_RECIPE_2()
 {
 	/* Default exit sequence for state RECIPE_2 */
 	stateConfVector[0] = Statechart_last_state;
 }
 
 /* Default exit sequence for state RECIPE_3 */
-void Statechart::exseq_main_region_RECIPE_3()
+void BaselineStatechart::exseq_main_region_RECIPE_3()
 {
 	/* Default exit sequence for state RECIPE_3 */
 	stateConfVector[0] = Statechart_last_state;
 }
 
 /* Default exit sequence for state RECIPE_4 */
-void Statechart::exseq_main_region_RECIPE_4()
+void BaselineStatechart::exseq_main_region_RECIPE_4()
 {
 	/* Default exit sequence for state RECIPE_4 */
 	stateConfVector[0] = Statechart_last_state;
 }
 
 /* Default exit sequence for state RECIPE_5 */
-void Statechart::exseq_main_region_RECIPE_5()
+void BaselineStatechart::exseq_main_region_RECIPE_5()
 {
 	/* Default exit sequence for state RECIPE_5 */
 	stateConfVector[0] = Statechart_last_state;
 }
 
 /* Default exit sequence for state FINISHED_MESSAGE */
-void Statechart::exseq_main_region_FINISHED_MESSAGE()
+void BaselineStatechart::exseq_main_region_FINISHED_MESSAGE()
 {
 	/* Default exit sequence for state FINISHED_MESSAGE */
 	stateConfVector[0] = Statechart_last_state;
@@ -1597,10 +1688,10 @@ void Statechart::exseq_main_region_FINISHED_MESSAGE()
 }
 
 /* Default exit sequence for region main region */
-void Statechart::exseq_main_region()
+void BaselineStatechart::exseq_main_region()
 {
 	/* Default exit sequence for region main region */
-	/* Handle exit of all possible states (of Statechart.main_region) at position 0... */
+	/* Handle exit of all possible states (of BaselineStatechart.main_region) at position 0... */
 	switch(stateConfVector[ 0 ])
 	{
 		case main_region_IDLE :
@@ -1710,10 +1801,10 @@ void Statechart::exseq_main_region()
 }
 
 /* Default exit sequence for region standard_process */
-void Statechart::exseq_main_region_STANDARD_PROCESS_standard_process()
+void BaselineStatechart::exseq_main_region_STANDARD_PROCESS_standard_process()
 {
 	/* Default exit sequence for region standard_process */
-	/* Handle exit of all possible states (of Statechart.main_region.STANDARD_PROCESS.standard_process) at position 0... */
+	/* Handle exit of all possible states (of BaselineStatechart.main_region.STANDARD_PROCESS.standard_process) at position 0... */
 	switch(stateConfVector[ 0 ])
 	{
 		case main_region_STANDARD_PROCESS_standard_process_START_PROCESS :
@@ -1738,10 +1829,10 @@ void Statechart::exseq_main_region_STANDARD_PROCESS_standard_process()
 }
 
 /* Default exit sequence for region custom_setup */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup()
+void BaselineStatechart::exseq_main_region_CUSTOM_SETUP_custom_setup()
 {
 	/* Default exit sequence for region custom_setup */
-	/* Handle exit of all possible states (of Statechart.main_region.CUSTOM_SETUP.custom_setup) at position 0... */
+	/* Handle exit of all possible states (of BaselineStatechart.main_region.CUSTOM_SETUP.custom_setup) at position 0... */
 	switch(stateConfVector[ 0 ])
 	{
 		case main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE :
@@ -1776,10 +1867,10 @@ void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup()
 }
 
 /* Default exit sequence for region loop_steps */
-void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps()
+void BaselineStatechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps()
 {
 	/* Default exit sequence for region loop_steps */
-	/* Handle exit of all possible states (of Statechart.main_region.CUSTOM_SETUP.custom_setup.LOOP_TEMP_TIME_STEPS.loop_steps) at position 0... */
+	/* Handle exit of all possible states (of BaselineStatechart.main_region.CUSTOM_SETUP.custom_setup.LOOP_TEMP_TIME_STEPS.loop_steps) at position 0... */
 	switch(stateConfVector[ 0 ])
 	{
 		case main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP :
@@ -1799,34 +1890,34 @@ void Statechart::exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEP
 }
 
 /* Default react sequence for initial entry  */
-void Statechart::react_main_region_STANDARD_PROCESS_standard_process__entry_Default()
+void BaselineStatechart::react_main_region_STANDARD_PROCESS_standard_process__entry_Default()
 {
 	/* Default react sequence for initial entry  */
 	enseq_main_region_STANDARD_PROCESS_standard_process_START_PROCESS_default();
 }
 
 /* Default react sequence for initial entry  */
-void Statechart::react_main_region_CUSTOM_SETUP_custom_setup__entry_Default()
+void BaselineStatechart::react_main_region_CUSTOM_SETUP_custom_setup__entry_Default()
 {
 	/* Default react sequence for initial entry  */
 	enseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_default();
 }
 
 /* Default react sequence for initial entry  */
-void Statechart::react_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps__entry_Default()
+void BaselineStatechart::react_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps__entry_Default()
 {
 	/* Default react sequence for initial entry  */
 	enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_default();
 }
 
 /* Default react sequence for initial entry  */
-void Statechart::react_main_region__entry_Default()
+void BaselineStatechart::react_main_region__entry_Default()
 {
 	/* Default react sequence for initial entry  */
 	enseq_main_region_IDLE_default();
 }
 
-sc_integer Statechart::main_region_IDLE_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_IDLE_react(const sc_integer transitioned_before) {
 	/* The reactions of state IDLE. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -1855,7 +1946,7 @@ sc_integer Statechart::main_region_IDLE_react(const sc_integer transitioned_befo
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_MENU_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_MENU_react(const sc_integer transitioned_before) {
 	/* The reactions of state MENU. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -1908,7 +1999,28 @@ sc_integer Statechart::main_region_MENU_react(const sc_integer transitioned_befo
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_STANDARD_PROCESS_standard_process_START_PROCESS_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_STANDARD_PROCESS_react(const sc_integer transitioned_before) {
+	/* The reactions of state STANDARD_PROCESS. */
+	sc_integer transitioned_after = transitioned_before;
+	if ((transitioned_after) < (0))
+	{ 
+		if (menu_raised)
+		{ 
+			exseq_main_region_STANDARD_PROCESS();
+			enseq_main_region_MENU_default();
+			transitioned_after = 0;
+		} 
+	} 
+	/* If no transition was taken */
+	if ((transitioned_after) == (transitioned_before))
+	{ 
+		/* then execute local reactions. */
+		transitioned_after = transitioned_before;
+	} 
+	return transitioned_after;
+}
+
+sc_integer BaselineStatechart::main_region_STANDARD_PROCESS_standard_process_START_PROCESS_react(const sc_integer transitioned_before) {
 	/* The reactions of state START_PROCESS. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -1924,12 +2036,12 @@ sc_integer Statechart::main_region_STANDARD_PROCESS_standard_process_START_PROCE
 	if ((transitioned_after) == (transitioned_before))
 	{ 
 		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
+		transitioned_after = main_region_STANDARD_PROCESS_react(transitioned_before);
 	} 
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_react(const sc_integer transitioned_before) {
 	/* The reactions of state FINISH_PROCESS. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -1945,12 +2057,12 @@ sc_integer Statechart::main_region_STANDARD_PROCESS_standard_process_FINISH_PROC
 	if ((transitioned_after) == (transitioned_before))
 	{ 
 		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
+		transitioned_after = main_region_STANDARD_PROCESS_react(transitioned_before);
 	} 
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_react(const sc_integer transitioned_before) {
 	/* The reactions of state CONTROL_PROCESS_LOOP. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -1974,12 +2086,12 @@ sc_integer Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PRO
 	if ((transitioned_after) == (transitioned_before))
 	{ 
 		/* then execute local reactions. */
-		transitioned_after = transitioned_before;
+		transitioned_after = main_region_STANDARD_PROCESS_react(transitioned_before);
 	} 
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_CUSTOM_SETUP_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_CUSTOM_SETUP_react(const sc_integer transitioned_before) {
 	/* The reactions of state CUSTOM_SETUP. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2000,7 +2112,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_react(const sc_integer transitio
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLETE_react(const sc_integer transitioned_before) {
 	/* The reactions of state CUSTOM_SETUP_COMPLETE. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2008,7 +2120,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLE
 		if (start_recipe_custom_raised)
 		{ 
 			exseq_main_region_CUSTOM_SETUP();
-			inEventQueue.push_back(new SctEvent__recipe_5_process(recipe_5_process));
+			pushInEvent(recipe_5_process);
 			;
 			enseq_main_region_STANDARD_PROCESS_default();
 			transitioned_after = 0;
@@ -2017,7 +2129,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLE
 			if (go_to_menu_raised)
 			{ 
 				exseq_main_region_CUSTOM_SETUP();
-				inEventQueue.push_back(new SctEvent__recipe_back_menu(recipe_back_menu));
+				pushInEvent(recipe_back_menu);
 				;
 				enseq_main_region_MENU_default();
 				transitioned_after = 0;
@@ -2033,7 +2145,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_CUSTOM_SETUP_COMPLE
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_react(const sc_integer transitioned_before) {
 	/* The reactions of state NUM_STEPS. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2042,7 +2154,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_react(con
 		{ 
 			exseq_main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS();
 			ifaceOperationCallback->setNumCustomSteps(received_value);
-			inEventQueue.push_back(new SctEvent__go_to_loop(go_to_loop));
+			pushInEvent(go_to_loop);
 			;
 			enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_default();
 			main_region_CUSTOM_SETUP_react(0);
@@ -2058,7 +2170,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_NUM_STEPS_react(con
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_react(const sc_integer transitioned_before) {
 	/* The reactions of state LOOP_TEMP_TIME_STEPS. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2090,7 +2202,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEP
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP_react(const sc_integer transitioned_before) {
 	/* The reactions of state TEMP. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2099,7 +2211,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEP
 		{ 
 			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TEMP();
 			ifaceOperationCallback->processTemperature(current_custom_step_idx, received_value);
-			inEventQueue.push_back(new SctEvent__temp_finished(temp_finished));
+			pushInEvent(temp_finished);
 			;
 			enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_default();
 			main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_react(0);
@@ -2115,7 +2227,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEP
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_loop_steps_TIME_react(const sc_integer transitioned_before) {
 	/* The reactions of state TIME. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2124,7 +2236,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEP
 		{ 
 			exseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS();
 			ifaceOperationCallback->processDuration(current_custom_step_idx, received_value);
-			inEventQueue.push_back(new SctEvent__loop_finished(loop_finished));
+			pushInEvent(loop_finished);
 			;
 			enseq_main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEPS_default();
 			main_region_CUSTOM_SETUP_react(0);
@@ -2140,7 +2252,7 @@ sc_integer Statechart::main_region_CUSTOM_SETUP_custom_setup_LOOP_TEMP_TIME_STEP
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_INIT_SYSTEM_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_INIT_SYSTEM_react(const sc_integer transitioned_before) {
 	/* The reactions of state INIT_SYSTEM. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2162,7 +2274,7 @@ sc_integer Statechart::main_region_INIT_SYSTEM_react(const sc_integer transition
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_RECIPE_1_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_RECIPE_1_react(const sc_integer transitioned_before) {
 	/* The reactions of state RECIPE_1. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2191,7 +2303,7 @@ sc_integer Statechart::main_region_RECIPE_1_react(const sc_integer transitioned_
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_RECIPE_2_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_RECIPE_2_react(const sc_integer transitioned_before) {
 	/* The reactions of state RECIPE_2. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2220,7 +2332,7 @@ sc_integer Statechart::main_region_RECIPE_2_react(const sc_integer transitioned_
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_RECIPE_3_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_RECIPE_3_react(const sc_integer transitioned_before) {
 	/* The reactions of state RECIPE_3. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2249,7 +2361,7 @@ sc_integer Statechart::main_region_RECIPE_3_react(const sc_integer transitioned_
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_RECIPE_4_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_RECIPE_4_react(const sc_integer transitioned_before) {
 	/* The reactions of state RECIPE_4. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2278,7 +2390,7 @@ sc_integer Statechart::main_region_RECIPE_4_react(const sc_integer transitioned_
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_RECIPE_5_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_RECIPE_5_react(const sc_integer transitioned_before) {
 	/* The reactions of state RECIPE_5. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2307,7 +2419,7 @@ sc_integer Statechart::main_region_RECIPE_5_react(const sc_integer transitioned_
 	return transitioned_after;
 }
 
-sc_integer Statechart::main_region_FINISHED_MESSAGE_react(const sc_integer transitioned_before) {
+sc_integer BaselineStatechart::main_region_FINISHED_MESSAGE_react(const sc_integer transitioned_before) {
 	/* The reactions of state FINISHED_MESSAGE. */
 	sc_integer transitioned_after = transitioned_before;
 	if ((transitioned_after) < (0))
@@ -2329,7 +2441,7 @@ sc_integer Statechart::main_region_FINISHED_MESSAGE_react(const sc_integer trans
 	return transitioned_after;
 }
 
-void Statechart::clearInEvents() {
+void BaselineStatechart::clearInEvents() {
 	menu_raised = false;
 	standard_process_raised = false;
 	heating_raised = false;
@@ -2373,7 +2485,7 @@ void Statechart::clearInEvents() {
 	timeEvents[1] = false;
 }
 
-void Statechart::microStep() {
+void BaselineStatechart::microStep() {
 	switch(stateConfVector[ 0 ])
 	{
 		case main_region_IDLE :
@@ -2466,49 +2578,67 @@ void Statechart::microStep() {
 	}
 }
 
-void Statechart::runCycle() {
+void BaselineStatechart::runCycle() {
 	/* Performs a 'run to completion' step. */
 	if (isExecuting)
 	{ 
 		return;
 	} 
 	isExecuting = true;
-	dispatch_event(getNextEvent());
+	++runCycleCount;
+	SctEvent nextEvent = {invalid_event, SCT_EVENT_FLAG_NONE, 0};
+	if (getNextEvent(nextEvent)) {
+		dispatch_event(nextEvent);
+	}
 	do
 	{ 
+#ifdef SC_TRACE_ENABLED
+		const StatechartStates traceSource = stateConfVector[0];
+		const uint32_t traceStart = traceClock ? traceClock() : 0;
+#endif
 		microStep();
+		++microStepCount;
 		clearInEvents();
-	} while (dispatch_event(getNextEvent()));
+#ifdef SC_TRACE_ENABLED
+		traceStep(nextEvent.name, traceSource, traceStart);
+#endif
+	} while (getNextEvent(nextEvent) && dispatch_event(nextEvent));
 	isExecuting = false;
 }
 
-void Statechart::enter() {
+void BaselineStatechart::enter() {
 	/* Activates the state machine. */
 	if (isExecuting)
 	{ 
 		return;
 	} 
 	isExecuting = true;
-	/* Default enter sequence for statechart Statechart */
+#ifdef SC_TRACE_ENABLED
+	const uint32_t traceStart = traceClock ? traceClock() : 0;
+#endif
+	/* Default enter sequence for statechart BaselineStatechart */
 	enseq_main_region_default();
+#ifdef SC_TRACE_ENABLED
+	traceStep(invalid_event, Statechart_last_state, traceStart);
+#endif
 	isExecuting = false;
 }
 
-void Statechart::exit() {
+void BaselineStatechart::exit() {
 	/* Deactivates the state machine. */
 	if (isExecuting)
 	{ 
 		return;
 	} 
 	isExecuting = true;
-	/* Default exit sequence for statechart Statechart */
+	/* Default exit sequence for statechart BaselineStatechart */
 	exseq_main_region();
 	stateConfVector[0] = Statechart_last_state;
 	isExecuting = false;
 }
 
 /* Can be used by the client code to trigger a run to completion step without raising an event. */
-void Statechart::triggerWithoutEvent() {
+void BaselineStatechart::triggerWithoutEvent() {
 	runCycle();
 }
 
@@ -1,23 +1,25 @@
 /* Generated by itemis CREATE code generator. */
+/* Saída do itemis CREATE que o sct_tablegen.py substituiu, com a classe renomeada para
+   BaselineStatechart e com a transição STANDARD_PROCESS -menu-> MENU acrescentada à mão (o modelo
+   a ganhou depois): referência do test_statechart_dispatch, fora do firmware. */
 
-#ifndef STATECHART_H_
-#define STATECHART_H_
+#ifndef BASELINESTATECHART_H_
+#define BASELINESTATECHART_H_
 
 /*!
-Forward declaration for the Statechart state machine.
+Forward declaration for the BaselineStatechart state machine.
 */
-class Statechart;
+class BaselineStatechart;
 
 
-#include <deque>
-#include "../src/sc_types.h"
-#include "../src/sc_statemachine.h"
-#include "../src/sc_eventdriven.h"
-#include "../src/sc_timer.h"
+#include "src-gen/sc_types.h"
+#include "src-gen/sc_statemachine.h"
+#include "src-gen/sc_eventdriven.h"
+#include "src-gen/sc_timer.h"
 #include <string.h>
 
 /*! \file
-Header of the state machine 'Statechart'.
+Header of the state machine 'BaselineStatechart'.
 */
 
 
@@ -26,6 +28,9 @@ Header of the state machine 'Statechart'.
 #ifndef SC_INVALID_EVENT_VALUE
 #define SC_INVALID_EVENT_VALUE 0
 #endif
+#ifndef SC_IN_EVENT_QUEUE_SIZE
+#define SC_IN_EVENT_QUEUE_SIZE 16
+#endif
 
 namespace statechart_events
 {
@@ -74,228 +79,24 @@ typedef enum  {
 	Statechart_main_region_FINISHED_MESSAGE_time_event_0
 } StatechartEventName;
 
-class SctEvent
-{
-	public:
-		SctEvent(StatechartEventName name_) : name(name_){}
-		virtual ~SctEvent(){}
-		const StatechartEventName name;
-		
-};
-		
-template <typename T>
-class TypedSctEvent : public SctEvent
-{
-	public:
-		TypedSctEvent(StatechartEventName name_, T value_) :
-			SctEvent(name_),
-			value(value_)
-			{}
-		virtual ~TypedSctEvent(){}
-		const T value;
-};
+/*! Flags of a queued event. */
+#define SCT_EVENT_FLAG_NONE 0x0000u
+#define SCT_EVENT_FLAG_TIME 0x0001u  /* raised by the timer service */
+#define SCT_EVENT_FLAG_VALUE 0x0002u /* 'value' carries a payload */
 
-class SctEvent__menu : public SctEvent
-{
-	public:
-		SctEvent__menu(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__standard_process : public SctEvent
-{
-	public:
-		SctEvent__standard_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__heating : public SctEvent
-{
-	public:
-		SctEvent__heating(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__resting : public SctEvent
-{
-	public:
-		SctEvent__resting(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__heating_2 : public SctEvent
-{
-	public:
-		SctEvent__heating_2(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__resting_2 : public SctEvent
-{
-	public:
-		SctEvent__resting_2(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__idle : public SctEvent
-{
-	public:
-		SctEvent__idle(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__custom_setup : public SctEvent
-{
-	public:
-		SctEvent__custom_setup(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__set_temperature : public SctEvent
-{
-	public:
-		SctEvent__set_temperature(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__set_time : public SctEvent
-{
-	public:
-		SctEvent__set_time(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__set_temperature_2 : public SctEvent
-{
-	public:
-		SctEvent__set_temperature_2(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__set_time_2 : public SctEvent
-{
-	public:
-		SctEvent__set_time_2(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__add_step : public SctEvent
-{
-	public:
-		SctEvent__add_step(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__standard_process_custom : public SctEvent
-{
-	public:
-		SctEvent__standard_process_custom(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__finish_process : public SctEvent
-{
-	public:
-		SctEvent__finish_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__finish_process_idle : public SctEvent
-{
-	public:
-		SctEvent__finish_process_idle(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__start_button : public SctEvent
-{
-	public:
-		SctEvent__start_button(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__exit_process : public SctEvent
-{
-	public:
-		SctEvent__exit_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_1 : public SctEvent
-{
-	public:
-		SctEvent__recipe_1(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_2 : public SctEvent
-{
-	public:
-		SctEvent__recipe_2(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_3 : public SctEvent
-{
-	public:
-		SctEvent__recipe_3(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_4 : public SctEvent
-{
-	public:
-		SctEvent__recipe_4(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_5 : public SctEvent
-{
-	public:
-		SctEvent__recipe_5(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_back_menu : public SctEvent
-{
-	public:
-		SctEvent__recipe_back_menu(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_1_process : public SctEvent
-{
-	public:
-		SctEvent__recipe_1_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_2_process : public SctEvent
-{
-	public:
-		SctEvent__recipe_2_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_3_process : public SctEvent
-{
-	public:
-		SctEvent__recipe_3_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_4_process : public SctEvent
-{
-	public:
-		SctEvent__recipe_4_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__recipe_5_process : public SctEvent
-{
-	public:
-		SctEvent__recipe_5_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__start_first_step : public SctEvent
-{
-	public:
-		SctEvent__start_first_step(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__step_finished : public SctEvent
+/*! Compact, tagged event record moved through the in-event queue.
+ * Plain data, 8 bytes, no per-event class and no virtual dispatch: the tag
+ * selects the handler in dispatch_event(). */
+struct SctEvent
 {
-	public:
-		SctEvent__step_finished(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__finished_process : public SctEvent
-{
-	public:
-		SctEvent__finished_process(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__keypad_input_confirm : public SctEvent
-{
-	public:
-		SctEvent__keypad_input_confirm(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__keypad_input_cancel : public SctEvent
-{
-	public:
-		SctEvent__keypad_input_cancel(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__go_to_loop : public SctEvent
-{
-	public:
-		SctEvent__go_to_loop(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__temp_finished : public SctEvent
-{
-	public:
-		SctEvent__temp_finished(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__loop_finished : public SctEvent
-{
-	public:
-		SctEvent__loop_finished(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__start_recipe_custom : public SctEvent
-{
-	public:
-		SctEvent__start_recipe_custom(StatechartEventName name_) : SctEvent(name_){};
-};
-class SctEvent__go_to_menu : public SctEvent
-{
-	public:
-		SctEvent__go_to_menu(StatechartEventName name_) : SctEvent(name_){};
-};
-class TimedSctEvent : public SctEvent
-{
-	public:
-		TimedSctEvent(StatechartEventName name_) : SctEvent(name_){};
+	uint16_t name;    /* StatechartEventName */
+	uint16_t flags;   /* SCT_EVENT_FLAG_* */
+	sc_integer value; /* payload slot for valued events */
 };
 
+static_assert(sizeof(SctEvent) == 8, "SctEvent must stay an 8-byte POD");
+static_assert(Statechart_main_region_FINISHED_MESSAGE_time_event_0 <= 0xFFFF, "event id must fit the 16-bit tag");
+
 }
 #endif /* SCT_EVENTS_STATECHART_H */
 
@@ -323,12 +124,12 @@ class TimedSctEvent : public SctEvent
 #define SCVI_MAIN_REGION_FINISHED_MESSAGE 0
 
 
-class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInterface
+class BaselineStatechart : public sc::timer::TimedInterface, public sc::EventDrivenInterface
 {
 	public:
-		Statechart();
+		BaselineStatechart();
 		
-		virtual ~Statechart();
+		virtual ~BaselineStatechart();
 		
 		/*! Enumeration of all states */ 
 		typedef enum
@@ -476,6 +277,18 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 		/*! Raises the in event 'go_to_menu' that is defined in the default interface scope. */
 		void raiseGo_to_menu();
 		
+		/*! Raises the in event identified by 'name' (same effect as the corresponding raise method). Time events are ignored. */
+		void raiseEvent(statechart_events::StatechartEventName name);
+		
+		/*! Queues 'count' in events in order and processes all of them in a single run cycle. Time events are ignored. */
+		void raiseEvents(const statechart_events::StatechartEventName * names, sc_integer count);
+		
+		/*! Returns how many run cycles were executed since the state machine was created. */
+		sc_integer getRunCycleCount() const;
+		
+		/*! Returns how many micro steps were executed since the state machine was created. */
+		sc_integer getMicroStepCount() const;
+		
 		/*! Gets the value of the variable 'output' that is defined in the default interface scope. */
 		sc_integer getOutput() const;
 		/*! Sets the value of the variable 'output' that is defined in the default interface scope. */
@@ -670,21 +483,51 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 		/*! Checks if the specified state is active (until 2.4.1 the used method for states was calles isActive()). */
 		sc_boolean isStateActive(StatechartStates state) const;
 		
+		/*! Returns the active leaf state of the main region in O(1) (Statechart_last_state if the state machine is inactive). */
+		StatechartStates getActiveLeafState() const;
+		
+#ifdef SC_TRACE_ENABLED
+		/*! Trace record of one micro step: the event consumed, the leaf state before
+		 *  and after the step, and trace clock readings around it (entry/exit actions included). */
+		struct TraceRecord
+		{
+			uint32_t startMicros;
+			uint32_t endMicros;
+			uint16_t event;  /* StatechartEventName (invalid_event for completion steps) */
+			uint8_t source;  /* StatechartStates before the step */
+			uint8_t target;  /* StatechartStates after the step */
+		};
+		typedef uint32_t (*TraceClock)();
+		typedef void (*TraceHook)(void * context, const TraceRecord & record);
+		
+		/*! Installs the trace sink. Steps that consume an event or change the active state are reported. */
+		void setTraceHook(TraceClock clock, TraceHook hook, void * context);
+#endif
+		
 		//! number of time events used by the state machine.
 		static const sc_integer timeEventsCount = 2;
 		
 		//! number of time events that can be active at once.
 		static const sc_integer parallelTimeEventsCount = 1;
 		
+		//! capacity of the in-event queue (events raised while the queue is full are dropped).
+		static const sc_ushort inEventQueueCapacity = SC_IN_EVENT_QUEUE_SIZE;
+		
+		/*! Returns the number of events dropped because the in-event queue was full. */
+		sc_integer getInEventQueueOverflows() const;
+		
+		/*! Returns the highest number of events that were pending in the in-event queue at once. */
+		sc_integer getInEventQueueHighWater() const;
+		
 		
 	protected:
 		
 		
 	private:
-		Statechart(const Statechart &rhs);
-		Statechart& operator=(const Statechart&);
+		BaselineStatechart(const BaselineStatechart &rhs);
+		BaselineStatechart& operator=(const BaselineStatechart&);
 		
-		sc_boolean internal_dispatch_event(statechart_events::SctEvent * event);
+		sc_boolean internal_dispatch_event(const statechart_events::SctEvent & event);
 		
 		/*! Raises the in event 'menu' that is defined in the default interface scope. */
 		void internal_raiseMenu();
@@ -818,7 +661,7 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 		/*! Raises the in event 'go_to_menu' that is defined in the default interface scope. */
 		void internal_raiseGo_to_menu();
 		sc_boolean go_to_menu_raised;
-		sc_boolean iface_dispatch_event(statechart_events::SctEvent * event);
+		sc_boolean iface_dispatch_event(const statechart_events::SctEvent & event);
 		
 		
 		//! the maximum number of orthogonal states defines the dimension of the state configuration vector.
@@ -915,6 +758,7 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 		void react_main_region__entry_Default();
 		sc_integer main_region_IDLE_react(const sc_integer transitioned_before);
 		sc_integer main_region_MENU_react(const sc_integer transitioned_before);
+		sc_integer main_region_STANDARD_PROCESS_react(const sc_integer transitioned_before);
 		sc_integer main_region_STANDARD_PROCESS_standard_process_START_PROCESS_react(const sc_integer transitioned_before);
 		sc_integer main_region_STANDARD_PROCESS_standard_process_FINISH_PROCESS_react(const sc_integer transitioned_before);
 		sc_integer main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP_react(const sc_integer transitioned_before);
@@ -936,10 +780,24 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 		void runCycle();
 		
 		
-		statechart_events::SctEvent* getNextEvent();
-		sc_boolean dispatch_event(statechart_events::SctEvent * event);
+		sc_boolean pushInEvent(statechart_events::StatechartEventName name, uint16_t flags = SCT_EVENT_FLAG_NONE, sc_integer value = 0);
+		sc_boolean getNextEvent(statechart_events::SctEvent & event);
+		sc_boolean dispatch_event(const statechart_events::SctEvent & event);
 		statechart_events::StatechartEventName getTimedEventName(sc_eventid evid);
-		std::deque<statechart_events::SctEvent*> inEventQueue;
+		statechart_events::SctEvent inEventQueue[inEventQueueCapacity];
+		sc_ushort inEventQueueHead;
+		sc_ushort inEventQueueCount;
+		sc_ushort inEventQueueHighWater;
+		sc_integer inEventQueueOverflows;
+		sc_integer runCycleCount;
+		sc_integer microStepCount;
+		
+#ifdef SC_TRACE_ENABLED
+		TraceClock traceClock;
+		TraceHook traceHook;
+		void * traceContext;
+		void traceStep(uint16_t event, StatechartStates source, uint32_t startMicros);
+#endif
 		
 		
 		
@@ -947,7 +805,7 @@ class Statechart : public sc::timer::TimedInterface, public sc::EventDrivenInter
 };
 
 
-inline Statechart::OperationCallback::~OperationCallback() {}
+inline BaselineStatechart::OperationCallback::~OperationCallback() {}
 
 
-#endif /* STATECHART_H_ */
+#endif /* BASELINESTATECHART_H_ */
@@ -0,0 +1,352 @@
+/**
+ * @file test_main.cpp
+ * @brief Despacho por tabelas (sct_tablegen.py) contra o código do itemis CREATE, no host.
+ * @details baseline/ guarda a Statechart que o gerador do itemis emitia antes das tabelas, com a
+ * classe renomeada para BaselineStatechart. As duas máquinas recebem o mesmo fluxo de eventos
+ * (o do test_statechart: teclas pelas tabelas do KeypadDispatch.h, step_finished,
+ * finished_process, eventos quaisquer do modelo e eventos de tempo) e, depois de cada um, a folha
+ * ativa, a receita/etapa do callback e os timers armados têm de ser iguais. O benchmark roda o
+ * fluxo aleatório e a receita completa do test_event_queue em cada máquina separadamente, com os
+ * eventos de tempo entregues direto (sem ticks da roda, que custariam o mesmo às duas), e falha se
+ * as tabelas ficarem STATECHART_DISPATCH_MAX_RATIO vezes mais lentas que o código do itemis.
+ * Ajustes por -D: STATECHART_DISPATCH_EVENTS, STATECHART_DISPATCH_LAPS, STATECHART_DISPATCH_SEED
+ * e STATECHART_DISPATCH_MAX_RATIO.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+
+// Includes do projeto
+#include "KeypadDispatch.h"
+#include "StatechartHarness.h"
+#include "baseline/BaselineStatechart.h"
+
+// --- PARÂMETROS DO TESTE ---
+#ifndef STATECHART_DISPATCH_EVENTS
+#define STATECHART_DISPATCH_EVENTS 300000UL // Eventos aleatórios por máquina
+#endif
+#ifndef STATECHART_DISPATCH_LAPS
+#define STATECHART_DISPATCH_LAPS 50000UL // Receitas completas por máquina
+#endif
+#ifndef STATECHART_DISPATCH_SEED
+#define STATECHART_DISPATCH_SEED 0x5EED2025UL
+#endif
+#ifndef STATECHART_DISPATCH_MAX_RATIO
+#define STATECHART_DISPATCH_MAX_RATIO 1.25f // Teto de ns/evento das tabelas / ns/evento do itemis
+#endif
+#define STATECHART_DISPATCH_ROUNDS 3 // Medições por máquina; vale a mais rápida
+
+using namespace statechart_events;
+
+static const char KEYPAD_KEYS[] = "123A456B789C*0#D";
+
+/**
+ * @brief Gerador xorshift32: determinístico e sem alocação.
+ */
+struct FuzzRandom
+{
+  uint32_t state;
+
+  uint32_t next()
+  {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+
+  uint32_t below(uint32_t n)
+  {
+    return next() % n;
+  }
+};
+
+/**
+ * @brief Serviço de timers sem relógio: guarda os timers armados e fire() entrega o mais antigo
+ * na hora, como se o atraso tivesse passado.
+ */
+class ArmedTimerService : public sc::timer::TimerServiceInterface
+{
+public:
+  void setTimer(sc::timer::TimedInterface *statemachine, sc_eventid event, sc_time, sc_boolean) override
+  {
+    unsetTimer(statemachine, event);
+    if (count < MAX_ARMED)
+    {
+      armed[count].sm = statemachine;
+      armed[count].event = event;
+      count++;
+    }
+    else
+    {
+      overflows++;
+    }
+  }
+
+  void unsetTimer(sc::timer::TimedInterface *, sc_eventid event) override
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      if (armed[i].event == event)
+      {
+        for (int j = i + 1; j < count; ++j)
+          armed[j - 1] = armed[j];
+        count--;
+        return;
+      }
+    }
+  }
+
+  /**
+   * @return true se havia um timer armado (retirado antes do despacho, que pode rearmar).
+   */
+  bool fire()
+  {
+    if (count == 0)
+    {
+      return false;
+    }
+    TimerExpiration expired = armed[0];
+    unsetTimer(expired.sm, expired.event);
+    expired.sm->raiseTimeEvent(expired.event);
+    return true;
+  }
+
+  static const int MAX_ARMED = 4;
+  TimerExpiration armed[MAX_ARMED];
+  int count = 0;
+  unsigned long overflows = 0;
+};
+
+/**
+ * @brief Uma máquina gerada com o callback falso e os timers, recebendo o fluxo de eventos.
+ * @tparam Machine Statechart ou BaselineStatechart.
+ */
+template <class Machine>
+struct Replay
+{
+  Machine machine;
+  MockCallbackFor<Machine> operations;
+  ArmedTimerService timers;
+  unsigned long events = 0;
+  unsigned long restarts = 0;
+
+  Replay()
+  {
+    machine.setOperationCallback(&operations);
+    machine.setTimerService(&timers);
+    machine.enter();
+  }
+
+  int leaf() const
+  {
+    return (int)machine.getActiveLeafState();
+  }
+
+  // Trata uma tecla como a processKeypadKey() da stateMachineTask
+  void key(char key)
+  {
+    const KeyBinding *binding = findKeyBinding(keyMapForState((Statechart::StatechartStates)leaf()), key);
+    if (binding == nullptr)
+    {
+      return;
+    }
+    switch (binding->action)
+    {
+    case KEY_ACTION_RAISE:
+    case KEY_ACTION_ABORT:
+      raise((StatechartEventName)binding->event);
+      break;
+    case KEY_ACTION_START_RECIPE:
+    {
+      operations.currentRecipeIdx = binding->arg;
+      const StatechartEventName batch[] = {(StatechartEventName)binding->event, start_first_step};
+      machine.raiseEvents(batch, 2);
+      events += 2;
+      break;
+    }
+    default:
+      break; // Log, trace e auto-tune não passam pela statechart
+    }
+  }
+
+  void raise(StatechartEventName event)
+  {
+    machine.raiseEvent(event);
+    events++;
+  }
+
+  void fire()
+  {
+    events += timers.fire() ? 1 : 0;
+  }
+
+  // Um evento do fluxo do test_statechart; o sorteio não depende do estado
+  void fuzzStep(FuzzRandom &random)
+  {
+    uint32_t dice = random.below(100);
+    if (operations.finishedPending)
+    {
+      operations.finishedPending = false;
+      raise(finished_process);
+    }
+    else if (dice < 55)
+    {
+      key(KEYPAD_KEYS[random.below(sizeof(KEYPAD_KEYS) - 1)]);
+    }
+    else if (dice < 70)
+    {
+      raise(step_finished); // Fim de etapa vindo da controlTask
+    }
+    else if (dice < 75)
+    {
+      raise((StatechartEventName)(1 + random.below(go_to_menu))); // Evento qualquer do modelo
+    }
+    else
+    {
+      fire();
+    }
+    if (leaf() == Statechart::main_region_EXIT)
+    {
+      // EXIT é final (desligamento): recomeça como num novo boot
+      machine.exit();
+      machine.enter();
+      restarts++;
+    }
+  }
+
+  // A receita do test_event_queue, de IDLE a IDLE
+  void recipeLap()
+  {
+    raise(start_button); // IDLE -> INIT_SYSTEM
+    fire();              // -> MENU
+    raise(recipe_1);
+    operations.currentRecipeIdx = 0;
+    const StatechartEventName start[] = {recipe_1_process, start_first_step};
+    machine.raiseEvents(start, 2); // -> CONTROL_PROCESS_LOOP
+    events += 2;
+    for (int i = 0; i < operations.stepsPerRecipe; ++i)
+    {
+      raise(step_finished);
+    }
+    operations.finishedPending = false;
+    raise(finished_process); // -> FINISHED_MESSAGE
+    fire();                  // -> IDLE
+    raise(heating);          // Sem transição no IDLE: só fila e run cycle
+  }
+};
+
+/**
+ * @brief Tempo por evento de uma máquina: a mais rápida de STATECHART_DISPATCH_ROUNDS medições.
+ * @param laps true: receitas completas; false: fluxo aleatório.
+ */
+template <class Machine>
+static double nanosPerEvent(bool laps, int &finalLeaf)
+{
+  double best = 0;
+  for (int round = 0; round < STATECHART_DISPATCH_ROUNDS; ++round)
+  {
+    Replay<Machine> *replay = new Replay<Machine>();
+    FuzzRandom random = {STATECHART_DISPATCH_SEED};
+    auto start = std::chrono::steady_clock::now();
+    if (laps)
+    {
+      for (unsigned long lap = 0; lap < STATECHART_DISPATCH_LAPS; ++lap)
+        replay->recipeLap();
+    }
+    else
+    {
+      for (unsigned long i = 0; i < STATECHART_DISPATCH_EVENTS; ++i)
+        replay->fuzzStep(random);
+    }
+    double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    double perEvent = nanos / (double)(replay->events ? replay->events : 1);
+    if (round == 0 || perEvent < best)
+      best = perEvent;
+    finalLeaf = replay->leaf();
+    delete replay;
+  }
+  return best;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_both_dispatchers_follow_the_same_event_stream(void)
+{
+  Replay<Statechart> *tables = new Replay<Statechart>();
+  Replay<BaselineStatechart> *itemis = new Replay<BaselineStatechart>();
+  FuzzRandom tablesRandom = {STATECHART_DISPATCH_SEED}, itemisRandom = {STATECHART_DISPATCH_SEED};
+  bool visited[Statechart::numStates + 1] = {};
+  TEST_ASSERT_EQUAL(itemis->leaf(), tables->leaf());
+
+  for (unsigned long i = 0; i < STATECHART_DISPATCH_EVENTS; ++i)
+  {
+    tables->fuzzStep(tablesRandom);
+    itemis->fuzzStep(itemisRandom);
+    if (tables->leaf() != itemis->leaf() || tables->operations.currentRecipeIdx != itemis->operations.currentRecipeIdx ||
+        tables->operations.currentStepIdx != itemis->operations.currentStepIdx ||
+        tables->operations.finishedPending != itemis->operations.finishedPending ||
+        tables->operations.shutdowns != itemis->operations.shutdowns || tables->timers.count != itemis->timers.count)
+    {
+      char message[160];
+      snprintf(message, sizeof(message), "evento %lu: folha %d (tabelas) x %d (itemis), receita %d/%d x %d/%d, timers %d x %d",
+               i, tables->leaf(), itemis->leaf(), (int)tables->operations.currentRecipeIdx,
+               (int)tables->operations.currentStepIdx, (int)itemis->operations.currentRecipeIdx,
+               (int)itemis->operations.currentStepIdx, tables->timers.count, itemis->timers.count);
+      TEST_FAIL_MESSAGE(message);
+    }
+    visited[tables->leaf()] = true;
+  }
+
+  int visitedCount = 0;
+  for (int s = 1; s <= Statechart::numStates; ++s)
+  {
+    visitedCount += visited[s] ? 1 : 0;
+  }
+  char report[160];
+  snprintf(report, sizeof(report), "%lu eventos iguais nas duas maquinas, %d estados visitados, %lu reinicios",
+           tables->events, visitedCount, tables->restarts);
+  TEST_MESSAGE(report);
+  TEST_ASSERT_EQUAL_UINT32(itemis->events, tables->events);
+  TEST_ASSERT_EQUAL_UINT32(0, tables->timers.overflows + itemis->timers.overflows);
+  TEST_ASSERT_TRUE(visited[Statechart::main_region_STANDARD_PROCESS_standard_process_CONTROL_PROCESS_LOOP]);
+  TEST_ASSERT_TRUE(visited[Statechart::main_region_FINISHED_MESSAGE]);
+  TEST_ASSERT_TRUE(tables->restarts > 0);
+  delete tables;
+  delete itemis;
+}
+
+void test_table_dispatch_is_not_slower_than_the_itemis_code(void)
+{
+  const char *streams[] = {"fluxo aleatorio", "receita completa"};
+  for (int laps = 0; laps < 2; ++laps)
+  {
+    int tablesLeaf = 0, itemisLeaf = 0;
+    double itemis = nanosPerEvent<BaselineStatechart>(laps, itemisLeaf);
+    double tables = nanosPerEvent<Statechart>(laps, tablesLeaf);
+    TEST_ASSERT_EQUAL(itemisLeaf, tablesLeaf);
+
+    char report[160];
+    snprintf(report, sizeof(report), "%s: itemis %.1f ns/evento, tabelas %.1f ns/evento, %.2fx",
+             streams[laps], itemis, tables, itemis / tables);
+    TEST_MESSAGE(report);
+    TEST_ASSERT_LESS_THAN_FLOAT_MESSAGE((float)(itemis * STATECHART_DISPATCH_MAX_RATIO), (float)tables,
+                                      "despacho por tabelas mais lento que o codigo do itemis");
+  }
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_both_dispatchers_follow_the_same_event_stream);
+  RUN_TEST(test_table_dispatch_is_not_slower_than_the_itemis_code);
+  return UNITY_END();
+}
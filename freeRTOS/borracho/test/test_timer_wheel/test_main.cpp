@@ -0,0 +1,230 @@
+/**
+ * @file test_main.cpp
+ * @brief TimerWheel no host: timers paralelos, rearme periódico, cancelamento, gerações e voltas.
+ * @details A roda é avançada tick a tick e cada expiração retirada com takeExpired() é anotada com
+ * o tick em que saiu, como a stateMachineTask faria depois de cada aviso do StatechartTimer. Os
+ * eventos são endereços de um vetor de flags, como o `timeEvents` da statechart. Cobre vários
+ * timers no mesmo tick e em ticks diferentes, o período mantido a cada rearme, o cancelamento antes
+ * e depois do tick (a expiração pendente fica obsoleta e não chega ao estado reentrado), expirações
+ * que esperam várias voltas e atrasos maiores que as TIMER_WHEEL_SLOTS posições.
+ * @author agent
+ * @date 16/10/2026
+ * @copyright Copyright (c) 2026
+ */
+
+#include <unity.h>
+
+#include <vector>
+
+// Includes do projeto
+#include "TimerWheel.h"
+
+static bool timeEvents[TIMER_WHEEL_MAX_TIMERS + 1]; // Eventos de tempo (só os endereços importam)
+static sc::timer::TimedInterface *const MACHINE = nullptr;
+
+static TimerWheel *wheel;
+
+/**
+ * @brief Uma expiração entregue: evento e tick em que foi retirada.
+ */
+struct Delivery
+{
+  sc_eventid event;
+  uint32_t tick;
+};
+
+void setUp(void)
+{
+  wheel = new TimerWheel();
+}
+
+void tearDown(void)
+{
+  delete wheel;
+}
+
+static sc_eventid eventAt(int i)
+{
+  return (sc_eventid)&timeEvents[i];
+}
+
+// Retira as expirações pendentes
+static void takeAll(std::vector<Delivery> &deliveries)
+{
+  TimerExpiration expired;
+  while (wheel->takeExpired(expired))
+  {
+    deliveries.push_back({expired.event, wheel->getNow()});
+  }
+}
+
+// Avança `ticks` ticks retirando as expirações a cada um
+static std::vector<Delivery> run(uint32_t ticks)
+{
+  std::vector<Delivery> deliveries;
+  for (uint32_t i = 0; i < ticks; ++i)
+  {
+    wheel->tick();
+    takeAll(deliveries);
+  }
+  return deliveries;
+}
+
+static std::vector<uint32_t> ticksOf(const std::vector<Delivery> &deliveries, sc_eventid event)
+{
+  std::vector<uint32_t> ticks;
+  for (const Delivery &d : deliveries)
+    if (d.event == event)
+      ticks.push_back(d.tick);
+  return ticks;
+}
+
+void test_parallel_timers_fire_once_at_their_own_tick(void)
+{
+  TEST_ASSERT_EQUAL_UINT32(1, TimerWheel::msToTicks(0));
+  TEST_ASSERT_EQUAL_UINT32(1, TimerWheel::msToTicks(1));
+  TEST_ASSERT_EQUAL_UINT32(3, TimerWheel::msToTicks(3 * TIMER_WHEEL_TICK_MS));
+  TEST_ASSERT_EQUAL_UINT32(4, TimerWheel::msToTicks(3 * TIMER_WHEEL_TICK_MS + 1));
+
+  const uint32_t delays[] = {5, 5, 1, 40, 63, 12, 7, 20};
+  for (int i = 0; i < TIMER_WHEEL_MAX_TIMERS; ++i)
+    TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(i), delays[i % 8], false));
+  TEST_ASSERT_EQUAL(TIMER_WHEEL_MAX_TIMERS, wheel->getActiveCount());
+  TEST_ASSERT_FALSE(wheel->arm(MACHINE, eventAt(TIMER_WHEEL_MAX_TIMERS), 3, false)); // Sem posição livre
+  TEST_ASSERT_EQUAL_UINT32(1, wheel->getOverflowCount());
+
+  std::vector<Delivery> deliveries = run(100);
+  TEST_ASSERT_EQUAL(TIMER_WHEEL_MAX_TIMERS, (int)deliveries.size());
+  for (int i = 0; i < TIMER_WHEEL_MAX_TIMERS; ++i)
+  {
+    std::vector<uint32_t> ticks = ticksOf(deliveries, eventAt(i));
+    TEST_ASSERT_EQUAL(1, (int)ticks.size());
+    TEST_ASSERT_EQUAL_UINT32(delays[i % 8], ticks[0]);
+  }
+  TEST_ASSERT_EQUAL(0, wheel->getActiveCount());
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(TIMER_WHEEL_MAX_TIMERS), 3, false)); // Posições liberadas
+}
+
+void test_periodic_timer_rearms_with_the_same_period(void)
+{
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(0), 7, true));
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(1), 64, true)); // Período de uma volta exata
+  std::vector<Delivery> deliveries = run(200);
+
+  std::vector<uint32_t> fast = ticksOf(deliveries, eventAt(0));
+  TEST_ASSERT_EQUAL(200 / 7, (int)fast.size());
+  for (size_t i = 0; i < fast.size(); ++i)
+    TEST_ASSERT_EQUAL_UINT32(7 * (i + 1), fast[i]);
+  std::vector<uint32_t> slow = ticksOf(deliveries, eventAt(1));
+  TEST_ASSERT_EQUAL(3, (int)slow.size());
+  TEST_ASSERT_EQUAL_UINT32(64, slow[0]);
+  TEST_ASSERT_EQUAL_UINT32(128, slow[1]);
+  TEST_ASSERT_EQUAL_UINT32(192, slow[2]);
+  TEST_ASSERT_EQUAL(2, wheel->getActiveCount());
+
+  // Sem retirar: expirações do mesmo timer periódico viram uma, nenhuma é perdida de vez
+  for (int i = 0; i < 3 * 7; ++i)
+    wheel->tick();
+  deliveries.clear();
+  takeAll(deliveries);
+  TEST_ASSERT_EQUAL(1, (int)ticksOf(deliveries, eventAt(0)).size());
+  TEST_ASSERT_EQUAL_UINT32(2, wheel->getCoalescedCount());
+}
+
+void test_cancel_before_the_tick_never_fires(void)
+{
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(0), 10, false));
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(1), 10, true));
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(2), 10, false));
+  run(5);
+  TEST_ASSERT_TRUE(wheel->cancel(eventAt(0)));
+  TEST_ASSERT_TRUE(wheel->cancel(eventAt(1)));
+  TEST_ASSERT_FALSE(wheel->cancel(eventAt(3))); // Nunca armado
+  std::vector<Delivery> deliveries = run(100);
+  TEST_ASSERT_EQUAL(1, (int)deliveries.size());
+  TEST_ASSERT_TRUE(deliveries[0].event == eventAt(2));
+  TEST_ASSERT_EQUAL(0, wheel->getActiveCount());
+}
+
+void test_cancel_or_rearm_after_the_tick_makes_the_expiration_stale(void)
+{
+  // Timer expira no tick, mas o estado é deixado e reentrado antes da entrega
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(0), 3, false));
+  for (int i = 0; i < 3; ++i)
+    wheel->tick();
+  TEST_ASSERT_TRUE(wheel->cancel(eventAt(0)));                  // Saída do estado: ainda encontra o timer
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(0), 3, false)); // Reentrada: nova geração
+  std::vector<Delivery> deliveries;
+  takeAll(deliveries);
+  TEST_ASSERT_EQUAL_MESSAGE(0, (int)deliveries.size(), "expiracao antiga entregue ao estado reentrado");
+  TEST_ASSERT_EQUAL_UINT32(1, wheel->getStaleCount());
+  deliveries = run(3);
+  TEST_ASSERT_EQUAL(1, (int)deliveries.size());
+  TEST_ASSERT_EQUAL_UINT32(6, deliveries[0].tick); // O atraso todo a partir da reentrada
+
+  // Periódico rearmado com outro período depois do tick
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(1), 2, true));
+  wheel->tick();
+  wheel->tick();
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(1), 5, true));
+  deliveries.clear();
+  takeAll(deliveries);
+  TEST_ASSERT_EQUAL(0, (int)deliveries.size());
+  deliveries = run(10);
+  std::vector<uint32_t> ticks = ticksOf(deliveries, eventAt(1));
+  TEST_ASSERT_EQUAL(2, (int)ticks.size());
+  TEST_ASSERT_EQUAL_UINT32(13, ticks[0]);
+  TEST_ASSERT_EQUAL_UINT32(18, ticks[1]);
+
+  // Cancelado depois do tick e a posição reaproveitada por outro evento
+  TEST_ASSERT_TRUE(wheel->cancel(eventAt(1)));
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(2), 1, false));
+  wheel->tick();
+  TEST_ASSERT_TRUE(wheel->cancel(eventAt(2)));
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(3), 50, false));
+  deliveries.clear();
+  takeAll(deliveries);
+  TEST_ASSERT_EQUAL(0, (int)deliveries.size());
+  TEST_ASSERT_EQUAL_UINT32(3, wheel->getStaleCount());
+}
+
+void test_delays_longer_than_the_wheel_take_rounds(void)
+{
+  const uint32_t delays[] = {TIMER_WHEEL_SLOTS - 1, TIMER_WHEEL_SLOTS, TIMER_WHEEL_SLOTS + 1,
+                             2 * TIMER_WHEEL_SLOTS, 2 * TIMER_WHEEL_SLOTS + 3, 1000, 6000};
+  const int count = sizeof(delays) / sizeof(delays[0]);
+  run(17); // Cursor fora da posição 0
+  for (int i = 0; i < count; ++i)
+    TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(i), delays[i], false));
+
+  std::vector<Delivery> deliveries = run(7000);
+  TEST_ASSERT_EQUAL(count, (int)deliveries.size());
+  for (int i = 0; i < count; ++i)
+  {
+    std::vector<uint32_t> ticks = ticksOf(deliveries, eventAt(i));
+    TEST_ASSERT_EQUAL(1, (int)ticks.size());
+    TEST_ASSERT_EQUAL_UINT32(17 + delays[i], ticks[0]);
+  }
+
+  // Periódico maior que a roda: cada rearme também conta as voltas
+  TEST_ASSERT_TRUE(wheel->arm(MACHINE, eventAt(0), 3 * TIMER_WHEEL_SLOTS + 5, true));
+  uint32_t start = wheel->getNow();
+  deliveries = run(4 * (3 * TIMER_WHEEL_SLOTS + 5));
+  std::vector<uint32_t> ticks = ticksOf(deliveries, eventAt(0));
+  TEST_ASSERT_EQUAL(4, (int)ticks.size());
+  for (int i = 0; i < 4; ++i)
+    TEST_ASSERT_EQUAL_UINT32(start + (i + 1) * (3 * TIMER_WHEEL_SLOTS + 5), ticks[i]);
+}
+
+int main(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_parallel_timers_fire_once_at_their_own_tick);
+  RUN_TEST(test_periodic_timer_rearms_with_the_same_period);
+  RUN_TEST(test_cancel_before_the_tick_never_fires);
+  RUN_TEST(test_cancel_or_rearm_after_the_tick_makes_the_expiration_stale);
+  RUN_TEST(test_delays_longer_than_the_wheel_take_rounds);
+  return UNITY_END();
+}
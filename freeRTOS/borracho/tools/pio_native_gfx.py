@@ -0,0 +1,20 @@
+"""
+Script PlatformIO do env:native (extra_scripts = pre:tools/pio_native_gfx.py).
+
+Os testes no host desenham com a Adafruit_GFX de verdade (HeadlessDisplay), mas a biblioteca
+também traz os drivers Adafruit_SPITFT e Adafruit_GrayOLED, que dependem do SPI/Wire do Arduino
+e da Adafruit BusIO (lib_ignore no env:native). Este script tira os dois do build; o desenho
+(Adafruit_GFX.cpp e a fonte glcdfont.c) continua igual ao do firmware.
+"""
+
+Import("env")  # noqa: F821 (injetado pelo SCons do PlatformIO)
+
+HARDWARE_DRIVERS = ("Adafruit_SPITFT.cpp", "Adafruit_GrayOLED.cpp")
+
+
+def skip_driver(node):
+    return None  # None: o arquivo não é compilado
+
+
+for driver in HARDWARE_DRIVERS:
+    env.AddBuildMiddleware(skip_driver, "*/" + driver)  # noqa: F821
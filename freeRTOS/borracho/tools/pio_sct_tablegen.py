@@ -0,0 +1,35 @@
+"""
+Script PlatformIO (extra_scripts = pre:tools/pio_sct_tablegen.py).
+
+Antes de cada build, regenera src/src-gen/StatechartModel.h a partir de
+../../itemis/project/Statechart.ysc quando o modelo for mais novo que o arquivo gerado.
+Se o modelo não estiver disponível (ex: só a pasta do firmware foi copiada), mantém o
+arquivo versionado no repositório.
+"""
+
+import os
+import sys
+
+Import("env")  # noqa: F821 (injetado pelo SCons do PlatformIO)
+
+PROJECT_DIR = env["PROJECT_DIR"]  # noqa: F821
+MODEL = os.path.normpath(os.path.join(PROJECT_DIR, "..", "..", "itemis", "project", "Statechart.ysc"))
+OUTPUT = os.path.join(PROJECT_DIR, "src", "src-gen", "StatechartModel.h")
+GENERATOR = os.path.join(PROJECT_DIR, "tools", "sct_tablegen.py")
+
+sys.path.insert(0, os.path.dirname(GENERATOR))
+import sct_tablegen  # noqa: E402
+
+
+def needs_update():
+    if not os.path.exists(OUTPUT):
+        return True
+    generated = os.path.getmtime(OUTPUT)
+    return os.path.getmtime(MODEL) > generated or os.path.getmtime(GENERATOR) > generated
+
+
+if not os.path.exists(MODEL):
+    print("sct_tablegen: modelo %s não encontrado, usando o StatechartModel.h versionado" % MODEL)
+elif needs_update():
+    if sct_tablegen.main(["sct_tablegen", MODEL, OUTPUT]) != 0:
+        env.Exit(1)  # noqa: F821
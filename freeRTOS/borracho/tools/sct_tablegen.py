@@ -0,0 +1,646 @@
+"""
+Gerador de tabelas da máquina de estados a partir do modelo itemis CREATE (Statechart.ysc).
+
+Lê o modelo (.ysc) e gera `src/src-gen/StatechartModel.h`, com:
+  - tabelas constexpr de estados (pai, filho inicial, último descendente, ações de entrada/saída)
+    e de transições (evento, guarda, destino, efeito), armazenadas em flash;
+  - as ações e guardas do modelo traduzidas para C++ (um `switch` por tipo);
+  - o interpretador que percorre as tabelas (microStep, entrada/saída de estados, isStateActive).
+
+O arquivo gerado é incluído apenas por `Statechart.cpp`, que mantém a API pública gerada pelo
+itemis (raise*, get/set das variáveis, OperationCallback, fila de eventos).
+
+Uso:
+    python tools/sct_tablegen.py [modelo.ysc] [saida.h]
+
+Sem argumentos, usa ../../itemis/project/Statechart.ysc e src/src-gen/StatechartModel.h
+relativos ao projeto PlatformIO (freeRTOS/borracho). Também é chamado antes de cada build
+pelo script tools/pio_sct_tablegen.py (extra_scripts do platformio.ini).
+"""
+
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+XSI_TYPE = '{http://www.w3.org/2001/XMLSchema-instance}type'
+XMI_ID = '{http://www.omg.org/XMI}id'
+SGRAPH = '{http://www.yakindu.org/sct/sgraph/2.0.0}'
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_MODEL = os.path.join(PROJECT_DIR, '..', '..', 'itemis', 'project', 'Statechart.ysc')
+DEFAULT_OUTPUT = os.path.join(PROJECT_DIR, 'src', 'src-gen', 'StatechartModel.h')
+
+NONE = 0xFF  # Índice "nenhum estado" nas tabelas
+
+
+class ModelError(Exception):
+    """Construção do modelo não suportada pelo gerador."""
+
+
+# --- MODELO ---
+class State:
+    def __init__(self, name, enum_name, parent, spec):
+        self.name = name
+        self.enum_name = enum_name
+        self.parent = parent
+        self.spec = spec or ''
+        self.children = []
+        self.initial = None
+        self.transitions = []
+        self.index = None
+        self.last_descendant = None
+        self.entry = []
+        self.exit = []
+        self.time_events = []  # (nome do evento, índice global, atraso em ms)
+
+
+class Transition:
+    def __init__(self, source, target, spec):
+        self.source = source
+        self.target = target
+        self.spec = spec or ''
+        self.triggers = []
+        self.guard = None
+        self.effect = []
+
+
+def strip_comments(text):
+    """Remove comentários // (fora de strings) e normaliza as quebras de linha."""
+    lines = []
+    for line in text.replace('\r', '').split('\n'):
+        out, in_string = '', False
+        i = 0
+        while i < len(line):
+            c = line[i]
+            if c == '"':
+                in_string = not in_string
+            if not in_string and line.startswith('//', i):
+                break
+            out += c
+            i += 1
+        lines.append(out)
+    return '\n'.join(lines)
+
+
+def split_top_level(text, sep):
+    """Divide `text` em `sep` ignorando parênteses, colchetes e strings."""
+    parts, depth, in_string, current = [], 0, False, ''
+    for c in text:
+        if c == '"':
+            in_string = not in_string
+        elif not in_string and c in '([':
+            depth += 1
+        elif not in_string and c in ')]':
+            depth -= 1
+        if c == sep and depth == 0 and not in_string:
+            parts.append(current)
+            current = ''
+        else:
+            current += c
+    parts.append(current)
+    return parts
+
+
+def parse_interface(specification):
+    """Extrai eventos de entrada, variáveis e operações da especificação do statechart."""
+    events, variables, operations = [], {}, set()
+    for line in strip_comments(specification).split('\n'):
+        line = line.strip()
+        m = re.match(r'in\s+event\s+(\w+)\s*(?::\s*(\w+))?$', line)
+        if m:
+            if m.group(2):
+                raise ModelError('eventos com valor não são suportados: ' + m.group(1))
+            events.append(m.group(1))
+            continue
+        m = re.match(r'var\s+(\w+)\s*:\s*(\w+)\s*(?:=\s*(.+))?$', line)
+        if m:
+            variables[m.group(1)] = m.group(3)
+            continue
+        m = re.match(r'operation\s+(\w+)\s*\(', line)
+        if m:
+            operations.add(m.group(1))
+    return events, variables, operations
+
+
+def load_model(path):
+    root = ET.parse(path).getroot()
+    statechart = root.find(SGRAPH + 'Statechart')
+    if statechart is None:
+        raise ModelError('nenhum sgraph:Statechart em ' + path)
+    events, variables, operations = parse_interface(statechart.get('specification', ''))
+
+    states, by_id, pending = [], {}, []
+
+    def load_region(region_elem, parent, prefix):
+        region_name = region_elem.get('name', '').replace(' ', '_')
+        region_prefix = (prefix + '_' if prefix else '') + region_name
+        initial_target = None
+        for vertex in region_elem.findall('vertices'):
+            vtype = vertex.get(XSI_TYPE)
+            if vtype == 'sgraph:Entry':
+                outs = vertex.findall('outgoingTransitions')
+                if len(outs) != 1:
+                    raise ModelError('entrada da região %s deve ter uma única transição' % region_prefix)
+                initial_target = outs[0].get('target')
+                continue
+            if vtype != 'sgraph:State':
+                raise ModelError('vértice %s não suportado em %s' % (vtype, region_prefix))
+            name = vertex.get('name')
+            state = State(name, region_prefix + '_' + name, parent, vertex.get('specification'))
+            states.append(state)
+            by_id[vertex.get(XMI_ID)] = state
+            if parent is not None:
+                parent.children.append(state)
+            for out in vertex.findall('outgoingTransitions'):
+                pending.append((state, out.get('target'), out.get('specification')))
+            regions = vertex.findall('regions')
+            if len(regions) > 1:
+                raise ModelError('regiões ortogonais não são suportadas (%s)' % state.enum_name)
+            for sub in regions:
+                state.initial = load_region(sub, state, state.enum_name)
+        return initial_target
+
+    regions = statechart.findall('regions')
+    if len(regions) != 1:
+        raise ModelError('o statechart deve ter exatamente uma região principal')
+    root_initial = load_region(regions[0], None, '')
+
+    for i, state in enumerate(states):
+        state.index = i + 1  # 0 é Statechart_last_state
+    for state in states:
+        if state.initial is not None:
+            state.initial = by_id[state.initial]
+    for source, target_id, spec in pending:
+        source.transitions.append(Transition(source, by_id[target_id], spec))
+    for state in reversed(states):
+        state.last_descendant = max([state.index] + [c.last_descendant for c in state.children])
+    return {
+        'events': events,
+        'variables': variables,
+        'operations': operations,
+        'states': states,
+        'initial': by_id[root_initial],
+    }
+
+
+# --- TRADUÇÃO DA LINGUAGEM DE AÇÕES ---
+TOKEN = re.compile(r'\s*(?:(\d+)|(\w+)|("(?:[^"\\]|\\.)*")|(&&|\|\||==|!=|<=|>=|[-+*/%!<>=(),]))')
+KEYWORDS = {'and': '&&', 'or': '||', 'not': '!', 'true': 'true', 'false': 'false'}
+
+
+def translate_expression(expr, model, where):
+    out, pos = [], 0
+    expr = expr.strip()
+    while pos < len(expr):
+        m = TOKEN.match(expr, pos)
+        if not m or m.end() == pos:
+            raise ModelError('expressão inválida em %s: %r' % (where, expr))
+        pos = m.end()
+        number, ident, string, op = m.groups()
+        if number:
+            out.append(number)
+        elif string:
+            out.append(string)
+        elif op:
+            out.append(op)
+        elif ident in KEYWORDS:
+            out.append(KEYWORDS[ident])
+        elif ident in model['operations']:
+            out.append('ifaceOperationCallback->' + ident)
+        elif ident in model['variables']:
+            out.append(ident)
+        else:
+            raise ModelError('identificador desconhecido %r em %s' % (ident, where))
+    code = ''
+    for token in out:
+        if code and (token[0].isalnum() or token[0] in '"_!') and (code[-1].isalnum() or code[-1] in '_)"'):
+            code += ' '
+        elif token in ('&&', '||', '==', '!=', '<=', '>=', '=', '+', '-', '*', '/', '%', '<', '>'):
+            token = ' ' + token + ' '
+        elif token == ',':
+            token = ', '
+        code += token
+    return code
+
+
+def translate_statements(text, model, where):
+    """Traduz uma sequência de comandos separados por ';' em linhas C++."""
+    lines = []
+    for statement in split_top_level(strip_comments(text).replace('\n', ' '), ';'):
+        statement = statement.strip()
+        if not statement:
+            continue
+        m = re.match(r'raise\s+(\w+)$', statement)
+        if m:
+            if m.group(1) not in model['events']:
+                raise ModelError('evento desconhecido %r em %s' % (m.group(1), where))
+            lines.append('pushInEvent(%s);' % m.group(1))
+            continue
+        lines.append(translate_expression(statement, model, where) + ';')
+    return lines
+
+
+def parse_state_spec(state, model):
+    text = strip_comments(state.spec)
+    clauses = re.split(r'(?m)^\s*(entry|exit)\s*/', '\n' + text)
+    # re.split com grupo: ['', 'entry', corpo, 'exit', corpo, ...]
+    if clauses[0].strip():
+        raise ModelError('reação local não suportada em %s: %r' % (state.enum_name, clauses[0]))
+    for i in range(1, len(clauses), 2):
+        body = translate_statements(clauses[i + 1], model, state.enum_name)
+        (state.entry if clauses[i] == 'entry' else state.exit).extend(body)
+
+
+def parse_transition_spec(transition, model, time_events):
+    spec = strip_comments(transition.spec).replace('\n', ' ').strip()
+    parts = split_top_level(spec, '/')
+    trigger_guard = parts[0].strip()
+    if len(parts) > 1:
+        transition.effect = translate_statements('/'.join(parts[1:]), model, transition.source.enum_name)
+    m = re.match(r'^([^\[]*)(?:\[(.*)\])?$', trigger_guard)
+    if not m:
+        raise ModelError('transição inválida em %s: %r' % (transition.source.enum_name, spec))
+    triggers, guard = m.group(1).strip(), m.group(2)
+    if guard:
+        transition.guard = translate_expression(guard, model, transition.source.enum_name)
+    if not triggers:
+        raise ModelError('transições sem gatilho não são suportadas (%s)' % transition.source.enum_name)
+    m = re.match(r'after\s+(\d+)\s*(s|ms)$', triggers)
+    if m:
+        source = transition.source
+        delay = int(m.group(1)) * (1000 if m.group(2) == 's' else 1)
+        name = 'Statechart_%s_time_event_%d' % (source.enum_name, len(source.time_events))
+        source.time_events.append((name, len(time_events), delay))
+        time_events.append(name)
+        transition.triggers = [name]
+        return
+    for trigger in triggers.split(','):
+        trigger = trigger.strip()
+        if trigger not in model['events']:
+            raise ModelError('evento desconhecido %r em %s' % (trigger, transition.source.enum_name))
+        transition.triggers.append(trigger)
+
+
+# --- GERAÇÃO ---
+def ancestors_or_self(state):
+    chain = []
+    while state is not None:
+        chain.append(state)
+        state = state.parent
+    return chain
+
+
+def exit_scope(source, target):
+    """Estado mais externo que a transição abandona (filho do ancestral comum mais próximo).
+
+    Se o destino é a própria origem ou um de seus ancestrais, a transição sai até o destino
+    (inclusive) e entra nele de novo, como no código gerado pelo itemis.
+    """
+    if target in ancestors_or_self(source):
+        return target
+    target_chain = ancestors_or_self(target)
+    top = source
+    while top.parent is not None and top.parent not in target_chain:
+        top = top.parent
+    return top
+
+
+def generate(model, model_path):
+    states = model['states']
+    time_events = []
+    for state in states:
+        parse_state_spec(state, model)
+    for state in states:
+        for transition in state.transitions:
+            parse_transition_spec(transition, model, time_events)
+
+    # Ações: entrada (timers primeiro, como no gerador itemis), saída e efeitos de transição
+    actions, action_enum = [], []
+
+    def add_action(name, lines):
+        if not lines:
+            return 'ACTION_NONE'
+        actions.append((name, lines))
+        action_enum.append(name)
+        return name
+
+    guards, guard_ids = [], {}
+
+    def add_guard(code):
+        if code is None:
+            return 'GUARD_NONE'
+        if code not in guard_ids:
+            guard_ids[code] = 'GUARD_%d' % (len(guards) + 1)
+            guards.append((guard_ids[code], code))
+        return guard_ids[code]
+
+    state_rows, transition_rows = [], []
+    for state in states:
+        entry = ['timerService->setTimer(this, (sc_eventid)(&timeEvents[%d]), %d, false);' % (idx, delay)
+                 for _, idx, delay in state.time_events] + state.entry
+        exit_ = ['timerService->unsetTimer(this, (sc_eventid)(&timeEvents[%d]));' % idx
+                 for _, idx, _ in state.time_events] + state.exit
+        state.entry_action = add_action('ACTION_ENTRY_' + state.enum_name, entry)
+        state.exit_action = add_action('ACTION_EXIT_' + state.enum_name, exit_)
+        state.first_transition = len(transition_rows)
+        for n, transition in enumerate(state.transitions):
+            effect = add_action('ACTION_EFFECT_%s_%d' % (state.enum_name, n), transition.effect)
+            guard = add_guard(transition.guard)
+            for trigger in transition.triggers:
+                transition_rows.append((trigger, guard, transition.target, effect, state))
+        state.transition_count = len(transition_rows) - state.first_transition
+
+    if len(states) >= NONE or len(transition_rows) > 0xFF or len(actions) >= 0xFF:
+        raise ModelError('modelo grande demais para índices de 8 bits')
+
+    o = []
+    w = o.append
+    w('/* Generated by tools/sct_tablegen.py from %s. Do not edit. */' % os.path.basename(model_path))
+    w('')
+    w('#ifndef STATECHARTMODEL_H_')
+    w('#define STATECHARTMODEL_H_')
+    w('')
+    w('/*! \\file')
+    w('Tables, actions and interpreter of the state machine \'Statechart\'.')
+    w('Included only by Statechart.cpp.')
+    w('*/')
+    w('')
+    w('#include "Statechart.h"')
+    w('')
+    w('namespace statechart_model')
+    w('{')
+    w('')
+    w('/*! Static description of a state. Indices are StatechartStates values. */')
+    w('struct StateInfo')
+    w('{')
+    w('\tuint8_t parent;          /* enclosing state, NO_STATE for the main region */')
+    w('\tuint8_t initial;         /* default child of a composite state, NO_STATE for leaves */')
+    w('\tuint8_t lastDescendant;  /* states are numbered in pre-order: [state, lastDescendant] is the subtree */')
+    w('\tuint8_t entryAction;')
+    w('\tuint8_t exitAction;')
+    w('\tuint8_t firstTransition; /* outgoing transitions, in model priority order */')
+    w('\tuint8_t transitionCount;')
+    w('};')
+    w('')
+    w('/*! Outgoing transition of a state. */')
+    w('struct TransitionInfo')
+    w('{')
+    w('\tuint16_t event;  /* StatechartEventName that triggers the transition */')
+    w('\tuint8_t guard;')
+    w('\tuint8_t target;')
+    w('\tuint8_t effect;')
+    w('\tuint8_t exitTop; /* outermost state left: child of the least common ancestor, or the target itself */')
+    w('};')
+    w('')
+    w('static const uint8_t NO_STATE = 0x%02X;' % NONE)
+    w('static const uint8_t ROOT_INITIAL = Statechart::%s;' % model['initial'].enum_name)
+    w('')
+    w('enum ActionId : uint8_t')
+    w('{')
+    w('\tACTION_NONE,')
+    for name in action_enum:
+        w('\t%s,' % name)
+    w('};')
+    w('')
+    w('enum GuardId : uint8_t')
+    w('{')
+    w('\tGUARD_NONE,')
+    for name, _ in guards:
+        w('\t%s,' % name)
+    w('};')
+    w('')
+    w('constexpr StateInfo states[Statechart::numStates + 1] = {')
+    w('\t{NO_STATE, NO_STATE, 0, ACTION_NONE, ACTION_NONE, 0, 0}, /* Statechart_last_state */')
+    for state in states:
+        parent = 'Statechart::' + state.parent.enum_name if state.parent else 'NO_STATE'
+        initial = 'Statechart::' + state.initial.enum_name if state.initial else 'NO_STATE'
+        w('\t{%s, %s, %d, %s, %s, %d, %d}, /* %s */' % (
+            parent, initial, state.last_descendant, state.entry_action, state.exit_action,
+            state.first_transition, state.transition_count, state.enum_name))
+    w('};')
+    w('')
+    w('constexpr TransitionInfo transitions[] = {')
+    for trigger, guard, target, effect, source in transition_rows:
+        w('\t{statechart_events::%s, %s, Statechart::%s, %s, Statechart::%s}, /* from %s */' % (
+            trigger, guard, target.enum_name, effect, exit_scope(source, target).enum_name, source.name))
+    w('};')
+    w('')
+    w('/* The hand-kept Statechart.h must match the model. */')
+    w('static_assert(Statechart::numStates == %d, "Statechart.h is out of date with the model");' % len(states))
+    w('static_assert(Statechart::timeEventsCount == %d, "Statechart.h is out of date with the model");' % len(time_events))
+    for state in states:
+        w('static_assert(Statechart::%s == %d, "Statechart.h is out of date with the model");' % (state.enum_name, state.index))
+    for i, event in enumerate(model['events']):
+        w('static_assert(statechart_events::%s == %d, "Statechart.h is out of date with the model");' % (event, i + 1))
+    for i, event in enumerate(time_events):
+        w('static_assert(statechart_events::%s == %d, "Statechart.h is out of date with the model");' % (
+            event, len(model['events']) + 1 + i))
+    w('')
+    w('} /* namespace statechart_model */')
+    w('')
+    w('')
+    w('/* Actions of the model (entry/exit actions and transition effects). */')
+    w('void Statechart::executeAction(sc_ushort action)')
+    w('{')
+    w('\tswitch (action)')
+    w('\t{')
+    for name, lines in actions:
+        w('\t\tcase statechart_model::%s:' % name)
+        for line in lines:
+            w('\t\t\t%s' % line)
+        w('\t\t\tbreak;')
+    w('\t\tdefault:')
+    w('\t\t\tbreak;')
+    w('\t}')
+    w('}')
+    w('')
+    w('/* Guards of the model. */')
+    w('sc_boolean Statechart::evaluateGuard(sc_ushort guard)')
+    w('{')
+    w('\tswitch (guard)')
+    w('\t{')
+    for name, code in guards:
+        w('\t\tcase statechart_model::%s:' % name)
+        w('\t\t\treturn %s;' % code)
+    w('\t\tdefault:')
+    w('\t\t\treturn true;')
+    w('\t}')
+    w('}')
+    w('')
+    o.extend(INTERPRETER.split('\n'))
+    w('#endif /* STATECHARTMODEL_H_ */')
+    return '\n'.join(o) + '\n'
+
+
+INTERPRETER = '''/*
+ * Interpreter. Single region per composite state, so the state configuration
+ * vector holds only the active leaf; ancestors are implied by the tables.
+ */
+
+static inline sc_boolean isAncestorOrSelf(sc_ushort ancestor, sc_ushort state)
+{
+	return state >= ancestor && state <= statechart_model::states[ancestor].lastDescendant;
+}
+
+/* Enters 'state' (running its entry action) and descends into the default children. */
+inline void Statechart::enterStateDefault(sc_ushort state)
+{
+	for (;;)
+	{
+		const statechart_model::StateInfo & info = statechart_model::states[state];
+		if (info.entryAction != statechart_model::ACTION_NONE)
+		{
+			executeAction(info.entryAction);
+		}
+		if (info.initial == statechart_model::NO_STATE)
+		{
+			stateConfVector[0] = (StatechartStates) state;
+			return;
+		}
+		state = info.initial;
+	}
+}
+
+/* Enters 'target' coming from 'outer' (exclusive): entry actions run from the outside in. */
+inline void Statechart::enterStatePath(sc_ushort outer, sc_ushort target)
+{
+	if (statechart_model::states[target].parent != outer)
+	{
+		sc_ushort path[numStates];
+		sc_ushort depth = 0;
+		for (sc_ushort s = statechart_model::states[target].parent; s != outer; s = statechart_model::states[s].parent)
+		{
+			path[depth++] = s;
+		}
+		while (depth > 0)
+		{
+			const sc_ushort action = statechart_model::states[path[--depth]].entryAction;
+			if (action != statechart_model::ACTION_NONE)
+			{
+				executeAction(action);
+			}
+		}
+	}
+	enterStateDefault(target);
+}
+
+/* Exits the active leaf and its ancestors up to and including 'outermost' (innermost first). */
+inline void Statechart::exitStatesUpTo(sc_ushort outermost)
+{
+	sc_ushort s = stateConfVector[0];
+	while (s != Statechart_last_state && s != statechart_model::NO_STATE)
+	{
+		const statechart_model::StateInfo & info = statechart_model::states[s];
+		if (info.exitAction != statechart_model::ACTION_NONE)
+		{
+			executeAction(info.exitAction);
+		}
+		stateConfVector[0] = (info.parent == statechart_model::NO_STATE) ? Statechart_last_state : (StatechartStates) info.parent;
+		if (s == outermost)
+		{
+			return;
+		}
+		s = info.parent;
+	}
+}
+
+/* External transition: exit up to the precomputed scope, run the effect, enter the target. */
+inline void Statechart::takeTransition(const statechart_model::TransitionInfo & transition)
+{
+	exitStatesUpTo(transition.exitTop);
+	if (transition.effect != statechart_model::ACTION_NONE)
+	{
+		executeAction(transition.effect);
+	}
+	enterStatePath(statechart_model::states[transition.exitTop].parent, transition.target);
+}
+
+/* Child-first search for the first enabled transition, from the active leaf outwards. */
+sc_boolean Statechart::microStep(sc_ushort event)
+{
+	if (event == invalid_event)
+	{
+		return false;
+	}
+	for (sc_ushort s = stateConfVector[0]; s != Statechart_last_state && s != statechart_model::NO_STATE; s = statechart_model::states[s].parent)
+	{
+		const statechart_model::StateInfo & info = statechart_model::states[s];
+		const statechart_model::TransitionInfo * transition = &statechart_model::transitions[info.firstTransition];
+		const statechart_model::TransitionInfo * const end = transition + info.transitionCount;
+		for (; transition != end; ++transition)
+		{
+			if (transition->event == event
+				&& (transition->guard == statechart_model::GUARD_NONE || evaluateGuard(transition->guard)))
+			{
+				takeTransition(*transition);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void Statechart::enterInitialState()
+{
+	enterStatePath(statechart_model::NO_STATE, statechart_model::ROOT_INITIAL);
+}
+
+void Statechart::exitAllStates()
+{
+	exitStatesUpTo(statechart_model::NO_STATE);
+}
+
+sc_boolean Statechart::restoreActiveState(StatechartStates state)
+{
+	if (isExecuting || isActive() || state <= Statechart_last_state || state > numStates
+		|| statechart_model::states[state].initial != statechart_model::NO_STATE)
+	{
+		return false;
+	}
+	stateConfVector[0] = state;
+	return true;
+}
+
+sc_boolean Statechart::isStateConfigurationValid() const
+{
+	const sc_ushort state = stateConfVector[0];
+	if (state == Statechart_last_state)
+	{
+		return true;
+	}
+	return state <= numStates && statechart_model::states[state].initial == statechart_model::NO_STATE;
+}
+
+sc_boolean Statechart::isStateActive(StatechartStates state) const
+{
+	if (state <= Statechart_last_state || state > numStates)
+	{
+		return false;
+	}
+	return isAncestorOrSelf(state, stateConfVector[0]);
+}
+'''
+
+
+def main(argv):
+    model_path = argv[1] if len(argv) > 1 else DEFAULT_MODEL
+    output_path = argv[2] if len(argv) > 2 else DEFAULT_OUTPUT
+    try:
+        code = generate(load_model(model_path), model_path)
+    except ModelError as error:
+        sys.stderr.write('sct_tablegen: %s\n' % error)
+        return 1
+    old = None
+    if os.path.exists(output_path):
+        with open(output_path, 'r', encoding='utf-8') as f:
+            old = f.read()
+    if old != code:
+        with open(output_path, 'w', encoding='utf-8', newline='\n') as f:
+            f.write(code)
+        print('sct_tablegen: %s gerado' % os.path.relpath(output_path))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))